@@ -38,6 +38,7 @@
 #include "exo_struct.h"
 #include "std.h"
 #include "stdio.h"
+#include "util/checkpoint_io.h"
 
 #ifndef GOMA_AC_PARTICLES_C
 #define EXTERN extern
@@ -93,7 +94,7 @@ enum Particle_Model_t {
   DIELECTROPHORETIC_TRACER_IMPLICIT
 };
 
-enum Particle_Output_Format_t { FLAT_TEXT, TECPLOT };
+enum Particle_Output_Format_t { FLAT_TEXT, TECPLOT, BINARY };
 
 enum PBC { PBC_OUTFLOW, PBC_SOURCE, PBC_TARGET, PBC_FREESTREAM_SOURCE, PBC_IMPERMEABLE };
 
@@ -208,6 +209,14 @@ EXTERN int compute_particles(const Exo_DB *,
                              const dbl,
                              const int);
 
+EXTERN void close_particle_output(void);
+
+EXTERN void free_particles(void);
+
 EXTERN void rd_particle_specs /* mm_input_particles.c */
     (FILE *, char *);
+
+EXTERN int write_particle_checkpoint(goma_ckpt_buffer *);
+
+EXTERN int read_particle_checkpoint(goma_ckpt_buffer *);
 #endif /* GOMA_AC_PARTICLES_H */
@@ -10,19 +10,26 @@ typedef struct Distributed_Processing_Information Dpi;
 #include "exo_struct.h"
 #endif
 
-void adapt_mesh_omega_h(struct GomaLinearSolverData **ams,
-                        Exo_DB *exo,
-                        Dpi *dpi,
-                        double **x,
-                        double **x_old,
-                        double **x_older,
-                        double **xdot,
-                        double **xdot_old,
-                        double **x_oldest,
-                        double **resid_vector,
-                        double **x_update,
-                        double **scale,
-                        int step);
+/*
+ * Returns FALSE, leaving everything untouched, if the mesh did not need
+ * adapting.  With on_error set it is only adapted when the error estimate
+ * of the current solution exceeds the Adapt Error Threshold; the estimate
+ * is made on the same Omega_h mesh that is then adapted.
+ */
+int adapt_mesh_omega_h(struct GomaLinearSolverData **ams,
+                       Exo_DB *exo,
+                       Dpi *dpi,
+                       double **x,
+                       double **x_old,
+                       double **x_older,
+                       double **xdot,
+                       double **xdot_old,
+                       double **x_oldest,
+                       double **resid_vector,
+                       double **x_update,
+                       double **scale,
+                       int step,
+                       int on_error);
 
 #if defined(c_plusplus) || defined(__cplusplus)
 }
@@ -7,5 +7,6 @@
 
 goma_error setup_base_mesh(Dpi *dpi, Exo_DB *exo, int num_proc);
 goma_error free_base_mesh(Exo_DB *exo);
+goma_error unalias_base_mesh(Dpi *dpi, Exo_DB *exo);
 
 #endif // GOMA_BASE_MESH_H
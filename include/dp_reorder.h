@@ -0,0 +1,23 @@
+#ifndef GOMA_DP_REORDER_H
+#define GOMA_DP_REORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "dpi.h"
+#include "exo_struct.h"
+#include "mm_eh.h"
+
+/* Mesh_Reorder_Type values */
+#define MESH_REORDER_NONE    0
+#define MESH_REORDER_RCM     1
+#define MESH_REORDER_HILBERT 2
+
+goma_error reorder_mesh(Exo_DB *exo, Dpi *dpi, int reorder_type);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // GOMA_DP_REORDER_H
@@ -0,0 +1,323 @@
+#ifndef GDS_VEC3_H
+#define GDS_VEC3_H
+
+#include <math.h>
+
+#include "gds/gds_vector.h"
+
+#ifdef __cplusplus
+extern "C" {
+#define GDS_ALIGNAS(n) alignas(n)
+#else
+#define GDS_ALIGNAS(n) _Alignas(n)
+#endif
+
+#define GDS_VEC3_ALIGNMENT 32
+
+/*
+ * Fixed size 3-vectors and 3x3 matrices.
+ *
+ * Unlike gds_vector these are plain values that live on the stack or in
+ * arrays, with no allocation per vector.  Each vector (and each matrix row)
+ * is padded to four doubles and 32 byte aligned so it fills one AVX register.
+ * The padding entry must stay zero; the functions here keep it that way.
+ */
+typedef struct {
+  GDS_ALIGNAS(GDS_VEC3_ALIGNMENT) double data[4];
+} gds_vec3;
+
+typedef struct {
+  GDS_ALIGNAS(GDS_VEC3_ALIGNMENT) double data[3][4]; /* row major */
+} gds_mat3;
+
+/**
+ * @brief gds_vec3_make
+ * @return vector (x, y, z)
+ */
+static inline gds_vec3 gds_vec3_make(double x, double y, double z) {
+  gds_vec3 v;
+  v.data[0] = x;
+  v.data[1] = y;
+  v.data[2] = z;
+  v.data[3] = 0.0;
+  return v;
+}
+
+/**
+ * @brief gds_vec3_zero set all values of v to 0.0
+ * @param v
+ */
+static inline void gds_vec3_zero(gds_vec3 *v) {
+  for (int i = 0; i < 4; i++) {
+    v->data[i] = 0.0;
+  }
+}
+
+/**
+ * @brief gds_vec3_add
+ * @param y y[i] += x[i]
+ * @param x
+ */
+static inline void gds_vec3_add(gds_vec3 *y, const gds_vec3 *x) {
+  for (int i = 0; i < 4; i++) {
+    y->data[i] += x->data[i];
+  }
+}
+
+/**
+ * @brief gds_vec3_sub
+ * @param y y[i] -= x[i]
+ * @param x
+ */
+static inline void gds_vec3_sub(gds_vec3 *y, const gds_vec3 *x) {
+  for (int i = 0; i < 4; i++) {
+    y->data[i] -= x->data[i];
+  }
+}
+
+/**
+ * @brief gds_vec3_scale
+ * @param y y = y*b
+ * @param b
+ */
+static inline void gds_vec3_scale(gds_vec3 *y, const double b) {
+  for (int i = 0; i < 4; i++) {
+    y->data[i] *= b;
+  }
+}
+
+/**
+ * @brief gds_vec3_axpy
+ * @param alpha
+ * @param x
+ * @param beta
+ * @param y y = alpha * x + beta * y
+ */
+static inline void
+gds_vec3_axpy(const double alpha, const gds_vec3 *x, const double beta, gds_vec3 *y) {
+  for (int i = 0; i < 4; i++) {
+    y->data[i] = y->data[i] * beta + alpha * x->data[i];
+  }
+}
+
+/**
+ * @brief gds_vec3_dot
+ * @param v
+ * @param u
+ * @return u dot v
+ */
+static inline double gds_vec3_dot(const gds_vec3 *v, const gds_vec3 *u) {
+  double dot = 0.0;
+  for (int i = 0; i < 4; i++) {
+    dot += v->data[i] * u->data[i];
+  }
+  return dot;
+}
+
+/**
+ * @brief gds_vec3_norm
+ * @param v
+ * @return magnitude of v
+ */
+static inline double gds_vec3_norm(const gds_vec3 *v) { return sqrt(gds_vec3_dot(v, v)); }
+
+/**
+ * @brief gds_vec3_normalize
+ * @param v in/out normalizes v as v = v / mag(v), left alone when mag(v) is 0
+ * @return mag(v) before normalizing
+ */
+static inline double gds_vec3_normalize(gds_vec3 *v) {
+  double mag = gds_vec3_norm(v);
+  if (mag != 0.0) {
+    gds_vec3_scale(v, 1.0 / mag);
+  }
+  return mag;
+}
+
+/**
+ * @brief gds_vec3_cross
+ * @param v
+ * @param u
+ * @param cross return cross product of v and u, may alias v or u
+ */
+static inline void gds_vec3_cross(const gds_vec3 *v, const gds_vec3 *u, gds_vec3 *cross) {
+  double c0 = v->data[1] * u->data[2] - v->data[2] * u->data[1];
+  double c1 = v->data[2] * u->data[0] - v->data[0] * u->data[2];
+  double c2 = v->data[0] * u->data[1] - v->data[1] * u->data[0];
+  cross->data[0] = c0;
+  cross->data[1] = c1;
+  cross->data[2] = c2;
+  cross->data[3] = 0.0;
+}
+
+/**
+ * @brief gds_vec3_axpy_dot fused axpy and dot product
+ * @param alpha
+ * @param x
+ * @param beta
+ * @param y y = alpha * x + beta * y
+ * @param z
+ * @return (updated y) dot z
+ */
+static inline double gds_vec3_axpy_dot(
+    const double alpha, const gds_vec3 *x, const double beta, gds_vec3 *y, const gds_vec3 *z) {
+  double dot = 0.0;
+  for (int i = 0; i < 4; i++) {
+    y->data[i] = y->data[i] * beta + alpha * x->data[i];
+    dot += y->data[i] * z->data[i];
+  }
+  return dot;
+}
+
+/**
+ * @brief gds_vec3_cross_normalize fused cross product and normalization
+ * @param v
+ * @param u
+ * @param n unit vector along v cross u (zero when v and u are parallel)
+ * @return mag(v cross u)
+ */
+static inline double gds_vec3_cross_normalize(const gds_vec3 *v, const gds_vec3 *u, gds_vec3 *n) {
+  gds_vec3_cross(v, u, n);
+  return gds_vec3_normalize(n);
+}
+
+/**
+ * @brief gds_mat3_identity
+ * @param M M = I
+ */
+static inline void gds_mat3_identity(gds_mat3 *M) {
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      M->data[i][j] = (i == j) ? 1.0 : 0.0;
+    }
+  }
+}
+
+/**
+ * @brief gds_mat3_mul_vec
+ * @param M
+ * @param x
+ * @param y y = M x, may alias x
+ */
+static inline void gds_mat3_mul_vec(const gds_mat3 *M, const gds_vec3 *x, gds_vec3 *y) {
+  double y0 = 0.0, y1 = 0.0, y2 = 0.0;
+  for (int j = 0; j < 4; j++) {
+    y0 += M->data[0][j] * x->data[j];
+    y1 += M->data[1][j] * x->data[j];
+    y2 += M->data[2][j] * x->data[j];
+  }
+  y->data[0] = y0;
+  y->data[1] = y1;
+  y->data[2] = y2;
+  y->data[3] = 0.0;
+}
+
+/**
+ * @brief gds_mat3_mul_vec_transpose
+ * @param M
+ * @param x
+ * @param y y = M^T x, may alias x
+ */
+static inline void gds_mat3_mul_vec_transpose(const gds_mat3 *M, const gds_vec3 *x, gds_vec3 *y) {
+  double tmp[4] = {0.0, 0.0, 0.0, 0.0};
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      tmp[j] += M->data[i][j] * x->data[i];
+    }
+  }
+  for (int j = 0; j < 4; j++) {
+    y->data[j] = tmp[j];
+  }
+}
+
+/**
+ * @brief gds_mat3_mul
+ * @param A
+ * @param B
+ * @param C C = A B, may alias A or B
+ */
+static inline void gds_mat3_mul(const gds_mat3 *A, const gds_mat3 *B, gds_mat3 *C) {
+  double tmp[3][4] = {{0.0}};
+  for (int i = 0; i < 3; i++) {
+    for (int k = 0; k < 3; k++) {
+      for (int j = 0; j < 4; j++) {
+        tmp[i][j] += A->data[i][k] * B->data[k][j];
+      }
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      C->data[i][j] = tmp[i][j];
+    }
+  }
+}
+
+/**
+ * @brief gds_mat3_rotation rotation matrix by the Rodrigues formula
+ * @param R rotates by angle_radians around axis
+ * @param axis unit axis
+ * @param angle_radians
+ */
+static inline void gds_mat3_rotation(gds_mat3 *R, const gds_vec3 *axis, double angle_radians) {
+  double c = cos(angle_radians);
+  double s = sin(angle_radians);
+  double t = 1.0 - c;
+  double x = axis->data[0], y = axis->data[1], z = axis->data[2];
+  R->data[0][0] = c + t * x * x;
+  R->data[0][1] = t * x * y - s * z;
+  R->data[0][2] = t * x * z + s * y;
+  R->data[1][0] = t * x * y + s * z;
+  R->data[1][1] = c + t * y * y;
+  R->data[1][2] = t * y * z - s * x;
+  R->data[2][0] = t * x * z - s * y;
+  R->data[2][1] = t * y * z + s * x;
+  R->data[2][2] = c + t * z * z;
+  R->data[0][3] = R->data[1][3] = R->data[2][3] = 0.0;
+}
+
+/**
+ * @brief gds_vec3_rotate_around_vector
+ * @param rotated rotated vector, may alias vec_to_rotate
+ * @param vec_to_rotate vector to be rotated
+ * @param axis unit axis to rotate around
+ * @param angle_radians angle to rotate
+ */
+static inline void gds_vec3_rotate_around_vector(gds_vec3 *rotated,
+                                                 const gds_vec3 *vec_to_rotate,
+                                                 const gds_vec3 *axis,
+                                                 double angle_radians) {
+  double c = cos(angle_radians);
+  double s = sin(angle_radians);
+  gds_vec3 cross;
+  gds_vec3_cross(axis, vec_to_rotate, &cross);
+  double dot = gds_vec3_dot(vec_to_rotate, axis) * (1.0 - c);
+  for (int i = 0; i < 4; i++) {
+    rotated->data[i] = c * vec_to_rotate->data[i] + s * cross.data[i] + dot * axis->data[i];
+  }
+}
+
+/**
+ * @brief gds_vec3_from_vector
+ * @param v v = first three values of src
+ * @param src gds_vector of size 3
+ */
+static inline void gds_vec3_from_vector(gds_vec3 *v, const gds_vector *src) {
+  *v = gds_vec3_make(src->data[0], src->data[1], src->data[2]);
+}
+
+/**
+ * @brief gds_vec3_to_vector
+ * @param dest gds_vector of size 3, dest = v
+ * @param v
+ */
+static inline void gds_vec3_to_vector(gds_vector *dest, const gds_vec3 *v) {
+  for (int i = 0; i < 3; i++) {
+    dest->data[i] = v->data[i];
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -156,6 +156,23 @@ double gds_vector_dot(const gds_vector *v, const gds_vector *u);
  */
 void gds_vector_free(gds_vector *v);
 
+/**
+ * @brief gds_vector_alloc_block allocate count vectors with size elements
+ *        each in a single zeroed block
+ * @param count
+ * @param size
+ * @param vectors out: vectors[i] points at the i-th vector in the block,
+ *        these must not be passed to gds_vector_free
+ * @return block to release with gds_vector_free_block, NULL on failure
+ */
+void *gds_vector_alloc_block(size_t count, size_t size, gds_vector **vectors);
+
+/**
+ * @brief gds_vector_free_block free a block from gds_vector_alloc_block
+ * @param block
+ */
+void gds_vector_free_block(void *block);
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,8 +4,11 @@
 #ifdef __cplusplus
 #include "Teuchos_RCP.hpp"
 #include <Tpetra_FECrsMatrix.hpp>
+#include <Tpetra_MultiVector.hpp>
+#include <vector>
 
 #include "linalg/sparse_matrix.h"
+#include "util/goma_memory.h"
 
 using LO = int;
 using GO = GomaGlobalOrdinal;
@@ -15,9 +18,22 @@ struct TpetraSparseMatrix {
   Teuchos::RCP<Tpetra::Map<LO, GO>> row_map;
   Teuchos::RCP<Tpetra::Map<LO, GO>> col_map;
   Teuchos::RCP<Tpetra::FECrsGraph<LO, GO>> crs_graph;
+  // Solve vectors on the domain and range maps, kept between solves
+  Teuchos::RCP<Tpetra::MultiVector<double, LO, GO>> x_vec;
+  Teuchos::RCP<Tpetra::MultiVector<double, LO, GO>> b_vec;
+  goma::tracked_vector<LO, GOMA_MEM_MATRIX> vec_index; // local vector entry of each Goma row
   TpetraSparseMatrix() = default;
 };
 
+/* Copies x_[k] and b_[k], k < num_vecs, into the x_vec and b_vec columns */
+void g_tpetra_load_solve_vectors(GomaSparseMatrix matrix,
+                                 double *const *x_,
+                                 double *const *b_,
+                                 size_t num_vecs);
+
+/* Copies the x_vec columns back into x_[k] */
+void g_tpetra_store_solution(GomaSparseMatrix matrix, double *const *x_, size_t num_vecs);
+
 extern "C" {
 #endif
 
@@ -15,6 +15,8 @@
 #ifndef GOMA_LOAD_FIELD_VARIABLES_H
 #define GOMA_LOAD_FIELD_VARIABLES_H
 
+extern unsigned long fv_load_id; /* changes whenever fv is reloaded */
+
 int load_fv /* mm_fill_terms.c                           */
     (void);
 
@@ -211,6 +211,7 @@ nonlinear_solver_conwrap(double *x, void *con, int step_num, double lambda, doub
 extern void assign_parameter_conwrap(double param);
 extern void assign_bif_parameter_conwrap(double bif_param);
 extern int linear_solver_conwrap(double *x, int jac_flag, double *tmp);
+extern int linear_solver_conwrap_multi(double **x, int nrhs, int jac_flag, double *tmp);
 extern int
 komplex_linear_solver_conwrap(double *x, double *y, int jac_flag, double *omega, double *tmp);
 extern void calc_scale_vec_conwrap(double *x, double *scale_vec, int numUnks);
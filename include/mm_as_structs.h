@@ -921,6 +921,7 @@ struct Uniform_Problem_Description {
   int strong_bc_replace;
   dbl strong_penalty;
   int AutoDiff;
+  int ContractionAssembly; /* Jacobian blocks as small GEMMs, see mm_fill_contract.h */
   int disable_pspg_tau_sensitivities;
   int pspg_lagged_tau;
   int disable_supg_tau_sensitivities;
@@ -1142,6 +1143,7 @@ struct Transient_Information {
                                                      theta = 1. => Forward Euler
                                                      theta = .5 => Crack-Nicholson  */
   dbl current_theta;
+  int bdf_max_order; /* variable order BDF up to this order, 0 = theta method */
   dbl eps;                              /* time step error  */
   int use_var_norm[MAX_VARIABLE_TYPES]; /* Booleans used for time step
                                            truncation error control */
@@ -1181,6 +1183,24 @@ struct Transient_Information {
   int ale_adapt;
   int ale_adapt_freq;
   double ale_adapt_iso_size;
+
+  /* Metric and trigger for Omega_h adaptation, see omega_h_interface.cpp */
+  int adapt_metric;   /* ADAPT_METRIC_* */
+  int adapt_num_vars; /* fields driving the ZZ and HESSIAN metrics */
+  char adapt_vars[MAX_ADAPT_VARS][MAX_VAR_NAME_LNGTH];
+  double adapt_error_tol;  /* target relative error of the ZZ and HESSIAN metrics */
+  double adapt_min_length; /* bounds on target edge lengths */
+  double adapt_max_length;
+  double adapt_min_elems; /* bounds on the target element count, 0 = none */
+  double adapt_max_elems;
+  double adapt_error_threshold; /* adapt only above this estimated error, 0 = always */
+
+  /* Binary checkpoints of the transient state, see rf_checkpoint.c */
+  int checkpoint_freq;      /* time steps between checkpoints, 0 = none */
+  int checkpoint_aggregate; /* one file for all processors instead of one each */
+  int checkpoint_restart;   /* start from checkpoint_file */
+  char checkpoint_file[MAX_FNL];
+
   double relaxation[MAX_NUM_MATRICES];
   double relaxation_tolerance[MAX_NUM_MATRICES];
 };
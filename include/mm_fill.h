@@ -121,6 +121,13 @@ EXTERN int matrix_fill_stress(struct GomaLinearSolverData *,
                                          * frontal solver                            */
                               int);     /* zeroCA */
 
+EXTERN void load_lec(Exo_DB *, /* Exodus database pointer */
+                     int,      /* element number we are working on */
+                     struct GomaLinearSolverData *,
+                     double[],  /* Solution vector */
+                     double[],  /* Residual vector */
+                     double *); /* element stiffness Matrix for frontal solver*/
+
 EXTERN int checkfinite(const char *file,
                        const int line,       /* line                                      */
                        const char *message); /* message                                   */
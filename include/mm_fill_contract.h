@@ -0,0 +1,79 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Jacobian blocks assembled as small dense contractions.
+ *
+ * At a quadrature point most volume Jacobian blocks have the form
+ *
+ *      J[i][j] += sum_k W[i][k] T[k][j]
+ *
+ * where the rows of W are the test function and its gradient (the same
+ * for every column variable) and the columns of T hold the coefficient
+ * tensors (property derivatives, stress sensitivities, ...) already
+ * multiplied into the trial function.  Filling T once per column and
+ * forming the block with one small GEMM replaces the scalar (i,j) double
+ * loop that rebuilds the same products for every test function.
+ */
+
+#ifndef GOMA_MM_FILL_CONTRACT_H
+#define GOMA_MM_FILL_CONTRACT_H
+
+#include "el_elm.h"
+#include "rf_fem_const.h"
+#include "std.h"
+
+#ifdef EXTERN
+#undef EXTERN
+#endif
+
+#ifdef GOMA_MM_FILL_CONTRACT_C
+#define EXTERN /* do nothing */
+#endif
+
+#ifndef GOMA_MM_FILL_CONTRACT_C
+#define EXTERN extern
+#endif
+
+/* Longest contraction: the weight plus the VIM x VIM tensor gradient */
+#define CONTRACT_MAX_K (1 + DIM * DIM)
+
+struct Contract_Block {
+  int k;                       /* contraction length */
+  dbl W[MDE][CONTRACT_MAX_K];  /* test side, one row per row dof */
+  dbl T[CONTRACT_MAX_K][MDE];  /* trial side, one column per column dof */
+};
+
+EXTERN int contraction_assembly(void);
+
+EXTERN void contract_scalar_test_functions(struct Contract_Block *, /* block to set up */
+                                           const int,               /* eqn */
+                                           const dbl);              /* scale of phi_i */
+
+EXTERN void contract_vector_test_functions(struct Contract_Block *, /* block to set up */
+                                           const int,               /* eqn */
+                                           const int,               /* component a */
+                                           const dbl);              /* scale of phi_i */
+
+EXTERN void contract_zero_trial(struct Contract_Block *, /* block */
+                                const int);              /* number of column dofs */
+
+EXTERN void contract_jacobian_block(const struct Contract_Block *, /* filled block */
+                                    const int,                     /* eqn */
+                                    const int,                     /* peqn */
+                                    const int,                     /* pvar */
+                                    const int,                     /* number of column dofs */
+                                    const int);                    /* use row map */
+
+#endif /* GOMA_MM_FILL_CONTRACT_H */
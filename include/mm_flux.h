@@ -32,6 +32,42 @@
 #define EXTERN extern
 #endif
 
+/*
+ * One side set flux/force request for evaluate_flux_batch(). The integrated
+ * results (summed over all processors) are returned in the last four members.
+ */
+struct Flux_Request {
+  int ss_id;             /* on which SSID to evaluate flux */
+  int quantity;          /* to pick HEAT_FLUX, FORCE_NORMAL, etc. */
+  const char *qtity_str; /* quantity string */
+  int blk_id;            /* material identification */
+  int species_id;        /* species identification */
+  const char *filenm;    /* File name pointer */
+  int profile_flag;      /*  flag for printing flux profiles  */
+  double *J_AC;          /* augmenting condition sensitivities, may be NULL */
+  double flux;           /* integrated flux */
+  double flux_conv;      /* integrated convective flux */
+  double area;           /* side set area */
+  double Torque[DIM];    /* torque, or force centers for REPULSIVE_FORCE */
+};
+
+EXTERN int evaluate_flux_batch(const Exo_DB *exo,       /* ptr to basic exodus ii mesh info */
+                               const Dpi *dpi,          /* distributed processing info */
+                               const int nreq,          /* number of requests */
+                               struct Flux_Request *rq, /* requests and their results */
+                               dbl *x,                  /* solution vector */
+                               dbl *xdot,               /* dx/dt vector */
+                               const double delta_t,    /* time-step size */
+                               const dbl time_value,    /* current time */
+                               const int print_flag);   /*  flag for printing results,1=print*/
+
+EXTERN void evaluate_pp_fluxes(const Exo_DB *exo,
+                               const Dpi *dpi,
+                               dbl *x,
+                               dbl *xdot,
+                               const double delta_t,
+                               const dbl time_value);
+
 EXTERN double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh information */
                             const Dpi *dpi,         /* distributed processing info */
                             const int side_set_id,  /* on which SSID to evaluate flux */
@@ -0,0 +1,72 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Quadrature point property store.
+ *
+ *    The momentum, continuity, energy, species, stress and post processing
+ *  routines each ask for the same material properties at a quadrature
+ *  point.  The property routines keep the value and dependence structure
+ *  of their last evaluation here and return it again while nothing it
+ *  depends on has changed.  An entry belongs to one quadrature point of
+ *  one element, and all properties share one rule for when it goes
+ *  stale: a reload of the field variables (fv_load_id, i.e. the next
+ *  load_fv(), load_fv_grads() or load_fv_mesh_derivs()), a change of the
+ *  level set side or interface functions, or a change of the temperature
+ *  or the time.  Since every equation is assembled inside the same
+ *  quadrature loop, one entry per property covers the whole element.
+ */
+
+#ifndef GOMA_MM_QP_PROPS_H
+#define GOMA_MM_QP_PROPS_H
+
+#include <stddef.h>
+
+enum qp_prop_id {
+  QP_PROP_DENSITY = 0,
+  QP_PROP_HEAT_CAPACITY,
+  QP_PROP_CONDUCTIVITY,
+  QP_PROP_VISCOSITY,
+  QP_PROP_COUNT
+};
+
+/*
+ * Returns TRUE and fills in value (and d, a dependence structure of
+ * d_size bytes, if not NULL) when prop was last evaluated at the current
+ * quadrature point with the same material, matrix, level set state,
+ * temperature and time.  key holds key_size bytes of model inputs the
+ * property depends on beyond those, e.g. the strain rate for the
+ * viscosity, and may be NULL.
+ */
+extern int qp_prop_lookup(const enum qp_prop_id prop,
+                          const double time,
+                          const void *key,
+                          const size_t key_size,
+                          void *d,
+                          const size_t d_size,
+                          double *value);
+
+extern void qp_prop_store(const enum qp_prop_id prop,
+                          const double time,
+                          const void *key,
+                          const size_t key_size,
+                          const void *d,
+                          const size_t d_size,
+                          const double value);
+
+extern void qp_prop_invalidate(void);
+
+extern void qp_prop_free(void);
+
+#endif /* GOMA_MM_QP_PROPS_H */
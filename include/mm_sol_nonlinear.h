@@ -152,6 +152,24 @@ EXTERN double Loo_norm_r_1p /* mm_sol_nonlinear.c */
      int *,                 /* num_unk - save the index! */
      char *);               /* dofname_r - dof name for num_unk  */
 
+/*
+ * Jacobian reuse bookkeeping for one matrix: Jacobians assembled and
+ * factored versus Newton iterations that got by with the previous ones.
+ */
+struct Jacobian_Reuse_Stats {
+  int assemblies;
+  int assemblies_saved;
+  int factorizations;
+  int factorizations_saved;
+};
+
+EXTERN void jacobian_reuse_invalidate(void); /* mm_sol_nonlinear.c */
+
+EXTERN void jacobian_reuse_get_stats(const int,                     /* imtrx */
+                                     struct Jacobian_Reuse_Stats *); /* stats */
+
+EXTERN void jacobian_reuse_print_stats(void); /* mm_sol_nonlinear.c */
+
 EXTERN void print_array /* mm_sol_nonlinear.c */
     (const void *,      /* array - generic pointer */
      const int,         /* length - of the array */
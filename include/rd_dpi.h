@@ -35,6 +35,9 @@
 EXTERN int rd_dpi                                        /* rd_dpi.c */
     (Exo_DB *exo, Dpi *d, char *fn, bool parallel_call); /* verbosity - how much to talk */
 
+EXTERN void setup_dpi                                    /* rd_dpi.c */
+    (Exo_DB *exo, Dpi *d, bool parallel_call);
+
 int zero_dpi(Dpi *d);
 int one_dpi(Dpi *d);
 
@@ -55,6 +55,10 @@ EXTERN int read_mesh_exoII /* rd_mesh.c */
     (Exo_DB *,             /* ptr to EXOII mesh datastructure */
      Dpi *);               /* ptr to distributed processing info d.s. */
 
+EXTERN int setup_mesh_exoII /* rd_mesh.c */
+    (Exo_DB *,              /* ptr to EXOII mesh datastructure (0-based) */
+     Dpi *);                /* ptr to distributed processing info d.s. */
+
 EXTERN void setup_old_exo /* rd_mesh.c */
     (Exo_DB *,            /* ptr to EXODUS II mesh database */
      Dpi *,
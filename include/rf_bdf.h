@@ -0,0 +1,100 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Variable order, variable step BDF time integration.
+ */
+
+#ifndef GOMA_RF_BDF_H
+#define GOMA_RF_BDF_H
+
+#include "std.h"
+#include "util/checkpoint_io.h"
+
+#define BDF_MAX_ORDER 5
+
+/*
+ * Solution history of the BDF integrator.  x[0] is the last converged
+ * solution at t[0], x[1] the one before it and so on; num_hist of the
+ * max_order + 1 slots are in use.  The step being taken uses
+ *
+ *   xdot = alpha[0] x + sum_{j >= 1} alpha[j] x[j - 1]
+ *
+ * which the assembly sees as a theta method whose mass coefficient
+ * (1 + 2 theta) / delta_t equals alpha[0].
+ */
+struct BDF_History {
+  int max_order;      /* highest order allowed, 1 to BDF_MAX_ORDER */
+  int order;          /* order of the step being taken */
+  int next_order;     /* order selected for the following step */
+  int steps_at_order; /* accepted steps taken in a row at order */
+  int num_hist;       /* stored past solutions */
+  int num_unknowns;
+  int nAC;
+  double t[BDF_MAX_ORDER + 1];
+  double *x[BDF_MAX_ORDER + 1];
+  double *x_AC[BDF_MAX_ORDER + 1];
+  double alpha[BDF_MAX_ORDER + 1];
+  double *work; /* lower and higher order predictions */
+  double *work_AC;
+};
+
+extern void bdf_init(struct BDF_History *h,
+                     const int max_order,
+                     const int num_unknowns,
+                     const int nAC);
+
+extern void bdf_free(struct BDF_History *h);
+
+extern void bdf_reset(struct BDF_History *h,
+                      const int num_unknowns,
+                      const double x[],
+                      const double x_AC[],
+                      const double time);
+
+extern void bdf_push(struct BDF_History *h,
+                     const double x[],
+                     const double x_AC[],
+                     const double time);
+
+extern double bdf_begin_step(struct BDF_History *h, const double time1);
+
+extern void bdf_predict(const struct BDF_History *h,
+                        const double time1,
+                        double x[],
+                        double xdot[],
+                        double x_AC[],
+                        double x_AC_dot[]);
+
+extern double bdf_step_control(struct BDF_History *h,
+                               const double time1,
+                               const int const_delta_t,
+                               const double x[],
+                               const double x_AC[],
+                               const double eps,
+                               int *success_dt,
+                               const int use_var_norm[]);
+
+extern double time_derivative_history(const double q,
+                                      const double q_old,
+                                      const double q_dot,
+                                      const double q_dot_old,
+                                      const double tt,
+                                      const double dt);
+
+extern int write_bdf_checkpoint(goma_ckpt_buffer *b, const struct BDF_History *h);
+
+extern int read_bdf_checkpoint(goma_ckpt_buffer *b, struct BDF_History *h);
+
+#endif /* GOMA_RF_BDF_H */
@@ -0,0 +1,58 @@
+#ifndef GOMA_RF_BENCHMARK_H
+#define GOMA_RF_BENCHMARK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "dp_types.h"
+#include "dpi.h"
+#include "exo_struct.h"
+#include "rf_io_const.h"
+
+struct GomaLinearSolverData;
+
+/*
+ * Kernel benchmarks, compiled in with -DENABLE_BENCHMARKS=ON (GOMA_BENCHMARKS).
+ *
+ * goma -bench reads an input deck and mesh as usual.  When the steady
+ * solver has been set up, instead of solving it times the hot kernels on
+ * that problem and writes the results as JSON.  The goma_benchmarks target
+ * runs it on the deck in tests/benchmarks.  The command line options are
+ *
+ *   -bench               run the benchmarks (implied by any option below)
+ *   -bench_out <file>    JSON output (default goma_benchmarks.json)
+ *   -bench_reps <n>      timed repetitions per kernel (default 10)
+ *   -bench_filter <str>  only run kernels whose name contains str
+ */
+
+typedef struct {
+  int enabled;
+  int repetitions;
+  char output_file[MAX_FNL];
+  char filter[MAX_FNL];
+} Benchmark_Options;
+
+extern Benchmark_Options Goma_Benchmark_Options;
+
+/* enable benchmarks if asked for and strip the -bench options from argv */
+int benchmark_parse_args(int *argc, char **argv);
+
+int run_kernel_benchmarks(struct GomaLinearSolverData *ams,
+                          double x[],
+                          double x_old[],
+                          double x_older[],
+                          double xdot[],
+                          double xdot_old[],
+                          double resid_vector[],
+                          double x_update[],
+                          double time_value,
+                          Exo_DB *exo,
+                          Dpi *dpi,
+                          Comm_Ex *cx);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // GOMA_RF_BENCHMARK_H
@@ -0,0 +1,75 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Binary checkpoint/restart of the full transient state.
+ */
+
+#ifndef GOMA_RF_CHECKPOINT_H
+#define GOMA_RF_CHECKPOINT_H
+
+#include "rf_bdf.h"
+#include "std.h"
+
+/*
+ * Time integrator state handed to write_checkpoint()/read_checkpoint().
+ * The vectors are the caller's; read_checkpoint() fills them in place.
+ * Level set renormalization countdowns, solid inertia history, element
+ * storage (saturation hysteresis) and particles are taken from and
+ * restored to their globals directly.  The BDF history, when there is
+ * one, is restored into the caller's bdf_init()'ed struct.
+ */
+struct Checkpoint_State {
+  double time;      /* time of the last converged step */
+  double delta_t;   /* next time step to try */
+  double delta_t_old;
+  double delta_t_older;
+  double delta_t_oldest;
+  double time_print; /* next printing time */
+  int n;             /* time step loop index to resume at */
+  int nt;            /* number of successful time steps */
+  int step_print;
+  int last_renorm_nt;
+  int failed_recently_countdown;
+
+  int num_unknowns;
+  double *x;
+  double *x_old;
+  double *x_older;
+  double *x_oldest;
+  double *xdot;
+  double *xdot_old;
+  double *xdot_older;
+
+  int nAC;
+  double *x_AC;
+  double *x_AC_old;
+  double *x_AC_older;
+  double *x_AC_oldest;
+  double *x_AC_dot;
+  double *x_AC_dot_old;
+  double *x_AC_dot_older;
+
+  struct BDF_History *bdf; /* NULL unless Time Integration Method = BDF */
+};
+
+extern int write_checkpoint(const char *filename,
+                            const struct Checkpoint_State *state,
+                            const int aggregate);
+
+extern int read_checkpoint(const char *filename,
+                           struct Checkpoint_State *state,
+                           const int aggregate);
+
+#endif /* GOMA_RF_CHECKPOINT_H */
@@ -24,6 +24,7 @@ extern void set_init_Element_Storage(ELEM_BLK_STRUCT *, int);
 extern void free_element_blocks(Exo_DB *exo);
 extern void free_element_storage(Exo_DB *exo);
 extern void free_elemStorage(ELEM_BLK_STRUCT *);
+extern int element_storage_span(ELEM_BLK_STRUCT *, double **);
 extern double get_nodalSat_tnm1_FromES(int);
 extern double get_Sat_tnm1_FromES(int);
 extern void put_nodalSat_tn_IntoES(int, double);
@@ -956,6 +956,16 @@
 #define STEADY    0 /* Steady state solution method               */
 #define TRANSIENT 1 /* Accurate transient solution method         */
 
+/* Target metric for Omega_h mesh adaptation (tran->adapt_metric) */
+
+#define ADAPT_METRIC_DEFAULT   0 /* LEVEL_SET with level set adaptivity, else ISO */
+#define ADAPT_METRIC_ISO       1 /* uniform ALE Adapt ISO Size                    */
+#define ADAPT_METRIC_LEVEL_SET 2 /* inner/outer size by level set proximity       */
+#define ADAPT_METRIC_ZZ        3 /* Zienkiewicz-Zhu gradient recovery error       */
+#define ADAPT_METRIC_HESSIAN   4 /* recovered Hessian interpolation error         */
+
+#define MAX_ADAPT_VARS 8 /* fields driving the ZZ and HESSIAN metrics */
+
 /* Selection of Continuation Method Order */
 
 #define ALC_NONE   -1 /* No continuation */
@@ -50,6 +50,7 @@ extern int Decompose_Flag;
 
 extern int Decompose_Type;
 extern int Skip_Fix;
+extern int Mesh_Reorder_Type;
 
 extern char *GomaPetscOptions;
 extern int GomaPetscOptionsStrLen;
@@ -90,6 +90,13 @@ extern String_line AztecOO_Solver;
 extern String_line Stratimikos_File[MAX_NUM_MATRICES];
 extern String_line Amesos2_File[MAX_NUM_MATRICES];
 
+extern int Teko_Block_Preconditioner;              /* enum Teko_Block_Preconditioner_Type */
+extern String_line Teko_Block_Preconditioner_Name; /* inverse name for TEKO_BLOCK_USER */
+extern String_line Teko_Block_Inverse;             /* inverse for the diagonal blocks */
+
+extern int Stratimikos_Prec_Reuse;            /* PREC_REUSE_REBUILD, _REFRESH or _KEEP */
+extern int Stratimikos_Prec_Reuse_Max_Solves; /* solves per preconditioner with _KEEP */
+
 /*
 extern  * A new Aztec 2.0 option. There are more and difft options and our
 extern  * previous options probably ought to be revised to reflect the newer
@@ -134,6 +141,11 @@ extern double convergence_rate_tolerance; /* tolerance for jacobian reformation
                                        based on convergence rate */
 extern double modified_newt_norm_tol;     /* tolerance for jacobian reformation
                                            based on residual norm */
+extern int Jacobian_Reuse;                /* carry the Jacobian across Newton
+                                             iterations and time steps */
+extern int Jacobian_Reuse_Max_Age;        /* Newton solves per Jacobian */
+extern double Jacobian_Reuse_Rate_Tol;    /* residual reduction that forces a refresh */
+extern double Jacobian_Reuse_Mass_Tol;    /* change in (1 + 2 theta) / dt that forces a refresh */
 
 extern double Epsilon[MAX_NUM_MATRICES][3]; /* Used for determining stopping criteria.     */
 extern int Solver_Output_Format;            /* Bitmap for Solver output columns    */
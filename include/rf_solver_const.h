@@ -65,6 +65,13 @@
 #define PETSC_COMPLEX_SOLVER 12
 #define AMESOS2              13
 #define MUMPS                14
+
+/*
+ * Stratimikos Preconditioner Reuse card values
+ */
+#define PREC_REUSE_REBUILD 0 /* new solver and preconditioner every solve */
+#define PREC_REUSE_REFRESH 1 /* keep the preconditioner structure, recompute values */
+#define PREC_REUSE_KEEP    2 /* keep the preconditioner for several solves */
 /*
  * FORTRAN BLAS functions. Inside C, use "DCOPY" and the preprocessor to
  * make it look like the FORTRAN name for this routine.
@@ -86,6 +86,10 @@ int rd_exoII_ev(double *u,
                 int spec,
                 const Exo_DB *exo);
 
+extern int time_step_norm_var /* rf_util.c                                */
+    (const int,               /* var                                      */
+     const int[]);            /* use_var_norm                             */
+
 extern double time_step_control /* rf_util.c                                 */
     (const double,              /* delta_t_old                               */
      const double,              /* delta_t_older                             */
@@ -219,6 +223,9 @@ extern int rd_trans_vectors_from_exoII /* rf_util.c                          */
      Comm_Ex *, /* cx - communications structure */
      Dpi *);    /* dpi - distributed processing struct */
 
+/* close the files rd_trans_vectors_from_exoII keeps open through the time loop */
+extern void close_trans_vectors_from_exoII(void); /* rf_util.c */
+
 extern void init_vec_value(double *, const double, const int);
 extern void dcopy1(const int, const double *, double *);
 
@@ -23,6 +23,22 @@ int stratimikos_solve(struct GomaLinearSolverData *ams,
                       char stratimikos_file[MAX_NUM_MATRICES][MAX_CHAR_IN_INPUT],
                       int imtrx);
 
+int stratimikos_solve_tpetra_multi(struct GomaLinearSolverData *ams,
+                                   double **x_,
+                                   double **b_,
+                                   int nrhs,
+                                   int *iterations,
+                                   char stratimikos_file[MAX_NUM_MATRICES][MAX_CHAR_IN_INPUT],
+                                   int imtrx);
+
+int stratimikos_solve_multi(struct GomaLinearSolverData *ams,
+                            double **x_,
+                            double **b_,
+                            int nrhs,
+                            int *iterations,
+                            char stratimikos_file[MAX_NUM_MATRICES][MAX_CHAR_IN_INPUT],
+                            int imtrx);
+
 #ifdef __cplusplus
 } // end of extern "C"
 #endif
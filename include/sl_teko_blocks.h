@@ -0,0 +1,89 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Field block structure and auxiliary pressure operators handed to
+ * Teko block preconditioners on the Stratimikos path.
+ */
+
+#ifndef GOMA_SL_TEKO_BLOCKS_H
+#define GOMA_SL_TEKO_BLOCKS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "dpi.h"
+#include "exo_struct.h"
+#include "mm_eh.h"
+#include "std.h"
+
+/* Teko Block Preconditioner card values */
+enum Teko_Block_Preconditioner_Type {
+  TEKO_BLOCK_NONE = 0,
+  TEKO_BLOCK_JACOBI,
+  TEKO_BLOCK_TRIANGULAR,
+  TEKO_BLOCK_LSC,
+  TEKO_BLOCK_PCD,
+  TEKO_BLOCK_USER /* named inverse from the "Teko Inverse Library" sublist */
+};
+
+enum Goma_Field_Block {
+  GOMA_FIELD_BLOCK_VELOCITY = 0,
+  GOMA_FIELD_BLOCK_PRESSURE,
+  GOMA_FIELD_BLOCK_MESH,
+  GOMA_FIELD_BLOCK_SPECIES,
+  GOMA_FIELD_BLOCK_STRESS,
+  GOMA_FIELD_BLOCK_OTHER,
+  GOMA_NUM_FIELD_BLOCKS
+};
+
+/*
+ * Pressure mass, pressure Laplacian and pressure convection-diffusion
+ * (PCD) operators in coordinate form.  row/col are processor dof
+ * numbers (as used for the solution vector); rows are owned dofs only.
+ */
+struct Pressure_Aux_Operators {
+  int nnz;
+  int capacity;
+  int *row;
+  int *col;
+  double *Mp;
+  double *Ap;
+  double *Fp;
+};
+
+extern int goma_field_block_of_var(const int var);
+
+extern int goma_field_blocks(const int imtrx,
+                             const int n_rows,
+                             const int saddle_point,
+                             int *row_block,
+                             int block_type[GOMA_NUM_FIELD_BLOCKS]);
+
+extern goma_error assemble_pressure_aux_operators(struct Pressure_Aux_Operators *ops,
+                                                  Exo_DB *exo,
+                                                  Dpi *dpi,
+                                                  dbl *x,
+                                                  dbl *x_old,
+                                                  dbl *xdot,
+                                                  dbl *xdot_old);
+
+extern void free_pressure_aux_operators(struct Pressure_Aux_Operators *ops);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GOMA_SL_TEKO_BLOCKS_H */
@@ -0,0 +1,33 @@
+#ifndef UTIL_BDF_COEFFICIENTS_H
+#define UTIL_BDF_COEFFICIENTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Coefficients of the variable step BDF formulas.  t[0] is the time of the
+ * last converged solution, t[1] the one before it and so on, all distinct
+ * from each other and from time1.
+ */
+
+/*
+ * Derivative at time1 of the polynomial through (time1, x) and the last
+ * order solutions (t[j], x_j):
+ *
+ *   xdot = alpha[0] x + sum_{j = 1..order} alpha[j] x_{j - 1}
+ */
+void goma_bdf_derivative_coefficients(int order, double time1, const double *t, double *alpha);
+
+/*
+ * Value at time1 of the polynomial through the last q + 1 solutions:
+ *
+ *   x(time1) = sum_{j = 0..q} w[j] x_j
+ */
+void goma_bdf_extrapolation_weights(int q, double time1, const double *t, double *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_BDF_COEFFICIENTS_H
@@ -0,0 +1,66 @@
+#ifndef UTIL_CHECKPOINT_IO_H
+#define UTIL_CHECKPOINT_IO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Binary checkpoint payloads.
+ *
+ * State is serialized into a growable in-memory buffer and written in one
+ * piece.  Arrays are stored with their length so a reader can check the
+ * layout matches before copying:
+ *
+ *   file:   "GOMACKPT", int version, int byte order check (0x01020304),
+ *           uint64 payload size, uint64 payload checksum (FNV-1a), payload
+ *   array:  int n, n values
+ *
+ * Files are written to "<name>.tmp", synced and renamed over <name>, so
+ * an interrupted write never replaces a good checkpoint.  Everything is
+ * in native byte order; the reader refuses files written with another.
+ */
+
+#define GOMA_CKPT_VERSION 2
+
+typedef struct {
+  char *data;
+  size_t size;
+  size_t capacity;
+  size_t pos; /* read position */
+} goma_ckpt_buffer;
+
+void goma_ckpt_buffer_init(goma_ckpt_buffer *b);
+
+void goma_ckpt_buffer_free(goma_ckpt_buffer *b);
+
+int goma_ckpt_put(goma_ckpt_buffer *b, const void *p, size_t n);
+
+int goma_ckpt_get(goma_ckpt_buffer *b, void *p, size_t n);
+
+int goma_ckpt_put_int(goma_ckpt_buffer *b, int v);
+
+int goma_ckpt_get_int(goma_ckpt_buffer *b, int *v);
+
+int goma_ckpt_put_double(goma_ckpt_buffer *b, double v);
+
+int goma_ckpt_get_double(goma_ckpt_buffer *b, double *v);
+
+int goma_ckpt_put_doubles(goma_ckpt_buffer *b, const double *v, int n);
+
+int goma_ckpt_get_doubles(goma_ckpt_buffer *b, double *v, int n);
+
+uint64_t goma_ckpt_checksum(const char *data, size_t n);
+
+int goma_ckpt_write_file(const char *filename, const goma_ckpt_buffer *b);
+
+int goma_ckpt_read_file(const char *filename, goma_ckpt_buffer *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_CHECKPOINT_IO_H
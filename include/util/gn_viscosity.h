@@ -0,0 +1,48 @@
+#ifndef UTIL_GN_VISCOSITY_H
+#define UTIL_GN_VISCOSITY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Generalized Newtonian viscosity models.
+ *
+ * Each routine evaluates one model and its derivatives at a point from the
+ * shear rate (and temperature), with no dependence on the goma field
+ * variable structures.  Each model costs two pow calls; the derivative
+ * powers are recovered from the value instead of being recomputed.
+ */
+
+/*
+ * Carreau-Yasuda with a temperature shift factor at:
+ *
+ *   mu = at (muinf + (mu0 - muinf) (1 + (at lambda gd)^a)^((n - 1) / a))
+ *
+ * Use at = 1 for no shift.  Outputs dmu_dgd and dmu_dat may be NULL.
+ */
+double goma_carreau(double gd,
+                    double at,
+                    double mu0,
+                    double muinf,
+                    double nexp,
+                    double aexp,
+                    double lambda,
+                    double *dmu_dgd,
+                    double *dmu_dat);
+
+/* Power law mu = mu0 (gd + offset)^(n - 1); dmu_dgd may be NULL */
+double goma_power_law(double gd, double mu0, double nexp, double offset, double *dmu_dgd);
+
+/*
+ * WLF shift factor at = exp(c1 (Tref - T) / (c2 + T - Tref)) and d(at)/dT.
+ * A zero denominator gives at = 1, an overflow gives DBL_MAX.  dat_dT may
+ * be NULL.
+ */
+double goma_wlf_shift(double T, double tref, double c1, double c2, double *dat_dT);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_GN_VISCOSITY_H
@@ -0,0 +1,79 @@
+#ifndef UTIL_GOMA_BENCHMARK_H
+#define UTIL_GOMA_BENCHMARK_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Timing harness for the kernel benchmarks.
+ *
+ * A benchmark is timed over a number of repetitions, each repetition one
+ * sweep over a fixed set of inputs (all elements of a mesh, a table of
+ * query points, ...).  The samples are reduced to min / median / mean /
+ * standard deviation per repetition and, using the work counts recorded
+ * with the result, to ns per element, per quadrature point and per call.
+ * A suite of results is written as JSON so runs can be compared in CI.
+ */
+
+#define GOMA_BENCHMARK_NAME_LEN    64
+#define GOMA_BENCHMARK_NOTE_LEN    128
+#define GOMA_BENCHMARK_MAX_CONTEXT 8
+
+typedef struct {
+  char name[GOMA_BENCHMARK_NAME_LEN];
+  char note[GOMA_BENCHMARK_NOTE_LEN]; /* reason when skipped */
+  int skipped;
+  int repetitions;
+  double min_ns; /* per repetition */
+  double median_ns;
+  double mean_ns;
+  double stddev_ns;
+  /* work per repetition, 0 when not meaningful */
+  double elements;
+  double quadrature_points;
+  double calls;
+} goma_benchmark_result;
+
+typedef struct {
+  char context_key[GOMA_BENCHMARK_MAX_CONTEXT][GOMA_BENCHMARK_NAME_LEN];
+  char context_value[GOMA_BENCHMARK_MAX_CONTEXT][GOMA_BENCHMARK_NOTE_LEN];
+  int num_context;
+  goma_benchmark_result *results;
+  int num_results;
+  int capacity;
+} goma_benchmark_suite;
+
+/* monotonic wall clock in ns */
+double goma_benchmark_now_ns(void);
+
+/* reduce n samples (ns per repetition) into result, samples are reordered */
+int goma_benchmark_stats(double *samples, int n, goma_benchmark_result *result);
+
+void goma_benchmark_suite_init(goma_benchmark_suite *suite);
+
+void goma_benchmark_suite_free(goma_benchmark_suite *suite);
+
+/* run metadata written at the top of the JSON, e.g. input file, processors */
+int goma_benchmark_suite_set_context(goma_benchmark_suite *suite,
+                                     const char *key,
+                                     const char *value);
+
+int goma_benchmark_suite_add(goma_benchmark_suite *suite, const goma_benchmark_result *result);
+
+/* record a benchmark that could not run for this problem */
+int goma_benchmark_suite_skip(goma_benchmark_suite *suite, const char *name, const char *reason);
+
+int goma_benchmark_suite_write_json(const goma_benchmark_suite *suite, FILE *file);
+
+/* human readable table */
+void goma_benchmark_suite_print(const goma_benchmark_suite *suite, FILE *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_GOMA_BENCHMARK_H
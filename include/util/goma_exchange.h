@@ -0,0 +1,70 @@
+#ifndef UTIL_GOMA_EXCHANGE_H
+#define UTIL_GOMA_EXCHANGE_H
+
+#include <mpi.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Point to point exchanges of byte buffers that do not need any collective
+ * that grows with the number of processors.
+ *
+ * goma_exchange_sparse() is the NBX algorithm (Hoefler, Siebert and
+ * Lumsdaine, "Scalable communication protocols for dynamic sparse data
+ * exchange"): each rank knows only whom it sends to, messages go out as
+ * synchronous sends, received messages are found with MPI_Iprobe and a
+ * nonblocking barrier entered once all our sends have been matched ends the
+ * exchange.  Cost is proportional to the number of messages plus a
+ * log(P) barrier, where an MPI_Alltoall of counts or an MPI_Allgather of
+ * neighbor lists is O(P) per rank.
+ *
+ * goma_exchange_neighbors() is for when both sides already know the
+ * pattern: one message each way per neighbor, sized on arrival with
+ * MPI_Probe, so no separate round of counts is needed.
+ *
+ * A message is sent to every listed rank, also when it is empty, and the
+ * destination lists must not repeat a rank.  The tag must not be in use by
+ * any other outstanding communication on comm.  Both return 0, or -1 when
+ * out of memory.  Either way every send has completed and every message
+ * addressed to this rank has been received (and dropped on error) before
+ * they return, so the other ranks are not left waiting; the caller is
+ * expected to stop on error.  When not even the bookkeeping can be
+ * allocated they call MPI_Abort().
+ */
+
+/* message i is data[offset[i]] .. data[offset[i + 1] - 1] */
+typedef struct {
+  int num_procs;  /* messages received */
+  int *proc;      /* rank each message came from */
+  size_t *offset; /* num_procs + 1 offsets into data */
+  char *data;
+} goma_exchange_recv;
+
+/* messages are returned ordered by ascending source rank */
+int goma_exchange_sparse(MPI_Comm comm,
+                         int tag,
+                         int num_dest,
+                         const int *dest,
+                         const void *const *send,
+                         const int *send_bytes,
+                         goma_exchange_recv *recv);
+
+/* message i is the one received from neighbor[i] */
+int goma_exchange_neighbors(MPI_Comm comm,
+                            int tag,
+                            int num_neighbors,
+                            const int *neighbor,
+                            const void *const *send,
+                            const int *send_bytes,
+                            goma_exchange_recv *recv);
+
+void goma_exchange_recv_free(goma_exchange_recv *recv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_GOMA_EXCHANGE_H
@@ -0,0 +1,165 @@
+#ifndef UTIL_GOMA_MEMORY_H
+#define UTIL_GOMA_MEMORY_H
+
+#include <mpi.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Memory accounting by subsystem.
+ *
+ * Every block handed out by smalloc() (and so by the alloc_*() and
+ * array_alloc() wrappers of rf_allo.c) is charged to the tag on top of a
+ * small tag stack, GOMA_MEM_OTHER when it is empty, and the charge is
+ * returned when the block goes back through safe_free() or safer_free().
+ * The mesh, ghost, matrix, assembly and post processing code releases its
+ * rf_allo blocks that way; a block released with a bare free() is not
+ * seen and stays charged until its address is handed out again.  Code
+ * that does not allocate through rf_allo (the C++ containers, the
+ * particle pool) charges its tag directly with goma_mem_track_bytes() or
+ * tracked_allocator below.  The address table behind all this is not
+ * charged to any tag.
+ *
+ * Tracking is off unless goma_mem_enable() turns it on, which goma does
+ * for -mem_report; otherwise the track functions return straight away.
+ * Current and peak bytes are kept per tag on each rank.  goma_mem_report()
+ * reduces them over a communicator and prints min / mean / max per tag;
+ * goma prints it after setup and at the end of a run.
+ */
+
+typedef enum {
+  GOMA_MEM_OTHER = 0,
+  GOMA_MEM_MESH,      /* exodus database, connectivity, coordinates */
+  GOMA_MEM_GHOST,     /* ghost element generation, communication maps */
+  GOMA_MEM_MATRIX,    /* MSR / sparse matrix storage */
+  GOMA_MEM_ASSEMBLY,  /* lec, field variables and other assembly scratch */
+  GOMA_MEM_SOLUTION,  /* solution, residual and update vectors */
+  GOMA_MEM_POST,      /* post processing and output vectors */
+  GOMA_MEM_PARTICLES, /* particle lists */
+  GOMA_MEM_NUM_TAGS
+} goma_mem_tag;
+
+const char *goma_mem_tag_name(goma_mem_tag tag);
+
+/* switch tracking on (nonzero) or off, blocks tracked so far are kept */
+void goma_mem_enable(int enable);
+
+int goma_mem_is_enabled(void);
+
+/* charge the blocks allocated until the matching pop to tag, nests */
+void goma_mem_push_tag(goma_mem_tag tag);
+
+void goma_mem_pop_tag(void);
+
+goma_mem_tag goma_mem_current_tag(void);
+
+/* record a block allocated at ptr, charged to the current tag */
+void goma_mem_track_alloc(const void *ptr, size_t bytes);
+
+/* release the charge for ptr, blocks that were never tracked are ignored */
+void goma_mem_track_free(const void *ptr);
+
+/*
+ * follow a block moved by a bare realloc(), it keeps the tag it had.  A
+ * NULL old_ptr is a new block; blocks that were never tracked stay so.
+ */
+void goma_mem_track_realloc(const void *old_ptr, const void *new_ptr, size_t bytes);
+
+/* charge (or with negative bytes release) tag without tracking a pointer */
+void goma_mem_track_bytes(goma_mem_tag tag, long long bytes);
+
+size_t goma_mem_current_bytes(goma_mem_tag tag);
+
+size_t goma_mem_peak_bytes(goma_mem_tag tag);
+
+/* forget all tracked blocks and zero the counters */
+void goma_mem_reset(void);
+
+/* strip -mem_report from argv, report is set to 1 when present */
+int goma_mem_parse_args(int *argc, char **argv, int *report);
+
+/* this rank only, no communication, safe to call when out of memory,
+ * prints nothing unless tracking is enabled */
+void goma_mem_print_local(FILE *file);
+
+/* collective over comm, the table is printed to file on rank 0 of comm */
+int goma_mem_report(MPI_Comm comm, const char *label, FILE *file);
+
+#ifdef __cplusplus
+}
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace goma {
+
+/* std::allocator that charges what it hands out to Tag */
+template <class T, goma_mem_tag Tag> struct tracked_allocator {
+  using value_type = T;
+
+  template <class U> struct rebind {
+    using other = tracked_allocator<U, Tag>;
+  };
+
+  tracked_allocator() noexcept = default;
+  template <class U> tracked_allocator(const tracked_allocator<U, Tag> &) noexcept {}
+
+  T *allocate(std::size_t n) {
+    T *p = std::allocator<T>().allocate(n);
+    goma_mem_track_bytes(Tag, static_cast<long long>(n * sizeof(T)));
+    return p;
+  }
+
+  void deallocate(T *p, std::size_t n) noexcept {
+    goma_mem_track_bytes(Tag, -static_cast<long long>(n * sizeof(T)));
+    std::allocator<T>().deallocate(p, n);
+  }
+};
+
+template <class T, class U, goma_mem_tag Tag>
+bool operator==(const tracked_allocator<T, Tag> &, const tracked_allocator<U, Tag> &) {
+  return true;
+}
+
+template <class T, class U, goma_mem_tag Tag>
+bool operator!=(const tracked_allocator<T, Tag> &, const tracked_allocator<U, Tag> &) {
+  return false;
+}
+
+template <class T, goma_mem_tag Tag>
+using tracked_vector = std::vector<T, tracked_allocator<T, Tag>>;
+
+template <class K, goma_mem_tag Tag>
+using tracked_unordered_set =
+    std::unordered_set<K, std::hash<K>, std::equal_to<K>, tracked_allocator<K, Tag>>;
+
+template <class K, class V, goma_mem_tag Tag>
+using tracked_unordered_map = std::unordered_map<K,
+                                                 V,
+                                                 std::hash<K>,
+                                                 std::equal_to<K>,
+                                                 tracked_allocator<std::pair<const K, V>, Tag>>;
+
+/* charges allocations in a scope to tag */
+class mem_tag_scope {
+public:
+  explicit mem_tag_scope(goma_mem_tag tag) { goma_mem_push_tag(tag); }
+  ~mem_tag_scope() { goma_mem_pop_tag(); }
+  mem_tag_scope(const mem_tag_scope &) = delete;
+  mem_tag_scope &operator=(const mem_tag_scope &) = delete;
+};
+
+} // namespace goma
+
+#endif
+
+#endif // UTIL_GOMA_MEMORY_H
@@ -6,6 +6,7 @@
 typedef struct {
   gds_vector *normal;
   gds_vector *d_normal_dx[3][MDE];
+  void *block; /* storage of the vectors above */
 } goma_normal;
 
 typedef struct {
@@ -0,0 +1,66 @@
+#ifndef UTIL_GOMA_PERF_LOG_H
+#define UTIL_GOMA_PERF_LOG_H
+
+#include <mpi.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Whole run performance log (goma -perf_log <file>).
+ *
+ * The Newton solver, the time stepping loops and write_solution add their
+ * timings to Goma_Perf_Log as the run goes.  At the end of the run the
+ * counters are reduced over all processors (times and memory as the max
+ * over processors, memory also summed) and written as JSON, which is what
+ * scripts/perf/goma_perf.py collects and compares against a baseline.
+ */
+
+#define GOMA_PERF_LOG_FILE_LEN 256
+
+typedef struct {
+  double assembly_s; /* Newton assembly, all iterations */
+  double solve_s;    /* linear solves, all iterations */
+  int newton_iterations;
+  int time_steps; /* attempted, including failed steps */
+  int outputs;    /* write_solution calls */
+  double output_s;
+  double wall_s;
+  /* filled in by goma_perf_log_reduce */
+  int processors;
+  double peak_rss_max_kb;
+  double peak_rss_sum_kb;
+} goma_perf_log;
+
+extern goma_perf_log Goma_Perf_Log;
+
+/* output file, empty when -perf_log was not given */
+extern char Goma_Perf_Log_File[GOMA_PERF_LOG_FILE_LEN];
+
+void goma_perf_log_init(goma_perf_log *log);
+
+/* strip -perf_log <file> from argv, file is left empty when not present */
+int goma_perf_log_parse_args(int *argc, char **argv, char *file, size_t len);
+
+void goma_perf_log_newton(goma_perf_log *log, double assembly_s, double solve_s);
+
+void goma_perf_log_time_step(goma_perf_log *log);
+
+void goma_perf_log_output(goma_perf_log *log, double output_s);
+
+/* peak resident set size of this process in kB */
+double goma_perf_log_peak_rss_kb(void);
+
+/* collective, every rank gets the reduced log */
+int goma_perf_log_reduce(const goma_perf_log *log, MPI_Comm comm, goma_perf_log *reduced);
+
+int goma_perf_log_write_json(const goma_perf_log *log, const char *input_file, FILE *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_GOMA_PERF_LOG_H
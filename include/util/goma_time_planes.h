@@ -0,0 +1,41 @@
+#ifndef UTIL_GOMA_TIME_PLANES_H
+#define UTIL_GOMA_TIME_PLANES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Bookkeeping for reading a time dependent field a couple of time planes at
+ * a time instead of whole files.  Planes are numbered from 1 as in exodus,
+ * times[i] is the time of plane i + 1.
+ */
+
+#define GOMA_TIME_PLANE_SLOTS 2
+
+/*
+ * Planes bracketing t and the weight of the higher one, the field at t is
+ * (1 - weight) * lower + weight * higher.  Before the first plane both are
+ * the first plane, past the last one the last two are extrapolated.
+ * Returns 0, or -1 when there are no planes.
+ */
+int goma_time_plane_bracket(
+    const double *times, int num_times, double t, int *lower, int *higher, double *weight);
+
+/*
+ * slot_plane[s] is the plane held in buffer s, 0 when empty.  Chooses the
+ * buffers for lower and higher (slot[0], slot[1]), keeping planes that are
+ * already held, and updates slot_plane.  load[s] is set to 1 for each buffer
+ * that has to be read.
+ */
+void goma_time_plane_slots(int slot_plane[GOMA_TIME_PLANE_SLOTS],
+                           int lower,
+                           int higher,
+                           int slot[2],
+                           int load[GOMA_TIME_PLANE_SLOTS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_GOMA_TIME_PLANES_H
@@ -0,0 +1,36 @@
+#ifndef UTIL_MESH_ORDERING_H
+#define UTIL_MESH_ORDERING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Orderings used to renumber the mesh for cache locality, see dp_reorder.cpp.
+ */
+
+/*
+ * Reverse Cuthill-McKee order of the vertices in [begin, end) of the graph
+ * given in compressed rows: vertex v is adjacent to adj[ptr[v]] ..
+ * adj[ptr[v + 1] - 1].  Edges leaving the range and self loops are ignored.
+ * Each connected component is started from a George-Liu pseudo-peripheral
+ * vertex.  order receives all end - begin vertices.  Returns 0, or -1 when
+ * out of memory.
+ */
+int goma_rcm_order(const int *ptr, const int *adj, int begin, int end, int *order);
+
+/*
+ * Position of the point X (dim coordinates in [0, 2^bits)) along the
+ * Hilbert curve through the 2^bits grid; X is overwritten.  dim * bits must
+ * be at most 64.  Skilling, "Programming the Hilbert curve", AIP Conf. Proc.
+ * 707 (2004).
+ */
+uint64_t goma_hilbert_index(uint32_t X[3], int dim, int bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_MESH_ORDERING_H
@@ -0,0 +1,72 @@
+#ifndef UTIL_PARTICLE_TRAJECTORY_H
+#define UTIL_PARTICLE_TRAJECTORY_H
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Binary particle trajectory files.
+ *
+ * Samples are buffered in memory and written in chunks, each chunk
+ * stored column by column so post-processing can read whole arrays:
+ *
+ *   header: "GOMAPTRJ", int version, int byte order check (0x01020304),
+ *           int pdim, int num_vars, int has_proc_id,
+ *           num_vars names of GOMA_PTRJ_NAME_LENGTH chars
+ *   record: int kind
+ *     GOMA_PTRJ_ZONE:   double zone time
+ *     GOMA_PTRJ_CHUNK:  int n, double x[pdim][n], double time[n],
+ *                       double vars[num_vars][n], int proc_id[n] (if has_proc_id)
+ *
+ * Everything is written in native byte order; the reader refuses
+ * files written with a different one.
+ */
+
+#define GOMA_PTRJ_VERSION          1
+#define GOMA_PTRJ_NAME_LENGTH      16
+#define GOMA_PTRJ_DEFAULT_CAPACITY 8192
+
+enum goma_ptrj_record_kind { GOMA_PTRJ_CHUNK = 1, GOMA_PTRJ_ZONE = 2 };
+
+typedef struct {
+  FILE *fp;
+  int pdim;
+  int num_vars;
+  int has_proc_id;
+  int capacity;
+  int count;
+  double *x;    /* pdim columns of capacity entries */
+  double *time; /* capacity entries */
+  double *vars; /* num_vars columns of capacity entries */
+  int *proc_id; /* capacity entries, NULL without has_proc_id */
+} goma_ptrj_writer;
+
+goma_ptrj_writer *goma_ptrj_open(const char *filename,
+                                 int pdim,
+                                 int num_vars,
+                                 const char *const *var_names,
+                                 int has_proc_id,
+                                 int capacity);
+
+int goma_ptrj_append(goma_ptrj_writer *w,
+                     const double *x,
+                     double time,
+                     const double *vars,
+                     int proc_id);
+
+int goma_ptrj_zone(goma_ptrj_writer *w, double time);
+
+int goma_ptrj_flush(goma_ptrj_writer *w);
+
+int goma_ptrj_close(goma_ptrj_writer *w);
+
+int goma_ptrj_to_tecplot(const char *filename, FILE *out, int tecplot_header);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_PARTICLE_TRAJECTORY_H
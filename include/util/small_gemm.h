@@ -0,0 +1,33 @@
+#ifndef UTIL_SMALL_GEMM_H
+#define UTIL_SMALL_GEMM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Small dense matrix products for element assembly.
+ *
+ * Element blocks are a few tens of rows and columns with a contraction
+ * length of one to ten, far too small for a BLAS call to pay off.  The
+ * kernel walks rows of C, takes the contraction four terms at a time and
+ * keeps the innermost loop a unit stride sweep over a row of C and B so
+ * the compiler can vectorize it.  All matrices are row major.
+ */
+
+/* C += A B, with A m x k (row stride lda), B k x n (ldb), C m x n (ldc) */
+void goma_small_gemm(int m,
+                     int n,
+                     int k,
+                     const double *A,
+                     int lda,
+                     const double *B,
+                     int ldb,
+                     double *C,
+                     int ldc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_SMALL_GEMM_H
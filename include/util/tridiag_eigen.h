@@ -0,0 +1,30 @@
+#ifndef UTIL_TRIDIAG_EIGEN_H
+#define UTIL_TRIDIAG_EIGEN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GOMA_TRIDIAG_EIGEN_MAX_N 16
+
+/*
+ * Eigenvalues of a small symmetric tridiagonal matrix by the implicit QL
+ * method, for the Jacobi matrices of moment inversion (Golub-Welsch).
+ *
+ * diag holds the n diagonal entries and offdiag the n - 1 entries coupling
+ * rows i and i + 1.  On return eigenvalues are in ascending order and z0[i]
+ * is the first component of the normalized eigenvector of eigenvalues[i],
+ * which is all the quadrature weights need, so the rotations are applied to
+ * that one row instead of the full eigenvector matrix.  z0 may be NULL.
+ *
+ * Returns 0, or -1 when n is out of range or the iteration does not
+ * converge.
+ */
+int goma_tridiag_eigen(
+    int n, const double *diag, const double *offdiag, double *eigenvalues, double *z0);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // UTIL_TRIDIAG_EIGEN_H
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+# Usage:
+#      box_mesh.py OUTPUT --element TYPE --elements NX NY [NZ] [--size LX LY [LZ]]
+#
+# Writes a structured box mesh as an Exodus II file, for the decks of the
+# kernel benchmarks (tests/benchmarks) and of the performance suite
+# (tests/performance).  TYPE is QUAD4 or QUAD9 for a 2D box, HEX8 for a 3D
+# box, or SHELL4 for the plane z = 0 of a 3D box meshed with shell elements.
+#
+# The mesh is one element block with id 1.  Each face of the box is a node
+# set and, except for shells, a side set whose id is the Exodus side number
+# of that face:
+#
+#      1  y = 0      2  x = LX      3  y = LY      4  x = 0
+#      5  z = 0      6  z = LZ      (HEX8 only)
+#
+# Side set distribution factors are all one, one per node of each side.
+#
+# Note: This requires the exodus python module of SEACAS (exodus3.py) to be
+# in a directory listed in $PYTHONPATH.
+
+import argparse
+import os
+
+import exodus3 as exodus
+
+CORNERS_2D = [(0, 0), (1, 0), (1, 1), (0, 1)]
+CORNERS_3D = [(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0),
+              (0, 0, 1), (1, 0, 1), (1, 1, 1), (0, 1, 1)]
+# QUAD9 mid-side nodes 5-8 and center node 9, in half element steps
+QUAD9_EXTRA = [(1, 0), (2, 1), (1, 2), (0, 1), (1, 1)]
+
+
+class Box:
+    def __init__(self, element, n, size):
+        self.element = element
+        self.dim = len(n)
+        self.n = n
+        self.order = 2 if element == 'QUAD9' else 1
+        # nodes along each direction
+        self.m = [self.order * ne + 1 for ne in n]
+        self.size = size
+
+    def node(self, i, j, k=0):
+        return (k * self.m[1] + j) * self.m[0] + i + 1
+
+    def elem(self, ex, ey, ez=0):
+        return (ez * self.n[1] + ey) * self.n[0] + ex + 1
+
+    def elements(self):
+        nz = self.n[2] if self.dim == 3 else 1
+        for ez in range(nz):
+            for ey in range(self.n[1]):
+                for ex in range(self.n[0]):
+                    yield ex, ey, ez
+
+    def coords(self):
+        c = [[], [], []]
+        mz = self.m[2] if self.dim == 3 else 1
+        for k in range(mz):
+            for j in range(self.m[1]):
+                for i in range(self.m[0]):
+                    for d, l in enumerate((i, j, k)):
+                        h = self.size[d] / (self.m[d] - 1) if d < self.dim else 0.0
+                        c[d].append(l * h)
+        return c
+
+    def connectivity(self):
+        conn = []
+        p = self.order
+        for ex, ey, ez in self.elements():
+            if self.dim == 2:
+                lattice = [(p * a, p * b) for a, b in CORNERS_2D]
+                if self.element == 'QUAD9':
+                    lattice += QUAD9_EXTRA
+                conn += [self.node(p * ex + a, p * ey + b) for a, b in lattice]
+            else:
+                conn += [self.node(ex + a, ey + b, ez + c) for a, b, c in CORNERS_3D]
+        return conn
+
+    def on_face(self, face, i, j, k):
+        last = [mi - 1 for mi in self.m]
+        return {1: j == 0, 2: i == last[0], 3: j == last[1], 4: i == 0,
+                5: k == 0, 6: self.dim == 3 and k == last[2]}[face]
+
+    def faces(self):
+        return range(1, 7) if self.dim == 3 else range(1, 5)
+
+    def node_set(self, face):
+        mz = self.m[2] if self.dim == 3 else 1
+        return [self.node(i, j, k) for k in range(mz) for j in range(self.m[1])
+                for i in range(self.m[0]) if self.on_face(face, i, j, k)]
+
+    def side_set(self, face):
+        last = [ne - 1 for ne in self.n] + [0]
+        test = {1: lambda e: e[1] == 0, 2: lambda e: e[0] == last[0],
+                3: lambda e: e[1] == last[1], 4: lambda e: e[0] == 0,
+                5: lambda e: e[2] == 0, 6: lambda e: e[2] == last[2]}[face]
+        elems = [self.elem(*e) for e in self.elements() if test(e)]
+        nodes_per_side = self.order + 1 if self.dim == 2 else 4
+        return elems, nodes_per_side
+
+
+def write(filename, box):
+    nodes_per_elem = {'QUAD4': 4, 'QUAD9': 9, 'HEX8': 8, 'SHELL4': 4}[box.element]
+    num_dim = 3 if box.element == 'SHELL4' else box.dim
+    num_elem = 1
+    for ne in box.n:
+        num_elem *= ne
+    coords = box.coords()
+    shell = box.element == 'SHELL4'
+    faces = list(box.faces())
+
+    if os.path.exists(filename):
+        os.remove(filename)
+    e = exodus.exodus(filename, mode='w', array_type='ctype',
+                      title='box_mesh.py %s %s' % (box.element, 'x'.join(map(str, box.n))),
+                      numDims=num_dim, numNodes=len(coords[0]), numElems=num_elem,
+                      numBlocks=1, numNodeSets=len(faces),
+                      numSideSets=0 if shell else len(faces))
+    e.put_coord_names(['x', 'y', 'z'][:num_dim])
+    e.put_coords(coords[0], coords[1], coords[2])
+    e.put_elem_blk_info(1, box.element, num_elem, nodes_per_elem, 0)
+    e.put_elem_connectivity(1, box.connectivity())
+    for face in faces:
+        nodes = box.node_set(face)
+        e.put_node_set_params(face, len(nodes), len(nodes))
+        e.put_node_set(face, nodes)
+        e.put_node_set_dist_fact(face, [1.0] * len(nodes))
+        if shell:
+            continue
+        elems, nodes_per_side = box.side_set(face)
+        e.put_side_set_params(face, len(elems), nodes_per_side * len(elems))
+        e.put_side_set(face, elems, [face] * len(elems))
+        e.put_side_set_dist_fact(face, [1.0] * (nodes_per_side * len(elems)))
+    e.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='structured Exodus II box mesh')
+    parser.add_argument('output')
+    parser.add_argument('--element', required=True, choices=['QUAD4', 'QUAD9', 'HEX8', 'SHELL4'])
+    parser.add_argument('--elements', required=True, type=int, nargs='+',
+                        help='elements in each direction')
+    parser.add_argument('--size', type=float, nargs='+', help='box size, default all 1')
+    args = parser.parse_args()
+
+    dim = 3 if args.element == 'HEX8' else 2
+    if len(args.elements) != dim or min(args.elements) < 1:
+        parser.error('%s needs %d positive element counts' % (args.element, dim))
+    size = args.size or [1.0] * dim
+    if len(size) != dim:
+        parser.error('%s needs %d sizes' % (args.element, dim))
+    write(args.output, Box(args.element, args.elements, size))
+
+
+if __name__ == '__main__':
+    main()
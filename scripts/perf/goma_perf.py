@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+# Usage:
+#      goma_perf.py list    [--suite suite.json]
+#      goma_perf.py run     [--suite suite.json] [--decks DIR] --goma PATH --results FILE
+#                           [--run ID ...] [--baseline FILE [--threshold FRAC]]
+#      goma_perf.py save    --results FILE [FILE ...] --baseline FILE
+#      goma_perf.py compare --results FILE [FILE ...] --baseline FILE [--threshold FRAC]
+#
+# End to end performance suite for goma.  Each case of the suite is an input
+# deck directory (under --decks, by default tests/performance next to the
+# suite) run at a few mesh sizes and processor counts.  The mesh of each
+# size is a box written by box_mesh.py before the run, which needs the
+# exodus python module of SEACAS in $PYTHONPATH.  goma is run with
+# -perf_log, which records assembly and solve
+# time, Newton iterations, output time per time step and peak memory, and
+# the results are collected into one JSON file.  A baseline is just such a
+# results file; compare reports every metric that grew by more than the
+# threshold and exits non-zero if any did.  See scripts/perf/README.md.
+
+import argparse
+import json
+import os
+import platform
+import shutil
+import subprocess
+import sys
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_SUITE = os.path.join(HERE, '..', '..', 'tests', 'performance', 'suite.json')
+BOX_MESH = os.path.join(HERE, 'box_mesh.py')
+
+# metric: (absolute floor below which a change is noise, unit)
+METRICS = {
+    'assembly_s': (0.05, 's'),
+    'solve_s': (0.05, 's'),
+    'output_s_per_step': (0.01, 's'),
+    'wall_s': (0.1, 's'),
+    'newton_iterations': (0, ''),
+    'peak_rss_max_mb': (1.0, 'MB'),
+}
+
+# times are the best of the repetitions, everything else comes from the first
+TIMES = ('assembly_s', 'solve_s', 'output_s', 'output_s_per_step', 'wall_s')
+
+
+def run_id(case, size, np):
+    return '%s/%s/np%d' % (case['name'], size, np)
+
+
+def load_suite(filename):
+    with open(filename) as f:
+        suite = json.load(f)
+    runs = {}
+    for case in suite['cases']:
+        for size, elements in case['sizes'].items():
+            for np in case.get('processors', [1]):
+                runs[run_id(case, size, np)] = (case, elements, np)
+    return runs
+
+
+def write_mesh(case, elements, work):
+    ''' Write the box mesh of one size of a case into the work directory'''
+    mesh = case['mesh']
+    command = [sys.executable, BOX_MESH, os.path.join(work, mesh['file']),
+               '--element', mesh['element'], '--elements'] + [str(n) for n in elements]
+    if 'size' in mesh:
+        command += ['--size'] + [str(x) for x in mesh['size']]
+    with open(os.path.join(work, 'box_mesh.log'), 'w') as log:
+        status = subprocess.call(command, stdout=log, stderr=subprocess.STDOUT)
+    if status != 0:
+        raise RuntimeError('%s failed with status %d, see %s/box_mesh.log' %
+                           (' '.join(command), status, work))
+
+
+def machine():
+    return {
+        'host': platform.node(),
+        'system': platform.platform(),
+        'processor': platform.processor(),
+        'cpus': os.cpu_count(),
+    }
+
+
+def run_goma(case, elements, np, opts, work):
+    if os.path.exists(work):
+        shutil.rmtree(work)
+    shutil.copytree(os.path.join(opts.decks, case['directory']), work)
+    write_mesh(case, elements, work)
+
+    command = [opts.goma, '-perf_log', 'perf_log.json', '-i', case.get('input', 'input')]
+    if np > 1:
+        command = [opts.mpiexec, opts.mpiexec_numproc_flag, str(np)] + command
+    with open(os.path.join(work, 'goma.log'), 'w') as log:
+        start = time.time()
+        status = subprocess.call(command, cwd=work, stdout=log, stderr=subprocess.STDOUT)
+        elapsed = time.time() - start
+    if status != 0:
+        raise RuntimeError('%s failed with status %d, see %s/goma.log' %
+                           (' '.join(command), status, work))
+    with open(os.path.join(work, 'perf_log.json')) as f:
+        result = json.load(f)
+    result['launch_s'] = elapsed
+    return result
+
+
+def best_of(results):
+    best = dict(results[0])
+    for key in TIMES:
+        best[key] = min(r[key] for r in results)
+    best['repetitions'] = len(results)
+    return best
+
+
+def read_results(filenames):
+    merged = {'machine': None, 'runs': {}}
+    for filename in filenames:
+        with open(filename) as f:
+            results = json.load(f)
+        merged['machine'] = merged['machine'] or results.get('machine')
+        merged['runs'].update(results['runs'])
+    return merged
+
+
+def write_results(results, filename):
+    directory = os.path.dirname(filename)
+    if directory and not os.path.isdir(directory):
+        os.makedirs(directory)
+    with open(filename, 'w') as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+        f.write('\n')
+
+
+def compare(results, baseline, threshold):
+    ''' Print a table of every metric against the baseline and return
+    the number of regressions, i.e. metrics that grew by more than
+    threshold (relative) and by more than the metric's noise floor'''
+    if baseline['machine'] and results['machine'] and \
+            baseline['machine']['host'] != results['machine']['host']:
+        print('warning: baseline was recorded on %s, these results on %s' %
+              (baseline['machine']['host'], results['machine']['host']))
+
+    regressions = 0
+    print('%-40s %-20s %12s %12s %8s' % ('run', 'metric', 'baseline', 'current', 'change'))
+    for rid in sorted(results['runs']):
+        current = results['runs'][rid]
+        base = baseline['runs'].get(rid)
+        if base is None:
+            print('%-40s no baseline' % rid)
+            continue
+        for metric, (floor, unit) in METRICS.items():
+            if metric not in base or metric not in current:
+                continue
+            old, new = base[metric], current[metric]
+            change = (new - old) / old if old > 0 else 0.0
+            flag = ''
+            if new > old * (1.0 + threshold) and new - old > floor:
+                flag = '  REGRESSION'
+                regressions += 1
+            print('%-40s %-20s %10.4g%-2s %10.4g%-2s %+7.1f%%%s' %
+                  (rid, metric, old, unit, new, unit, 100.0 * change, flag))
+    return regressions
+
+
+def cmd_list(opts):
+    for rid in load_suite(opts.suite):
+        print(rid)
+    return 0
+
+
+def cmd_run(opts):
+    runs = load_suite(opts.suite)
+    opts.decks = opts.decks or os.path.dirname(os.path.abspath(opts.suite))
+    selected = opts.run or list(runs)
+    unknown = [rid for rid in selected if rid not in runs]
+    if unknown:
+        sys.exit('unknown run(s): %s' % ', '.join(unknown))
+
+    results = {'machine': machine(), 'runs': {}}
+    for rid in selected:
+        case, elements, np = runs[rid]
+        work = os.path.join(opts.work_dir, rid.replace('/', '_'))
+        print('running %s' % rid)
+        sys.stdout.flush()
+        samples = [run_goma(case, elements, np, opts, work) for _ in range(opts.repeat)]
+        results['runs'][rid] = best_of(samples)
+    write_results(results, opts.results)
+
+    if opts.baseline:
+        if not os.path.exists(opts.baseline):
+            print('no baseline %s, nothing to compare' % opts.baseline)
+            return 0
+        return 1 if compare(results, read_results([opts.baseline]), opts.threshold) else 0
+    return 0
+
+
+def cmd_save(opts):
+    results = read_results(opts.results)
+    if os.path.exists(opts.baseline):
+        baseline = read_results([opts.baseline])
+        baseline['machine'] = results['machine']
+        baseline['runs'].update(results['runs'])
+    else:
+        baseline = results
+    write_results(baseline, opts.baseline)
+    print('saved %d run(s) to %s' % (len(results['runs']), opts.baseline))
+    return 0
+
+
+def cmd_compare(opts):
+    regressions = compare(read_results(opts.results), read_results([opts.baseline]),
+                          opts.threshold)
+    if regressions:
+        print('%d regression(s) beyond %.0f%%' % (regressions, 100.0 * opts.threshold))
+        return 1
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description='goma end to end performance suite')
+    sub = parser.add_subparsers(dest='command')
+    sub.required = True
+
+    p = sub.add_parser('list', help='list the run ids of a suite')
+    p.add_argument('--suite', default=DEFAULT_SUITE)
+    p.set_defaults(func=cmd_list)
+
+    p = sub.add_parser('run', help='run the suite, or some runs of it')
+    p.add_argument('--suite', default=DEFAULT_SUITE)
+    p.add_argument('--decks', help='directory holding the case directories, '
+                   'default the directory of the suite')
+    p.add_argument('--goma', required=True, help='goma executable')
+    p.add_argument('--results', required=True, help='JSON file to write')
+    p.add_argument('--run', action='append', help='run id (case/size/npN), may repeat')
+    p.add_argument('--repeat', type=int, default=1, help='keep the best of REPEAT runs')
+    p.add_argument('--work-dir', default='goma_perf_work')
+    p.add_argument('--mpiexec', default='mpirun')
+    p.add_argument('--mpiexec-numproc-flag', default='-np')
+    p.add_argument('--baseline', help='compare against this baseline after running')
+    p.add_argument('--threshold', type=float, default=0.10)
+    p.set_defaults(func=cmd_run)
+
+    p = sub.add_parser('save', help='store results as (part of) a baseline')
+    p.add_argument('--results', required=True, nargs='+')
+    p.add_argument('--baseline', required=True)
+    p.set_defaults(func=cmd_save)
+
+    p = sub.add_parser('compare', help='compare results against a baseline')
+    p.add_argument('--results', required=True, nargs='+')
+    p.add_argument('--baseline', required=True)
+    p.add_argument('--threshold', type=float, default=0.10)
+    p.set_defaults(func=cmd_compare)
+
+    opts = parser.parse_args()
+    return opts.func(opts)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -920,11 +920,7 @@ void continue_problem(Comm_Ex *cx, /* array of communications structures */
         /*
          * INTEGRATE FLUXES, FORCES
          */
-        for (i = 0; i < nn_post_fluxes; i++)
-          evaluate_flux(exo, dpi, pp_fluxes[i]->ss_id, pp_fluxes[i]->flux_type,
-                        pp_fluxes[i]->flux_type_name, pp_fluxes[i]->blk_id,
-                        pp_fluxes[i]->species_number, pp_fluxes[i]->flux_filenm,
-                        pp_fluxes[i]->profile_flag, x, xdot, NULL, delta_s, path1, 1);
+        evaluate_pp_fluxes(exo, dpi, x, xdot, delta_s, path1);
 
         /*
          * COMPUTE FLUX, FORCE SENSITIVITIES
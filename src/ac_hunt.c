@@ -911,12 +911,7 @@ void hunt_problem(Comm_Ex *cx, /* array of communications structures */
 
         */
 
-        for (i = 0; i < nn_post_fluxes; i++) {
-          evaluate_flux(exo, dpi, pp_fluxes[i]->ss_id, pp_fluxes[i]->flux_type,
-                        pp_fluxes[i]->flux_type_name, pp_fluxes[i]->blk_id,
-                        pp_fluxes[i]->species_number, pp_fluxes[i]->flux_filenm,
-                        pp_fluxes[i]->profile_flag, x, xdot, NULL, delta_s[0], path1[0], 1);
-        }
+        evaluate_pp_fluxes(exo, dpi, x, xdot, delta_s[0], path1[0]);
 
         /*
           COMPUTE FLUX, FORCE SENSITIVITIES
@@ -149,6 +149,7 @@
 #include "sl_lu.h"
 #include "sl_matrix_util.h"
 #include "sl_mumps.h"
+#include "sl_stratimikos_interface.h"
 #include "sl_umf.h"
 #include "sl_util.h"
 #include "sl_util_structs.h"
@@ -1395,11 +1396,7 @@ int nonlinear_solver_conwrap(double *x, void *con_ptr, int step_num, double lamb
 
     /* INTEGRATE FLUXES, FORCES */
 
-    for (i = 0; i < nn_post_fluxes; i++)
-      evaluate_flux(passdown.exo, passdown.dpi, pp_fluxes[i]->ss_id, pp_fluxes[i]->flux_type,
-                    pp_fluxes[i]->flux_type_name, pp_fluxes[i]->blk_id,
-                    pp_fluxes[i]->species_number, pp_fluxes[i]->flux_filenm,
-                    pp_fluxes[i]->profile_flag, x, passdown.xdot, NULL, delta_s, lambda, 1);
+    evaluate_pp_fluxes(passdown.exo, passdown.dpi, x, passdown.xdot, delta_s, lambda);
 
     /* COMPUTE FLUX, FORCE SENSITIVITIES */
 
@@ -1621,6 +1618,23 @@ int linear_solver_conwrap(double *x, int jac_flag, double *tmp)
     strcpy(stringer, " 1 ");
     break;
 
+  case STRATIMIKOS: {
+    int iterations = 0;
+    if (strcmp(Matrix_Format, "epetra") == 0) {
+      error = stratimikos_solve(ams, x, xr, &iterations, Stratimikos_File, pg->imtrx);
+    } else if (strcmp(Matrix_Format, "tpetra") == 0) {
+      error = stratimikos_solve_tpetra(ams, x, xr, &iterations, Stratimikos_File, pg->imtrx);
+    } else {
+      GOMA_EH(GOMA_ERROR, "Sorry, only Epetra and Tpetra matrix formats are currently supported "
+                          "with the Stratimikos interface\n");
+    }
+    if (error) {
+      why = AZ_breakdown;
+    }
+    aztec_stringer(why, iterations, &stringer[0]);
+    passdown.num_linear_its += iterations;
+  } break;
+
   case MA28:
     /*
      * sl_ma28 keeps interntal static variables to determine whether
@@ -1643,11 +1657,11 @@ int linear_solver_conwrap(double *x, int jac_flag, double *tmp)
   /* Report solve time and status */
   s_end = ut();
   if (ProcID == 0) {
-    if (Linear_Solver == AZTEC) {
+    if (Linear_Solver == AZTEC || Linear_Solver == STRATIMIKOS) {
       if (why == AZ_normal) {
         printf("\tResolve time = %7.1e   lits = %s\n", (s_end - s_start), stringer);
       } else {
-        printf("WARNING:  Aztec status was %s !\n", stringer);
+        printf("WARNING:  Linear solver status was %s !\n", stringer);
       }
     } else {
       printf(" Resolve_time:%7.1e ", (s_end - s_start));
@@ -1668,6 +1682,203 @@ int linear_solver_conwrap(double *x, int jac_flag, double *tmp)
 /*****************************************************************************/
 /*****************************************************************************/
 /*****************************************************************************/
+int linear_solver_conwrap_multi(double **x, int nrhs, int jac_flag, double *tmp)
+/* Solve the same Jacobian system for several right hand sides at once.
+ * This is used by the bordering algorithms, which need several solves
+ * with an unchanged matrix per Newton step. The matrix is scaled once and
+ * every right hand side is scaled by the same row sums. Direct solvers
+ * factor the matrix once and back substitute for each right hand side,
+ * Aztec keeps its preconditioner between right hand sides, and
+ * Stratimikos receives the whole block so block Krylov methods (e.g.
+ * Belos "Block GMRES") can be used.
+ * Input:
+ *    x          Array of nrhs right hand sides
+ *    nrhs       Number of right hand sides
+ *    jac_flag   Same meaning as in linear_solver_conwrap, applies to the
+ *               first right hand side
+ *    tmp        Work space, see linear_solver_conwrap
+ *
+ * Output:
+ *    x          Solution vectors
+ *
+ * Return Value:
+ *    Negative value means linear solver didn't converge for at least
+ *    one right hand side.
+ */
+{
+  struct GomaLinearSolverData *ams = &(passdown.ams[JAC]);
+  static int first_linear_solver_call = FALSE;
+  double *a = ams->val;  /* nonzero values of a CMSR matrix */
+  int *ija = ams->bindx; /* column pointer array into matrix "a" */
+  int Factor_Flag;
+  int matr_form;
+  int error = 0;
+  int why = AZ_normal;
+  int k;
+  char stringer[80];
+  dbl s_start;
+  dbl s_end;
+
+  int numUnks = NumUnknowns[pg->imtrx] + NumExtUnknowns[pg->imtrx];
+  double **xr = NULL;
+
+  if (nrhs == 1 || (Linear_Solver != UMFPACK2 && Linear_Solver != UMFPACK2F &&
+                    Linear_Solver != SPARSE13a && Linear_Solver != AZTEC &&
+                    Linear_Solver != AMESOS && Linear_Solver != STRATIMIKOS)) {
+    /* No reuse available, one solve per rhs */
+    for (k = 0; k < nrhs; k++) {
+      int err = linear_solver_conwrap(x[k], (k == 0) ? jac_flag : OLD_JACOBIAN, tmp);
+      if (err < 0) {
+        error = err;
+      }
+    }
+    return error;
+  }
+
+  /* Copy right hand sides, scale the matrix once and every rhs by the same row sums */
+  xr = (double **)array_alloc(2, nrhs, numUnks, sizeof(double));
+  for (k = 0; k < nrhs; k++) {
+    dcopy1(numUnks, x[k], xr[k]);
+  }
+  row_sum_scaling_scale(ams, xr[0], passdown.scale);
+  for (k = 1; k < nrhs; k++) {
+    vector_scaling(NumUnknowns[pg->imtrx], xr[k], passdown.scale);
+  }
+
+  s_start = ut();
+  switch (Linear_Solver) {
+  case UMFPACK2:
+  case UMFPACK2F:
+    if (strcmp(Matrix_Format, "msr"))
+      GOMA_EH(GOMA_ERROR, "ERROR: umfpack solver needs msr matrix format");
+
+    matr_form = 1;
+    for (k = 0; k < nrhs; k++) {
+      /* factor with the first rhs, back substitution only for the rest */
+      if (k == 0) {
+        Factor_Flag = (Linear_Solver == UMFPACK2F) ? 0 : 1;
+      } else {
+        Factor_Flag = 3;
+      }
+      LOCA_UMF_ID =
+          SL_UMF(LOCA_UMF_ID, &first_linear_solver_call, &Factor_Flag, &matr_form,
+                 &NumUnknowns[pg->imtrx], &NZeros, &ija[0], &ija[0], &a[0], &xr[k][0], &x[k][0]);
+    }
+    first_linear_solver_call = FALSE;
+    sprintf(stringer, " %d ", nrhs);
+    break;
+
+  case SPARSE13a:
+    if (strcmp(Matrix_Format, "msr"))
+      GOMA_EH(GOMA_ERROR, "ERROR: lu solver needs msr matrix format");
+
+    for (k = 0; k < nrhs; k++) {
+      dcopy1(NumUnknowns[pg->imtrx], xr[k], x[k]);
+      lu(NumUnknowns[pg->imtrx], NumExtUnknowns[pg->imtrx], NZeros, a, ija, x[k], (k == 0) ? 2 : 3);
+    }
+    sprintf(stringer, " %d ", nrhs);
+    break;
+
+  case AZTEC: {
+    int pre_calc;
+    int keep_info_save = ams->options[AZ_keep_info];
+    int linear_solver_itns = 0;
+
+    if (strcmp(Matrix_Factorization_Reuse, "calc") == 0) {
+      AZ_free_memory(ams->data_org[AZ_name]);
+      pre_calc = AZ_calc;
+    } else if (strcmp(Matrix_Factorization_Reuse, "recalc") == 0) {
+      pre_calc = AZ_recalc;
+    } else if (strcmp(Matrix_Factorization_Reuse, "reuse") == 0) {
+      pre_calc = AZ_reuse;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Unknown factorization reuse specification.");
+      pre_calc = AZ_calc;
+    }
+
+    /* Keep the preconditioner built for the first rhs for all of the others */
+    ams->options[AZ_keep_info] = 1;
+    for (k = 0; k < nrhs; k++) {
+      ams->options[AZ_pre_calc] = (k == 0) ? pre_calc : AZ_reuse;
+      vzero(numUnks, &x[k][0]);
+      AZ_solve(x[k], xr[k], ams->options, ams->params, ams->indx, ams->bindx, ams->rpntr,
+               ams->cpntr, ams->bpntr, ams->val, ams->data_org, ams->status, ams->proc_config);
+
+      if (Debug_Flag > 0) {
+        dump_aztec_status(ams->status);
+      }
+
+      if ((int)ams->status[AZ_why] != AZ_normal) {
+        why = (int)ams->status[AZ_why];
+        error = -1;
+      }
+      linear_solver_itns += ams->status[AZ_its];
+    }
+    first_linear_solver_call = FALSE;
+    ams->options[AZ_keep_info] = keep_info_save;
+    ams->options[AZ_pre_calc] = pre_calc;
+
+    if (pre_calc == AZ_calc) {
+      AZ_free_memory(ams->data_org[AZ_name]);
+    }
+
+    aztec_stringer(why, linear_solver_itns, &stringer[0]);
+    passdown.num_linear_its += linear_solver_itns;
+  } break;
+
+  case AMESOS:
+    if ((strcmp(Matrix_Format, "msr") != 0) && (strcmp(Matrix_Format, "epetra") != 0)) {
+      GOMA_EH(GOMA_ERROR, " Sorry, only MSR and Epetra matrix formats are currently supported with "
+                          "the Amesos solver suite\n");
+    }
+    amesos_solve_multi(Amesos_Package, ams, x, xr, nrhs, pg->imtrx);
+    sprintf(stringer, " %d ", nrhs);
+    break;
+
+  case STRATIMIKOS: {
+    int iterations = 0;
+    if (strcmp(Matrix_Format, "epetra") == 0) {
+      error = stratimikos_solve_multi(ams, x, xr, nrhs, &iterations, Stratimikos_File, pg->imtrx);
+    } else if (strcmp(Matrix_Format, "tpetra") == 0) {
+      error = stratimikos_solve_tpetra_multi(ams, x, xr, nrhs, &iterations, Stratimikos_File,
+                                             pg->imtrx);
+    } else {
+      GOMA_EH(GOMA_ERROR, "Sorry, only Epetra and Tpetra matrix formats are currently supported "
+                          "with the Stratimikos interface\n");
+    }
+    if (error) {
+      why = AZ_breakdown;
+    }
+    aztec_stringer(why, iterations, &stringer[0]);
+    passdown.num_linear_its += iterations;
+  } break;
+
+  default:
+    GOMA_EH(GOMA_ERROR, "That linear solver package is not implemented.");
+    break;
+  }
+
+  /* Report solve time and status */
+  s_end = ut();
+  if (ProcID == 0) {
+    if (Linear_Solver == AZTEC || Linear_Solver == STRATIMIKOS) {
+      if (why == AZ_normal) {
+        printf("\tBlock resolve time (%d rhs) = %7.1e   lits = %s\n", nrhs, (s_end - s_start),
+               stringer);
+      } else {
+        printf("WARNING:  Block solve status was %s !\n", stringer);
+      }
+    } else {
+      printf(" Block resolve_time (%d rhs):%7.1e ", nrhs, (s_end - s_start));
+    }
+  }
+
+  safe_free((void *)xr);
+  return error;
+}
+/*****************************************************************************/
+/*****************************************************************************/
+/*****************************************************************************/
 #ifndef ENABLE_KOMPLEX
 #define KOMPLEX_UNUSED UNUSED
 #else
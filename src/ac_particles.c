@@ -56,12 +56,17 @@
 #include "sl_auxutil.h"
 #include "sl_util.h"
 #include "std.h"
+#include "util/goma_memory.h"
+#include "util/particle_trajectory.h"
 
 /* GOMA include files */
 #define GOMA_AC_PARTICLES_C
 
 /* Global variables that reside entirely within this file. */
 static particle_t *particles_to_do, *particles_to_send;
+static particle_t *particle_free_list;
+static particle_t **particle_pool_chunks;
+static int num_particle_pool_chunks;
 static particle_t **element_particle_list_head;
 static particle_t **backup_element_particle_list_head;
 static int num_particles;
@@ -93,6 +98,7 @@ static dbl *static_resid_vector;
 static dbl my_volume;
 static dbl *el_volume;
 static FILE **pa_fp;
+static goma_ptrj_writer **pa_bin;
 static FILE *pa_full_fp;
 
 static int pdim; /* particle dimension (coordinate, velocities, etc.) */
@@ -114,6 +120,10 @@ static void get_boundary_xi_newton(const dbl *const, const int, dbl *, const int
 
 static particle_t *obtain_particle_space(const int);
 
+static particle_t *particle_pool_get(void);
+
+static void particle_pool_put(particle_t *);
+
 static particle_t *create_a_particle(particle_t *, const int);
 
 static int rejection_sample_a_particle(void);
@@ -148,6 +158,9 @@ static dbl get_element_minimum_side_length(const int);
 
 static void output_TECPLOT_zone_info(const dbl, const int, const int);
 
+static void
+output_sample_row(const int, const dbl *, const dbl, const dbl *, const int);
+
 static void
 output_a_particle(particle_t *const, const dbl, const dbl, const int, const int, const int);
 
@@ -177,6 +190,10 @@ static void add_to_send_list(particle_t *);
 
 static void add_to_do_list(particle_t *);
 
+#ifdef PARALLEL
+static int exchange_migrating_particles(void);
+#endif
+
 static void couple_to_continuum(void);
 
 static void load_restart_file(void);
@@ -308,7 +325,33 @@ void initialize_particles(const Exo_DB *exo,
   } else
     pa_full_fp = NULL;
 
-  if (Particle_Number_Sample_Types) {
+  pa_bin = NULL;
+  if (Particle_Number_Sample_Types && Particle_Output_Format == BINARY) {
+    /* Columnar, chunked samples; see util/particle_trajectory.h.  The
+     * particle2tec tool turns these back into the TECPLOT text. */
+    const char *var_names[MAX_DATA_REAL_VALUES];
+    pa_fp = NULL;
+    pa_bin = (goma_ptrj_writer **)array_alloc(1, Particle_Number_Sample_Types,
+                                              sizeof(goma_ptrj_writer *));
+    for (i = 0; i < Particle_Number_Sample_Types; i++) {
+      if (Particle_Number_Output_Variables[i] > MAX_DATA_REAL_VALUES)
+        GOMA_EH(GOMA_ERROR, "Too many particle output variables, increase MAX_DATA_REAL_VALUES.");
+      for (j = 0; j < Particle_Number_Output_Variables[i]; j++)
+        var_names[j] = Particle_Output_Variables[i][j];
+#ifdef PARALLEL
+      pa_bin[i] = goma_ptrj_open(construct_filename(Particle_Filename_Template[i]), pdim,
+                                 Particle_Number_Output_Variables[i], var_names, 1, 0);
+#else
+      pa_bin[i] = goma_ptrj_open(construct_filename(Particle_Filename_Template[i]), pdim,
+                                 Particle_Number_Output_Variables[i], var_names, 0, 0);
+#endif
+      if (!pa_bin[i])
+        GOMA_EH(GOMA_ERROR, "Could not open a binary particle file for zeroing.");
+      DPRINTF(stdout, "%s, ", Particle_Filename_Template[i]);
+      fflush(stdout);
+      Particle_Number_Samples_Existing[i] = 0;
+    }
+  } else if (Particle_Number_Sample_Types) {
     pa_fp = (FILE **)array_alloc(1, Particle_Number_Sample_Types, sizeof(FILE *));
     for (i = 0; i < Particle_Number_Sample_Types; i++) {
       if (!(pa_fp[i] = fopen(construct_filename(Particle_Filename_Template[i]), "w")))
@@ -336,7 +379,8 @@ void initialize_particles(const Exo_DB *exo,
     }
   } else
     pa_fp = NULL;
-  if (Particle_Output_Format == TECPLOT && Particle_Number > 0)
+  if ((Particle_Output_Format == TECPLOT || Particle_Output_Format == BINARY) &&
+      Particle_Number > 0)
     output_TECPLOT_zone_info(0.0, 0, 1);
   get_time(time_of_day);
   DPRINTF(stdout, "done at %s\n", time_of_day);
@@ -1289,14 +1333,11 @@ int compute_particles(const Exo_DB *exo,         /* mesh */
   particle_t *p, *p_tmp;
   int i, el_index;
 #ifdef PARALLEL
-  int mpi_byte_count, mpi_retval;
-  particle_t termination_p, send_p, recv_p;
-  int j, done, local_max_particle_iterations, local_max_newton_iterations;
+  int done, local_max_particle_iterations, local_max_newton_iterations;
   int local_num_particles, local_particle_transfers, particle_transfers;
   dbl local_total_accum_ust, local_particle_accum_ust, local_output_accum_ust,
       local_communication_accum_ust;
   int local_num_to_send, num_to_send;
-  MPI_Status mpi_status;
 #endif
 
   total_accum_ust = 0.0;
@@ -1319,7 +1360,7 @@ int compute_particles(const Exo_DB *exo,         /* mesh */
   static_xdot_old = xdot_old;
   static_resid_vector = resid_vector;
 
-  if (Particle_Output_Format == TECPLOT)
+  if (Particle_Output_Format == TECPLOT || Particle_Output_Format == BINARY)
     output_TECPLOT_zone_info(global_end_time, n, 0);
   output_accum_ust = MAX(ust() - start_ust, 0.0);
 
@@ -1391,7 +1432,7 @@ int compute_particles(const Exo_DB *exo,         /* mesh */
       {
         num_particles--;
         remove_from_element_particle_list(p, el_index);
-        free(p); /* Bye bye */
+        particle_pool_put(p); /* Bye bye */
         fprintf(stderr, "REMOVING A PARTICLE\n");
       } else if (p->state == ACTIVE &&
                  el_index != p->owning_elem_id) /* I moved elements on the same processor. */
@@ -1437,94 +1478,10 @@ int compute_particles(const Exo_DB *exo,         /* mesh */
     else
       done = 0;
 
-    zero_a_particle(&termination_p);
-    termination_p.state = TERMINATION_MARKER;
     while (!done) {
-      /* This next loop does a full all processor to all processor
-       * exchange of particles.  This is done before any other moves are
-       * completed. */
-      for (i = 0; i < Num_Proc; i++) {
-        if (i == ProcID) /* I'm the sender! */
-        {
-          p = particles_to_send;
-          particles_to_send = NULL;
-          while (p) {
-            p_tmp = p->next;
-            /*
-              fprintf(stderr, "Proc %d is sending a particle to proc %d\n", i, p->owning_proc_id);
-              fflush(stderr);
-            */
-            memcpy(&send_p, p, sizeof(particle_t));
-            mpi_retval = MPI_Send(&send_p, sizeof(particle_t), MPI_BYTE, p->owning_proc_id, 0,
-                                  MPI_COMM_WORLD);
-            if (mpi_retval != MPI_SUCCESS) {
-              fprintf(stderr, "Proc %d failed on particle send (%d).\n", ProcID, mpi_retval);
-              exit(-1);
-            }
-            free(p);
-            p = p_tmp;
-          }
-          for (j = 0; j < Num_Proc; j++)
-            if (i == j)
-              continue;
-            else {
-              /*
-                fprintf(stderr, "Proc %d is sending the TERMINATION_MARKER to proc %d\n", i, j);
-                fflush(stderr);
-              */
-              mpi_retval =
-                  MPI_Send(&termination_p, sizeof(particle_t), MPI_BYTE, j, 0, MPI_COMM_WORLD);
-              if (mpi_retval != MPI_SUCCESS) {
-                fprintf(stderr, "Proc %d failed on TERMINATION_MARKER send (%d).\n", ProcID,
-                        mpi_retval);
-                exit(-1);
-              }
-            }
-        } else {
-          recv_p.state = ACTIVE;
-          while (recv_p.state != TERMINATION_MARKER) {
-            mpi_retval =
-                MPI_Recv(&recv_p, sizeof(particle_t), MPI_BYTE, i, 0, MPI_COMM_WORLD, &mpi_status);
-            if (mpi_retval != MPI_SUCCESS) {
-              fprintf(stderr, "Proc %d failed on particle receive (%d).\n", ProcID, mpi_retval);
-              exit(-1);
-            }
-            MPI_Get_count(&mpi_status, MPI_BYTE, &mpi_byte_count);
-
-            /*
-              fprintf(stderr, "Proc %d received a particle from proc %d with state = %d\n
-              MPI_SOURCE/TAG/ERROR = %d/%d/%d, MPI_Count = %d.\n", ProcID, i, recv_p.state,
-              mpi_status.MPI_SOURCE, mpi_status.MPI_TAG, mpi_status.MPI_ERROR, mpi_byte_count);
-              fflush(stderr);
-            */
-            if (mpi_byte_count != sizeof(particle_t)) {
-              fprintf(stderr, "Proc %d did not have proper incoming byte count!\n", ProcID);
-              fflush(stderr);
-              MPI_Finalize();
-              exit(-1);
-            }
-
-            if (recv_p.state != TERMINATION_MARKER) {
-              add_to_do_list(&recv_p);
-              /*
-                fprintf(stderr, "Proc %d is adding a particle to its to do list.\n", ProcID);
-                fflush(stderr);
-              */
-              /*
-                dump(NO_EXIT, &termination_p, "Rcvd by proc %d.\n", ProcID);
-              */
-            }
-          }
-        }
-        mpi_retval = MPI_Barrier(MPI_COMM_WORLD);
-        /*
-          fprintf(stderr, "Proc %d BARRIER\n", ProcID);
-        */
-        if (mpi_retval != MPI_SUCCESS) {
-          fprintf(stderr, "Proc %d failed on MPI_BARRIER (%d).\n", ProcID, mpi_retval);
-          exit(-1);
-        }
-      }
+      /* Every processor ships its outgoing particles in one
+       * collective exchange before any other moves are completed. */
+      exchange_migrating_particles();
 
       /* Now we move the new particles. */
       local_num_to_send = 0;
@@ -1582,10 +1539,10 @@ int compute_particles(const Exo_DB *exo,         /* mesh */
           add_to_send_list(p);
           local_num_to_send++;
         } else if (p->state == DEAD) /* Delete me */
-          free(p);                   /* Bye bye */
+          particle_pool_put(p);      /* Bye bye */
         else {
           create_a_particle(p, p->owning_elem_id); /* This num_particles++ already */
-          free(p);
+          particle_pool_put(p);
         }
 
         p = p_tmp;
@@ -1659,13 +1616,39 @@ int compute_particles(const Exo_DB *exo,         /* mesh */
   DPRINTF(stderr, "                    Total time = %g seconds\n", total_accum_ust);
 
   for (i = 0; i < Particle_Number_Sample_Types; i++)
-    fflush(pa_fp[i]);
+    if (pa_bin) {
+      if (goma_ptrj_flush(pa_bin[i]))
+        GOMA_EH(GOMA_ERROR, "Could not write binary particle samples.");
+    } else
+      fflush(pa_fp[i]);
   if (Particle_Full_Output_Stride)
     fflush(pa_full_fp);
 
   return 0;
 }
 
+/* Close the particle sample and full output files opened by
+ * initialize_particles(), writing out any buffered binary samples. */
+void close_particle_output(void) {
+  int i;
+
+  if (pa_bin) {
+    for (i = 0; i < Particle_Number_Sample_Types; i++)
+      if (goma_ptrj_close(pa_bin[i]))
+        GOMA_EH(GOMA_ERROR, "Could not write binary particle samples.");
+    safer_free((void **)&pa_bin);
+  }
+  if (pa_fp) {
+    for (i = 0; i < Particle_Number_Sample_Types; i++)
+      fclose(pa_fp[i]);
+    safer_free((void **)&pa_fp);
+  }
+  if (pa_full_fp) {
+    fclose(pa_full_fp);
+    pa_full_fp = NULL;
+  }
+}
+
 /* Fill the element_volume array with the volumes of each elements.
  * This can be called repeatedly (as in it doesn't allocate anything
  * internally).
@@ -1982,21 +1965,14 @@ static void get_boundary_xi_newton(const dbl *const coeff,
  */
 static particle_t *obtain_particle_space(const int elem_id) {
   particle_t *p;
-  char s[128];
 
   if (!element_particle_list_head[elem_id]) {
-    element_particle_list_head[elem_id] = (particle_t *)malloc(sizeof(particle_t));
-    if (!element_particle_list_head[elem_id]) {
-      sprintf(s, "Could not allocate %ld bytes of space for particle.\n", sizeof(particle_t));
-      GOMA_EH(GOMA_ERROR, s);
-    }
+    element_particle_list_head[elem_id] = particle_pool_get();
     p = element_particle_list_head[elem_id];
     p->last = NULL;
     p->next = NULL;
   } else {
-    p = (particle_t *)malloc(sizeof(particle_t));
-    if (!p)
-      GOMA_EH(GOMA_ERROR, "Could not allocate space for particle.");
+    p = particle_pool_get();
     p->next = element_particle_list_head[elem_id];
     p->last = NULL;
     element_particle_list_head[elem_id]->last = p;
@@ -2007,6 +1983,83 @@ static particle_t *obtain_particle_space(const int elem_id) {
   return p;
 }
 
+/* Particles are carved out of large chunks instead of being
+ * malloc()'ed one at a time.  With millions of particles the
+ * individual malloc()/free() pairs for every creation, transfer and
+ * deletion dominated the bookkeeping, and the resulting particles
+ * were scattered all over the heap.  Returned particles go onto a
+ * free list (threaded through p->next) and are reused first.  The
+ * chunks are only released, all at once, by free_particles(). */
+#define PARTICLE_POOL_CHUNK 4096
+
+static particle_t *particle_pool_get(void) {
+  particle_t *p, *chunk;
+  int i;
+  char s[128];
+
+  if (!particle_free_list) {
+    chunk = (particle_t *)malloc(PARTICLE_POOL_CHUNK * sizeof(particle_t));
+    if (!chunk) {
+      sprintf(s, "Could not allocate %ld bytes of space for particles.\n",
+              (long)(PARTICLE_POOL_CHUNK * sizeof(particle_t)));
+      GOMA_EH(GOMA_ERROR, s);
+    }
+    particle_pool_chunks = (particle_t **)realloc(
+        particle_pool_chunks, (num_particle_pool_chunks + 1) * sizeof(particle_t *));
+    if (!particle_pool_chunks)
+      GOMA_EH(GOMA_ERROR, "Could not allocate space for particle pool.");
+    particle_pool_chunks[num_particle_pool_chunks++] = chunk;
+    goma_mem_track_bytes(GOMA_MEM_PARTICLES, (long long)(PARTICLE_POOL_CHUNK * sizeof(particle_t)));
+
+    /* Thread the chunk in address order so consecutive gets are
+     * contiguous in memory. */
+    for (i = 0; i < PARTICLE_POOL_CHUNK - 1; i++)
+      chunk[i].next = &chunk[i + 1];
+    chunk[PARTICLE_POOL_CHUNK - 1].next = NULL;
+    particle_free_list = chunk;
+  }
+
+  p = particle_free_list;
+  particle_free_list = p->next;
+  p->next = NULL;
+  p->last = NULL;
+  return p;
+}
+
+/* Return a particle to the pool.  The caller must already have
+ * unhooked it from whatever list it was on. */
+static void particle_pool_put(particle_t *p) {
+  p->last = NULL;
+  p->next = particle_free_list;
+  particle_free_list = p;
+}
+
+/* Release the particle pool at the end of the run.  Every particle
+ * lives in a pool chunk, so the per-element lists and the transfer
+ * lists are emptied along with it. */
+void free_particles(void) {
+  int i;
+
+  for (i = 0; i < num_particle_pool_chunks; i++)
+    free(particle_pool_chunks[i]);
+  goma_mem_track_bytes(GOMA_MEM_PARTICLES,
+                       -(long long)num_particle_pool_chunks * PARTICLE_POOL_CHUNK *
+                           (long long)sizeof(particle_t));
+  safer_free((void **)&particle_pool_chunks);
+  num_particle_pool_chunks = 0;
+  particle_free_list = NULL;
+
+  if (element_particle_list_head) {
+    for (i = 0; i < static_exo->num_elems; i++) {
+      element_particle_list_head[i] = NULL;
+      backup_element_particle_list_head[i] = NULL;
+    }
+  }
+  particles_to_do = NULL;
+  particles_to_send = NULL;
+  num_particles = 0;
+}
+
 /* This routine creates a particle.  It seeds this new particle with
  * the passed one.  It returns the new particle.
  *
@@ -3095,8 +3148,38 @@ output_TECPLOT_zone_info(const dbl end_time, const int goma_time_step, const int
   if ((TimeIntegration == TRANSIENT && Particle_Output_Stride > 0 &&
        (!((goma_time_step + 1) % Particle_Output_Stride))) ||
       (TimeIntegration == STEADY && Particle_Output_Time_Step > 0.0))
-    for (i = 0; i < Particle_Number_Sample_Types; i++)
-      fprintf(pa_fp[i], "ZONE T=\"%g\"\n", end_time);
+    for (i = 0; i < Particle_Number_Sample_Types; i++) {
+      if (pa_bin) {
+        if (goma_ptrj_zone(pa_bin[i], end_time))
+          GOMA_EH(GOMA_ERROR, "Could not write binary particle zone.");
+      } else
+        fprintf(pa_fp[i], "ZONE T=\"%g\"\n", end_time);
+    }
+}
+
+/* Write one sample row to the sample type's output file, either
+ * appended to the binary chunk buffer or as a line of text. */
+static void output_sample_row(
+    const int output_sample_number, const dbl *x, const dbl time, const dbl *vars, const int proc) {
+  int i;
+  FILE *fp;
+
+  if (pa_bin) {
+    if (goma_ptrj_append(pa_bin[output_sample_number], x, time, vars, proc))
+      GOMA_EH(GOMA_ERROR, "Could not write binary particle samples.");
+    return;
+  }
+
+  fp = pa_fp[output_sample_number];
+  for (i = 0; i < pdim; i++)
+    fprintf(fp, " %12g", x[i]);
+  fprintf(fp, " %12g", time);
+  for (i = 0; i < Particle_Number_Output_Variables[output_sample_number]; i++)
+    fprintf(fp, " %12g", vars[i]);
+#ifdef PARALLEL
+  fprintf(fp, " %d", proc);
+#endif
+  fprintf(fp, "\n");
 }
 
 /* This routine handles quite a lot.  There are two basic kinds of
@@ -3125,22 +3208,32 @@ static void output_a_particle(particle_t *const p,
   int output_n, start_n, end_n;
   int strided_output, last_goma_step;
   dbl time_fraction, output_time;
-  dbl x_time[DIM], real_data_time;
+  dbl x_time[DIM], real_data_time[MAX_DATA_REAL_VALUES];
+#ifdef PARALLEL
+  const int sample_proc_id = p->owning_proc_id;
+#else
+  const int sample_proc_id = 0;
+#endif
 
   /* The nice thing about strided output is that there is no
    * linearization by time fractions required... */
   if (Particle_Output_Stride > 0) {
     if ((!((goma_time_step + 1) % Particle_Output_Stride) || force_output) && last_step) {
       if ((output_sample_number = p->output_sample_number) != -1) {
-        for (i = 0; i < pdim; i++)
-          fprintf(pa_fp[output_sample_number], " %12g ", p->x_old[i]);
-        fprintf(pa_fp[output_sample_number], " %12g", particle_time);
-        for (i = 0; i < Particle_Number_Output_Variables[output_sample_number]; i++)
-          fprintf(pa_fp[output_sample_number], " %12g", p->real_data[i]);
+        if (pa_bin) {
+          output_sample_row(output_sample_number, p->x_old, particle_time, p->real_data,
+                            sample_proc_id);
+        } else {
+          for (i = 0; i < pdim; i++)
+            fprintf(pa_fp[output_sample_number], " %12g ", p->x_old[i]);
+          fprintf(pa_fp[output_sample_number], " %12g", particle_time);
+          for (i = 0; i < Particle_Number_Output_Variables[output_sample_number]; i++)
+            fprintf(pa_fp[output_sample_number], " %12g", p->real_data[i]);
 #ifdef PARALLEL
-        fprintf(pa_fp[output_sample_number], " %d", p->owning_proc_id);
+          fprintf(pa_fp[output_sample_number], " %d", p->owning_proc_id);
 #endif
-        fprintf(pa_fp[output_sample_number], "\n");
+          fprintf(pa_fp[output_sample_number], "\n");
+        }
       }
     }
   } else if ((output_sample_number = p->output_sample_number) != -1 || force_output) {
@@ -3163,18 +3256,11 @@ static void output_a_particle(particle_t *const p,
       for (i = 0; i < pdim; i++)
         x_time[i] = (1.0 - time_fraction) * p->x_old[i] + time_fraction * p->x[i];
       if (output_sample_number != -1) {
-        for (i = 0; i < pdim; i++)
-          fprintf(pa_fp[output_sample_number], " %12g", x_time[i]);
-        fprintf(pa_fp[output_sample_number], " %12g", output_time);
-        for (i = 0; i < Particle_Number_Output_Variables[output_sample_number]; i++) {
-          real_data_time =
+        for (i = 0; i < Particle_Number_Output_Variables[output_sample_number]; i++)
+          real_data_time[i] =
               (1.0 - time_fraction) * p->real_data_old[i] + time_fraction * p->real_data[i];
-          fprintf(pa_fp[output_sample_number], " %12g", real_data_time);
-        }
-#ifdef PARALLEL
-        fprintf(pa_fp[output_sample_number], " %d", p->owning_proc_id);
-#endif
-        fprintf(pa_fp[output_sample_number], "\n");
+        output_sample_row(output_sample_number, x_time, output_time, real_data_time,
+                          sample_proc_id);
       }
     }
   }
@@ -4682,17 +4768,13 @@ static void add_to_do_list(particle_t *p) {
   particle_t *p_recv;
 
   if (!particles_to_do) {
-    particles_to_do = (particle_t *)malloc(sizeof(particle_t));
-    if (!particles_to_do)
-      GOMA_EH(GOMA_ERROR, "Could not malloc particle space.");
+    particles_to_do = particle_pool_get();
     p_recv = particles_to_do;
     memcpy(p_recv, p, sizeof(particle_t));
     p_recv->last = NULL;
     p_recv->next = NULL;
   } else {
-    p_recv = (particle_t *)malloc(sizeof(particle_t));
-    if (!p_recv)
-      GOMA_EH(GOMA_ERROR, "Could not malloc particle space.");
+    p_recv = particle_pool_get();
     memcpy(p_recv, p, sizeof(particle_t));
     particles_to_do->last = p_recv;
     p_recv->next = particles_to_do;
@@ -4702,6 +4784,93 @@ static void add_to_do_list(particle_t *p) {
   p_recv->state = ACTIVE;
 }
 
+#ifdef PARALLEL
+/* This routine sends every particle on the particles_to_send list to
+ * its owning processor and puts the particles it receives on the
+ * particles_to_do list.  The outgoing particles are packed into one
+ * contiguous buffer sorted by destination, so the whole exchange is a
+ * single MPI_Alltoall of the counts and a single MPI_Alltoallv of the
+ * particles, instead of a round robin of per-particle sends and
+ * termination markers with a barrier per processor.  Returns the
+ * number of particles received. */
+static int exchange_migrating_particles(void) {
+  int i, dest, num_send, num_recv;
+  int *send_count, *recv_count, *send_displ, *recv_displ, *packed;
+  particle_t *p, *p_tmp, *send_buf, *recv_buf;
+  MPI_Datatype mpi_particle;
+  dbl temp_ust;
+
+  send_count = (int *)calloc((unsigned)Num_Proc, sizeof(int));
+  recv_count = (int *)calloc((unsigned)Num_Proc, sizeof(int));
+  send_displ = (int *)calloc((unsigned)Num_Proc, sizeof(int));
+  recv_displ = (int *)calloc((unsigned)Num_Proc, sizeof(int));
+  packed = (int *)calloc((unsigned)Num_Proc, sizeof(int));
+  if (!send_count || !recv_count || !send_displ || !recv_displ || !packed)
+    GOMA_EH(GOMA_ERROR, "Could not allocate particle exchange counts.");
+
+  num_send = 0;
+  for (p = particles_to_send; p; p = p->next) {
+    dest = p->owning_proc_id;
+    if (dest < 0 || dest >= Num_Proc || dest == ProcID)
+      dump2(EXIT, p, "Particle transfer to invalid processor %d.", dest);
+    send_count[dest]++;
+    num_send++;
+  }
+
+  temp_ust = ust();
+  MPI_Alltoall(send_count, 1, MPI_INT, recv_count, 1, MPI_INT, MPI_COMM_WORLD);
+  communication_accum_ust += MAX(ust() - temp_ust, 0.0);
+
+  num_recv = 0;
+  for (i = 0; i < Num_Proc; i++) {
+    send_displ[i] = (i == 0) ? 0 : send_displ[i - 1] + send_count[i - 1];
+    recv_displ[i] = num_recv;
+    num_recv += recv_count[i];
+  }
+
+  send_buf = (particle_t *)malloc((num_send ? num_send : 1) * sizeof(particle_t));
+  recv_buf = (particle_t *)malloc((num_recv ? num_recv : 1) * sizeof(particle_t));
+  if (!send_buf || !recv_buf)
+    GOMA_EH(GOMA_ERROR, "Could not allocate particle exchange buffers.");
+
+  /* Pack by destination and hand the list entries back to the pool. */
+  p = particles_to_send;
+  particles_to_send = NULL;
+  while (p) {
+    p_tmp = p->next;
+    dest = p->owning_proc_id;
+    memcpy(&send_buf[send_displ[dest] + packed[dest]], p, sizeof(particle_t));
+    packed[dest]++;
+    particle_pool_put(p);
+    p = p_tmp;
+  }
+
+  /* Counts are in particles, not bytes, so large transfers don't
+   * overflow the int arguments. */
+  MPI_Type_contiguous((int)sizeof(particle_t), MPI_BYTE, &mpi_particle);
+  MPI_Type_commit(&mpi_particle);
+  temp_ust = ust();
+  if (MPI_Alltoallv(send_buf, send_count, send_displ, mpi_particle, recv_buf, recv_count,
+                    recv_displ, mpi_particle, MPI_COMM_WORLD) != MPI_SUCCESS)
+    GOMA_EH(GOMA_ERROR, "Particle exchange failed in MPI_Alltoallv().");
+  communication_accum_ust += MAX(ust() - temp_ust, 0.0);
+  MPI_Type_free(&mpi_particle);
+
+  for (i = 0; i < num_recv; i++)
+    add_to_do_list(&recv_buf[i]);
+
+  free(send_buf);
+  free(recv_buf);
+  free(send_count);
+  free(recv_count);
+  free(send_displ);
+  free(recv_displ);
+  free(packed);
+
+  return num_recv;
+}
+#endif
+
 /* This routine handles whatever needs to be saved off, etc., to
  * influence the continuum solution with repsect to the particles'
  * presence.  It assumes that all particles contribute (irresepective
@@ -4875,7 +5044,7 @@ static void couple_to_continuum(void) {
         p_tmp = p->next;
         if (p->state == GHOST) {
           remove_from_element_particle_list(p, i);
-          free(p);
+          particle_pool_put(p);
         }
         p = p_tmp;
       }
@@ -5009,3 +5178,70 @@ static void load_restart_file(void) {
     output_a_particle(p_ptr, 0.0, 0.0, 0, 1, 1);
   }
 }
+
+/* Checkpoint support (see rf_checkpoint.c).  The particles this
+ * processor holds are written verbatim together with the drand48()
+ * state, so a restarted run moves and creates exactly the same
+ * particles as the uninterrupted one.  Each element list is written
+ * tail first because create_a_particle() prepends, which keeps the
+ * list order (and so the order random numbers are drawn in). */
+int write_particle_checkpoint(goma_ckpt_buffer *b) {
+  unsigned short state[3] = {0, 0, 0}, *old_state;
+  particle_t *p, *tail;
+  int el_index, count = 0, err = 0;
+
+  /* seed48() is the only way to look at the state; put it right back. */
+  old_state = seed48(state);
+  memcpy(state, old_state, sizeof(state));
+  seed48(state);
+  err |= goma_ckpt_put(b, state, sizeof(state));
+  err |= goma_ckpt_put_int(b, num_particles);
+
+  for (el_index = 0; el_index < static_exo->num_elems; el_index++)
+    for (p = element_particle_list_head[el_index]; p; p = p->next)
+      count++;
+  err |= goma_ckpt_put_int(b, count);
+
+  for (el_index = 0; el_index < static_exo->num_elems; el_index++) {
+    tail = element_particle_list_head[el_index];
+    if (!tail)
+      continue;
+    while (tail->next)
+      tail = tail->next;
+    for (p = tail; p; p = p->last)
+      err |= goma_ckpt_put(b, p, sizeof(particle_t));
+  }
+  return err ? -1 : 0;
+}
+
+/* Replace the particles created by initialize_particles() with the
+ * checkpointed ones. */
+int read_particle_checkpoint(goma_ckpt_buffer *b) {
+  unsigned short state[3];
+  particle_t p, *p_next, *p_ptr;
+  int el_index, i, count, saved_num_particles;
+
+  for (el_index = 0; el_index < static_exo->num_elems; el_index++) {
+    for (p_ptr = element_particle_list_head[el_index]; p_ptr; p_ptr = p_next) {
+      p_next = p_ptr->next;
+      particle_pool_put(p_ptr);
+    }
+    element_particle_list_head[el_index] = NULL;
+  }
+  num_particles = 0;
+
+  if (goma_ckpt_get(b, state, sizeof(state)) || goma_ckpt_get_int(b, &saved_num_particles) ||
+      goma_ckpt_get_int(b, &count))
+    return -1;
+  seed48(state);
+
+  for (i = 0; i < count; i++) {
+    if (goma_ckpt_get(b, &p, sizeof(particle_t)))
+      return -1;
+    if (p.owning_elem_id < 0 || p.owning_elem_id >= static_exo->num_elems)
+      return -1;
+    create_a_particle(&p, p.owning_elem_id);
+  }
+  num_particles = saved_num_particles;
+  return 0;
+}
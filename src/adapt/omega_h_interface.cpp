@@ -29,11 +29,15 @@
 #include <Omega_h_mesh.hpp>
 #include <Omega_h_metric.hpp>
 #include <Omega_h_profile.hpp>
+#include <Omega_h_recover.hpp>
+#include <Omega_h_shape.hpp>
 #include <Omega_h_vector.hpp>
 #include <algorithm>
 #include <assert.h>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mpi.h>
@@ -48,6 +52,7 @@
 #include "Omega_h_align.hpp"
 #include "Omega_h_array_ops.hpp"
 #include "Omega_h_build.hpp"
+#include "Omega_h_dist.hpp"
 #include "Omega_h_element.hpp"
 #include "Omega_h_for.hpp"
 #include "Omega_h_map.hpp"
@@ -72,6 +77,7 @@ extern "C" {
 #include "rf_bc.h"
 #include "rf_bc_const.h"
 #include "rf_fem_const.h"
+#include "rf_fem.h"
 #include "rf_fill_const.h"
 #include "rf_io.h"
 #include "rf_io_const.h"
@@ -82,8 +88,12 @@ extern "C" {
 #include "sl_util_structs.h"
 #undef IGNORE_CPP_DEFINE
 #include "adapt/resetup_problem.h"
+#include "base_mesh.h"
 #include "el_elm.h"
 #include "el_elm_info.h"
+#include "mm_elem_block_structs.h"
+#include "mm_fill_fill.h"
+#include "mm_mp.h"
 #include "mm_unknown_map.h"
 #include "rd_dpi.h"
 #include "rd_exo.h"
@@ -108,7 +118,23 @@ extern Comm_Ex **cx;
 
 // #define DEBUG_OMEGA_H
 
-static bool power_of_two(int num) { return (num & (num - 1)) == 0; }
+static const Omega_h::Real adapt_max_length_desired = 1.8;
+
+// Target metric for this adaptation, resolving the default from the
+// adaptivity that is turned on
+static int adapt_metric_type() {
+  int metric = tran->adapt_metric;
+  if (metric == ADAPT_METRIC_DEFAULT) {
+    metric = (ls != NULL && ls->adapt) ? ADAPT_METRIC_LEVEL_SET : ADAPT_METRIC_ISO;
+  }
+  if (metric == ADAPT_METRIC_ISO && !tran->ale_adapt) {
+    GOMA_EH(GOMA_ERROR, "Adapt Metric = ISO requires ALE Adapt = yes");
+  }
+  if (metric == ADAPT_METRIC_LEVEL_SET && (ls == NULL || !ls->adapt)) {
+    GOMA_EH(GOMA_ERROR, "Adapt Metric = LEVEL_SET requires Level Set Adaptive Mesh = yes");
+  }
+  return metric;
+}
 
 namespace goma {
 
@@ -270,7 +296,7 @@ void convert_goma_to_omega_h(Exo_DB *exo, Dpi *dpi, double **x, Mesh *mesh, bool
   mesh->add_coords(coords);
   Write<LO> elem_class_ids_w(LO(owned_elems.size()));
   for (size_t i = 0; i < owned_elems.size(); i++) {
-    elem_class_ids_w[i] = 1;
+    elem_class_ids_w[i] = exo->eb_id[find_elemblock_index(owned_elems[i], exo)];
   }
   std::map<LO, LO> exo_to_global;
   for (int node = 0; node < mesh->globals(0).size(); node++) {
@@ -310,7 +336,7 @@ void convert_goma_to_omega_h(Exo_DB *exo, Dpi *dpi, double **x, Mesh *mesh, bool
         }
         mesh->add_tag(Omega_h::VERT, Exo_Var_Names[j].name2, 1, Omega_h::Reals(var_values));
 
-        if (tran->ale_adapt && j == R_MESH1 && ((ls == NULL) || (!ls->adapt))) {
+        if (adapt_metric_type() == ADAPT_METRIC_ISO && j == R_MESH1) {
           auto target_metrics =
               Omega_h::Write<Omega_h::Real>(mesh->nverts() * Omega_h::symm_ncomps(mesh->dim()));
           auto f0 = OMEGA_H_LAMBDA(Omega_h::LO index) {
@@ -330,7 +356,7 @@ void convert_goma_to_omega_h(Exo_DB *exo, Dpi *dpi, double **x, Mesh *mesh, bool
           Omega_h::parallel_for(mesh->nverts(), f0, "set_iso_metric_values");
           mesh->add_tag(Omega_h::VERT, "iso_size_metric", Omega_h::symm_ncomps(mesh->dim()),
                         Omega_h::Reals(target_metrics));
-        } else if (ls != NULL && ls->adapt && (j == FILL)) {
+        } else if (adapt_metric_type() == ADAPT_METRIC_LEVEL_SET && (j == FILL)) {
           auto target_metrics =
               Omega_h::Write<Omega_h::Real>(mesh->nverts() * Omega_h::symm_ncomps(mesh->dim()));
           auto f0 = OMEGA_H_LAMBDA(Omega_h::LO index) {
@@ -584,34 +610,31 @@ void convert_goma_to_omega_h(Exo_DB *exo, Dpi *dpi, double **x, Mesh *mesh, bool
   finalize_classification(mesh);
 }
 
+/* The single "ID" property every Exodus block and set carries. */
+static void id_property(int num, const int *ids, char ***prop_name, int ***prop) {
+  *prop_name = (char **)malloc(sizeof(char *));
+  (*prop_name)[0] = (char *)calloc(MAX_STR_LENGTH, sizeof(char));
+  strcpy((*prop_name)[0], "ID");
+  *prop = (int **)malloc(sizeof(int *));
+  (*prop)[0] = alloc_int_1(num, 0);
+  std::copy(ids, ids + num, (*prop)[0]);
+}
+
 void convert_omega_h_to_goma(
     const char *path, Mesh *mesh, Exo_DB *exo, Dpi *dpi, bool verbose, int classify_with) {
 
-  //  Omega_h::exodus::write(std::to_string(ProcID) + "", mesh, true, classify_with);
-  char out_par[MAX_FNL];
-  strncpy(out_par, "tmp_omega_h_mesh.e", MAX_FNL - 1);
-  multiname(out_par, ProcID, Num_Proc);
   mesh->set_parting(OMEGA_H_ELEM_BASED);
-  auto comp_ws = int(sizeof(Real));
-  auto io_ws = comp_ws;
-  auto exoid = ex_create(out_par, EX_CLOBBER, &comp_ws, &io_ws);
   std::set<LO> region_set;
   auto dim = mesh->dim();
   auto title = "Omega_h " OMEGA_H_SEMVER " Exodus Output";
 
   auto class_sets = mesh->class_sets;
   // TODO multiblock
+  // node sets are the nodes of the surface sets, with the same ids
   std::set<LO> surface_set;
-  std::set<LO> node_set;
   for (auto &it : class_sets) {
-    auto key = it.first;
-    auto value = it.second;
-    for (size_t i = 0; i < value.size(); i++) {
-      if (static_cast<int>(i) < dpi->num_side_sets_global) {
-        surface_set.insert(value[i].id);
-      } else {
-        node_set.insert(value[i].id);
-      }
+    for (auto &cp : it.second) {
+      surface_set.insert(cp.id);
     }
   }
   std::vector<LO> surface_set_vec(surface_set.begin(), surface_set.end());
@@ -624,9 +647,8 @@ void convert_omega_h_to_goma(
   auto side_class_dims = mesh->get_array<I8>(dim - 1, "class_dim");
   auto h_side_class_ids = HostRead<LO>(side_class_ids);
   auto h_side_class_dims = HostRead<I8>(side_class_dims);
-  auto nelem_blocks = int(region_set.size());
   auto nside_sets = (classify_with & exodus::SIDE_SETS) ? int(surface_set_vec.size()) : 0;
-  auto nnode_sets = (classify_with & exodus::NODE_SETS) ? int(node_set.size()) : 0;
+  auto nnode_sets = (classify_with & exodus::NODE_SETS) ? int(surface_set_vec.size()) : 0;
 
   auto all_conn = mesh->ask_elem_verts();
   auto deg = element_degree(mesh->family(), dim, VERT);
@@ -823,161 +845,69 @@ void convert_omega_h_to_goma(
     }
   }
 
-  ex_put_init(exoid, title, dim, global_node.size(), global_elem.size(), nelem_blocks, nnode_sets,
-              nside_sets);
-
-  Few<Write<Real>, 3> coord_blk;
-  for (Int i = 0; i < dim; ++i)
-    coord_blk[i] = Write<Real>(new_nodes_v.size());
+  // Host copies of everything the new Goma mesh database needs; they are
+  // gathered before the old database is freed below.
+  int num_new_nodes = int(new_nodes_v.size());
+  int num_new_elems = int(global_elem.size());
+  std::vector<dbl> new_coords(dim * num_new_nodes);
   auto coords = mesh->coords();
-  for (size_t i = 0; i < new_nodes_v.size(); i++) {
+  for (int i = 0; i < num_new_nodes; i++) {
     auto local_node = new_nodes_v[i];
     for (Int j = 0; j < dim; ++j) {
-      coord_blk[j][i] = coords[local_node * dim + j];
+      new_coords[j * num_new_nodes + i] = coords[local_node * dim + j];
     }
   }
-  HostRead<Real> h_coord_blk[3];
-  for (Int i = 0; i < dim; ++i)
-    h_coord_blk[i] = HostRead<Real>(coord_blk[i]);
-  CALL(ex_put_coord(exoid, h_coord_blk[0].data(), h_coord_blk[1].data(), h_coord_blk[2].data()));
-  auto elems2file_idx = Write<LO>(mesh->nelems());
-  auto elem_file_offset = LO(0);
 
-  // TODO
+  // TODO multiblock
   assert(region_set.size() == 1);
-
-  for (auto block_id : region_set) {
-    auto type_name = (dim == 3) ? "tetra4" : "tri3";
-    auto elems_in_block = each_eq_to(elem_class_ids, block_id);
-    auto block_elems2elem = collect_marked(elems_in_block);
-    auto nblock_elems = block_elems2elem.size();
-    if (verbose) {
-      std::cout << "element block " << block_id << " has " << nblock_elems << " of type "
-                << type_name << '\n';
-    }
-    CALL(ex_put_block(exoid, EX_ELEM_BLOCK, block_id, type_name, global_elem.size(), deg, 0, 0, 0));
-    auto block_conn = read(unmap(block_elems2elem, all_conn, deg));
-    auto block_conn_ex = add_to_each(block_conn, 1);
-    auto h_block_conn = HostRead<LO>(block_conn_ex);
-    CALL(ex_put_conn(exoid, EX_ELEM_BLOCK, block_id, reduced_conn.data(), nullptr, nullptr));
-    auto f = OMEGA_H_LAMBDA(LO block_elem) {
-      elems2file_idx[block_elems2elem[block_elem]] = elem_file_offset + block_elem;
-    };
-    parallel_for(nblock_elems, f);
-    elem_file_offset += nblock_elems;
-  }
-
-  std::vector<int> global_node_counts(dpi->num_node_sets_global);
+  int block_id = *region_set.begin();
+  const char *block_type_name = (dim == 3) ? "TETRA4" : "TRI3";
+  if (verbose) {
+    std::cout << "element block " << block_id << " has " << num_new_elems << " of type "
+              << block_type_name << '\n';
+  }
+
+  int num_sets = int(surface_set_vec.size());
+  std::vector<std::vector<int>> ns_nodes(num_sets);
+  std::vector<std::vector<int>> ss_elems(num_sets);
+  std::vector<std::vector<int>> ss_sides(num_sets);
+  std::vector<int> global_node_counts(num_sets);
   std::vector<int> sset_global_side;
-  if (1 && classify_with) {
-
-    std::vector<std::vector<int>> ns_nodes(surface_set_vec.size());
-    for (auto set_id : surface_set_vec) {
+  if (classify_with) {
+    auto sides2elems = mesh->ask_up(dim - 1, dim);
+    for (int set_index = 0; set_index < num_sets; set_index++) {
+      auto set_id = surface_set_vec[set_index];
       auto sides_in_set =
           land_each(each_eq_to(side_class_ids, set_id), each_eq_to(side_class_dims, I8(dim - 1)));
       if (classify_with & exodus::SIDE_SETS) {
-        std::vector<int> sides2elem_new;
-        std::vector<int> sides2local_new;
         auto set_sides2side = collect_marked(sides_in_set);
         auto nset_sides = set_sides2side.size();
         if (verbose) {
           std::cout << "side set " << set_id << " has " << nset_sides << " sides\n";
         }
-        auto sides2elems = mesh->ask_up(dim - 1, dim);
-        Write<int> set_sides2elem(nset_sides);
-        Write<int> set_sides2local(nset_sides);
         for (int set_side = 0; set_side < nset_sides; set_side++) {
           auto side = set_sides2side[set_side];
           auto side_elem = sides2elems.a2ab[side];
           auto elem = sides2elems.ab2b[side_elem];
-          auto elem_in_file = elems2file_idx[elem];
-          auto code = sides2elems.codes[side_elem];
-          auto which_down = code_which_down(code);
-          set_sides2elem[set_side] = elem_in_file + 1;
-          set_sides2local[set_side] = side_osh2exo(dim, which_down);
-          if (std::find(mesh_owned_elements.begin(), mesh_owned_elements.end(), elem_in_file) !=
-              mesh_owned_elements.end()) {
-            sides2elem_new.push_back(old_to_new_elem_map[elem_in_file] + 1);
-            sides2local_new.push_back(side_osh2exo(dim, which_down));
-          }
-        }
-        auto h_set_sides2elem = HostRead<int>(set_sides2elem);
-        auto h_set_sides2local = HostRead<int>(set_sides2local);
-        CALL(ex_put_set_param(exoid, EX_SIDE_SET, set_id, sides2elem_new.size(), 0));
-        sset_global_side.push_back(sides2elem_new.size());
-        if (sides2elem_new.size() > 0) {
-          CALL(ex_put_set(exoid, EX_SIDE_SET, set_id, sides2elem_new.data(),
-                          sides2local_new.data()));
+          auto which_down = code_which_down(sides2elems.codes[side_elem]);
+          ss_elems[set_index].push_back(old_to_new_elem_map[elem] + 1);
+          ss_sides[set_index].push_back(side_osh2exo(dim, which_down));
         }
+        sset_global_side.push_back(ss_elems[set_index].size());
       }
       if (classify_with & exodus::NODE_SETS) {
         auto nodes_in_set = mark_down(mesh, dim - 1, VERT, sides_in_set);
         auto set_nodes2node = collect_marked(nodes_in_set);
-        auto set_nodes2node_ex = add_to_each(set_nodes2node, 1);
-        auto nset_nodes = set_nodes2node.size();
-        std::size_t set_id_offset = 0;
-        for (std::size_t i = 0; i < surface_set_vec.size(); i++) {
-          if (surface_set_vec[i] == set_id) {
-            set_id_offset = i;
-          }
-        }
         for (int i = 0; i < set_nodes2node.size(); i++) {
           int local_node = old_to_new_node_map[set_nodes2node[i]];
           if (local_node != -1) {
-            ns_nodes[set_id_offset].push_back(local_node + 1);
+            ns_nodes[set_index].push_back(local_node + 1);
           }
         }
         if (verbose) {
-          std::cout << "node set " << set_id << " has " << nset_nodes << " nodes\n";
-        }
-        auto h_set_nodes2node = HostRead<LO>(set_nodes2node_ex);
-        CALL(ex_put_set_param(exoid, EX_NODE_SET, set_id, ns_nodes[set_id_offset].size(), 0));
-        if (ns_nodes[set_id_offset].size() > 0) {
-          CALL(ex_put_set(exoid, EX_NODE_SET, set_id, ns_nodes[set_id_offset].data(), nullptr));
+          std::cout << "node set " << set_id << " has " << set_nodes2node.size() << " nodes\n";
         }
       }
-      std::vector<std::string> set_names(surface_set_vec.size());
-      for (auto &pair : mesh->class_sets) {
-        auto &name = pair.first;
-        for (auto &cp : pair.second) {
-          if (cp.dim != I8(dim - 1))
-            continue;
-          std::size_t index = 0;
-          for (auto surface_id : surface_set_vec) {
-            if (surface_id == cp.id) {
-              set_names[index] = name;
-              if (verbose && (classify_with & exodus::NODE_SETS)) {
-                std::cout << "node set " << surface_id << " will be called \"" << name << "\"\n";
-              }
-              if (verbose && (classify_with & exodus::SIDE_SETS)) {
-                std::cout << "side set " << surface_id << " will be called \"" << name << "\"\n";
-              }
-            }
-            ++index;
-          }
-        }
-      }
-      std::vector<char *> set_name_ptrs(surface_set_vec.size(), nullptr);
-      for (std::size_t i = 0; i < set_names.size(); ++i) {
-        if (set_names[i].empty()) {
-          std::stringstream ss;
-          ss << "ss_" << i;
-          set_names[i] = ss.str();
-        }
-        set_name_ptrs[i] = const_cast<char *>(set_names[i].c_str());
-      }
-      if (classify_with & exodus::SIDE_SETS) {
-        CALL(ex_put_names(exoid, EX_SIDE_SET, set_name_ptrs.data()));
-      }
-      for (std::size_t i = 0; i < set_names.size(); ++i) {
-        std::stringstream ss;
-        ss << "ns_" << i;
-        set_names[i] = ss.str();
-        set_name_ptrs[i] = const_cast<char *>(set_names[i].c_str());
-      }
-      if (classify_with & exodus::NODE_SETS) {
-        CALL(ex_put_names(exoid, EX_NODE_SET, set_name_ptrs.data()));
-      }
     }
 
     // Nodeset dpi information needs total nodes for each nodeset and we need
@@ -1022,9 +952,6 @@ void convert_omega_h_to_goma(
   std::vector<int> elem_map(global_elem.begin(), global_elem.end());
   std::for_each(elem_map.begin(), elem_map.end(), add1);
 
-  ex_put_id_map(exoid, EX_NODE_MAP, node_map.data());
-  ex_put_id_map(exoid, EX_ELEM_MAP, elem_map.data());
-
   int max_sets = surface_set_vec.size();
   int gmax_sets;
   MPI_Allreduce(&max_sets, &gmax_sets, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
@@ -1044,8 +971,6 @@ void convert_omega_h_to_goma(
   std::vector<int> global_sets(global_set_uniq.begin(), global_set_uniq.end());
   std::sort(global_sets.begin(), global_sets.end());
   std::vector<int> global_side_counts(global_sets.size());
-  std::vector<int> df_counts(global_sets.size());
-  std::fill(df_counts.begin(), df_counts.end(), 0);
 
   for (size_t setidx = 0; setidx < global_sets.size(); setidx++) {
     auto set = global_sets[setidx];
@@ -1056,35 +981,8 @@ void convert_omega_h_to_goma(
                     MPI_COMM_WORLD);
     }
   }
-  CALL(ex_put_init_global(exoid, mesh->nglobal_ents(0), mesh->nglobal_ents(mesh->dim()), 1,
-                          global_sets.size(), global_sets.size()));
-
-  CALL(ex_put_ns_param_global(exoid, global_sets.data(), global_node_counts.data(),
-                              df_counts.data()));
-  CALL(ex_put_ss_param_global(exoid, global_sets.data(), global_side_counts.data(),
-                              df_counts.data()));
-
-  std::vector<int> eb_id(1);
-  eb_id[0] = 1;
-  std::vector<int> eb_counts(1);
-  eb_counts[0] = mesh->nglobal_ents(mesh->dim());
-
-  CALL(ex_put_eb_info_global(exoid, eb_id.data(), eb_counts.data()));
-  char ftype = 'p';
-  CALL(ex_put_init_info(exoid, Num_Proc, 1, &ftype));
-
-  CALL(ex_put_loadbal_param(exoid, internal_nodes.size(), boundary_nodes_sorted.size(), 0,
-                            global_elem.size(), 0, node_cmap_ids.size(), 0, ProcID));
-
-  std::vector<int> elem_internal(global_elem.size());
-  std::iota(elem_internal.begin(), elem_internal.end(), 1);
-
-  CALL(ex_put_processor_elem_maps(exoid, elem_internal.data(), NULL, ProcID));
-  std::vector<int> node_mesh(global_node.size());
-  std::iota(node_mesh.begin(), node_mesh.end(), 1);
-
-  CALL(ex_put_processor_node_maps(exoid, node_mesh.data(), &node_mesh[internal_nodes.size()], NULL,
-                                  ProcID));
+  int num_global_nodes = mesh->nglobal_ents(0);
+  int num_global_elems = mesh->nglobal_ents(mesh->dim());
 
   std::vector<int> cmap_node_counts;
   cmap_node_counts.reserve(node_cmap_to_neighbor.size());
@@ -1092,20 +990,11 @@ void convert_omega_h_to_goma(
     cmap_node_counts.push_back(proc_node_counts[idx]);
   }
 
-  CALL(
-      ex_put_cmap_params(exoid, node_cmap_ids.data(), cmap_node_counts.data(), NULL, NULL, ProcID));
-
   std::vector<int> node_map_proc_ids(proc_node_idx[neighbor_list.size()]);
   for (auto nidx : node_cmap_to_neighbor) {
     std::fill(node_map_proc_ids.begin() + proc_node_idx[nidx],
               node_map_proc_ids.begin() + proc_node_idx[nidx + 1], neighbor_list[nidx]);
   }
-  for (auto nidx : node_cmap_to_neighbor) {
-    CALL(ex_put_node_cmap(exoid, neighbor_list[nidx], proc_node_list[nidx].data(),
-                          &node_map_proc_ids[proc_node_idx[nidx]], ProcID));
-  }
-
-  CALL(ex_close(exoid));
 
   for (int imtrx = 0; imtrx < upd->Total_Num_Matrices; imtrx++) {
     free(idv[imtrx]);
@@ -1156,11 +1045,11 @@ void convert_omega_h_to_goma(
     goma_automatic_rotations.rotation_nodes = NULL;
   }
 
-  //  const char * tmpfile = "";
-  strncpy(ExoFile, "tmp_omega_h_mesh.e", 127);
   strncpy(ExoFileOutMono, path, 127);
   strncpy(ExoFileOut, path, 127);
   multiname(ExoFileOut, ProcID, Num_Proc);
+  // the adapted mesh is written to ExoFileOut below, so that becomes the mesh file
+  strncpy(ExoFile, ExoFileOut, 127);
   int num_total_nodes = dpi->num_internal_nodes + dpi->num_boundary_nodes + dpi->num_external_nodes;
 
   for (int imtrx = 0; imtrx < upd->Total_Num_Matrices; imtrx++) {
@@ -1174,7 +1063,244 @@ void convert_omega_h_to_goma(
   safer_free((void **)&Local_Offset);
   safer_free((void **)&Dolphin);
 
-  read_mesh_exoII(exo, dpi);
+  /*
+   * Fill the mesh database and the raw Nemesis information directly, in the
+   * state rd_exo() and rd_dpi() leave them after reading a mesh file
+   * (1-based), then finish the setup the way read_mesh_exoII() does.
+   */
+  exo->state = EXODB_STATE_GRND;
+  exo->path = (char *)malloc(strlen(ExoFile) + 1);
+  strcpy(exo->path, ExoFile);
+  exo->mode = EX_READ;
+  exo->comp_wordsize = sizeof(dbl);
+  exo->io_wordsize = sizeof(dbl);
+  exo->node_map_exists = FALSE;
+  exo->elem_map_exists = FALSE;
+  exo->elem_order_map_exists = FALSE;
+  exo->elem_var_tab_exists = FALSE;
+
+  exo->title = (char *)calloc(MAX_SLENGTH, sizeof(char));
+  strncpy(exo->title, title, MAX_SLENGTH - 1);
+  exo->num_dim = dim;
+  exo->num_nodes = num_new_nodes;
+  exo->num_elems = num_new_elems;
+  exo->num_elem_blocks = 1;
+  exo->num_node_sets = nnode_sets;
+  exo->num_side_sets = nside_sets;
+  exo->num_qa_rec = 0;
+  exo->num_info = 0;
+  exo->num_times = 0;
+  exo->state |= EXODB_STATE_INIT;
+
+  dbl **coord_ptrs[3] = {&exo->x_coord, &exo->y_coord, &exo->z_coord};
+  exo->x_coord = exo->y_coord = exo->z_coord = NULL;
+  exo->coord_names = (char **)malloc(dim * sizeof(char *));
+  for (int j = 0; j < dim; j++) {
+    *coord_ptrs[j] = alloc_dbl_1(num_new_nodes, 0.0);
+    std::copy(new_coords.begin() + j * num_new_nodes, new_coords.begin() + (j + 1) * num_new_nodes,
+              *coord_ptrs[j]);
+    exo->coord_names[j] = (char *)calloc(MAX_STR_LENGTH + 1, sizeof(char));
+  }
+
+  exo->elem_eb = alloc_int_1(num_new_elems, 0);
+  Element_Blocks = alloc_struct_1(ELEM_BLK_STRUCT, 1);
+  exo->eb_id = alloc_int_1(1, block_id);
+  exo->eb_elem_type = (char **)malloc(sizeof(char *));
+  exo->eb_elem_type[0] = (char *)calloc(MAX_STR_LENGTH, sizeof(char));
+  strcpy(exo->eb_elem_type[0], block_type_name);
+  exo->eb_num_elems = alloc_int_1(1, num_new_elems);
+  exo->eb_num_nodes_per_elem = alloc_int_1(1, deg);
+  exo->eb_num_attr = alloc_int_1(1, 0);
+  exo->eb_conn = (int **)malloc(sizeof(int *));
+  exo->eb_conn[0] = alloc_int_1(reduced_conn.size(), 0);
+  std::copy(reduced_conn.begin(), reduced_conn.end(), exo->eb_conn[0]);
+  exo->eb_attr = (dbl **)malloc(sizeof(dbl *));
+  exo->eb_attr[0] = NULL;
+  exo->eb_ptr = alloc_int_1(2, 0);
+  exo->eb_ptr[1] = num_new_elems;
+
+  ELEM_BLK_STRUCT *eb_ptr = Element_Blocks;
+  eb_ptr->Elem_Blk_Num = 0;
+  eb_ptr->Elem_Blk_Id = block_id;
+  eb_ptr->Elem_Type = get_type(exo->eb_elem_type[0], deg, 0);
+  eb_ptr->Num_Nodes_Per_Elem = deg;
+  eb_ptr->Num_Attr_Per_Elem = 0;
+  int mindex = map_mat_index(block_id);
+  eb_ptr->MatlProp_ptr = (mindex < 0) ? NULL : mp_glob[mindex];
+  eb_ptr->ElemStorage = NULL;
+  eb_ptr->Num_Elems_In_Block = num_new_elems;
+  eb_ptr->IP_total = elem_info(NQUAD, eb_ptr->Elem_Type);
+
+  exo->ns_node_len = 0;
+  exo->ns_distfact_len = 0;
+  if (exo->num_node_sets > 0) {
+    exo->ns_id = alloc_int_1(exo->num_node_sets, 0);
+    exo->ns_num_nodes = alloc_int_1(exo->num_node_sets, 0);
+    exo->ns_num_distfacts = alloc_int_1(exo->num_node_sets, 0);
+    exo->ns_node_index = alloc_int_1(exo->num_node_sets, 0);
+    exo->ns_distfact_index = alloc_int_1(exo->num_node_sets, 0);
+    for (int i = 0; i < exo->num_node_sets; i++) {
+      exo->ns_id[i] = surface_set_vec[i];
+      exo->ns_num_nodes[i] = ns_nodes[i].size();
+      exo->ns_node_index[i] = exo->ns_node_len;
+      exo->ns_node_len += ns_nodes[i].size();
+    }
+    if (exo->ns_node_len > 0) {
+      exo->ns_node_list = alloc_int_1(exo->ns_node_len, 0);
+      for (int i = 0; i < exo->num_node_sets; i++) {
+        std::copy(ns_nodes[i].begin(), ns_nodes[i].end(),
+                  exo->ns_node_list + exo->ns_node_index[i]);
+      }
+    }
+  }
+
+  exo->ss_elem_len = 0;
+  exo->ss_distfact_len = 0;
+  exo->ss_node_len = 0;
+  if (exo->num_side_sets > 0) {
+    exo->ss_id = alloc_int_1(exo->num_side_sets, 0);
+    exo->ss_num_sides = alloc_int_1(exo->num_side_sets, 0);
+    exo->ss_num_distfacts = alloc_int_1(exo->num_side_sets, 0);
+    exo->ss_elem_index = alloc_int_1(exo->num_side_sets, 0);
+    exo->ss_distfact_index = alloc_int_1(exo->num_side_sets, 0);
+    exo->ss_node_list = (int **)malloc(exo->num_side_sets * sizeof(int *));
+    exo->ss_node_cnt_list = (int **)malloc(exo->num_side_sets * sizeof(int *));
+    exo->ss_node_side_index = (int **)malloc(exo->num_side_sets * sizeof(int *));
+    for (int i = 0; i < exo->num_side_sets; i++) {
+      exo->ss_id[i] = surface_set_vec[i];
+      exo->ss_num_sides[i] = ss_elems[i].size();
+      exo->ss_elem_index[i] = exo->ss_elem_len;
+      exo->ss_elem_len += ss_elems[i].size();
+    }
+    if (exo->ss_elem_len > 0) {
+      exo->ss_elem_list = alloc_int_1(exo->ss_elem_len, 0);
+      exo->ss_side_list = alloc_int_1(exo->ss_elem_len, 0);
+    }
+
+    // side set node lists, as ex_get_side_set_node_list() would return them
+    exo->ss_node_list_exists = TRUE;
+    for (int i = 0; i < exo->num_side_sets; i++) {
+      std::copy(ss_elems[i].begin(), ss_elems[i].end(), exo->ss_elem_list + exo->ss_elem_index[i]);
+      std::copy(ss_sides[i].begin(), ss_sides[i].end(), exo->ss_side_list + exo->ss_elem_index[i]);
+
+      std::vector<int> side_nodes;
+      exo->ss_node_cnt_list[i] = alloc_int_1(exo->ss_num_sides[i], 0);
+      exo->ss_node_side_index[i] = alloc_int_1(exo->ss_num_sides[i] + 1, 0);
+      for (int j = 0; j < exo->ss_num_sides[i]; j++) {
+        int local_side_node_list[MAX_NODES_PER_SIDE];
+        int num_nodes_on_side = 0;
+        get_side_info(eb_ptr->Elem_Type, ss_sides[i][j], &num_nodes_on_side,
+                      local_side_node_list);
+        int elem = ss_elems[i][j] - 1;
+        for (int k = 0; k < num_nodes_on_side; k++) {
+          side_nodes.push_back(exo->eb_conn[0][elem * deg + local_side_node_list[k]]);
+        }
+        exo->ss_node_cnt_list[i][j] = num_nodes_on_side;
+        exo->ss_node_side_index[i][j + 1] = exo->ss_node_side_index[i][j] + num_nodes_on_side;
+      }
+      exo->ss_node_list[i] = alloc_int_1(side_nodes.size(), 0);
+      std::copy(side_nodes.begin(), side_nodes.end(), exo->ss_node_list[i]);
+      exo->ss_node_len += side_nodes.size();
+    }
+  }
+
+  exo->eb_num_props = 1;
+  exo->ns_num_props = 1;
+  exo->ss_num_props = 1;
+  id_property(exo->num_elem_blocks, exo->eb_id, &exo->eb_prop_name, &exo->eb_prop);
+  id_property(exo->num_node_sets, exo->ns_id, &exo->ns_prop_name, &exo->ns_prop);
+  id_property(exo->num_side_sets, exo->ss_id, &exo->ss_prop_name, &exo->ss_prop);
+  exo->state |= EXODB_STATE_MESH;
+
+  exo->num_glob_vars = 0;
+  exo->num_elem_vars = 0;
+  exo->num_node_vars = 0;
+  exo->state |= EXODB_STATE_RES0;
+
+  if (Num_Proc > 1) {
+    dpi->num_nodes_global = num_global_nodes;
+    dpi->num_elems_global = num_global_elems;
+    dpi->num_elem_blocks_global = 1;
+    dpi->num_node_sets_global = global_sets.size();
+    dpi->num_side_sets_global = global_sets.size();
+
+    dpi->ns_id_global = alloc_int_1(global_sets.size(), 0);
+    dpi->num_ns_global_node_counts = alloc_int_1(global_sets.size(), 0);
+    dpi->num_ns_global_df_counts = alloc_int_1(global_sets.size(), 0);
+    dpi->ss_id_global = alloc_int_1(global_sets.size(), 0);
+    dpi->num_ss_global_side_counts = alloc_int_1(global_sets.size(), 0);
+    dpi->num_ss_global_df_counts = alloc_int_1(global_sets.size(), 0);
+    for (size_t i = 0; i < global_sets.size(); i++) {
+      dpi->ns_id_global[i] = global_sets[i];
+      dpi->num_ns_global_node_counts[i] = global_node_counts[i];
+      dpi->ss_id_global[i] = global_sets[i];
+      dpi->num_ss_global_side_counts[i] = global_side_counts[i];
+    }
+    dpi->global_elem_block_ids = alloc_int_1(1, block_id);
+    dpi->global_elem_block_counts = alloc_int_1(1, num_global_elems);
+
+    dpi->rank = ProcID;
+    dpi->num_proc = Num_Proc;
+    dpi->num_proc_in_file = 1;
+    dpi->ftype = 'p';
+
+    dpi->node_index_global = alloc_int_1(num_new_nodes, 0);
+    dpi->elem_index_global = alloc_int_1(num_new_elems, 0);
+    std::copy(node_map.begin(), node_map.end(), dpi->node_index_global);
+    std::copy(elem_map.begin(), elem_map.end(), dpi->elem_index_global);
+
+    dpi->num_internal_nodes = internal_nodes.size();
+    dpi->num_boundary_nodes = boundary_nodes_sorted.size();
+    dpi->num_external_nodes = 0;
+    dpi->num_internal_elems = num_new_elems;
+    dpi->num_border_elems = 0;
+    dpi->num_node_cmaps = node_cmap_ids.size();
+    dpi->num_elem_cmaps = 0;
+    dpi->base_internal_nodes = dpi->num_internal_nodes;
+    dpi->base_boundary_nodes = dpi->num_boundary_nodes;
+    dpi->base_external_nodes = dpi->num_external_nodes;
+    dpi->base_internal_elems = dpi->num_internal_elems;
+    dpi->base_border_elems = dpi->num_border_elems;
+
+    // new nodes are numbered internal first, then boundary
+    dpi->proc_node_internal = alloc_int_1(dpi->num_internal_nodes, 0);
+    std::iota(dpi->proc_node_internal, dpi->proc_node_internal + dpi->num_internal_nodes, 1);
+    if (dpi->num_boundary_nodes > 0) {
+      dpi->proc_node_boundary = alloc_int_1(dpi->num_boundary_nodes, 0);
+      std::iota(dpi->proc_node_boundary, dpi->proc_node_boundary + dpi->num_boundary_nodes,
+                dpi->num_internal_nodes + 1);
+    }
+
+    dpi->node_cmap_ids = alloc_int_1(dpi->num_node_cmaps, 0);
+    dpi->node_cmap_node_counts = alloc_int_1(dpi->num_node_cmaps, 0);
+    dpi->node_map_node_ids = (int **)calloc(dpi->num_node_cmaps, sizeof(int *));
+    dpi->node_map_proc_ids = (int **)calloc(dpi->num_node_cmaps, sizeof(int *));
+    for (int i = 0; i < dpi->num_node_cmaps; i++) {
+      int nidx = node_cmap_to_neighbor[i];
+      dpi->node_cmap_ids[i] = node_cmap_ids[i];
+      dpi->node_cmap_node_counts[i] = cmap_node_counts[i];
+      dpi->node_map_node_ids[i] = alloc_int_1(cmap_node_counts[i], 0);
+      dpi->node_map_proc_ids[i] = alloc_int_1(cmap_node_counts[i], 0);
+      std::copy(proc_node_list[nidx].begin(), proc_node_list[nidx].end(),
+                dpi->node_map_node_ids[i]);
+      std::copy(node_map_proc_ids.begin() + proc_node_idx[nidx],
+                node_map_proc_ids.begin() + proc_node_idx[nidx + 1], dpi->node_map_proc_ids[i]);
+    }
+  }
+
+  zero_base(exo);
+  int error = setup_base_mesh(dpi, exo, Num_Proc);
+  GOMA_EH(error, "setup_base_mesh");
+  if (Num_Proc == 1) {
+    uni_dpi(dpi, exo);
+  } else {
+    setup_dpi(exo, dpi, true);
+    // no Goma side and node set consistency data for an adapted mesh
+    dpi->goma_dpi_data = false;
+    dpi->global_ns_node_len = 0;
+    dpi->global_ss_elem_len = 0;
+  }
+  setup_mesh_exoII(exo, dpi);
   one_base(exo, Num_Proc);
   wr_mesh_exo(exo, ExoFileOut, 0);
   zero_base(exo);
@@ -1204,19 +1330,441 @@ void convert_omega_h_to_goma(
 } // namespace exodus
 } // namespace goma
 
-void adapt_mesh(Omega_h::Mesh &mesh) {
+// Vertex tag name of the variables driving the ZZ and HESSIAN metrics
+static std::vector<std::string> adapt_variable_names(Omega_h::Mesh &mesh) {
+  std::vector<std::string> names;
+  for (int i = 0; i < tran->adapt_num_vars; i++) {
+    std::string name(tran->adapt_vars[i]);
+    if (!mesh.has_tag(Omega_h::VERT, name)) {
+      GOMA_EH(GOMA_ERROR, "Adapt Metric Variables: no nodal variable %s", name.c_str());
+    }
+    names.push_back(name);
+  }
+  return names;
+}
+
+/*
+ * Zienkiewicz-Zhu error of the adapt variables.  Per element, err2 is the
+ * squared difference between the element gradient and the gradient
+ * recovered at the vertices (averaged to the element), and grad2 the
+ * squared recovered gradient, both integrated over the element.  The
+ * recovery needs neighboring elements, so the mesh must be ghosted.
+ */
+static void zz_element_errors(Omega_h::Mesh &mesh,
+                              Omega_h::Reals &err2_out,
+                              Omega_h::Reals &grad2_out) {
+  auto dim = mesh.dim();
+  auto elems2verts = mesh.ask_elem_verts();
+  auto sizes = Omega_h::measure_elements_real(&mesh);
+  auto err2 = Omega_h::Write<Omega_h::Real>(mesh.nelems(), 0.0);
+  auto grad2 = Omega_h::Write<Omega_h::Real>(mesh.nelems(), 0.0);
+
+  for (auto &name : adapt_variable_names(mesh)) {
+    auto u = mesh.get_array<Omega_h::Real>(Omega_h::VERT, name);
+    auto elem_grads = Omega_h::derive_element_gradients(&mesh, u);
+    auto vert_grads = Omega_h::project_by_fit(&mesh, elem_grads);
+    auto f0 = OMEGA_H_LAMBDA(Omega_h::LO e) {
+      Omega_h::Real e2 = 0.0;
+      Omega_h::Real g2 = 0.0;
+      for (int d = 0; d < dim; d++) {
+        Omega_h::Real recovered = 0.0;
+        for (int v = 0; v <= dim; v++) {
+          recovered += vert_grads[elems2verts[e * (dim + 1) + v] * dim + d];
+        }
+        recovered /= (dim + 1);
+        auto diff = recovered - elem_grads[e * dim + d];
+        e2 += diff * diff;
+        g2 += recovered * recovered;
+      }
+      err2[e] += e2 * sizes[e];
+      grad2[e] += g2 * sizes[e];
+    };
+    Omega_h::parallel_for(mesh.nelems(), f0, "zz_element_errors");
+  }
+  err2_out = err2;
+  grad2_out = grad2;
+}
+
+// Sum of an element quantity over the owned elements of all processors
+static Omega_h::Real sum_owned_elements(Omega_h::Mesh &mesh, Omega_h::Reals a) {
+  auto owned = mesh.owned(mesh.dim());
+  auto masked = Omega_h::Write<Omega_h::Real>(mesh.nelems());
+  auto f0 = OMEGA_H_LAMBDA(Omega_h::LO e) { masked[e] = owned[e] ? a[e] : 0.0; };
+  Omega_h::parallel_for(mesh.nelems(), f0, "mask_owned_elements");
+  return Omega_h::get_sum(mesh.comm(), Omega_h::Reals(masked));
+}
+
+static void add_iso_size_metric_tag(Omega_h::Mesh &mesh,
+                                    std::string const &name,
+                                    Omega_h::Reals vert_sizes) {
+  auto dim = mesh.dim();
+  auto target_metrics =
+      Omega_h::Write<Omega_h::Real>(mesh.nverts() * Omega_h::symm_ncomps(dim));
+  auto f0 = OMEGA_H_LAMBDA(Omega_h::LO index) {
+    auto iso_size = vert_sizes[index];
+    if (dim == 2) {
+      auto target_metric = Omega_h::compose_metric(Omega_h::identity_matrix<2, 2>(),
+                                                   Omega_h::vector_2(iso_size, iso_size));
+      Omega_h::set_vector(target_metrics, index, Omega_h::symm2vector(target_metric));
+    } else {
+      auto target_metric = Omega_h::compose_metric(
+          Omega_h::identity_matrix<3, 3>(), Omega_h::vector_3(iso_size, iso_size, iso_size));
+      Omega_h::set_vector(target_metrics, index, Omega_h::symm2vector(target_metric));
+    }
+  };
+  Omega_h::parallel_for(mesh.nverts(), f0, "set_iso_metric_values");
+  mesh.add_tag(Omega_h::VERT, name, Omega_h::symm_ncomps(dim), Omega_h::Reals(target_metrics));
+}
+
+/*
+ * Isotropic size field equidistributing the ZZ error: each element gets
+ * an equal share of the allowed error, tol * sqrt((|e|^2 + |grad u|^2) / N),
+ * and its size h is scaled by the ratio of that share to its own error
+ * (linear elements converge as O(h)).  The scaling is limited to a factor
+ * of four either way per adaptation; element sizes are averaged to the
+ * vertices for the "zz_size_metric" tag.
+ */
+static void add_zz_size_metric_tag(Omega_h::Mesh &mesh) {
+  auto dim = mesh.dim();
+  Omega_h::Reals err2, grad2;
+
+  mesh.set_parting(OMEGA_H_GHOSTED);
+  zz_element_errors(mesh, err2, grad2);
+  auto total = sum_owned_elements(mesh, err2) + sum_owned_elements(mesh, grad2);
+  auto nelems = Omega_h::Real(mesh.nglobal_ents(dim));
+  auto elem_error = tran->adapt_error_tol * std::sqrt(total / nelems);
+
+  auto sizes = Omega_h::measure_elements_real(&mesh);
+  auto elem_lengths = Omega_h::Write<Omega_h::Real>(mesh.nelems());
+  auto f0 = OMEGA_H_LAMBDA(Omega_h::LO e) {
+    // edge length of the equilateral triangle / regular tetrahedron of this size
+    auto h = (dim == 2) ? std::sqrt(4.0 * sizes[e] / std::sqrt(3.0))
+                        : std::cbrt(6.0 * std::sqrt(2.0) * sizes[e]);
+    auto ratio = (elem_error > 0.0) ? std::sqrt(err2[e]) / elem_error : 0.0;
+    ratio = std::min(std::max(ratio, 0.25), 4.0);
+    elem_lengths[e] = h / ratio;
+  };
+  Omega_h::parallel_for(mesh.nelems(), f0, "zz_element_lengths");
+  auto vert_lengths = Omega_h::project_by_average(&mesh, Omega_h::Reals(elem_lengths));
+  add_iso_size_metric_tag(mesh, "zz_size_metric", vert_lengths);
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+}
+
+/*
+ * Error estimate compared against the Adapt Error Threshold: the global
+ * relative ZZ error |e| / sqrt(|e|^2 + |grad u|^2) of the adapt variables
+ * for the ZZ and HESSIAN metrics, and for the ISO and LEVEL_SET metrics
+ * the fraction of edges whose length in the target metric is outside the
+ * range adaptation would accept.
+ */
+static Omega_h::Real adapt_error_estimate(Omega_h::Mesh &mesh) {
+  auto metric = adapt_metric_type();
+  if (metric == ADAPT_METRIC_ZZ || metric == ADAPT_METRIC_HESSIAN) {
+    Omega_h::Reals err2, grad2;
+    mesh.set_parting(OMEGA_H_GHOSTED);
+    zz_element_errors(mesh, err2, grad2);
+    auto e2 = sum_owned_elements(mesh, err2);
+    auto g2 = sum_owned_elements(mesh, grad2);
+    mesh.set_parting(OMEGA_H_ELEM_BASED);
+    return (e2 + g2 > 0.0) ? std::sqrt(e2 / (e2 + g2)) : 0.0;
+  }
+
+  Omega_h::AdaptOpts opts(&mesh);
+  auto min_length = opts.min_length_desired;
+  auto max_length = adapt_max_length_desired;
+  auto metrics = mesh.get_array<Omega_h::Real>(Omega_h::VERT, "iso_size_metric");
+  auto lengths = Omega_h::measure_edges_metric(&mesh, metrics);
+  auto owned = mesh.owned(Omega_h::EDGE);
+  auto is_owned = Omega_h::Write<Omega_h::Real>(mesh.nedges());
+  auto is_bad = Omega_h::Write<Omega_h::Real>(mesh.nedges());
+  auto f0 = OMEGA_H_LAMBDA(Omega_h::LO e) {
+    is_owned[e] = owned[e] ? 1.0 : 0.0;
+    is_bad[e] = (lengths[e] < min_length || lengths[e] > max_length) ? is_owned[e] : 0.0;
+  };
+  Omega_h::parallel_for(mesh.nedges(), f0, "count_unacceptable_edges");
+  auto nedges = Omega_h::get_sum(mesh.comm(), Omega_h::Reals(is_owned));
+  auto nbad = Omega_h::get_sum(mesh.comm(), Omega_h::Reals(is_bad));
+  return (nedges > 0.0) ? nbad / nedges : 0.0;
+}
+
+/*
+ * Degrees of freedom of the active equations of material mn on the
+ * adapted (simplex) element shape, as in the METIS decomposition
+ * (metis_decomp.c).
+ */
+static Omega_h::Real material_element_dofs(int mn, int ielem_shape) {
+  Omega_h::Real dofs = 0;
+  for (int imtrx = 0; imtrx < upd->Total_Num_Matrices; imtrx++) {
+    for (int var = V_FIRST; var < V_LAST; var++) {
+      if (pd_glob[mn]->e[imtrx][var]) {
+        dofs += getdofs(ielem_shape, pd_glob[mn]->i[imtrx][var]);
+      }
+    }
+  }
+  return dofs;
+}
+
+/*
+ * Estimated cost of assembling each element: the degrees of freedom of
+ * the active equations of the material of its block (the element
+ * class_id), scaled up for elements cut by the level set when subgrid or
+ * subelement integration adds quadrature points there.
+ */
+static Omega_h::Reals physics_element_weights(Omega_h::Mesh &mesh) {
+  auto dim = mesh.dim();
+  int ielem_type = (dim == 2) ? LINEAR_TRI : LINEAR_TET;
+  int ielem_shape = type2shape(ielem_type);
+
+  auto h_class_ids = Omega_h::HostRead<Omega_h::ClassId>(
+      mesh.get_array<Omega_h::ClassId>(dim, "class_id"));
+  std::map<Omega_h::ClassId, Omega_h::Real> block_dofs;
+  Omega_h::HostWrite<Omega_h::Real> h_base(mesh.nelems());
+  for (Omega_h::LO e = 0; e < mesh.nelems(); e++) {
+    auto block_id = h_class_ids[e];
+    auto it = block_dofs.find(block_id);
+    if (it == block_dofs.end()) {
+      int mn = map_mat_index(block_id);
+      if (mn < 0) {
+        GOMA_EH(GOMA_ERROR, "No material for element block %d of the adapted mesh", block_id);
+      }
+      it = block_dofs.emplace(block_id, material_element_dofs(mn, ielem_shape)).first;
+    }
+    h_base[e] = it->second;
+  }
+  auto base = Omega_h::Reals(h_base.write());
+
+  Omega_h::Real interface_factor = 1.0;
+  std::string fill_name(Exo_Var_Names[FILL].name2);
+  if (ls != NULL && mesh.has_tag(Omega_h::VERT, fill_name)) {
+    if (ls->Integration_Depth > 0) {
+      interface_factor = Omega_h::Real(1 << (dim * ls->Integration_Depth));
+    } else if (ls->SubElemIntegration) {
+      interface_factor = 4.0;
+    }
+  }
+  if (interface_factor == 1.0) {
+    return base;
+  }
+
+  auto F = mesh.get_array<Omega_h::Real>(Omega_h::VERT, fill_name);
+  auto elems2verts = mesh.ask_elem_verts();
+  auto weights = Omega_h::Write<Omega_h::Real>(mesh.nelems());
+  auto f0 = OMEGA_H_LAMBDA(Omega_h::LO e) {
+    bool negative = false, positive = false;
+    for (int v = 0; v <= dim; v++) {
+      auto Fv = F[elems2verts[e * (dim + 1) + v]];
+      negative = negative || Fv < 0.0;
+      positive = positive || Fv > 0.0;
+    }
+    weights[e] = (negative && positive) ? interface_factor * base[e] : base[e];
+  };
+  Omega_h::parallel_for(mesh.nelems(), f0, "physics_element_weights");
+  return Omega_h::Reals(weights);
+}
+
+// bisection steps locating each cut, enough to resolve 1e-12 of the extent
+static const int rcb_cut_steps = 40;
+
+/*
+ * Weighted recursive coordinate bisection of the elements of all
+ * processors in comm into nparts parts, computed in parallel: every
+ * processor only ever holds its own elements.  Each cut is across the
+ * longest extent of the group being split and splits its weight in
+ * proportion to the number of parts on either side, so any number of
+ * parts works.  The groups of one level are cut together, each cut is
+ * located by bisection on the coordinate with one reduction per step.
+ * Returns the part of each local element.
+ */
+static std::vector<int> rcb_partition(MPI_Comm comm,
+                                      int nparts,
+                                      std::vector<double> const &centroids,
+                                      std::vector<double> const &weights) {
+  int nelems = weights.size();
+  // elements carry the first part of their group, group_parts[first] is its size
+  std::vector<int> parts(nelems, 0);
+  std::vector<int> group_parts(nparts, 0);
+  group_parts[0] = nparts;
+
+  for (;;) {
+    std::vector<int> splitting;
+    for (int g = 0; g < nparts; g++) {
+      if (group_parts[g] > 1) {
+        splitting.push_back(g);
+      }
+    }
+    if (splitting.empty()) {
+      break;
+    }
+
+    std::vector<double> lo(3 * nparts, std::numeric_limits<double>::max());
+    std::vector<double> hi(3 * nparts, -std::numeric_limits<double>::max());
+    std::vector<double> total(nparts, 0.0);
+    for (int e = 0; e < nelems; e++) {
+      int g = parts[e];
+      for (int d = 0; d < 3; d++) {
+        lo[3 * g + d] = std::min(lo[3 * g + d], centroids[3 * e + d]);
+        hi[3 * g + d] = std::max(hi[3 * g + d], centroids[3 * e + d]);
+      }
+      total[g] += weights[e];
+    }
+    MPI_Allreduce(MPI_IN_PLACE, lo.data(), 3 * nparts, MPI_DOUBLE, MPI_MIN, comm);
+    MPI_Allreduce(MPI_IN_PLACE, hi.data(), 3 * nparts, MPI_DOUBLE, MPI_MAX, comm);
+    MPI_Allreduce(MPI_IN_PLACE, total.data(), nparts, MPI_DOUBLE, MPI_SUM, comm);
+
+    // the cut of group g lies in [a, b], the weight below a and b brackets the target
+    std::vector<int> axis(nparts, 0);
+    std::vector<double> a(nparts, 0.0), b(nparts, 0.0), target(nparts, 0.0);
+    std::vector<double> below_a(nparts, 0.0), below_b(nparts, 0.0);
+    for (int g : splitting) {
+      for (int d = 1; d < 3; d++) {
+        if (hi[3 * g + d] - lo[3 * g + d] > hi[3 * g + axis[g]] - lo[3 * g + axis[g]]) {
+          axis[g] = d;
+        }
+      }
+      if (total[g] > 0.0) {
+        a[g] = lo[3 * g + axis[g]];
+        b[g] = std::nextafter(hi[3 * g + axis[g]], std::numeric_limits<double>::max());
+      }
+      target[g] = total[g] * (group_parts[g] / 2) / group_parts[g];
+      below_b[g] = total[g];
+    }
+
+    std::vector<double> below(nparts);
+    for (int step = 0; step < rcb_cut_steps; step++) {
+      std::fill(below.begin(), below.end(), 0.0);
+      for (int e = 0; e < nelems; e++) {
+        int g = parts[e];
+        if (group_parts[g] > 1 && centroids[3 * e + axis[g]] < 0.5 * (a[g] + b[g])) {
+          below[g] += weights[e];
+        }
+      }
+      MPI_Allreduce(MPI_IN_PLACE, below.data(), nparts, MPI_DOUBLE, MPI_SUM, comm);
+      for (int g : splitting) {
+        double mid = 0.5 * (a[g] + b[g]);
+        if (below[g] < target[g]) {
+          a[g] = mid;
+          below_a[g] = below[g];
+        } else {
+          b[g] = mid;
+          below_b[g] = below[g];
+        }
+      }
+    }
+
+    std::vector<double> cut(nparts);
+    for (int g : splitting) {
+      cut[g] = (target[g] - below_a[g] <= below_b[g] - target[g]) ? a[g] : b[g];
+    }
+    for (int e = 0; e < nelems; e++) {
+      int g = parts[e];
+      if (group_parts[g] > 1 && centroids[3 * e + axis[g]] >= cut[g]) {
+        parts[e] = g + group_parts[g] / 2;
+      }
+    }
+    for (int g : splitting) {
+      int nleft = group_parts[g] / 2;
+      group_parts[g + nleft] = group_parts[g] - nleft;
+      group_parts[g] = nleft;
+    }
+  }
+  return parts;
+}
+
+/*
+ * Weighted repartition of the adapted mesh for any number of processors;
+ * Omega_h's own balance() bisects the communicator and needs a power of
+ * two.  The elements, weighted by physics_element_weights(), are
+ * partitioned in parallel by recursive coordinate bisection of their
+ * centroids and then migrated to their new processors.
+ */
+static void balance_mesh_weighted(Omega_h::Mesh &mesh) {
+  mesh.set_parting(OMEGA_H_ELEM_BASED);
+  auto weights = physics_element_weights(mesh);
+  auto dim = mesh.dim();
+  int nelems = mesh.nelems();
+  int nverts_per_elem = dim + 1;
+
+  Omega_h::HostRead<Omega_h::LO> elems2verts(mesh.ask_elem_verts());
+  Omega_h::HostRead<Omega_h::Real> coords(mesh.coords());
+  Omega_h::HostRead<Omega_h::Real> h_weights(weights);
+
+  std::vector<double> centroids(3 * nelems, 0.0);
+  std::vector<double> elem_weights(nelems);
+  for (int e = 0; e < nelems; e++) {
+    for (int v = 0; v < nverts_per_elem; v++) {
+      auto vert = elems2verts[e * nverts_per_elem + v];
+      for (int d = 0; d < dim; d++) {
+        centroids[3 * e + d] += coords[vert * dim + d] / nverts_per_elem;
+      }
+    }
+    elem_weights[e] = h_weights[e];
+  }
+
+  std::vector<int> parts = rcb_partition(MPI_COMM_WORLD, Num_Proc, centroids, elem_weights);
+
+  std::vector<double> part_weights(Num_Proc, 0.0);
+  for (int e = 0; e < nelems; e++) {
+    part_weights[parts[e]] += elem_weights[e];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, part_weights.data(), Num_Proc, MPI_DOUBLE, MPI_SUM,
+                MPI_COMM_WORLD);
+  if (ProcID == 0) {
+    double total_weight = std::accumulate(part_weights.begin(), part_weights.end(), 0.0);
+    std::cout << "Weighted imbalance after balance = "
+              << *std::max_element(part_weights.begin(), part_weights.end()) * Num_Proc /
+                     total_weight
+              << "\n";
+  }
+
+  Omega_h::HostWrite<Omega_h::I32> dest_ranks(nelems);
+  for (int e = 0; e < nelems; e++) {
+    dest_ranks[e] = parts[e];
+  }
+
+  // each processor pulls the elements sent to it from their old owners
+  Omega_h::Dist dist;
+  dist.set_parent_comm(mesh.comm());
+  dist.set_dest_ranks(Omega_h::Read<Omega_h::I32>(dest_ranks.write()));
+  auto owner_ranks = dist.exch(Omega_h::Read<Omega_h::I32>(nelems, mesh.comm()->rank()), 1);
+  auto owner_idxs = dist.exch(Omega_h::LOs(nelems, 0, 1), 1);
+  mesh.migrate(Omega_h::Remotes(owner_ranks, owner_idxs));
+}
+
+/*
+ * Adapt the mesh towards the target metric and rebalance it.  Returns
+ * false if the mesh already satisfied the metric, in which case it is
+ * left as it was, distribution included.
+ */
+bool adapt_mesh(Omega_h::Mesh &mesh) {
   Omega_h::MetricInput genopts;
-  //  genopts.sources.push_back(
-  //      Omega_h::MetricSource{OMEGA_H_VARIATION, 1e-3, "phi", OMEGA_H_ISO_SIZE});
-  genopts.sources.push_back(Omega_h::MetricSource{OMEGA_H_GIVEN, 1.0, "iso_size_metric",
-                                                  OMEGA_H_ISO_SIZE, OMEGA_H_ABSOLUTE});
-  //      genopts.sources.push_back(Omega_h::MetricSource{OMEGA_H_GIVEN, 1.0,
-  //    "initial_metric",OMEGA_H_ISO_SIZE,OMEGA_H_ABSOLUTE});
+  switch (adapt_metric_type()) {
+  case ADAPT_METRIC_ZZ:
+    add_zz_size_metric_tag(mesh);
+    genopts.sources.push_back(Omega_h::MetricSource{OMEGA_H_GIVEN, 1.0, "zz_size_metric",
+                                                    OMEGA_H_ISO_SIZE, OMEGA_H_ABSOLUTE});
+    break;
+  case ADAPT_METRIC_HESSIAN:
+    for (auto &name : adapt_variable_names(mesh)) {
+      genopts.sources.push_back(Omega_h::MetricSource{OMEGA_H_VARIATION, tran->adapt_error_tol,
+                                                      name, OMEGA_H_ANISOTROPIC,
+                                                      OMEGA_H_ABSOLUTE});
+    }
+    break;
+  default:
+    genopts.sources.push_back(Omega_h::MetricSource{OMEGA_H_GIVEN, 1.0, "iso_size_metric",
+                                                    OMEGA_H_ISO_SIZE, OMEGA_H_ABSOLUTE});
+    break;
+  }
   genopts.should_limit_lengths = true;
-  genopts.min_length = 1e-6;
-  genopts.max_length = 0.6;
+  genopts.min_length = tran->adapt_min_length;
+  genopts.max_length = tran->adapt_max_length;
   genopts.should_limit_gradation = true;
   genopts.max_gradation_rate = 0.3;
+  if (tran->adapt_max_elems > 0) {
+    genopts.should_limit_element_count = true;
+    genopts.min_element_count = tran->adapt_min_elems;
+    genopts.max_element_count = tran->adapt_max_elems;
+  }
   Omega_h::add_implied_isos_tag(&mesh);
   Omega_h::generate_target_metric_tag(&mesh, genopts);
 
@@ -1238,11 +1786,12 @@ void adapt_mesh(Omega_h::Mesh &mesh) {
     opts.xfer_opts.type_map[efv->name[w]] = OMEGA_H_LINEAR_INTERP;
   }
   opts.max_length_allowed = 5;
-  opts.max_length_desired = 1.8;
+  opts.max_length_desired = adapt_max_length_desired;
   opts.should_coarsen_slivers = true;
   opts.should_refine = true;
   opts.min_quality_desired = 0.5;
   int count = 1000;
+  bool changed = false;
 
   for (int i = 0; i < count; i++) {
     if (Omega_h::approach_metric(&mesh, opts)) {
@@ -1250,27 +1799,26 @@ void adapt_mesh(Omega_h::Mesh &mesh) {
         std::cout << "Omega_h approach_metric adapt count = " << i << "\n";
       }
       Omega_h::adapt(&mesh, opts);
+      changed = true;
     } else {
       break;
     }
   }
+  if (!changed) {
+    return false;
+  }
   auto imb = mesh.imbalance();
   if (ProcID == 0) {
     std::cout << "Mesh imbalance = " << imb << "\n";
   }
-  if (power_of_two(Num_Proc)) {
-    mesh.balance();
+  if (Num_Proc > 1) {
+    balance_mesh_weighted(mesh);
     imb = mesh.imbalance();
     if (ProcID == 0) {
       std::cout << "Mesh imbalance after balance = " << imb << "\n";
     }
-  } else {
-    GOMA_WH_MANY(GOMA_ERROR,
-                 "Omega_h requires a power of 2 number of processors to balance the mesh");
-    if (imb > 2.5) {
-      GOMA_EH(-1, "Mesh imbalance too large: %g exiting", imb);
-    }
   }
+  return true;
 }
 
 extern "C" {
@@ -1322,19 +1870,20 @@ void copy_solution(Exo_DB *exo, Dpi *dpi, double **x, Omega_h::Mesh &mesh) {
 }
 
 // start with just level set field
-void adapt_mesh_omega_h(struct GomaLinearSolverData **ams,
-                        Exo_DB *exo,
-                        Dpi *dpi,
-                        double **x,
-                        double **x_old,
-                        double **x_older,
-                        double **xdot,
-                        double **xdot_old,
-                        double **x_oldest,
-                        double **resid_vector,
-                        double **x_update,
-                        double **scale,
-                        int step) {
+int adapt_mesh_omega_h(struct GomaLinearSolverData **ams,
+                       Exo_DB *exo,
+                       Dpi *dpi,
+                       double **x,
+                       double **x_old,
+                       double **x_older,
+                       double **xdot,
+                       double **xdot_old,
+                       double **x_oldest,
+                       double **resid_vector,
+                       double **x_update,
+                       double **scale,
+                       int step,
+                       int on_error) {
 
   static std::string base_name;
   static bool first_call = true;
@@ -1347,15 +1896,30 @@ void adapt_mesh_omega_h(struct GomaLinearSolverData **ams,
 #ifdef DEBUG_OMEGA_H
   verbose = true;
 #endif
-  Omega_h::Mesh mesh(&lib);
-  goma::exodus::convert_goma_to_omega_h(exo, dpi, x, &mesh, verbose);
-  adapt_mesh(mesh);
-
   if (first_call) {
     base_name = std::string(ExoFileOutMono);
     first_call = false;
   }
 
+  Omega_h::Mesh mesh(&lib);
+  goma::exodus::convert_goma_to_omega_h(exo, dpi, x, &mesh, verbose);
+  if (on_error) {
+    auto error = adapt_error_estimate(mesh);
+    if (ProcID == 0) {
+      std::cout << "Omega_h adapt error estimate = " << error
+                << " threshold = " << tran->adapt_error_threshold << "\n";
+    }
+    if (error <= tran->adapt_error_threshold) {
+      return FALSE;
+    }
+  }
+  if (!adapt_mesh(mesh)) {
+    if (ProcID == 0) {
+      std::cout << "Omega_h mesh already satisfies the metric, not adapted\n";
+    }
+    return FALSE;
+  }
+
   std::stringstream ss2;
 
   if (step == 0) {
@@ -1399,7 +1963,7 @@ void adapt_mesh_omega_h(struct GomaLinearSolverData **ams,
   }
   resetup_matrix(ams, exo, dpi);
   copy_solution(exo, dpi, x, mesh);
-  step++;
+  return TRUE;
 }
 
 } // extern "C"
@@ -191,6 +191,13 @@ int resetup_problem(Exo_DB *exo, /* ptr to the finite element mesh database */
 int resetup_matrix(struct GomaLinearSolverData **ams, Exo_DB *exo, Dpi *dpi) {
   if ((strcmp(Matrix_Format, "tpetra") == 0) || (strcmp(Matrix_Format, "epetra") == 0)) {
     for (pg->imtrx = 0; pg->imtrx < upd->Total_Num_Matrices; pg->imtrx++) {
+      /* The solver, its builder and any kept preconditioner were set up
+       * on the old maps; the next solve starts over on the new matrix */
+      if (ams[pg->imtrx]->DestroySolverData) {
+        ams[pg->imtrx]->DestroySolverData(ams[pg->imtrx]);
+        ams[pg->imtrx]->DestroySolverData = NULL;
+        ams[pg->imtrx]->SolverData = NULL;
+      }
       GomaSparseMatrix goma_matrix = ams[pg->imtrx]->GomaMatrixData;
       GomaSparseMatrix_Destroy(&goma_matrix);
       GomaSparseMatrix_CreateFromFormat(&goma_matrix, Matrix_Format);
@@ -37,6 +37,25 @@ goma_error free_base_mesh(Exo_DB *exo) {
   return error;
 }
 
+/*
+ * The serial base mesh points into exo, give it a copy of its own so that
+ * exo can be modified in place (e.g. by reorder_mesh)
+ */
+goma_error unalias_base_mesh(Dpi *dpi, Exo_DB *exo) {
+  if (!exo->base_mesh_is_serial) {
+    return GOMA_SUCCESS;
+  }
+  int *node_map = exo->base_mesh->node_map;
+  int *elem_map = exo->base_mesh->elem_map;
+  free(exo->base_mesh);
+  goma_error error = setup_base_mesh_parallel(dpi, exo);
+  exo->base_mesh->node_map = node_map;
+  exo->base_mesh->elem_map = elem_map;
+  exo->base_mesh->ss_node_len = exo->ss_node_len;
+  exo->base_mesh->elem_var_tab = exo->elem_var_tab;
+  return error;
+}
+
 static goma_error setup_base_mesh_serial(Dpi *dpi, Exo_DB *exo) {
   // serial mesh is same as Exo_DB so just point to Exo_DB
   struct Exodus_Base *base = malloc(sizeof(struct Exodus_Base));
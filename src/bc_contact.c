@@ -66,6 +66,7 @@
 #include "mm_unknown_map.h"
 #include "rf_bc.h"
 #include "rf_bc_const.h"
+#include "rf_bdf.h"
 #include "rf_fem.h"
 #include "rf_fem_const.h"
 #include "rf_masks.h"
@@ -245,8 +246,10 @@ int apply_contact_bc(double x[],              /* Solution vector for the current
 
     if (TimeIntegration != STEADY && pd->e[pg->imtrx][MESH_DISPLACEMENT1]) {
       for (icount = 0; icount < ielem_dim; icount++) {
-        x_dot[icount] = (1 + 2. * theta) * (fv->x[icount] - fv_old->x[icount]) / delta_t -
-                        2. * theta * fv_dot->x[icount];
+        x_dot[icount] = (1 + 2. * theta) * (fv->x[icount] - fv_old->x[icount]) / delta_t +
+                        time_derivative_history(fv->x[icount], fv_old->x[icount],
+                                                fv_dot->x[icount], fv_dot->x[icount], theta,
+                                                delta_t);
         /* calculate surface position for wall repulsion/no penetration condition */
       }
 
@@ -1667,8 +1670,9 @@ int assemble_embedded_bc(int ielem,    /* element number */
 
         for (a = 0; a < ei[pg->imtrx]->ielem_dim; a++) {
           if (pd->TimeIntegration != STEADY && pd->v[pg->imtrx][MESH_DISPLACEMENT1 + a]) {
-            x_dot[a] =
-                (1. + 2. * theta) * (fv->x[a] - fv_old->x[a]) / dt - 2. * theta * fv_dot->x[a];
+            x_dot[a] = (1. + 2. * theta) * (fv->x[a] - fv_old->x[a]) / dt +
+                       time_derivative_history(fv->x[a], fv_old->x[a], fv_dot->x[a], fv_dot->x[a],
+                                               theta, dt);
           } else {
             x_dot[a] = 0.;
           }
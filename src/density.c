@@ -48,6 +48,7 @@
 #include "mm_mp_structs.h"
 #include "mm_ns_bc.h"
 #include "mm_post_def.h"
+#include "mm_qp_props.h"
 #include "mm_qtensor_model.h"
 #include "mm_shell_util.h"
 #include "mm_species.h"
@@ -72,11 +73,11 @@
 #include <string.h>
 /********************************************************************************/
 
-double density(DENSITY_DEPENDENCE_STRUCT *d_rho, double time)
+static double density_eval(DENSITY_DEPENDENCE_STRUCT *d_rho, double time)
 
 /**************************************************************************
  *
- * density
+ * density_eval
  *
  *   Calculate the density and its derivatives at the local gauss point
  *
@@ -856,3 +857,20 @@ double density(DENSITY_DEPENDENCE_STRUCT *d_rho, double time)
 
   return (rho);
 }
+
+double density(DENSITY_DEPENDENCE_STRUCT *d_rho, double time)
+/*
+ * Density and its derivatives at the local gauss point, reusing the last
+ * evaluation while the field variables are unchanged (see mm_qp_props.h)
+ */
+{
+  dbl rho;
+
+  if (qp_prop_lookup(QP_PROP_DENSITY, time, NULL, 0, d_rho, sizeof(DENSITY_DEPENDENCE_STRUCT),
+                     &rho)) {
+    return (rho);
+  }
+  rho = density_eval(d_rho, time);
+  qp_prop_store(QP_PROP_DENSITY, time, NULL, 0, d_rho, sizeof(DENSITY_DEPENDENCE_STRUCT), rho);
+  return (rho);
+}
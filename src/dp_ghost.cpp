@@ -12,7 +12,6 @@
 * See LICENSE file.                                                       *
 \************************************************************************/
 #include <algorithm>
-#include <array>
 #include <cstdio>
 #include <cstring>
 #include <exodusII.h>
@@ -28,6 +27,8 @@
 // not needed except to avoid including as a C file
 
 #include "dp_ghost.h"
+#include "util/goma_exchange.h"
+#include "util/goma_memory.h"
 
 extern "C" {
 #include "el_elm.h"
@@ -37,6 +38,7 @@ extern "C" {
 #include "mm_fill_fill.h"
 #include "mm_mp.h"
 #include "rd_mesh.h"
+#include "rf_allo.h"
 #include "rf_mp.h"
 #include "std.h"
 struct Material_Properties;
@@ -47,6 +49,7 @@ struct shared_elem {
   int type;
   int id;
   int n_nodes;
+  int n_attr;
 };
 
 struct shared_node {
@@ -68,17 +71,99 @@ template <> struct std::hash<shared_elem> {
   std::size_t operator()(shared_elem const &elem) const noexcept { return elem.id; }
 };
 
+// everything built while ghosting is charged to the ghost memory tag
+template <class T> using ghost_vector = goma::tracked_vector<T, GOMA_MEM_GHOST>;
+template <class K> using ghost_set = goma::tracked_unordered_set<K, GOMA_MEM_GHOST>;
+template <class K, class V> using ghost_map = goma::tracked_unordered_map<K, V, GOMA_MEM_GHOST>;
+
+// the mesh arrays grown here keep the tag they were allocated with
+static void *ghost_realloc(void *ptr, size_t bytes) {
+  void *new_ptr = realloc(ptr, bytes);
+  if (new_ptr != NULL) {
+    goma_mem_track_realloc(ptr, new_ptr, bytes);
+  }
+  return new_ptr;
+}
+
+// one message to a neighbor, a sequence of length prefixed arrays
+class ghost_message {
+public:
+  template <class T> void put(const ghost_vector<T> &values) {
+    int n = values.size();
+    put_raw(&n, sizeof(int));
+    put_raw(values.data(), n * sizeof(T));
+  }
+
+  const char *data() const { return bytes.data(); }
+  int size() const { return bytes.size(); }
+
+private:
+  void put_raw(const void *values, size_t n_bytes) {
+    size_t offset = bytes.size();
+    bytes.resize(offset + n_bytes);
+    if (n_bytes > 0) {
+      memcpy(bytes.data() + offset, values, n_bytes);
+    }
+  }
+
+  ghost_vector<char> bytes;
+};
+
+// reads back, in the same order, the arrays put in the message from neighbor i
+class ghost_message_reader {
+public:
+  ghost_message_reader(const goma_exchange_recv &recv, int i)
+      : pos(recv.data + recv.offset[i]), end(recv.data + recv.offset[i + 1]) {}
+
+  template <class T> ghost_vector<T> get() {
+    int n;
+    get_raw(&n, sizeof(int));
+    ghost_vector<T> values(n);
+    get_raw(values.data(), n * sizeof(T));
+    return values;
+  }
+
+private:
+  void get_raw(void *values, size_t n_bytes) {
+    GOMA_ASSERT_ALWAYS(pos + n_bytes <= end);
+    if (n_bytes > 0) {
+      memcpy(values, pos, n_bytes);
+    }
+    pos += n_bytes;
+  }
+
+  const char *pos;
+  const char *end;
+};
+
+// send messages[i] to dpi->neighbor[i], one message each way per neighbor
+static void exchange_with_neighbors(const Dpi *dpi,
+                                    int tag,
+                                    const ghost_vector<const ghost_message *> &messages,
+                                    goma_exchange_recv *recv) {
+  ghost_vector<const void *> send(dpi->num_neighbors);
+  ghost_vector<int> send_bytes(dpi->num_neighbors);
+  for (int i = 0; i < dpi->num_neighbors; i++) {
+    send[i] = messages[i]->data();
+    send_bytes[i] = messages[i]->size();
+  }
+  if (goma_exchange_neighbors(MPI_COMM_WORLD, tag, dpi->num_neighbors, dpi->neighbor, send.data(),
+                              send_bytes.data(), recv) != 0) {
+    GOMA_EH(GOMA_ERROR, "out of memory exchanging ghost information with neighbors");
+  }
+}
+
 goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
-  MPI_Datatype shared_elem_mpi;
-  MPI_Type_contiguous(sizeof(shared_elem), MPI_BYTE, &shared_elem_mpi);
-  MPI_Type_commit(&shared_elem_mpi);
+  goma::mem_tag_scope mem_tag(GOMA_MEM_GHOST);
 
-  MPI_Datatype shared_node_mpi;
-  MPI_Type_contiguous(sizeof(shared_node), MPI_BYTE, &shared_node_mpi);
-  MPI_Type_commit(&shared_node_mpi);
+  // blocks with no local elements have no attribute array to grow
+  ghost_vector<bool> had_attr(exo->num_elem_blocks);
+  for (int i = 0; i < exo->num_elem_blocks; i++) {
+    had_attr[i] = exo->eb_attr != NULL && exo->eb_num_elems[i] * exo->eb_num_attr[i] > 0;
+  }
 
   // setup num_nodes_per_elem
-  std::vector<int> eb_num_nodes_per_elem(exo->num_elem_blocks);
+  ghost_vector<int> eb_num_nodes_per_elem(exo->num_elem_blocks);
   std::fill(eb_num_nodes_per_elem.begin(), eb_num_nodes_per_elem.end(), 0);
   MPI_Allreduce(exo->eb_num_nodes_per_elem, eb_num_nodes_per_elem.data(), exo->num_elem_blocks,
                 MPI_INT, MPI_MAX, MPI_COMM_WORLD);
@@ -87,43 +172,53 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   }
 
   // setup eb_num_attr
-  std::vector<int> eb_num_attr(exo->num_elem_blocks);
+  ghost_vector<int> eb_num_attr(exo->num_elem_blocks);
   MPI_Allreduce(exo->eb_num_attr, eb_num_attr.data(), exo->num_elem_blocks, MPI_INT, MPI_MAX,
                 MPI_COMM_WORLD);
   for (int i = 0; i < exo->num_elem_blocks; i++) {
     exo->eb_num_attr[i] = eb_num_attr[i];
   }
 
-  // setup eb_elem_type
-  std::vector<std::array<char, MAX_STR_LENGTH>> local_elem_type(exo->num_elem_blocks);
-  std::vector<std::array<char, MAX_STR_LENGTH>> global_elem_type(Num_Proc * exo->num_elem_blocks);
+  // setup eb_elem_type, every processor with elements in a block has the same name for it and
+  // the others have "NULL", so a bytewise max with NULL as zeros gives the name everywhere
+  // without gathering every processor's names
+  ghost_vector<unsigned char> local_elem_type(MAX_STR_LENGTH * exo->num_elem_blocks, 0);
+  ghost_vector<unsigned char> global_elem_type(MAX_STR_LENGTH * exo->num_elem_blocks);
   for (int i = 0; i < exo->num_elem_blocks; i++) {
-    memcpy(local_elem_type[i].data(), exo->eb_elem_type[i], MAX_STR_LENGTH);
+    if (strncmp(exo->eb_elem_type[i], "NULL", MAX_STR_LENGTH) != 0) {
+      strncpy((char *)&local_elem_type[i * MAX_STR_LENGTH], exo->eb_elem_type[i],
+              MAX_STR_LENGTH - 1);
+    }
   }
 
-  MPI_Allgather(local_elem_type.data(), MAX_STR_LENGTH * exo->num_elem_blocks, MPI_BYTE,
-                global_elem_type.data(), MAX_STR_LENGTH * exo->num_elem_blocks, MPI_BYTE,
+  MPI_Allreduce(local_elem_type.data(), global_elem_type.data(),
+                MAX_STR_LENGTH * exo->num_elem_blocks, MPI_UNSIGNED_CHAR, MPI_MAX,
                 MPI_COMM_WORLD);
 
   for (int i = 0; i < exo->num_elem_blocks; i++) {
-    if (strncmp((const char *)local_elem_type[i].data(), "NULL", MAX_STR_LENGTH) == 0) {
-      for (int j = 0; j < Num_Proc; j++) {
-        if (strncmp((const char *)global_elem_type[j * exo->num_elem_blocks + i].data(), "NULL",
-                    MAX_STR_LENGTH) != 0) {
-          memcpy(exo->eb_elem_type[i], global_elem_type[j * exo->num_elem_blocks + i].data(),
-                 MAX_STR_LENGTH);
-        }
+    const char *elem_type = (const char *)&global_elem_type[i * MAX_STR_LENGTH];
+    if (strncmp(exo->eb_elem_type[i], "NULL", MAX_STR_LENGTH) == 0) {
+      if (elem_type[0] != '\0') {
+        memcpy(exo->eb_elem_type[i], elem_type, MAX_STR_LENGTH);
       }
+    } else if (exo->eb_num_elems[i] > 0 &&
+               strncmp(exo->eb_elem_type[i], elem_type, MAX_STR_LENGTH) != 0) {
+      GOMA_EH(GOMA_ERROR, "element block %d has element type %s on some processors and not others",
+              exo->eb_id[i], exo->eb_elem_type[i]);
     }
   }
 
-  // collect nodes/elems this processor needs to send to lower processors
-  std::vector<std::vector<shared_node>> external_nodes;
+  ghost_map<int, int> neighbor_index_of;
+  for (int i = 0; i < dpi->num_neighbors; i++) {
+    neighbor_index_of[dpi->neighbor[i]] = i;
+  }
 
-  std::vector<std::vector<shared_elem>> shared_elems_neighbor(dpi->num_neighbors);
-  std::vector<std::vector<shared_node>> shared_nodes_neighbor(dpi->num_neighbors);
-  std::vector<std::unordered_set<int>> saved_nodes(dpi->num_neighbors);
-  std::vector<std::vector<int>> connectivity(dpi->num_neighbors);
+  // collect nodes/elems this processor needs to send to lower processors
+  ghost_vector<ghost_vector<shared_elem>> shared_elems_neighbor(dpi->num_neighbors);
+  ghost_vector<ghost_vector<shared_node>> shared_nodes_neighbor(dpi->num_neighbors);
+  ghost_vector<ghost_set<int>> saved_nodes(dpi->num_neighbors);
+  ghost_vector<ghost_vector<int>> connectivity(dpi->num_neighbors);
+  ghost_vector<ghost_vector<double>> attributes(dpi->num_neighbors);
 
   int offset = 0;
   int elem_offset = 0;
@@ -131,37 +226,38 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     if (i > 0) {
       elem_offset += exo->eb_num_elems[i - 1];
     }
+    int nnode_per_elem = exo->eb_num_nodes_per_elem[i];
+    int n_attr = exo->eb_num_attr[i];
+    int type = 0;
+    if (exo->eb_num_elems[i] > 0) {
+      type = get_type(exo->eb_elem_type[i], nnode_per_elem, n_attr);
+    }
+    ghost_set<int> neighbor_index;
     for (int j = 0; j < exo->eb_num_elems[i]; j++) {
-      int nnode_per_elem = exo->eb_num_nodes_per_elem[i];
       // check if neighbors need an elem
-      std::unordered_set<int> neighbor_index;
+      neighbor_index.clear();
       for (int k = 0; k < nnode_per_elem; k++) {
         int local_node = exo->eb_conn[i][j * nnode_per_elem + k];
         int owner = dpi->node_owner[local_node];
-        if (dpi->node_owner[local_node] != ProcID) {
-          // neighbor needs element find which negibhor
-          int n_index = -1;
-          for (int k = 0; k < dpi->num_neighbors; k++) {
-            if (dpi->neighbor[k] == owner) {
-              neighbor_index.insert(k);
-              n_index = k;
-            }
-          }
-          GOMA_ASSERT_ALWAYS(n_index != -1);
+        if (owner != ProcID) {
+          // neighbor needs element find which neighbor
+          auto n_index = neighbor_index_of.find(owner);
+          GOMA_ASSERT_ALWAYS(n_index != neighbor_index_of.end());
+          neighbor_index.insert(n_index->second);
         }
       }
 
       for (auto n_index : neighbor_index) {
-        int type =
-            get_type(exo->eb_elem_type[i], exo->eb_num_nodes_per_elem[i], exo->eb_num_attr[i]);
         shared_elem elem{dpi->global_elem_block_ids[i], type,
-                         dpi->elem_index_global[elem_offset + j], exo->eb_num_nodes_per_elem[i]};
+                         dpi->elem_index_global[elem_offset + j], nnode_per_elem, n_attr};
         shared_elems_neighbor[n_index].emplace_back(elem);
+        for (int a = 0; a < n_attr; a++) {
+          attributes[n_index].push_back(had_attr[i] ? exo->eb_attr[i][j * n_attr + a] : 0.0);
+        }
         for (int k = 0; k < nnode_per_elem; k++) {
           int local_node = exo->eb_conn[i][j * nnode_per_elem + k];
           connectivity[n_index].push_back(dpi->node_index_global[local_node]);
-          if (saved_nodes[n_index].find(local_node) == saved_nodes[n_index].end()) {
-            saved_nodes[n_index].insert(local_node);
+          if (saved_nodes[n_index].insert(local_node).second) {
             double coord[3] = {0.0, 0.0, 0.0};
             coord[0] = exo->x_coord[local_node];
             if (exo->num_dim > 1) {
@@ -184,79 +280,45 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     }
   }
 
-  std::vector<std::array<int, 3>> recv_sizes(dpi->num_neighbors);
-  std::vector<std::array<int, 3>> send_sizes(dpi->num_neighbors);
-  std::vector<MPI_Request> requests(dpi->num_neighbors * 2);
-
+  // elements, connectivity, coordinates and attributes go in one message per neighbor
+  ghost_vector<ghost_message> elem_messages(dpi->num_neighbors);
+  ghost_vector<const ghost_message *> elem_message_ptrs(dpi->num_neighbors);
   for (int i = 0; i < dpi->num_neighbors; i++) {
-    std::array<int, 3> sizes{static_cast<int>(shared_elems_neighbor[i].size()),
-                             static_cast<int>(connectivity[i].size()),
-                             static_cast<int>(shared_nodes_neighbor[i].size())};
-    for (unsigned int j = 0; j < sizes.size(); j++) {
-      send_sizes[i][j] = sizes[j];
-    }
-
-    MPI_Irecv(recv_sizes[i].data(), 3, MPI_INT, dpi->neighbor[i], 2500, MPI_COMM_WORLD,
-              &requests[i]);
-    MPI_Isend(send_sizes[i].data(), 3, MPI_INT, dpi->neighbor[i], 2500, MPI_COMM_WORLD,
-              &requests[dpi->num_neighbors + i]);
+    elem_messages[i].put(shared_elems_neighbor[i]);
+    elem_messages[i].put(connectivity[i]);
+    elem_messages[i].put(shared_nodes_neighbor[i]);
+    elem_messages[i].put(attributes[i]);
+    elem_message_ptrs[i] = &elem_messages[i];
   }
 
-  MPI_Waitall(dpi->num_neighbors, requests.data(), MPI_STATUSES_IGNORE);
+  goma_exchange_recv elem_recv;
+  exchange_with_neighbors(dpi, 2500, elem_message_ptrs, &elem_recv);
 
-  std::vector<std::vector<shared_elem>> recv_elems_neighbor(dpi->num_neighbors);
-  std::vector<std::vector<shared_node>> recv_shared_node(dpi->num_neighbors);
-  std::vector<std::vector<int>> recv_connectivity(dpi->num_neighbors);
-  std::vector<MPI_Request> many_requests(3 * dpi->num_neighbors * 2);
-  int req_index = 0;
+  ghost_vector<ghost_vector<shared_elem>> recv_elems_neighbor(dpi->num_neighbors);
+  ghost_vector<ghost_vector<shared_node>> recv_shared_node(dpi->num_neighbors);
+  ghost_vector<ghost_vector<int>> recv_connectivity(dpi->num_neighbors);
+  ghost_vector<ghost_vector<double>> recv_attributes(dpi->num_neighbors);
   for (int i = 0; i < dpi->num_neighbors; i++) {
-    if (recv_sizes[i][0] > 0) {
-      recv_elems_neighbor[i].resize(recv_sizes[i][0]);
-      MPI_Irecv(recv_elems_neighbor[i].data(), recv_sizes[i][0] * sizeof(shared_elem), MPI_BYTE,
-                dpi->neighbor[i], 2500, MPI_COMM_WORLD, &many_requests[req_index++]);
-    }
-    if (send_sizes[i][0] > 0) {
-      GOMA_ASSERT(send_sizes[i][0] == static_cast<int>(shared_elems_neighbor[i].size()));
-      MPI_Isend(shared_elems_neighbor[i].data(), send_sizes[i][0] * sizeof(shared_elem), MPI_BYTE,
-                dpi->neighbor[i], 2500, MPI_COMM_WORLD, &many_requests[req_index++]);
-    }
-
-    if (recv_sizes[i][1] > 0) {
-      recv_connectivity[i].resize(recv_sizes[i][1]);
-      MPI_Irecv(recv_connectivity[i].data(), recv_sizes[i][1], MPI_INT, dpi->neighbor[i], 2501,
-                MPI_COMM_WORLD, &many_requests[req_index++]);
-    }
-    if (send_sizes[i][1] > 0) {
-      GOMA_ASSERT(send_sizes[i][1] == static_cast<int>(connectivity[i].size()));
-      MPI_Isend(connectivity[i].data(), send_sizes[i][1], MPI_INT, dpi->neighbor[i], 2501,
-                MPI_COMM_WORLD, &many_requests[req_index++]);
-    }
-    if (recv_sizes[i][2] > 0) {
-      recv_shared_node[i].resize(recv_sizes[i][2]);
-      MPI_Irecv(recv_shared_node[i].data(), recv_sizes[i][2] * sizeof(shared_node), MPI_BYTE,
-                dpi->neighbor[i], 2502, MPI_COMM_WORLD, &many_requests[req_index++]);
-    }
-    if (send_sizes[i][2] > 0) {
-      GOMA_ASSERT(send_sizes[i][2] == static_cast<int>(shared_nodes_neighbor[i].size()));
-      MPI_Isend(shared_nodes_neighbor[i].data(), send_sizes[i][2] * sizeof(shared_node), MPI_BYTE,
-                dpi->neighbor[i], 2502, MPI_COMM_WORLD, &many_requests[req_index++]);
-    }
+    ghost_message_reader reader(elem_recv, i);
+    recv_elems_neighbor[i] = reader.get<shared_elem>();
+    recv_connectivity[i] = reader.get<int>();
+    recv_shared_node[i] = reader.get<shared_node>();
+    recv_attributes[i] = reader.get<double>();
   }
-
-  MPI_Waitall(req_index, many_requests.data(), MPI_STATUSES_IGNORE);
+  goma_exchange_recv_free(&elem_recv);
 
   // These elems should all be unique, there should probably be some shared nodes however
-  std::vector<int> global_nodes;
-  std::unordered_set<int> global_nodes_set;
+  ghost_vector<int> global_nodes;
+  ghost_set<int> global_nodes_set;
   for (int i = 0; i < exo->num_nodes; i++) {
     global_nodes.push_back(dpi->node_index_global[i]);
     global_nodes_set.insert(dpi->node_index_global[i]);
   }
 
-  std::unordered_set<shared_node> new_nodes;
-  std::unordered_set<int> my_boundary_nodes;
-  std::unordered_set<int> new_nodes_ids;
-  std::unordered_map<int, int> node_owner_new;
+  ghost_set<shared_node> new_nodes;
+  ghost_set<int> my_boundary_nodes;
+  ghost_set<int> new_nodes_ids;
+  ghost_map<int, int> node_owner_new;
   for (int i = 0; i < dpi->num_neighbors; i++) {
     for (auto &ref : recv_shared_node[i]) {
       if (global_nodes_set.find(ref.id) == global_nodes_set.end()) {
@@ -276,8 +338,8 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   GOMA_ASSERT(new_nodes.size() == new_nodes_ids.size());
 
   // mapping of local to global
-  std::unordered_map<int, int> global_to_local;
-  std::unordered_map<int, int> local_to_global;
+  ghost_map<int, int> global_to_local;
+  ghost_map<int, int> local_to_global;
   for (int i = 0; i < static_cast<int>(global_nodes.size()); i++) {
     global_to_local.insert(std::make_pair(global_nodes[i], i));
     local_to_global.insert(std::make_pair(i, global_nodes[i]));
@@ -288,28 +350,40 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   num_nodes_new += new_nodes.size();
   GOMA_ASSERT(num_nodes_new == static_cast<int>(global_nodes.size()));
 
-  std::unordered_map<int, int> elem_local_to_global;
-  std::unordered_map<int, int> old_elem_to_new;
+  ghost_map<int, int> elem_local_to_global;
+  ghost_map<int, int> old_elem_to_new;
+
+  // sort the received elements into blocks in one pass
+  ghost_map<int, int> block_index_of;
+  for (int block = 0; block < dpi->num_elem_blocks_global; block++) {
+    block_index_of[dpi->global_elem_block_ids[block]] = block;
+  }
+  ghost_vector<ghost_vector<shared_elem>> block_elems_new(dpi->num_elem_blocks_global);
+  ghost_vector<ghost_vector<int>> block_connectivity(dpi->num_elem_blocks_global);
+  ghost_vector<ghost_vector<double>> block_attributes(dpi->num_elem_blocks_global);
+  for (int i = 0; i < dpi->num_neighbors; i++) {
+    int conn_offset = 0;
+    int attr_offset = 0;
+    for (auto &ref : recv_elems_neighbor[i]) {
+      int block = block_index_of.at(ref.block);
+      block_elems_new[block].push_back(ref);
+      for (int j = 0; j < ref.n_nodes; j++) {
+        block_connectivity[block].push_back(
+            global_to_local.at(recv_connectivity[i][conn_offset + j]));
+      }
+      for (int a = 0; a < ref.n_attr; a++) {
+        block_attributes[block].push_back(recv_attributes[i][attr_offset + a]);
+      }
+      conn_offset += ref.n_nodes;
+      attr_offset += ref.n_attr;
+    }
+  }
 
-  // assume we only have one block to start
   int old_elem_offset = 0;
   int local_elem_offset = 0;
   for (int block = 0; block < dpi->num_elem_blocks_global; block++) {
     int block_offset = 0;
-    std::vector<shared_elem> elems_new;
-    std::vector<int> block_connectivity;
-    for (int i = 0; i < dpi->num_neighbors; i++) {
-      int conn_offset = 0;
-      for (auto &ref : recv_elems_neighbor[i]) {
-        if (ref.block == dpi->global_elem_block_ids[block]) {
-          elems_new.push_back(ref);
-          for (int j = 0; j < ref.n_nodes; j++) {
-            block_connectivity.push_back(global_to_local.at(recv_connectivity[i][conn_offset + j]));
-          }
-        }
-        conn_offset += ref.n_nodes;
-      }
-    }
+    const ghost_vector<shared_elem> &elems_new = block_elems_new[block];
 
     for (int i = 0; i < exo->eb_num_elems[block]; i++) {
       elem_local_to_global.insert(
@@ -324,19 +398,38 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     }
 
     int n_nodes = exo->eb_num_nodes_per_elem[block];
-    int *int_ptr =
-        (int *)realloc(exo->eb_conn[block], sizeof(int) * (exo->eb_num_elems[block] * n_nodes +
-                                                           elems_new.size() * n_nodes));
+    int *int_ptr = (int *)ghost_realloc(
+        exo->eb_conn[block],
+        sizeof(int) * (exo->eb_num_elems[block] * n_nodes + elems_new.size() * n_nodes));
     GOMA_ASSERT(int_ptr != NULL);
     exo->eb_conn[block] = int_ptr;
 
+    // ghost attributes follow the local ones, zero where the local elements had none
+    int n_attr = exo->eb_num_attr[block];
+    if (exo->eb_attr != NULL && n_attr > 0) {
+      int num_local_attr = exo->eb_num_elems[block] * n_attr;
+      size_t attr_bytes = sizeof(dbl) * (num_local_attr + elems_new.size() * n_attr);
+      dbl *attr_ptr =
+          (dbl *)ghost_realloc(had_attr[block] ? exo->eb_attr[block] : NULL, attr_bytes);
+      GOMA_ASSERT(attr_ptr != NULL);
+      if (!had_attr[block]) {
+        std::fill(attr_ptr, attr_ptr + num_local_attr, 0.0);
+        had_attr[block] = true;
+      }
+      std::copy(block_attributes[block].begin(), block_attributes[block].end(),
+                attr_ptr + num_local_attr);
+      exo->eb_attr[block] = attr_ptr;
+    }
+
     // setup new connectivity
     for (unsigned int i = 0; i < elems_new.size(); i++) {
       auto &elem = elems_new[i];
       elem_local_to_global.insert(std::make_pair(local_elem_offset, elem.id));
       GOMA_ASSERT(elem.n_nodes == exo->eb_num_nodes_per_elem[block]);
+      GOMA_ASSERT(elem.n_attr == exo->eb_num_attr[block]);
       for (int j = 0; j < n_nodes; j++) {
-        exo->eb_conn[block][block_offset * n_nodes + j] = block_connectivity[i * n_nodes + j];
+        exo->eb_conn[block][block_offset * n_nodes + j] =
+            block_connectivity[block][i * n_nodes + j];
       }
       block_offset++;
       local_elem_offset++;
@@ -345,15 +438,25 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     exo->eb_num_elems[block] += elems_new.size();
   }
 
+  // local elements of blocks whose attribute count only became known above
+  for (int block = 0; block < exo->num_elem_blocks && exo->eb_attr != NULL; block++) {
+    int num_attr = exo->eb_num_elems[block] * exo->eb_num_attr[block];
+    if (!had_attr[block] && num_attr > 0) {
+      exo->eb_attr[block] = (dbl *)ghost_realloc(NULL, sizeof(dbl) * num_attr);
+      GOMA_ASSERT(exo->eb_attr[block] != NULL);
+      std::fill(exo->eb_attr[block], exo->eb_attr[block] + num_attr, 0.0);
+    }
+  }
+
   int total_elems = 0;
   for (int block = 0; block < dpi->num_elem_blocks_global; block++) {
     total_elems += exo->eb_num_elems[block];
   }
 
   exo->num_elems = total_elems;
-  int *int_ptr = (int *)realloc(dpi->elem_index_global, sizeof(int) * total_elems);
+  int *int_ptr = (int *)ghost_realloc(dpi->elem_index_global, sizeof(int) * total_elems);
   GOMA_ASSERT(int_ptr != NULL);
-  std::unordered_map<int, int> elem_global_to_local;
+  ghost_map<int, int> elem_global_to_local;
   dpi->elem_index_global = int_ptr;
   for (int i = 0; i < exo->num_elems; i++) {
     dpi->elem_index_global[i] = elem_local_to_global.at(i);
@@ -361,25 +464,25 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   }
 
   exo->num_nodes = num_nodes_new;
-  int_ptr = (int *)realloc(dpi->node_index_global, sizeof(int) * num_nodes_new);
+  int_ptr = (int *)ghost_realloc(dpi->node_index_global, sizeof(int) * num_nodes_new);
   GOMA_ASSERT(int_ptr != NULL);
   dpi->node_index_global = int_ptr;
   for (int i = 0; i < exo->num_nodes; i++) {
     dpi->node_index_global[i] = local_to_global.at(i);
   }
 
-  double *double_ptr = (double *)realloc(exo->x_coord, sizeof(double) * exo->num_nodes);
+  double *double_ptr = (double *)ghost_realloc(exo->x_coord, sizeof(double) * exo->num_nodes);
   GOMA_ASSERT(double_ptr != NULL);
   exo->x_coord = double_ptr;
 
   if (exo->num_dim > 1) {
-    double_ptr = (double *)realloc(exo->y_coord, sizeof(double) * exo->num_nodes);
+    double_ptr = (double *)ghost_realloc(exo->y_coord, sizeof(double) * exo->num_nodes);
     GOMA_ASSERT(double_ptr != NULL);
     exo->y_coord = double_ptr;
   }
 
   if (exo->num_dim > 2) {
-    double_ptr = (double *)realloc(exo->z_coord, sizeof(double) * exo->num_nodes);
+    double_ptr = (double *)ghost_realloc(exo->z_coord, sizeof(double) * exo->num_nodes);
     GOMA_ASSERT(double_ptr != NULL);
     exo->z_coord = double_ptr;
   }
@@ -395,7 +498,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     }
   }
 
-  int_ptr = (int *)realloc(exo->elem_eb, sizeof(int) * exo->num_elems);
+  int_ptr = (int *)ghost_realloc(exo->elem_eb, sizeof(int) * exo->num_elems);
   GOMA_ASSERT(int_ptr != NULL);
   exo->elem_eb = int_ptr;
 
@@ -407,108 +510,75 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     exo->eb_ptr[i + 1] = exo->eb_ptr[i] + exo->eb_num_elems[i];
   }
 
-  int_ptr = (int *)realloc(dpi->node_owner, sizeof(int) * exo->num_nodes);
+  int_ptr = (int *)ghost_realloc(dpi->node_owner, sizeof(int) * exo->num_nodes);
   GOMA_ASSERT(int_ptr != NULL);
   dpi->node_owner = int_ptr;
 
-  // our neighbor list might have changed so now we have to find out which processors need our nodes
-  std::unordered_set<int> neighbors_set;
+  // our neighbor list might have changed so now we have to find out which processors need our
+  // nodes.  Each owner of one of our nodes is told which of its nodes we have, and those we hear
+  // from are the rest of our neighbors: a sparse (NBX) exchange rather than gathering every
+  // processor's neighbor list.  It probes for any source, so its tag must not be used by
+  // anything a faster processor could send once it is done here (rd_dpi uses 206 and 207)
   for (int i = num_old_nodes; i < exo->num_nodes; i++) {
     int global_id = local_to_global[i];
     dpi->node_owner[i] = node_owner_new.at(global_id);
   }
+  ghost_map<int, ghost_vector<int>> nodes_by_owner;
   for (int i = 0; i < exo->num_nodes; i++) {
     if (dpi->node_owner[i] != ProcID) {
-      neighbors_set.insert(dpi->node_owner[i]);
+      nodes_by_owner[dpi->node_owner[i]].push_back(dpi->node_index_global[i]);
     }
   }
 
-  std::vector<int> neighbor_list(neighbors_set.begin(), neighbors_set.end());
-
-  int my_neighbors = neighbor_list.size();
-  int max_neighbors;
-
-  MPI_Allreduce(&my_neighbors, &max_neighbors, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
-  std::vector<int> all_neighbors(max_neighbors * Num_Proc);
-  neighbor_list.resize(max_neighbors);
-  for (int i = my_neighbors; i < max_neighbors; i++) {
-    neighbor_list[i] = -1;
+  ghost_vector<int> owners;
+  for (auto &owner_nodes : nodes_by_owner) {
+    owners.push_back(owner_nodes.first);
+  }
+  std::sort(owners.begin(), owners.end());
+  ghost_vector<const void *> owner_send(owners.size());
+  ghost_vector<int> owner_send_bytes(owners.size());
+  for (unsigned int i = 0; i < owners.size(); i++) {
+    const ghost_vector<int> &nodes = nodes_by_owner.at(owners[i]);
+    owner_send[i] = nodes.data();
+    owner_send_bytes[i] = nodes.size() * sizeof(int);
   }
 
-  MPI_Allgather(neighbor_list.data(), max_neighbors, MPI_INT, all_neighbors.data(), max_neighbors,
-                MPI_INT, MPI_COMM_WORLD);
-
-  // loop over the neighbors and decide if we have another neighbor
-  for (int i = 0; i < Num_Proc; i++) {
-    if (i == ProcID)
-      continue;
-    for (int j = max_neighbors * i; j < (max_neighbors * i + max_neighbors); j++) {
-      if (all_neighbors[j] == ProcID) {
-        neighbors_set.insert(i);
-      }
-    }
+  goma_exchange_recv node_recv;
+  if (goma_exchange_sparse(MPI_COMM_WORLD, 2501, owners.size(), owners.data(), owner_send.data(),
+                           owner_send_bytes.data(), &node_recv) != 0) {
+    GOMA_EH(GOMA_ERROR, "out of memory finding ghost neighbors");
   }
 
-  neighbor_list.resize(neighbors_set.size());
-  neighbor_list.assign(neighbors_set.begin(), neighbors_set.end());
+  ghost_set<int> neighbors_set(owners.begin(), owners.end());
+  for (int i = 0; i < node_recv.num_procs; i++) {
+    neighbors_set.insert(node_recv.proc[i]);
+  }
+  ghost_vector<int> neighbor_list(neighbors_set.begin(), neighbors_set.end());
   std::sort(neighbor_list.begin(), neighbor_list.end());
 
   dpi->num_neighbors = neighbor_list.size();
-  int_ptr = (int *)realloc(dpi->neighbor, sizeof(int) * dpi->num_neighbors);
+  int_ptr = (int *)ghost_realloc(dpi->neighbor, sizeof(int) * dpi->num_neighbors);
   GOMA_ASSERT(int_ptr != NULL);
   dpi->neighbor = int_ptr;
   for (int i = 0; i < dpi->num_neighbors; i++) {
     dpi->neighbor[i] = neighbor_list[i];
   }
 
-  requests.resize(2 * dpi->num_neighbors);
-  std::vector<MPI_Request> requests_sendrecv(2 * dpi->num_neighbors);
-  std::vector<int> num_send_nodes(dpi->num_neighbors);
-  std::vector<int> num_recv_nodes(dpi->num_neighbors);
-
-  std::vector<std::vector<int>> global_send_nodes(dpi->num_neighbors);
-  std::vector<std::vector<int>> global_recv_nodes(dpi->num_neighbors);
+  // our nodes each neighbor has as external nodes
+  ghost_vector<ghost_vector<int>> global_send_nodes(dpi->num_neighbors);
+  int recv_index = 0;
   for (int i = 0; i < dpi->num_neighbors; i++) {
-    MPI_Irecv(&num_send_nodes[i], 1, MPI_INT, dpi->neighbor[i], 206, MPI_COMM_WORLD,
-              &requests[dpi->num_neighbors + i]);
-    // printf("Proc %d recv from Proc %d tag %d", dpi->neighbor[i], ProcID, 206);
-  }
-  for (int i = 0; i < dpi->num_neighbors; i++) {
-    num_recv_nodes[i] = 0;
-    for (int j = 0; j < exo->num_nodes; j++) {
-      if (dpi->node_owner[j] == dpi->neighbor[i]) {
-        num_recv_nodes[i] += 1;
-      }
+    if (recv_index < node_recv.num_procs && node_recv.proc[recv_index] == dpi->neighbor[i]) {
+      const int *nodes = (const int *)(node_recv.data + node_recv.offset[recv_index]);
+      size_t num_nodes = (node_recv.offset[recv_index + 1] - node_recv.offset[recv_index]) /
+                         sizeof(int);
+      global_send_nodes[i].assign(nodes, nodes + num_nodes);
+      recv_index++;
     }
-    MPI_Isend(&num_recv_nodes[i], 1, MPI_INT, dpi->neighbor[i], 206, MPI_COMM_WORLD, &requests[i]);
-    // printf("Proc %d sending to Proc %d tag %d", ProcID, dpi->neighbor[i], 206);
   }
+  goma_exchange_recv_free(&node_recv);
 
-  MPI_Waitall(dpi->num_neighbors * 2, requests.data(), MPI_STATUSES_IGNORE);
-
-  for (int i = 0; i < dpi->num_neighbors; i++) {
-    global_send_nodes[i].resize(num_send_nodes[i]);
-    MPI_Irecv(global_send_nodes[i].data(), num_send_nodes[i], MPI_INT, dpi->neighbor[i], 207,
-              MPI_COMM_WORLD, &requests[dpi->num_neighbors + i]);
-    // printf("Proc %d recv from Proc %d tag %d", dpi->neighbor[i], ProcID, 207);
-  }
-
-  for (int i = 0; i < dpi->num_neighbors; i++) {
-    global_recv_nodes[i].resize(num_recv_nodes[i]);
-    int recv_index = 0;
-    for (int j = 0; j < exo->num_nodes; j++) {
-      if (dpi->node_owner[j] == dpi->neighbor[i]) {
-        global_recv_nodes[i][recv_index++] = dpi->node_index_global[j];
-      }
-    }
-    MPI_Isend(global_recv_nodes[i].data(), num_recv_nodes[i], MPI_INT, dpi->neighbor[i], 207,
-              MPI_COMM_WORLD, &requests[i]);
-    // printf("Proc %d sending to Proc %d tag %d", ProcID, dpi->neighbor[i], 207);
-  }
-
-  MPI_Waitall(dpi->num_neighbors * 2, requests.data(), MPI_STATUSES_IGNORE);
-
-  std::unordered_set<int> new_external_nodes;
+  ghost_set<int> new_external_nodes;
   // all new nodes
   for (int i = num_old_nodes; i < exo->num_nodes; i++) {
     new_external_nodes.insert(i);
@@ -524,7 +594,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
 
   dpi->num_external_nodes = exo->num_nodes - num_old_nodes + changed_to_external;
 
-  std::unordered_set<int> new_boundary_nodes;
+  ghost_set<int> new_boundary_nodes;
   for (int i = 0; i < dpi->num_neighbors; i++) {
     for (int j = 0; j < static_cast<int>(global_send_nodes[i].size()); j++) {
       int local_id = global_to_local.at(global_send_nodes[i][j]);
@@ -547,8 +617,8 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   }
 
   // Reorder nodes to internal, boundary, external
-  std::unordered_map<int, int> old_to_new_map;
-  std::unordered_set<int> added_bn;
+  ghost_map<int, int> old_to_new_map;
+  ghost_set<int> added_bn;
   int boundary_offset = num_old_nodes - changed_to_external - new_boundary_nodes.size();
   int external_offset = num_old_nodes - changed_to_external;
   int internal_offset = 0;
@@ -565,7 +635,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
       internal_offset++;
     }
   }
-  std::unordered_set<int> result;
+  ghost_set<int> result;
   std::set_difference(new_boundary_nodes.begin(), new_boundary_nodes.end(), added_bn.begin(),
                       added_bn.end(), std::inserter(result, result.end()));
 
@@ -603,7 +673,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     for (int j = 0; j < exo->eb_num_elems[i] * exo->eb_num_nodes_per_elem[i]; j++) {
       exo->eb_conn[i][j] = old_to_new_map.at(tmp_eb_conn[j]);
     }
-    free(tmp_eb_conn);
+    safe_free(tmp_eb_conn);
   }
 
   for (int i = 0; i < exo->num_nodes; i++) {
@@ -634,7 +704,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
 
   // exchange node sets
   // find boundary nodes that are part of a nodeset
-  std::vector<std::vector<int>> ns_boundary_nodes(exo->num_node_sets);
+  ghost_vector<ghost_vector<int>> ns_boundary_nodes(exo->num_node_sets);
   for (int i = 0; i < exo->num_node_sets; i++) {
     for (int j = 0; j < exo->ns_num_nodes[i]; j++) {
       int offset = j + exo->ns_node_index[i];
@@ -645,47 +715,31 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     }
   }
 
-  std::vector<std::vector<int>> ns_recv_nodes(dpi->num_neighbors);
-
-  std::vector<MPI_Request> ns_requests(2 * dpi->num_neighbors * exo->num_node_sets);
-
-  int req_offset = 0;
-  // exchange with neighbors
-  for (int i = 0; i < dpi->num_neighbors; i++) {
-    ns_recv_nodes[i].resize(exo->num_node_sets);
-    MPI_Irecv(ns_recv_nodes[i].data(), exo->num_node_sets, MPI_INT, dpi->neighbor[i], 208,
-              MPI_COMM_WORLD, &ns_requests[req_offset++]);
+  // the same message goes to every neighbor
+  ghost_message ns_message;
+  for (int ns = 0; ns < exo->num_node_sets; ns++) {
+    ns_message.put(ns_boundary_nodes[ns]);
   }
-  std::vector<int> num_send(exo->num_node_sets);
-  for (int j = 0; j < exo->num_node_sets; j++) {
-    num_send[j] = ns_boundary_nodes[j].size();
-  }
-  for (int i = 0; i < dpi->num_neighbors; i++) {
-    MPI_Isend(&num_send[0], exo->num_node_sets, MPI_INT, dpi->neighbor[i], 208, MPI_COMM_WORLD,
-              &ns_requests[req_offset++]);
-  }
-  MPI_Waitall(req_offset, ns_requests.data(), MPI_STATUSES_IGNORE);
+  ghost_vector<const ghost_message *> ns_messages(dpi->num_neighbors, &ns_message);
+  goma_exchange_recv ns_recv;
+  exchange_with_neighbors(dpi, 2502, ns_messages, &ns_recv);
 
-  std::vector<std::vector<std::vector<int>>> ns_neighbor_external_nodes(dpi->num_neighbors);
-  req_offset = 0;
+  ghost_vector<ghost_vector<ghost_vector<int>>> ns_neighbor_external_nodes(dpi->num_neighbors);
   for (int i = 0; i < dpi->num_neighbors; i++) {
+    ghost_message_reader reader(ns_recv, i);
     ns_neighbor_external_nodes[i].resize(exo->num_node_sets);
     for (int ns = 0; ns < exo->num_node_sets; ns++) {
-      ns_neighbor_external_nodes[i][ns].resize(ns_recv_nodes[i][ns]);
-      MPI_Irecv(ns_neighbor_external_nodes[i][ns].data(), ns_recv_nodes[i][ns], MPI_INT,
-                dpi->neighbor[i], 208, MPI_COMM_WORLD, &ns_requests[req_offset++]);
-      MPI_Isend(ns_boundary_nodes[ns].data(), num_send[ns], MPI_INT, dpi->neighbor[i], 208,
-                MPI_COMM_WORLD, &ns_requests[req_offset++]);
+      ns_neighbor_external_nodes[i][ns] = reader.get<int>();
     }
   }
-  MPI_Waitall(req_offset, ns_requests.data(), MPI_STATUSES_IGNORE);
+  goma_exchange_recv_free(&ns_recv);
 
-  std::unordered_map<int, int> new_global_to_local;
+  ghost_map<int, int> new_global_to_local;
   for (int i = 0; i < exo->num_nodes; i++) {
     new_global_to_local.insert(std::make_pair(dpi->node_index_global[i], i));
   }
   // create nodeset node lists
-  std::vector<std::vector<int>> ns_nodes(exo->num_node_sets);
+  ghost_vector<ghost_vector<int>> ns_nodes(exo->num_node_sets);
   int total_ns_nodes = 0;
   for (int i = 0; i < exo->num_node_sets; i++) {
     for (int j = 0; j < exo->ns_num_nodes[i]; j++) {
@@ -706,7 +760,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   exo->ns_node_len = total_ns_nodes;
   exo->ns_distfact_len = total_ns_nodes;
 
-  int_ptr = (int *)realloc(exo->ns_node_list, sizeof(int) * exo->ns_node_len);
+  int_ptr = (int *)ghost_realloc(exo->ns_node_list, sizeof(int) * exo->ns_node_len);
   GOMA_ASSERT(int_ptr != NULL);
   exo->ns_node_list = int_ptr;
 
@@ -723,7 +777,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     }
   }
 
-  dbl *dbl_ptr = (dbl *)realloc(exo->ns_distfact_list, sizeof(dbl) * exo->ns_node_len);
+  dbl *dbl_ptr = (dbl *)ghost_realloc(exo->ns_distfact_list, sizeof(dbl) * exo->ns_node_len);
   GOMA_ASSERT(dbl_ptr != NULL);
   exo->ns_distfact_list = dbl_ptr;
 
@@ -752,65 +806,41 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   }
 
   // exchange_ss
-  std::vector<std::vector<int>> ss_elems(exo->num_side_sets);
-  std::vector<std::vector<int>> num_recv_sides(dpi->num_neighbors);
-  std::vector<int> num_send_sides(exo->num_side_sets);
-  std::vector<std::vector<int>> ss_sides(exo->num_side_sets);
+  ghost_vector<ghost_vector<int>> ss_elems(exo->num_side_sets);
+  ghost_vector<ghost_vector<int>> ss_sides(exo->num_side_sets);
   for (int ins = 0; ins < exo->num_side_sets; ins++) {
     for (int j = exo->ss_elem_index[ins]; j < exo->ss_elem_index[ins] + exo->ss_num_sides[ins];
          j++) {
       ss_elems[ins].push_back(dpi->elem_index_global[exo->ss_elem_list[j]]);
       ss_sides[ins].push_back(exo->ss_side_list[j]);
     }
-    num_send_sides[ins] = ss_sides[ins].size();
   }
 
-  std::vector<MPI_Request> ss_requests(2 * dpi->num_neighbors * exo->num_side_sets);
-
-  req_offset = 0;
-  // exchange with neighbors
-  for (int i = 0; i < dpi->num_neighbors; i++) {
-    num_recv_sides[i].resize(exo->num_side_sets);
-    MPI_Irecv(num_recv_sides[i].data(), exo->num_side_sets, MPI_INT, dpi->neighbor[i], 210,
-              MPI_COMM_WORLD, &ss_requests[req_offset++]);
-  }
-  for (int i = 0; i < dpi->num_neighbors; i++) {
-    MPI_Isend(&num_send_sides[0], exo->num_side_sets, MPI_INT, dpi->neighbor[i], 210,
-              MPI_COMM_WORLD, &ss_requests[req_offset++]);
+  ghost_message ss_message;
+  for (int ss = 0; ss < exo->num_side_sets; ss++) {
+    ss_message.put(ss_sides[ss]);
+    ss_message.put(ss_elems[ss]);
   }
-  MPI_Waitall(req_offset, ss_requests.data(), MPI_STATUSES_IGNORE);
+  ghost_vector<const ghost_message *> ss_messages(dpi->num_neighbors, &ss_message);
+  goma_exchange_recv ss_recv;
+  exchange_with_neighbors(dpi, 2503, ss_messages, &ss_recv);
 
-  std::vector<std::vector<std::vector<int>>> ss_neighbor_sides(dpi->num_neighbors);
-  std::vector<std::vector<std::vector<int>>> ss_neighbor_elem(dpi->num_neighbors);
-  req_offset = 0;
+  ghost_vector<ghost_vector<ghost_vector<int>>> ss_neighbor_sides(dpi->num_neighbors);
+  ghost_vector<ghost_vector<ghost_vector<int>>> ss_neighbor_elem(dpi->num_neighbors);
   for (int i = 0; i < dpi->num_neighbors; i++) {
+    ghost_message_reader reader(ss_recv, i);
     ss_neighbor_sides[i].resize(exo->num_side_sets);
-    for (int ss = 0; ss < exo->num_side_sets; ss++) {
-      ss_neighbor_sides[i][ss].resize(num_recv_sides[i][ss]);
-      MPI_Irecv(ss_neighbor_sides[i][ss].data(), num_recv_sides[i][ss], MPI_INT, dpi->neighbor[i],
-                211, MPI_COMM_WORLD, &ss_requests[req_offset++]);
-      MPI_Isend(ss_sides[ss].data(), num_send_sides[ss], MPI_INT, dpi->neighbor[i], 211,
-                MPI_COMM_WORLD, &ss_requests[req_offset++]);
-    }
-  }
-  MPI_Waitall(req_offset, ss_requests.data(), MPI_STATUSES_IGNORE);
-
-  req_offset = 0;
-  for (int i = 0; i < dpi->num_neighbors; i++) {
     ss_neighbor_elem[i].resize(exo->num_side_sets);
     for (int ss = 0; ss < exo->num_side_sets; ss++) {
-      ss_neighbor_elem[i][ss].resize(num_recv_sides[i][ss]);
-      MPI_Irecv(ss_neighbor_elem[i][ss].data(), num_recv_sides[i][ss], MPI_INT, dpi->neighbor[i],
-                211, MPI_COMM_WORLD, &ss_requests[req_offset++]);
-      MPI_Isend(ss_elems[ss].data(), num_send_sides[ss], MPI_INT, dpi->neighbor[i], 211,
-                MPI_COMM_WORLD, &ss_requests[req_offset++]);
+      ss_neighbor_sides[i][ss] = reader.get<int>();
+      ss_neighbor_elem[i][ss] = reader.get<int>();
     }
   }
-  MPI_Waitall(req_offset, ss_requests.data(), MPI_STATUSES_IGNORE);
+  goma_exchange_recv_free(&ss_recv);
 
   // find neighbor ss_elems that we have and add to our ss
-  std::vector<std::vector<int>> my_ss_elems(exo->num_side_sets);
-  std::vector<std::vector<int>> my_ss_sides(exo->num_side_sets);
+  ghost_vector<ghost_vector<int>> my_ss_elems(exo->num_side_sets);
+  ghost_vector<ghost_vector<int>> my_ss_sides(exo->num_side_sets);
   int total_ss_sides = 0;
   for (int ins = 0; ins < exo->num_side_sets; ins++) {
     for (int j = exo->ss_elem_index[ins]; j < exo->ss_elem_index[ins] + exo->ss_num_sides[ins];
@@ -832,11 +862,11 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   }
 
   // resetup elem_list, side_list, indices
-  int_ptr = (int *)realloc(exo->ss_elem_list, sizeof(int) * total_ss_sides);
+  int_ptr = (int *)ghost_realloc(exo->ss_elem_list, sizeof(int) * total_ss_sides);
   GOMA_ASSERT(int_ptr != NULL);
   exo->ss_elem_list = int_ptr;
 
-  int_ptr = (int *)realloc(exo->ss_side_list, sizeof(int) * total_ss_sides);
+  int_ptr = (int *)ghost_realloc(exo->ss_side_list, sizeof(int) * total_ss_sides);
   GOMA_ASSERT(int_ptr != NULL);
   exo->ss_side_list = int_ptr;
 
@@ -853,10 +883,10 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   }
 
   // find nodes for sidesets
-  std::vector<std::vector<int>> ss_nodes(exo->num_side_sets);
+  ghost_vector<ghost_vector<int>> ss_nodes(exo->num_side_sets);
   for (int ins = 0; ins < exo->num_side_sets; ins++) {
-    free(exo->ss_node_side_index[ins]);
-    free(exo->ss_node_cnt_list[ins]);
+    safe_free(exo->ss_node_side_index[ins]);
+    safe_free(exo->ss_node_cnt_list[ins]);
     exo->ss_node_side_index[ins] = (int *)malloc((exo->ss_num_sides[ins] + 1) * sizeof(int));
     if (exo->ss_num_sides[ins] > 0) {
       exo->ss_node_cnt_list[ins] = (int *)malloc((exo->ss_num_sides[ins]) * sizeof(int));
@@ -901,7 +931,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   int total_ss_nodes = 0;
   for (int ins = 0; ins < exo->num_side_sets; ins++) {
     if (ss_nodes[ins].size() > 0) {
-      int_ptr = (int *)realloc(exo->ss_node_list[ins], sizeof(int) * ss_nodes[ins].size());
+      int_ptr = (int *)ghost_realloc(exo->ss_node_list[ins], sizeof(int) * ss_nodes[ins].size());
       GOMA_ASSERT(int_ptr != NULL);
       exo->ss_node_list[ins] = int_ptr;
       for (unsigned int j = 0; j < ss_nodes[ins].size(); j++) {
@@ -912,7 +942,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   }
 
   // setup distfacts that we use but expect to be 0
-  dbl_ptr = (dbl *)realloc(exo->ss_distfact_list, sizeof(dbl) * total_ss_nodes);
+  dbl_ptr = (dbl *)ghost_realloc(exo->ss_distfact_list, sizeof(dbl) * total_ss_nodes);
   GOMA_ASSERT(dbl_ptr != NULL);
   for (int j = 0; j < total_ss_nodes; j++) {
     dbl_ptr[j] = 0.0;
@@ -925,7 +955,7 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
     ss_offset += ss_nodes[ins].size();
   }
 
-  int_ptr = (int *)realloc(dpi->elem_owner, exo->num_elems * sizeof(int));
+  int_ptr = (int *)ghost_realloc(dpi->elem_owner, exo->num_elems * sizeof(int));
   GOMA_ASSERT(int_ptr != NULL);
   dpi->elem_owner = int_ptr;
   offset = 0;
@@ -948,11 +978,11 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
   dpi->num_owned_nodes = dpi->num_internal_nodes + dpi->num_boundary_nodes;
   dpi->num_universe_nodes =
       dpi->num_internal_nodes + dpi->num_boundary_nodes + dpi->num_external_nodes;
-  free(tmp_node_index_global);
-  free(tmp_node_owner);
-  free(tmp_x);
-  free(tmp_y);
-  free(tmp_z);
+  safe_free(tmp_node_index_global);
+  safe_free(tmp_node_owner);
+  safe_free(tmp_x);
+  safe_free(tmp_y);
+  safe_free(tmp_z);
 
   /*
    *  Fill in the information in the current
@@ -990,8 +1020,9 @@ goma_error generate_ghost_elems(Exo_DB *exo, Dpi *dpi) {
 }
 
 goma_error setup_ghost_to_base(Exo_DB *exo, Dpi *dpi) {
+  goma::mem_tag_scope mem_tag(GOMA_MEM_GHOST);
   exo->ghost_node_to_base = (int *)malloc(sizeof(int) * exo->num_nodes);
-  std::unordered_map<int, int> old_map;
+  ghost_map<int, int> old_map;
   for (int i = 0; i < exo->base_mesh->num_nodes; i++) {
     old_map[exo->base_mesh->node_map[i]] = i;
   }
@@ -1008,7 +1039,7 @@ goma_error setup_ghost_to_base(Exo_DB *exo, Dpi *dpi) {
   int offset_old = 0;
   int offset_new = 0;
   for (int i = 0; i < exo->num_elem_blocks; i++) {
-    std::unordered_map<int, int> old_elem_map;
+    ghost_map<int, int> old_elem_map;
     for (int j = 0; j < exo->base_mesh->eb_num_elems[i]; j++) {
       old_elem_map[exo->base_mesh->elem_map[offset_old + j]] = j;
     }
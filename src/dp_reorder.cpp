@@ -0,0 +1,339 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Cache locality reordering of the processor mesh.
+ *
+ * After the mesh is read (and ghosted) the nodes and elements keep the order
+ * of the EXODUS II file, which is often far from the order the assembly and
+ * the linear solvers touch them in.  reorder_mesh() renumbers the owned nodes
+ * and the elements of each block so that neighbors in the mesh are close in
+ * memory.  Internal, boundary and external nodes stay in their own ranges
+ * (the communication setup depends on that) and only the owned ranges are
+ * permuted.  Output goes through ghost_node_to_base and eb_ghost_elem_to_base,
+ * which are permuted along with the mesh, so results are written in the
+ * original order.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mpi.h>
+#include <numeric>
+#include <vector>
+
+#include "dp_reorder.h"
+#include "util/mesh_ordering.h"
+
+extern "C" {
+#include "base_mesh.h"
+#include "std.h"
+}
+
+namespace {
+
+struct node_graph {
+  std::vector<int> ptr;
+  std::vector<int> adj;
+};
+
+/* offset of each element block in the processor element numbering */
+std::vector<int> block_offsets(const Exo_DB *exo) {
+  std::vector<int> offset(exo->num_elem_blocks + 1, 0);
+  for (int i = 0; i < exo->num_elem_blocks; i++) {
+    offset[i + 1] = offset[i] + exo->eb_num_elems[i];
+  }
+  return offset;
+}
+
+/* nodes are adjacent when they share an element */
+node_graph build_node_graph(const Exo_DB *exo) {
+  int num_nodes = exo->num_nodes;
+  std::vector<int> elem_ptr(num_nodes + 1, 0);
+  for (int i = 0; i < exo->num_elem_blocks; i++) {
+    int len = exo->eb_num_elems[i] * exo->eb_num_nodes_per_elem[i];
+    for (int k = 0; k < len; k++) {
+      elem_ptr[exo->eb_conn[i][k] + 1]++;
+    }
+  }
+  std::partial_sum(elem_ptr.begin(), elem_ptr.end(), elem_ptr.begin());
+
+  // node -> (block, element) pairs
+  std::vector<int> elem_block(elem_ptr[num_nodes]);
+  std::vector<int> elem_local(elem_ptr[num_nodes]);
+  std::vector<int> next(elem_ptr.begin(), elem_ptr.end() - 1);
+  for (int i = 0; i < exo->num_elem_blocks; i++) {
+    int nnodes = exo->eb_num_nodes_per_elem[i];
+    for (int j = 0; j < exo->eb_num_elems[i]; j++) {
+      for (int k = 0; k < nnodes; k++) {
+        int pos = next[exo->eb_conn[i][j * nnodes + k]]++;
+        elem_block[pos] = i;
+        elem_local[pos] = j;
+      }
+    }
+  }
+
+  node_graph g;
+  g.ptr.resize(num_nodes + 1, 0);
+  std::vector<int> marker(num_nodes, -1);
+  for (int node = 0; node < num_nodes; node++) {
+    marker[node] = node;
+    for (int pos = elem_ptr[node]; pos < elem_ptr[node + 1]; pos++) {
+      int eb = elem_block[pos];
+      int nnodes = exo->eb_num_nodes_per_elem[eb];
+      const int *conn = exo->eb_conn[eb] + elem_local[pos] * nnodes;
+      for (int k = 0; k < nnodes; k++) {
+        if (marker[conn[k]] != node) {
+          marker[conn[k]] = node;
+          g.adj.push_back(conn[k]);
+        }
+      }
+    }
+    g.ptr[node + 1] = g.adj.size();
+  }
+  return g;
+}
+
+/* reverse Cuthill-McKee order of the nodes in [begin, end) */
+std::vector<int> rcm_order(const node_graph &g, const int begin, const int end) {
+  std::vector<int> order(end - begin);
+  if (goma_rcm_order(g.ptr.data(), g.adj.data(), begin, end, order.data())) {
+    GOMA_EH(GOMA_ERROR, "Could not allocate the RCM ordering");
+  }
+  return order;
+}
+
+/* maps points in the bounding box of the mesh to Hilbert curve positions */
+struct hilbert_map {
+  int dim;
+  int bits;
+  double lo[3];
+  double scale[3];
+
+  explicit hilbert_map(const Exo_DB *exo) {
+    const double *coord[3] = {exo->x_coord, exo->y_coord, exo->z_coord};
+    dim = std::min(std::max(exo->num_dim, 1), 3);
+    bits = std::min(31, 63 / dim);
+    for (int d = 0; d < dim; d++) {
+      double hi = coord[d][0];
+      lo[d] = coord[d][0];
+      for (int i = 1; i < exo->num_nodes; i++) {
+        lo[d] = std::min(lo[d], coord[d][i]);
+        hi = std::max(hi, coord[d][i]);
+      }
+      double cells = (double)((1u << bits) - 1);
+      scale[d] = (hi > lo[d]) ? cells / (hi - lo[d]) : 0.0;
+    }
+  }
+
+  uint64_t key(const double x[3]) const {
+    uint32_t X[3] = {0, 0, 0};
+    for (int d = 0; d < dim; d++) {
+      X[d] = (uint32_t)((x[d] - lo[d]) * scale[d]);
+    }
+    return goma_hilbert_index(X, dim, bits);
+  }
+};
+
+/* order of [begin, end) by ascending key, ties keep their current order */
+std::vector<int> sort_by_key(const int begin, const int end, const std::vector<uint64_t> &key) {
+  std::vector<int> order(end - begin);
+  std::iota(order.begin(), order.end(), begin);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](int a, int b) { return key[a - begin] < key[b - begin]; });
+  return order;
+}
+
+std::vector<int> hilbert_node_order(const Exo_DB *exo,
+                                    const hilbert_map &curve,
+                                    const int begin,
+                                    const int end) {
+  const double *coord[3] = {exo->x_coord, exo->y_coord, exo->z_coord};
+  std::vector<uint64_t> key(end - begin);
+  for (int node = begin; node < end; node++) {
+    double x[3] = {0.0, 0.0, 0.0};
+    for (int d = 0; d < curve.dim; d++) {
+      x[d] = coord[d][node];
+    }
+    key[node - begin] = curve.key(x);
+  }
+  return sort_by_key(begin, end, key);
+}
+
+/* element order within block eb, by element centroid or by lowest node */
+std::vector<int> block_elem_order(const Exo_DB *exo,
+                                  const int eb,
+                                  const int reorder_type,
+                                  const hilbert_map &curve) {
+  const double *coord[3] = {exo->x_coord, exo->y_coord, exo->z_coord};
+  int nnodes = exo->eb_num_nodes_per_elem[eb];
+  std::vector<uint64_t> key(exo->eb_num_elems[eb]);
+  for (int j = 0; j < exo->eb_num_elems[eb]; j++) {
+    const int *conn = exo->eb_conn[eb] + j * nnodes;
+    if (reorder_type == MESH_REORDER_HILBERT) {
+      double x[3] = {0.0, 0.0, 0.0};
+      for (int k = 0; k < nnodes; k++) {
+        for (int d = 0; d < curve.dim; d++) {
+          x[d] += coord[d][conn[k]] / nnodes;
+        }
+      }
+      key[j] = curve.key(x);
+    } else {
+      key[j] = *std::min_element(conn, conn + nnodes);
+    }
+  }
+  return sort_by_key(0, exo->eb_num_elems[eb], key);
+}
+
+/* new[old_to_new[i]] = old[i] */
+template <typename T> void permute_values(T *values, const std::vector<int> &old_to_new) {
+  if (values == NULL) {
+    return;
+  }
+  std::vector<T> old(values, values + old_to_new.size());
+  for (size_t i = 0; i < old_to_new.size(); i++) {
+    values[old_to_new[i]] = old[i];
+  }
+}
+
+void renumber_nodes(Exo_DB *exo, Dpi *dpi, const std::vector<int> &old_to_new) {
+  permute_values(exo->x_coord, old_to_new);
+  if (exo->num_dim > 1) {
+    permute_values(exo->y_coord, old_to_new);
+  }
+  if (exo->num_dim > 2) {
+    permute_values(exo->z_coord, old_to_new);
+  }
+  if (exo->node_map_exists) {
+    permute_values(exo->node_map, old_to_new);
+  }
+  permute_values(exo->ghost_node_to_base, old_to_new);
+  permute_values(dpi->node_index_global, old_to_new);
+  permute_values(dpi->node_owner, old_to_new);
+
+  for (int i = 0; i < exo->num_elem_blocks; i++) {
+    int len = exo->eb_num_elems[i] * exo->eb_num_nodes_per_elem[i];
+    for (int k = 0; k < len; k++) {
+      exo->eb_conn[i][k] = old_to_new[exo->eb_conn[i][k]];
+    }
+  }
+
+  for (int i = 0; i < exo->ns_node_len; i++) {
+    exo->ns_node_list[i] = old_to_new[exo->ns_node_list[i]];
+  }
+
+  for (int ins = 0; ins < exo->num_side_sets; ins++) {
+    for (int side_index = 0; side_index < exo->ss_num_sides[ins]; side_index++) {
+      for (int lni = exo->ss_node_side_index[ins][side_index];
+           lni < exo->ss_node_side_index[ins][side_index + 1]; lni++) {
+        exo->ss_node_list[ins][lni] = old_to_new[exo->ss_node_list[ins][lni]];
+      }
+    }
+  }
+}
+
+void renumber_elems(Exo_DB *exo, Dpi *dpi, const std::vector<int> &old_to_new) {
+  std::vector<int> offset = block_offsets(exo);
+  for (int i = 0; i < exo->num_elem_blocks; i++) {
+    int nnodes = exo->eb_num_nodes_per_elem[i];
+    if (exo->eb_num_elems[i] == 0) {
+      continue;
+    }
+    std::vector<int> old_conn(exo->eb_conn[i], exo->eb_conn[i] + exo->eb_num_elems[i] * nnodes);
+    std::vector<int> local(exo->eb_num_elems[i]);
+    for (int j = 0; j < exo->eb_num_elems[i]; j++) {
+      local[j] = old_to_new[offset[i] + j] - offset[i];
+      std::memcpy(exo->eb_conn[i] + local[j] * nnodes, &old_conn[j * nnodes],
+                  sizeof(int) * nnodes);
+    }
+    permute_values(exo->eb_ghost_elem_to_base[i], local);
+  }
+
+  if (exo->elem_map_exists) {
+    permute_values(exo->elem_map, old_to_new);
+  }
+  permute_values(dpi->elem_index_global, old_to_new);
+  permute_values(dpi->elem_owner, old_to_new);
+
+  for (int i = 0; i < exo->ss_elem_len; i++) {
+    exo->ss_elem_list[i] = old_to_new[exo->ss_elem_list[i]];
+  }
+}
+
+} // namespace
+
+/*
+ * reorder_mesh() -- renumber nodes and elements of the processor mesh for
+ *                   cache locality
+ *
+ * MESH_REORDER_RCM orders the owned nodes by reverse Cuthill-McKee on the
+ * node graph and the elements of each block by their lowest numbered node,
+ * MESH_REORDER_HILBERT orders both along a Hilbert curve through the
+ * coordinates (element centroids).  Must be called before the derived
+ * connectivity is set up (setup_mesh_exoII).
+ */
+goma_error reorder_mesh(Exo_DB *exo, Dpi *dpi, int reorder_type) {
+  if (reorder_type == MESH_REORDER_NONE || exo->num_nodes == 0) {
+    return GOMA_SUCCESS;
+  }
+  if (reorder_type != MESH_REORDER_RCM && reorder_type != MESH_REORDER_HILBERT) {
+    GOMA_EH(GOMA_ERROR, "Unknown mesh reordering type %d", reorder_type);
+    return GOMA_ERROR;
+  }
+  if (exo->elem_elem_conn_exists || exo->node_elem_conn_exists || exo->node_node_conn_exists) {
+    GOMA_WH(GOMA_ERROR, "Mesh connectivity already built, not reordering mesh");
+    return GOMA_SUCCESS;
+  }
+
+  // the serial base mesh shares its arrays with exo
+  goma_error error = unalias_base_mesh(dpi, exo);
+  if (error != GOMA_SUCCESS) {
+    return error;
+  }
+
+  hilbert_map curve(exo);
+
+  std::vector<int> node_old_to_new(exo->num_nodes);
+  std::iota(node_old_to_new.begin(), node_old_to_new.end(), 0);
+  node_graph g;
+  if (reorder_type == MESH_REORDER_RCM) {
+    g = build_node_graph(exo);
+  }
+  int range[3] = {0, dpi->num_internal_nodes, dpi->num_internal_nodes + dpi->num_boundary_nodes};
+  for (int r = 0; r < 2; r++) {
+    if (range[r + 1] - range[r] < 2) {
+      continue;
+    }
+    std::vector<int> order = (reorder_type == MESH_REORDER_RCM)
+                                 ? rcm_order(g, range[r], range[r + 1])
+                                 : hilbert_node_order(exo, curve, range[r], range[r + 1]);
+    for (size_t k = 0; k < order.size(); k++) {
+      node_old_to_new[order[k]] = range[r] + k;
+    }
+  }
+  renumber_nodes(exo, dpi, node_old_to_new);
+
+  std::vector<int> offset = block_offsets(exo);
+  std::vector<int> elem_old_to_new(offset[exo->num_elem_blocks]);
+  for (int i = 0; i < exo->num_elem_blocks; i++) {
+    std::vector<int> order = block_elem_order(exo, i, reorder_type, curve);
+    for (size_t k = 0; k < order.size(); k++) {
+      elem_old_to_new[offset[i] + order[k]] = offset[i] + k;
+    }
+  }
+  renumber_elems(exo, dpi, elem_old_to_new);
+
+  return GOMA_SUCCESS;
+}
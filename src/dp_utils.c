@@ -69,10 +69,10 @@ DDD ddd_alloc(void) {
 
 void ddd_free(DDD p) {
   MPI_Type_free(&p->new_type);
-  free(p->block_count);
-  free(p->data_type);
-  free(p->address);
-  free(p);
+  safe_free(p->block_count);
+  safe_free(p->data_type);
+  safe_free(p->address);
+  safe_free(p);
   return;
 }
 /**********************************************************************/
@@ -112,6 +112,7 @@ void noahs_raven(void) {
   ddd_add_member(n, &Decompose_Flag, 1, MPI_INT);
   ddd_add_member(n, &Decompose_Type, 1, MPI_INT);
   ddd_add_member(n, &Skip_Fix, 1, MPI_INT);
+  ddd_add_member(n, &Mesh_Reorder_Type, 1, MPI_INT);
 
   ddd_add_member(n, &Num_Var_Init, 1, MPI_INT);
   ddd_add_member(n, &Num_Var_Bound, 1, MPI_INT);
@@ -631,6 +632,7 @@ void noahs_ark(void) {
   ddd_add_member(n, &tran->Delta_t_max, 1, MPI_DOUBLE);
   ddd_add_member(n, &tran->TimeMax, 1, MPI_DOUBLE);
   ddd_add_member(n, &tran->theta, 1, MPI_DOUBLE);
+  ddd_add_member(n, &tran->bdf_max_order, 1, MPI_INT);
   ddd_add_member(n, &tran->eps, 1, MPI_DOUBLE);
   ddd_add_member(n, tran->relaxation, MAX_NUM_MATRICES, MPI_DOUBLE);
   ddd_add_member(n, tran->relaxation_tolerance, MAX_NUM_MATRICES, MPI_DOUBLE);
@@ -658,6 +660,19 @@ void noahs_ark(void) {
   ddd_add_member(n, &tran->ale_adapt, 1, MPI_INT);
   ddd_add_member(n, &tran->ale_adapt_freq, 1, MPI_INT);
   ddd_add_member(n, &tran->ale_adapt_iso_size, 1, MPI_DOUBLE);
+  ddd_add_member(n, &tran->adapt_metric, 1, MPI_INT);
+  ddd_add_member(n, &tran->adapt_num_vars, 1, MPI_INT);
+  ddd_add_member(n, tran->adapt_vars, MAX_ADAPT_VARS * MAX_VAR_NAME_LNGTH, MPI_CHAR);
+  ddd_add_member(n, &tran->adapt_error_tol, 1, MPI_DOUBLE);
+  ddd_add_member(n, &tran->adapt_min_length, 1, MPI_DOUBLE);
+  ddd_add_member(n, &tran->adapt_max_length, 1, MPI_DOUBLE);
+  ddd_add_member(n, &tran->adapt_min_elems, 1, MPI_DOUBLE);
+  ddd_add_member(n, &tran->adapt_max_elems, 1, MPI_DOUBLE);
+  ddd_add_member(n, &tran->adapt_error_threshold, 1, MPI_DOUBLE);
+  ddd_add_member(n, &tran->checkpoint_freq, 1, MPI_INT);
+  ddd_add_member(n, &tran->checkpoint_aggregate, 1, MPI_INT);
+  ddd_add_member(n, &tran->checkpoint_restart, 1, MPI_INT);
+  ddd_add_member(n, tran->checkpoint_file, MAX_FNL, MPI_CHAR);
 
   /*
    * Solver stuff
@@ -697,6 +712,11 @@ void noahs_ark(void) {
   ddd_add_member(n, Amesos2_Package, MAX_CHAR_IN_INPUT, MPI_CHAR);
   ddd_add_member(n, Stratimikos_File, MAX_CHAR_IN_INPUT * MAX_NUM_MATRICES, MPI_CHAR);
   ddd_add_member(n, Amesos2_File, MAX_CHAR_IN_INPUT * MAX_NUM_MATRICES, MPI_CHAR);
+  ddd_add_member(n, &Teko_Block_Preconditioner, 1, MPI_INT);
+  ddd_add_member(n, Teko_Block_Preconditioner_Name, MAX_CHAR_IN_INPUT, MPI_CHAR);
+  ddd_add_member(n, Teko_Block_Inverse, MAX_CHAR_IN_INPUT, MPI_CHAR);
+  ddd_add_member(n, &Stratimikos_Prec_Reuse, 1, MPI_INT);
+  ddd_add_member(n, &Stratimikos_Prec_Reuse_Max_Solves, 1, MPI_INT);
 
   ddd_add_member(n, &Linear_Solver, 1, MPI_INT);
 
@@ -717,6 +737,10 @@ void noahs_ark(void) {
   ddd_add_member(n, &modified_newton, 1, MPI_INT);
   ddd_add_member(n, &convergence_rate_tolerance, 1, MPI_DOUBLE);
   ddd_add_member(n, &modified_newt_norm_tol, 1, MPI_DOUBLE);
+  ddd_add_member(n, &Jacobian_Reuse, 1, MPI_INT);
+  ddd_add_member(n, &Jacobian_Reuse_Max_Age, 1, MPI_INT);
+  ddd_add_member(n, &Jacobian_Reuse_Rate_Tol, 1, MPI_DOUBLE);
+  ddd_add_member(n, &Jacobian_Reuse_Mass_Tol, 1, MPI_DOUBLE);
   ddd_add_member(n, Epsilon, MAX_NUM_MATRICES * 3, MPI_DOUBLE);
   ddd_add_member(n, &Solver_Output_Format, 1, MPI_INT);
   ddd_add_member(n, &Output_Variable_Stats, 1, MPI_INT);
@@ -1015,6 +1039,7 @@ void noahs_ark(void) {
   ddd_add_member(n, &upd->SegregatedSolve, 1, MPI_INT);
   ddd_add_member(n, &upd->SegregatedSubcycles, 1, MPI_INT);
   ddd_add_member(n, &upd->AutoDiff, 1, MPI_INT);
+  ddd_add_member(n, &upd->ContractionAssembly, 1, MPI_INT);
   ddd_add_member(n, &upd->disable_pspg_tau_sensitivities, 1, MPI_INT);
   ddd_add_member(n, &upd->disable_supg_tau_sensitivities, 1, MPI_INT);
   ddd_add_member(n, &upd->supg_lagged_tau, 1, MPI_INT);
@@ -109,6 +109,7 @@ char Echo_Input_File[MAX_FNL] = "\0"; /* echo of problem def file  */
 int Decompose_Flag = 1;
 int Decompose_Type = 0;
 int Skip_Fix = 0;
+int Mesh_Reorder_Type = 0;
 
 char *GomaPetscOptions = NULL;
 int GomaPetscOptionsStrLen = 0;
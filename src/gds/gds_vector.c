@@ -6,6 +6,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "gds/gds_vec3.h"
+
 static const size_t gds_vector_size = sizeof(gds_vector);
 static const size_t double_size = sizeof(double);
 
@@ -114,12 +116,12 @@ void gds_vector_cross(const gds_vector *v, const gds_vector *u, gds_vector *cros
   assert(u->size == 3);
   assert(v->size == 3);
   assert(cross->size == 3);
-  gds_vector *cross_tmp = gds_vector_alloc(3);
-  cross_tmp->data[0] = (v->data[1] * u->data[2] - v->data[2] * u->data[1]);
-  cross_tmp->data[1] = (v->data[2] * u->data[0] - v->data[0] * u->data[2]);
-  cross_tmp->data[2] = (v->data[0] * u->data[1] - v->data[1] * u->data[0]);
-  gds_vector_copy(cross, cross_tmp);
-  gds_vector_free(cross_tmp);
+  double c0 = (v->data[1] * u->data[2] - v->data[2] * u->data[1]);
+  double c1 = (v->data[2] * u->data[0] - v->data[0] * u->data[2]);
+  double c2 = (v->data[0] * u->data[1] - v->data[1] * u->data[0]);
+  cross->data[0] = c0;
+  cross->data[1] = c1;
+  cross->data[2] = c2;
 }
 
 double gds_vector_dot(const gds_vector *v, const gds_vector *u) {
@@ -139,29 +141,29 @@ void gds_vector_rotate_around_vector(gds_vector *rotated,
   assert(rotated->size == vec_to_rotate->size);
   assert(rotated->size == axis->size);
 
-  size_t size = axis->size;
-  gds_vector *cross = gds_vector_alloc(size);
-  gds_vector *temp1 = gds_vector_alloc(size);
-  gds_vector *temp2 = gds_vector_alloc(size);
-  gds_vector_cross(axis, vec_to_rotate, cross);
-
-  gds_vector_copy(temp1, vec_to_rotate);
-  gds_vector_scale(temp1, cos(angle_radians));
-
-  gds_vector_scale(cross, sin(angle_radians));
-  double dot = gds_vector_dot(vec_to_rotate, axis);
-
-  gds_vector_copy(temp2, axis);
-  gds_vector_scale(temp2, dot * (1 - cos(angle_radians)));
+  gds_vec3 r, v, axis3;
+  gds_vec3_from_vector(&v, vec_to_rotate);
+  gds_vec3_from_vector(&axis3, axis);
+  gds_vec3_rotate_around_vector(&r, &v, &axis3, angle_radians);
+  gds_vec3_to_vector(rotated, &r);
+}
 
-  gds_vector_zero(rotated);
-  gds_vector_add(rotated, temp1);
-  gds_vector_add(rotated, cross);
-  gds_vector_add(rotated, temp2);
+void gds_vector_free(gds_vector *v) { free(v); }
 
-  gds_vector_free(cross);
-  gds_vector_free(temp1);
-  gds_vector_free(temp2);
+void *gds_vector_alloc_block(size_t count, size_t size, gds_vector **vectors) {
+  // keep every vector double aligned within the block
+  size_t struct_size = gds_vector_size + double_size * size;
+  struct_size = (struct_size + double_size - 1) / double_size * double_size;
+  char *block = calloc(count, struct_size);
+  if (block == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < count; i++) {
+    vectors[i] = (gds_vector *)(block + i * struct_size);
+    vectors[i]->size = size;
+    vectors[i]->struct_size = struct_size;
+  }
+  return block;
 }
 
-void gds_vector_free(gds_vector *v) { free(v); }
+void gds_vector_free_block(void *block) { free(block); }
@@ -211,6 +211,15 @@ String_line Stratimikos_File[MAX_NUM_MATRICES];
 
 String_line Amesos2_File[MAX_NUM_MATRICES];
 
+int Teko_Block_Preconditioner;
+
+String_line Teko_Block_Preconditioner_Name;
+
+String_line Teko_Block_Inverse;
+
+int Stratimikos_Prec_Reuse;            /* PREC_REUSE_REBUILD, _REFRESH or _KEEP */
+int Stratimikos_Prec_Reuse_Max_Solves; /* solves per preconditioner with _KEEP */
+
 /*
  * A new Aztec 2.0 option. There are more and difft options and our
  * previous options probably ought to be revised to reflect the newer
@@ -255,6 +264,11 @@ double convergence_rate_tolerance; /* tolerance for jacobian reformation
                                        based on convergence rate */
 double modified_newt_norm_tol;     /* tolerance for jacobian reformation
                                            based on residual norm */
+int Jacobian_Reuse;                /* carry the Jacobian across Newton
+                                      iterations and time steps */
+int Jacobian_Reuse_Max_Age;        /* Newton solves per Jacobian */
+double Jacobian_Reuse_Rate_Tol;    /* residual reduction that forces a refresh */
+double Jacobian_Reuse_Mass_Tol;    /* change in (1 + 2 theta) / dt that forces a refresh */
 
 double Epsilon[MAX_NUM_MATRICES][3]; /* Used for determining stopping criteria.     */
 int Solver_Output_Format;            /* Bitmap for Solver Output Format     */
@@ -2,6 +2,7 @@
 #include <vector>
 
 #include "linalg/sparse_matrix.h"
+#include "util/goma_memory.h"
 #ifdef GOMA_ENABLE_TPETRA
 #include "linalg/sparse_matrix_tpetra.h"
 #endif
@@ -25,6 +26,9 @@ extern "C" {
 #undef DISABLE_CPP
 }
 
+// the problem graph, charged to the matrix memory tag
+using ordinal_vector = goma::tracked_vector<GomaGlobalOrdinal, GOMA_MEM_MATRIX>;
+
 extern "C" goma_error GomaSparseMatrix_CreateFromFormat(GomaSparseMatrix *matrix,
                                                         char *matrix_format) {
   if (strcmp(matrix_format, "tpetra") == 0) {
@@ -96,7 +100,7 @@ extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
   MPI_Scan(&NumMyRows, &RowOffset, 1, MPI_GOMA_ORDINAL, MPI_SUM, MPI_COMM_WORLD);
   RowOffset -= NumMyRows;
 
-  std::vector<GomaGlobalOrdinal> GlobalIDs(NumMyCols);
+  ordinal_vector GlobalIDs(NumMyCols);
 
   for (int i = 0; i < NumMyRows; i++) {
     GlobalIDs[i] = i + RowOffset;
@@ -113,10 +117,10 @@ extern "C" goma_error GomaSparseMatrix_SetProblemGraph(
     matrix->global_ids[i] = GlobalIDs[i];
   }
 
-  std::vector<GomaGlobalOrdinal> rows(GlobalIDs.begin(), GlobalIDs.begin() + NumMyRows);
-  std::vector<GomaGlobalOrdinal> cols(GlobalIDs.begin(), GlobalIDs.end());
-  std::vector<GomaGlobalOrdinal> coo_rows;
-  std::vector<GomaGlobalOrdinal> coo_cols;
+  ordinal_vector rows(GlobalIDs.begin(), GlobalIDs.begin() + NumMyRows);
+  ordinal_vector cols(GlobalIDs.begin(), GlobalIDs.end());
+  ordinal_vector coo_rows;
+  ordinal_vector coo_cols;
 
   int max_nz_per_row = 0;
   int row_nz;
@@ -88,6 +88,9 @@ extern "C" goma_error g_tpetra_create_graph(GomaSparseMatrix matrix,
 
   tmp->matrix = Teuchos::rcp(new Tpetra::FECrsMatrix<double, LO, GO>((tmp->crs_graph)));
   tmp->matrix->beginAssembly();
+  tmp->x_vec = Teuchos::null;
+  tmp->b_vec = Teuchos::null;
+  tmp->vec_index.clear();
   return GOMA_SUCCESS;
 }
 
@@ -206,6 +209,56 @@ extern "C" goma_error g_tpetra_zero_row_set_diag(GomaSparseMatrix matrix,
   return GOMA_SUCCESS;
 }
 
+/*
+ * The solve vectors are allocated for the first solve (or when the number
+ * of right hand sides changes) and copied by local index instead of global
+ * id lookups.  The matrix must be fill complete.
+ */
+void g_tpetra_load_solve_vectors(GomaSparseMatrix matrix,
+                                 double *const *x_,
+                                 double *const *b_,
+                                 size_t num_vecs) {
+  auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
+  if (tmp->x_vec.is_null() || tmp->x_vec->getNumVectors() != num_vecs) {
+    tmp->x_vec = Teuchos::rcp(
+        new Tpetra::MultiVector<double, LO, GO>(tmp->matrix->getDomainMap(), num_vecs, false));
+    tmp->b_vec = Teuchos::rcp(
+        new Tpetra::MultiVector<double, LO, GO>(tmp->matrix->getRangeMap(), num_vecs, false));
+  }
+  if (tmp->vec_index.size() != static_cast<size_t>(matrix->n_rows)) {
+    // Domain and range maps are both the row map
+    auto map = tmp->x_vec->getMap();
+    tmp->vec_index.resize(matrix->n_rows);
+    for (GomaGlobalOrdinal i = 0; i < matrix->n_rows; i++) {
+      tmp->vec_index[i] = map->getLocalElement(matrix->global_ids[i]);
+    }
+  }
+
+  const LO *index = tmp->vec_index.data();
+  for (size_t k = 0; k < num_vecs; k++) {
+    auto x_data = tmp->x_vec->getDataNonConst(k);
+    auto b_data = tmp->b_vec->getDataNonConst(k);
+    const double *x_k = x_[k];
+    const double *b_k = b_[k];
+    for (GomaGlobalOrdinal i = 0; i < matrix->n_rows; i++) {
+      x_data[index[i]] = x_k[i];
+      b_data[index[i]] = b_k[i];
+    }
+  }
+}
+
+void g_tpetra_store_solution(GomaSparseMatrix matrix, double *const *x_, size_t num_vecs) {
+  auto *tmp = static_cast<TpetraSparseMatrix *>(matrix->data);
+  const LO *index = tmp->vec_index.data();
+  for (size_t k = 0; k < num_vecs; k++) {
+    auto x_data = tmp->x_vec->getData(k);
+    double *x_k = x_[k];
+    for (GomaGlobalOrdinal i = 0; i < matrix->n_rows; i++) {
+      x_k[i] = x_data[index[i]];
+    }
+  }
+}
+
 extern "C" goma_error g_tpetra_destroy(GomaSparseMatrix matrix) {
   delete static_cast<TpetraSparseMatrix *>(matrix->data);
   return GOMA_SUCCESS;
@@ -25,6 +25,13 @@
 #include "rf_fem.h"
 #include "std.h"
 
+/*
+ * Incremented whenever field variables, their gradients or their mesh
+ * derivatives are reloaded so that quantities computed from fv can be
+ * reused until the next load.
+ */
+unsigned long fv_load_id = 0;
+
 /***************************************************************************/
 /****************************************************************************/
 /****************************************************************************/
@@ -186,6 +193,7 @@ int load_fv(void)
   int *pdgv = pd->gv;
 
   status = 0;
+  fv_load_id++;
 
   /* load eqn and variable number in tensor form */
   if (pdgv[POLYMER_STRESS11]) {
@@ -2108,6 +2116,8 @@ int load_fv_grads(void)
    */
   static int zero_unused_grads = FALSE;
 
+  fv_load_id++;
+
   /*
    * grad(T)
    */
@@ -3940,6 +3950,7 @@ int load_fv_mesh_derivs(int okToZero)
   int VIMis3;
 
   status = 0;
+  fv_load_id++;
 
   VIMis3 = (VIM == 3) ? TRUE : FALSE;
 
@@ -164,6 +164,7 @@ int turning_point_alg(
   struct private_info_struct *cpi = &(con->private_info);
 
   double *a, *b, *c, *d, *x_tmp, dt_p;
+  double *cd_rhs[2];
 #ifdef SCALE_TP
   double a_big, b_big, c_big, d_big;
 #endif
@@ -302,14 +303,16 @@ int turning_point_alg(
 
   RayQ = null_vector_resid(0.0, 0.0, y, NULL, FALSE);
 
-  i = linear_solver_conwrap(c, SAME_BUT_UNSCALED_JACOBIAN, x_tmp);
-
   /* Next, "d" is calculated as a function of b and y. */
 
   calc_rhs_continuation(TP_CONT_SOL4, x, d, b, phi, x_tmp, con->turning_point_info.bif_param,
                         cgi->perturb, y, cgi->numUnks, cgi->numOwnedUnks);
 
-  i = linear_solver_conwrap(d, SAME_BUT_UNSCALED_JACOBIAN, x_tmp);
+  /* Both rhs leave the recovered Jacobian in place, solve them together */
+
+  cd_rhs[0] = c;
+  cd_rhs[1] = d;
+  i = linear_solver_conwrap_multi(cd_rhs, 2, SAME_BUT_UNSCALED_JACOBIAN, x_tmp);
 
   /*
    * Calculate the updates to bif_param (stored in dt_p),
@@ -443,6 +446,7 @@ pitchfork_alg(double *x, double *delta_x, struct con_struct *con, double reltol,
   struct private_info_struct *cpi = &(con->private_info);
 
   double *a, *b, *c, *d, *e, *f, *x_tmp, dt_p;
+  double *rhs[3];
   int i;
   double param_update, r_update, vecnorm, gnum_unks, tmp, RayQ;
   double *phi = cpi->x_tang;
@@ -528,14 +532,14 @@ pitchfork_alg(double *x, double *delta_x, struct con_struct *con, double reltol,
   calc_rhs_continuation(TP_CONT_SOL2, x, b, NULL, NULL, NULL, con->pitchfork_info.bif_param,
                         cgi->perturb, NULL, cgi->numUnks, cgi->numOwnedUnks);
 
-  i = linear_solver_conwrap(b, CHECK_JACOBIAN, NULL);
-
-  /* Next, "c" is calculated using just psi as rhs */
+  /* Next, "c" is calculated using just psi as rhs, same matrix as "b" */
 
   for (i = 0; i < cgi->numUnks; i++)
     c[i] = -psi[i];
 
-  i = linear_solver_conwrap(c, OLD_JACOBIAN, NULL);
+  rhs[0] = b;
+  rhs[1] = c;
+  i = linear_solver_conwrap_multi(rhs, 2, CHECK_JACOBIAN, NULL);
 
   /* Next, "d" is calculated as a function of a and phi. */
 
@@ -546,29 +550,29 @@ pitchfork_alg(double *x, double *delta_x, struct con_struct *con, double reltol,
 
   RayQ = null_vector_resid(0.0, 0.0, phi, NULL, FALSE);
 
-  i = linear_solver_conwrap(d, SAME_BUT_UNSCALED_JACOBIAN, x_tmp);
-
-  if (AGS_option == 1)
-    for (i = 0; i < cgi->numUnks; i++)
-      d[i] += phi[i];
-
   /* Next, "e" is calculated as a function of b and phi. */
 
   calc_rhs_continuation(TP_CONT_SOL4, x, e, b, cpi->scale_vec, x_tmp, con->pitchfork_info.bif_param,
                         cgi->perturb, phi, cgi->numUnks, cgi->numOwnedUnks);
 
-  i = linear_solver_conwrap(e, SAME_BUT_UNSCALED_JACOBIAN, x_tmp);
-
   /* Next, "f" is calculated as a function of c and phi. */
 
   calc_rhs_continuation(TP_CONT_SOL3, x, f, c, cpi->scale_vec, x_tmp, con->pitchfork_info.bif_param,
                         cgi->perturb, phi, cgi->numUnks, cgi->numOwnedUnks);
 
-  i = linear_solver_conwrap(f, SAME_BUT_UNSCALED_JACOBIAN, x_tmp);
+  /* All three rhs leave the recovered Jacobian in place, solve them together */
+
+  rhs[0] = d;
+  rhs[1] = e;
+  rhs[2] = f;
+  i = linear_solver_conwrap_multi(rhs, 3, SAME_BUT_UNSCALED_JACOBIAN, x_tmp);
 
-  if (AGS_option == 1)
+  if (AGS_option == 1) {
+    for (i = 0; i < cgi->numUnks; i++)
+      d[i] += phi[i];
     for (i = 0; i < cgi->numUnks; i++)
       f[i] += phi[i];
+  }
 
   /*
    * Calculate the updates to bif_param (stored in dt_p),
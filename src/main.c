@@ -61,6 +61,7 @@ extern void handle_ieee(void);
 #include "rd_exo.h"
 #include "rd_mesh.h"
 #include "rf_allo.h"
+#include "rf_benchmark.h"
 #include "rf_element_storage_const.h"
 #include "rf_fem.h"
 #include "rf_fem_const.h"
@@ -73,6 +74,8 @@ extern void handle_ieee(void);
 #include "rf_solver.h"
 #include "rf_solver_const.h"
 #include "std.h"
+#include "util/goma_memory.h"
+#include "util/goma_perf_log.h"
 #include "wr_dpi.h"
 #include "wr_exo.h"
 
@@ -109,6 +112,7 @@ char Echo_Input_File[MAX_FNL] = "\0"; /* echo of problem def file  */
 int Decompose_Flag = 1;
 int Decompose_Type = 0;
 int Skip_Fix = 0;
+int Mesh_Reorder_Type = 0;
 
 char *GomaPetscOptions = NULL;
 int GomaPetscOptionsStrLen = 0;
@@ -298,6 +302,7 @@ int main(int argc, char **argv)
   /* Local Declarations */
 
   double time_start, total_time; /* timing variables */
+  int mem_report = 0;            /* -mem_report */
 #ifndef PARALLEL
   /*  struct tm *tm_ptr;               additional serial timing variables */
   time_t now;
@@ -334,6 +339,16 @@ int main(int argc, char **argv)
 
   time_goma_started = time_start;
 
+  error = goma_perf_log_parse_args(&argc, argv, Goma_Perf_Log_File, GOMA_PERF_LOG_FILE_LEN);
+  GOMA_EH(error, "-perf_log needs an output file");
+  error = goma_mem_parse_args(&argc, argv, &mem_report);
+  goma_mem_enable(mem_report);
+
+#ifdef GOMA_BENCHMARKS
+  error = benchmark_parse_args(&argc, argv);
+  GOMA_EH(error, "bad -bench command line option");
+#endif
+
   Argv = argv;
 
   Argc = argc;
@@ -603,7 +618,9 @@ int main(int argc, char **argv)
   init_dpi_struct(DPI_ptr);
 
   log_msg("Reading mesh from EXODUS II file...");
+  goma_mem_push_tag(GOMA_MEM_MESH);
   error = read_mesh_exoII(EXO_ptr, DPI_ptr);
+  goma_mem_pop_tag();
 
   /*
    *   Missing files on any processor are detected at a lower level
@@ -654,7 +671,9 @@ int main(int argc, char **argv)
    */
   log_msg("Assembly allocation...");
 
+  goma_mem_push_tag(GOMA_MEM_ASSEMBLY);
   error = assembly_alloc(EXO_ptr);
+  goma_mem_pop_tag();
   GOMA_EH(error, "Problem from assembly_alloc");
 
   if (Debug_Flag) {
@@ -809,6 +828,18 @@ int main(int argc, char **argv)
    *                           SOLVE THE PROBLEM
    */
 
+#ifdef GOMA_BENCHMARKS
+  if (Goma_Benchmark_Options.enabled &&
+      (upd->Total_Num_Matrices > 1 || TimeIntegration != STEADY || Continuation != ALC_NONE ||
+       loca_in->Cont_Alg == LOCA_LSA_ONLY)) {
+    GOMA_EH(GOMA_ERROR, "-bench needs a steady, single matrix problem");
+  }
+#endif
+
+  if (mem_report) {
+    goma_mem_report(MPI_COMM_WORLD, "before solve", stdout);
+  }
+
   if (upd->Total_Num_Matrices == 1) {
     pg->imtrx = 0;
 
@@ -877,6 +908,10 @@ int main(int argc, char **argv)
 
   fix_output();
 
+  if (mem_report) {
+    goma_mem_report(MPI_COMM_WORLD, "end of run", stdout);
+  }
+
   /***********************************************************************/
   /***********************************************************************/
   /***********************************************************************/
@@ -939,6 +974,27 @@ int main(int argc, char **argv)
     GOMA_WH(unlerr, "Unlink problem with front scratch file");
   }
 
+  if (Goma_Perf_Log_File[0] != '\0') {
+    goma_perf_log perf_log;
+#ifdef PARALLEL
+    Goma_Perf_Log.wall_s = MPI_Wtime() - time_start;
+#else
+    (void)time(&now);
+    Goma_Perf_Log.wall_s = (double)now - time_start;
+#endif
+    error = goma_perf_log_reduce(&Goma_Perf_Log, MPI_COMM_WORLD, &perf_log);
+    if (error == 0 && ProcID == 0) {
+      FILE *perf_file = fopen(Goma_Perf_Log_File, "w");
+      if (perf_file == NULL || goma_perf_log_write_json(&perf_log, Input_File, perf_file) != 0) {
+        error = -1;
+      }
+      if (perf_file != NULL) {
+        fclose(perf_file);
+      }
+    }
+    GOMA_WH(error, "could not write the -perf_log file");
+  }
+
 #ifdef PARALLEL
   total_time = (MPI_Wtime() - time_start) / 60.;
   DPRINTF(stdout, "\nProc 0 runtime: %10.2f Minutes.\n\n", total_time);
@@ -15,6 +15,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "ac_update_parameter.h"
 #include "az_aztec.h"
@@ -1859,28 +1860,39 @@ int std_aug_cond(int iAC,
    *        FEM degrees of freedom ( i.e. everything except the augmenting parameter )
    */
   if (augc[iAC].Type == AC_FLUX) {
-    inventory = evaluate_flux(mf_args->exo, mf_args->dpi, augc[iAC].SSID, augc[iAC].MFID, NULL,
-                              augc[iAC].MTID, augc[iAC].COMPID, NULL, FALSE, mf_args->x,
-                              mf_args->xdot, cAC[iAC], *(mf_args->delta_t), *(mf_args->time), 0);
     if (augc[iAC].len_AC > 2) {
-      int mfid, ssid, mtid, compid;
-      double inventory1, ac_factor = 1.0;
-
-      mfid = (int)augc[iAC].DataFlt[0];
-      ssid = (int)augc[iAC].DataFlt[1];
-      mtid = (int)augc[iAC].DataFlt[2];
+      /*
+       * Both fluxes feed the same sensitivity vector, so evaluate them as one
+       * batch (one sweep per side set and one reduction).
+       */
+      struct Flux_Request rq[2];
+      double ac_factor = 1.0;
+
+      memset(rq, 0, 2 * sizeof(struct Flux_Request));
+      rq[0].ss_id = augc[iAC].SSID;
+      rq[0].quantity = augc[iAC].MFID;
+      rq[0].blk_id = augc[iAC].MTID;
+      rq[0].species_id = augc[iAC].COMPID;
+      rq[0].J_AC = cAC[iAC];
+
+      rq[1].quantity = (int)augc[iAC].DataFlt[0];
+      rq[1].ss_id = (int)augc[iAC].DataFlt[1];
+      rq[1].blk_id = (int)augc[iAC].DataFlt[2];
       if (augc[iAC].len_AC > 3) {
-        compid = (int)augc[iAC].DataFlt[3];
-      } else {
-        compid = 0;
+        rq[1].species_id = (int)augc[iAC].DataFlt[3];
       }
       if (augc[iAC].len_AC > 4) {
         ac_factor = augc[iAC].DataFlt[4];
       }
-      inventory1 = evaluate_flux(mf_args->exo, mf_args->dpi, ssid, mfid, NULL, mtid, compid, NULL,
-                                 FALSE, mf_args->x, mf_args->xdot, cAC[iAC], *(mf_args->delta_t),
-                                 *(mf_args->time), 0);
-      inventory += ac_factor * inventory1;
+      rq[1].J_AC = cAC[iAC];
+
+      evaluate_flux_batch(mf_args->exo, mf_args->dpi, 2, rq, mf_args->x, mf_args->xdot,
+                          *(mf_args->delta_t), *(mf_args->time), 0);
+      inventory = rq[0].flux + rq[0].flux_conv + ac_factor * (rq[1].flux + rq[1].flux_conv);
+    } else {
+      inventory = evaluate_flux(mf_args->exo, mf_args->dpi, augc[iAC].SSID, augc[iAC].MFID, NULL,
+                                augc[iAC].MTID, augc[iAC].COMPID, NULL, FALSE, mf_args->x,
+                                mf_args->xdot, cAC[iAC], *(mf_args->delta_t), *(mf_args->time), 0);
     }
     /*
      * And last of all. set the diagonal sensitivities to zero (but not for Level Set Velocity AC)
@@ -79,6 +79,7 @@
 #include "mm_mp.h"
 #include "mm_mp_const.h"
 #include "mm_mp_structs.h"
+#include "mm_qp_props.h"
 #include "mm_qp_storage.h"
 #include "mm_qtensor_model.h"
 #include "mm_shell_util.h"
@@ -128,12 +129,6 @@ extern struct elem_edge_bc_struct ***First_Elem_Edge_BC_Array;
 double mm_fill_total;
 extern int PRS_mat_ielem;
 
-static void load_lec(Exo_DB *, /* Exodus database pointer */
-                     int,      /* element number we are working on */
-                     struct GomaLinearSolverData *,
-                     double[],  /* Solution vector */
-                     double[],  /* Residual vector */
-                     double *); /* element stiffness Matrix for frontal solver*/
 static void zero_lec(void);
 
 /*****************************************************************************/
@@ -261,6 +256,7 @@ int matrix_fill_full(struct GomaLinearSolverData *ams,
    * Free memory allocated above
    */
   global_qp_storage_destroy();
+  qp_prop_invalidate();
 
   /*
    * Now coordinate the processors so that they all know about a negative or zero
@@ -5145,12 +5141,12 @@ int matrix_fill_stress(struct GomaLinearSolverData *ams,
   return 0;
 } /*   END OF matrix_fill_stress                                                     */
 
-static void load_lec(Exo_DB *exo, /* ptr to EXODUS II finite element mesh db */
-                     int ielem,   /* Element number we are working on */
-                     struct GomaLinearSolverData *ams,
-                     double x[],            /* Solution vector */
-                     double resid_vector[], /* Residual vector */
-                     dbl *estifm)           /* element stiffness Matrix for frontal solver*/
+void load_lec(Exo_DB *exo, /* ptr to EXODUS II finite element mesh db */
+              int ielem,   /* Element number we are working on */
+              struct GomaLinearSolverData *ams,
+              double x[],            /* Solution vector */
+              double resid_vector[], /* Residual vector */
+              dbl *estifm)           /* element stiffness Matrix for frontal solver*/
 
 /**************************************************************************
  *
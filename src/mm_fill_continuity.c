@@ -30,6 +30,7 @@
 #include "mm_eh.h"
 #include "mm_fill_aux.h"
 #include "mm_fill_common.h"
+#include "mm_fill_contract.h"
 #include "mm_fill_energy.h"
 #include "mm_fill_fill.h"
 #include "mm_fill_ls.h"
@@ -637,6 +638,10 @@ int assemble_continuity(dbl time_value, /* current time */
     }
   }
 
+  /* J_c_v and J_c_P are formed as small GEMMs after the row loop */
+  int contract_on = contraction_assembly() && !particle_momentum_on && !electrode_kinetics_on &&
+                    !ion_reactions_on && !(hydromassflux_on && suspensionsource_on);
+
   if (af->Assemble_Jacobian) {
     for (i = 0; i < ei[pg->imtrx]->dof[eqn]; i++) {
 #if 1
@@ -655,7 +660,7 @@ int assemble_continuity(dbl time_value, /* current time */
       /*
        * J_c_v NOTE that this is applied whenever velocity is a variable
        */
-      for (b = 0; b < WIM; b++) {
+      for (b = 0; b < WIM && !contract_on; b++) {
         var = VELOCITY1 + b;
         if (pdv[var]) {
           pvar = upd->vp[pg->imtrx][var];
@@ -863,7 +868,7 @@ int assemble_continuity(dbl time_value, /* current time */
        * J_c_P here species act as a volume source in continuous lagrangian mesh motion
        */
       var = PRESSURE;
-      if (pdv[var]) {
+      if (pdv[var] && !contract_on) {
         pvar = upd->vp[pg->imtrx][var];
 
         J = &(lec->J[LEC_J_INDEX(peqn, pvar, i, 0)]);
@@ -1374,6 +1379,74 @@ int assemble_continuity(dbl time_value, /* current time */
         }
       }
     }
+
+    /*
+     * J_c_v and J_c_P as contractions of [phi_i, grad_phi_i] (W) with the
+     * divergence and source coefficients (T[0]) and the PSPG sensitivities
+     * (T[1+a]) of each column dof.
+     */
+    if (contract_on) {
+      struct Contract_Block blk;
+      contract_scalar_test_functions(&blk, eqn, d_area);
+
+      for (b = 0; b < WIM; b++) {
+        var = VELOCITY1 + b;
+        if (!pdv[var])
+          continue;
+        pvar = upd->vp[pg->imtrx][var];
+        contract_zero_trial(&blk, ei[pg->imtrx]->dof[var]);
+
+        for (j = 0; j < ei[pg->imtrx]->dof[var]; j++) {
+          advection = 0.;
+          if (advection_on) {
+            div_phi_j_e_b = 0.;
+            for (p = 0; p < VIM; p++) {
+              div_phi_j_e_b += bf[var]->grad_phi_e[j][b][p][p];
+            }
+            advection = div_phi_j_e_b * advection_etm;
+          }
+
+          source = 0.;
+          if (source_on && foam_volume_source_on) {
+            source = dFVS_dv[b][j] * source_etm;
+          }
+
+          blk.T[0][j] = advection + source;
+
+          if (PSPG) {
+            for (a = 0; a < WIM; a++) {
+              meqn = R_MOMENTUM1 + a;
+              if (pd->e[pg->imtrx][meqn]) {
+                blk.T[1 + a][j] = d_pspg->v[a][b][j] * d_area * ls_disable_pspg;
+              }
+            }
+          }
+        }
+        contract_jacobian_block(&blk, eqn, peqn, pvar, ei[pg->imtrx]->dof[var], FALSE);
+      }
+
+      var = PRESSURE;
+      if (pdv[var]) {
+        pvar = upd->vp[pg->imtrx][var];
+        contract_zero_trial(&blk, ei[pg->imtrx]->dof[var]);
+
+        for (j = 0; j < ei[pg->imtrx]->dof[var]; j++) {
+          if (advection_on && (lagrangian_mesh_motion || total_ale_and_velo_off)) {
+            blk.T[0][j] = fv->d_volume_change_dp[j] * advection_etm;
+          }
+
+          if (PSPG) {
+            for (a = 0; a < WIM; a++) {
+              meqn = R_MOMENTUM1 + a;
+              if (pd->e[pg->imtrx][meqn] & T_DIFFUSION) {
+                blk.T[1 + a][j] = d_pspg->P[a][j] * d_area * ls_disable_pspg;
+              }
+            }
+          }
+        }
+        contract_jacobian_block(&blk, eqn, peqn, pvar, ei[pg->imtrx]->dof[var], FALSE);
+      }
+    }
   }
 
   return (status);
@@ -0,0 +1,132 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Small GEMM assembly of volume Jacobian blocks, see mm_fill_contract.h.
+ */
+
+#define GOMA_MM_FILL_CONTRACT_C
+
+#include "mm_fill_contract.h"
+#include "el_elm.h"
+#include "mm_as.h"
+#include "mm_as_const.h"
+#include "mm_as_structs.h"
+#include "mm_fill_ls.h"
+#include "mm_fill_util.h"
+#include "rf_fem.h"
+#include "util/small_gemm.h"
+
+/*
+ * TRUE when the "Use Contraction Assembly" card is on and nothing in the
+ * element needs the per-(i,j) logic of the scalar assemblers.  Extended
+ * XFEM dofs are switched on and off row by row, so XFEM problems always
+ * take the scalar path.
+ */
+int contraction_assembly(void) {
+  return upd->ContractionAssembly && af->Assemble_Jacobian && xfem == NULL;
+}
+
+/* W = [scale * phi_i, grad_phi_i[0..VIM-1]] */
+void contract_scalar_test_functions(struct Contract_Block *blk, const int eqn, const dbl scale) {
+  int i, p;
+  struct Basis_Functions *bfe = bf[eqn];
+
+  blk->k = 1 + VIM;
+  for (i = 0; i < ei[pg->imtrx]->dof[eqn]; i++) {
+    blk->W[i][0] = scale * bfe->phi[i];
+    for (p = 0; p < VIM; p++) {
+      blk->W[i][1 + p] = bfe->grad_phi[i][p];
+    }
+  }
+}
+
+/* W = [scale * phi_i, grad_phi_e[i][a][p][q] for p, q < VIM] */
+void contract_vector_test_functions(struct Contract_Block *blk,
+                                    const int eqn,
+                                    const int a,
+                                    const dbl scale) {
+  int i, p, q;
+  struct Basis_Functions *bfe = bf[eqn];
+
+  blk->k = 1 + VIM * VIM;
+  for (i = 0; i < ei[pg->imtrx]->dof[eqn]; i++) {
+    blk->W[i][0] = scale * bfe->phi[i];
+    for (p = 0; p < VIM; p++) {
+      for (q = 0; q < VIM; q++) {
+        blk->W[i][1 + p * VIM + q] = bfe->grad_phi_e[i][a][p][q];
+      }
+    }
+  }
+}
+
+void contract_zero_trial(struct Contract_Block *blk, const int n_j) {
+  int k, j;
+  for (k = 0; k < blk->k; k++) {
+    for (j = 0; j < n_j; j++) {
+      blk->T[k][j] = 0.;
+    }
+  }
+}
+
+/*
+ * lec->J[peqn][pvar] += W T.  With row_map set, rows follow
+ * lvdof_to_row_lvdof and inactive dofs are skipped, as in the momentum
+ * and species assemblers; otherwise row i goes to row i.  When the map
+ * is the identity the product accumulates straight into lec->J.
+ */
+void contract_jacobian_block(const struct Contract_Block *blk,
+                             const int eqn,
+                             const int peqn,
+                             const int pvar,
+                             const int n_j,
+                             const int row_map) {
+  int i, j, ii, ledof;
+  int n_i = ei[pg->imtrx]->dof[eqn];
+  int identity = TRUE;
+  dbl C[MDE][MDE];
+
+  if (row_map) {
+    for (i = 0; i < n_i && identity; i++) {
+      ledof = ei[pg->imtrx]->lvdof_to_ledof[eqn][i];
+      identity = ei[pg->imtrx]->active_interp_ledof[ledof] &&
+                 ei[pg->imtrx]->lvdof_to_row_lvdof[eqn][i] == i;
+    }
+  }
+
+  if (identity) {
+    goma_small_gemm(n_i, n_j, blk->k, &blk->W[0][0], CONTRACT_MAX_K, &blk->T[0][0], MDE,
+                    &lec->J[LEC_J_INDEX(peqn, pvar, 0, 0)], lec->max_dof);
+    return;
+  }
+
+  for (i = 0; i < n_i; i++) {
+    for (j = 0; j < n_j; j++) {
+      C[i][j] = 0.;
+    }
+  }
+  goma_small_gemm(n_i, n_j, blk->k, &blk->W[0][0], CONTRACT_MAX_K, &blk->T[0][0], MDE, &C[0][0],
+                  MDE);
+
+  for (i = 0; i < n_i; i++) {
+    ledof = ei[pg->imtrx]->lvdof_to_ledof[eqn][i];
+    if (!ei[pg->imtrx]->active_interp_ledof[ledof])
+      continue;
+    ii = ei[pg->imtrx]->lvdof_to_row_lvdof[eqn][i];
+    dbl *J = &lec->J[LEC_J_INDEX(peqn, pvar, ii, 0)];
+    for (j = 0; j < n_j; j++) {
+      J[j] += C[i][j];
+    }
+  }
+}
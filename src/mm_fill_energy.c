@@ -30,6 +30,7 @@
 #include "mm_eh.h"
 #include "mm_fill_aux.h"
 #include "mm_fill_common.h"
+#include "mm_fill_contract.h"
 #include "mm_fill_fill.h"
 #include "mm_fill_ls.h"
 #include "mm_fill_ls_capillary_bcs.h"
@@ -50,6 +51,7 @@
 #include "mm_mp_structs.h"
 #include "mm_ns_bc.h"
 #include "mm_post_def.h"
+#include "mm_qp_props.h"
 #include "mm_qtensor_model.h"
 #include "mm_shell_util.h"
 #include "mm_species.h"
@@ -384,6 +386,9 @@ int assemble_energy(
    * Jacobian terms...
    */
 
+  /* J_e_T is formed as a small GEMM after the row loop */
+  int contract_on = contraction_assembly();
+
   if (af->Assemble_Jacobian) {
     eqn = R_ENERGY;
     peqn = upd->ep[pg->imtrx][eqn];
@@ -421,7 +426,7 @@ int assemble_energy(
        * J_e_T
        */
       var = TEMPERATURE;
-      if (pd->v[pg->imtrx][var]) {
+      if (pd->v[pg->imtrx][var] && !contract_on) {
         pvar = upd->vp[pg->imtrx][var];
         for (j = 0; j < ei[pg->imtrx]->dof[var]; j++) {
           phi_j = bf[var]->phi[j];
@@ -1129,16 +1134,81 @@ int assemble_energy(
         }
       }
     }
+
+    /*
+     * J_e_T as a contraction of [phi_i, grad_phi_i] (W) with the column
+     * coefficients (T).  The upwinded weight phi_i + supg/h vconv.grad_phi_i
+     * splits into the phi_i and grad_phi_i columns.
+     */
+    var = TEMPERATURE;
+    if (contract_on && pd->v[pg->imtrx][var]) {
+      struct Contract_Block blk;
+      dbl dV = det_J * wt * h3;
+
+      pvar = upd->vp[pg->imtrx][var];
+      contract_scalar_test_functions(&blk, eqn, dV);
+      contract_zero_trial(&blk, ei[pg->imtrx]->dof[var]);
+
+      for (j = 0; j < ei[pg->imtrx]->dof[var]; j++) {
+        phi_j = bf[var]->phi[j];
+
+        mass = 0.;
+        if (pd->TimeIntegration != STEADY) {
+          if (pd->e[pg->imtrx][eqn] & T_MASS) {
+            mass = rho * d_Cp->T[j] * T_dot + d_rho->T[j] * Cp * T_dot +
+                   rho * Cp * (1 + 2. * tt) * phi_j / dt;
+            mass *= -pd->etm[pg->imtrx][eqn][(LOG2_MASS)];
+          }
+        }
+
+        /* terms weighted by wt_func */
+        advection = 0.;
+        if (pd->e[pg->imtrx][eqn] & T_ADVECTION) {
+          for (p = 0; p < VIM; p++) {
+            advection += rho * d_Cp->T[j] * vconv[p] * grad_T[p] +
+                         d_rho->T[j] * Cp * vconv[p] * grad_T[p] +
+                         rho * Cp * vconv[p] * bf[var]->grad_phi[j][p] +
+                         rho * Cp * d_vconv->T[p][j] * grad_T[p];
+          }
+          advection *= -pd->etm[pg->imtrx][eqn][(LOG2_ADVECTION)];
+        }
+
+        if (mp->Energy_Div_Term) {
+          advection -= rho * d_Cp->T[j] * fv->div_v * fv->T +
+                       d_rho->T[j] * Cp * fv->div_v * fv->T + rho * Cp * fv->div_v * phi_j;
+        }
+
+        source = 0.;
+        if (pd->e[pg->imtrx][eqn] & T_SOURCE) {
+          source = d_h->T[j] * pd->etm[pg->imtrx][eqn][(LOG2_SOURCE)];
+        }
+
+        blk.T[0][j] = mass + advection + source;
+
+        if (supg != 0.) {
+          for (p = 0; p < dim; p++) {
+            blk.T[1 + p][j] += supg * h_elem_inv * vconv[p] * advection * dV;
+          }
+        }
+
+        if (pd->e[pg->imtrx][eqn] & T_DIFFUSION) {
+          for (p = 0; p < VIM; p++) {
+            blk.T[1 + p][j] += d_q->T[p][j] * dV * pd->etm[pg->imtrx][eqn][(LOG2_DIFFUSION)];
+          }
+        }
+      }
+      contract_jacobian_block(&blk, eqn, peqn, pvar, ei[pg->imtrx]->dof[var], FALSE);
+    }
   }
 
   return (status);
 } /********************************************************************************/
 
-double conductivity(CONDUCTIVITY_DEPENDENCE_STRUCT *d_k, dbl time)
+static double conductivity_eval(CONDUCTIVITY_DEPENDENCE_STRUCT *d_k, dbl time)
 
 /**************************************************************************
  *
- * conductivity
+ * conductivity_eval
  *
  *   Calculate the thermal conductivity and its derivatives wrt to nodal dofs
  *   at the local gauss point
@@ -1345,10 +1415,10 @@ double conductivity(CONDUCTIVITY_DEPENDENCE_STRUCT *d_k, dbl time)
 
   return (k);
 }
-double heat_capacity(HEAT_CAPACITY_DEPENDENCE_STRUCT *d_Cp, dbl time)
+static double heat_capacity_eval(HEAT_CAPACITY_DEPENDENCE_STRUCT *d_Cp, dbl time)
 /**************************************************************************
  *
- * heat capacity
+ * heat_capacity_eval
  *
  *   Calculate the thermal heat capacity and its derivatives wrt to nodal dofs
  *   at the local gauss point
@@ -1515,6 +1585,36 @@ double heat_capacity(HEAT_CAPACITY_DEPENDENCE_STRUCT *d_Cp, dbl time)
 
   return (Cp);
 }
+
+/*
+ * conductivity() and heat_capacity() reuse the last evaluation at the local
+ * gauss point while the field variables are unchanged (see mm_qp_props.h)
+ */
+double conductivity(CONDUCTIVITY_DEPENDENCE_STRUCT *d_k, dbl time) {
+  double k;
+
+  if (qp_prop_lookup(QP_PROP_CONDUCTIVITY, time, NULL, 0, d_k,
+                     sizeof(CONDUCTIVITY_DEPENDENCE_STRUCT), &k)) {
+    return (k);
+  }
+  k = conductivity_eval(d_k, time);
+  qp_prop_store(QP_PROP_CONDUCTIVITY, time, NULL, 0, d_k, sizeof(CONDUCTIVITY_DEPENDENCE_STRUCT),
+                k);
+  return (k);
+}
+
+double heat_capacity(HEAT_CAPACITY_DEPENDENCE_STRUCT *d_Cp, dbl time) {
+  double Cp;
+
+  if (qp_prop_lookup(QP_PROP_HEAT_CAPACITY, time, NULL, 0, d_Cp,
+                     sizeof(HEAT_CAPACITY_DEPENDENCE_STRUCT), &Cp)) {
+    return (Cp);
+  }
+  Cp = heat_capacity_eval(d_Cp, time);
+  qp_prop_store(QP_PROP_HEAT_CAPACITY, time, NULL, 0, d_Cp,
+                sizeof(HEAT_CAPACITY_DEPENDENCE_STRUCT), Cp);
+  return (Cp);
+}
 double ls_modulate_thermalconductivity(double k1,
                                        double k2,
                                        double width,
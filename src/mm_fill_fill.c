@@ -66,6 +66,7 @@
 #include "mm_mp_structs.h"
 #include "mm_shell_util.h"
 #include "rf_allo.h"
+#include "rf_bdf.h"
 #include "rf_fem.h"
 #include "rf_fem_const.h"
 #include "rf_io.h"
@@ -337,7 +338,8 @@ int assemble_fill(double tt,
   if (pd->TimeIntegration != STEADY && pd->gv[MESH_DISPLACEMENT1]) {
     x_dot_old = fv_dot_old->x;
     for (a = 0; a < VIM; a++) {
-      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv - 2. * tt * x_dot_old[a];
+      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv +
+                 time_derivative_history(xx[a], x_old[a], fv_dot->x[a], x_dot_old[a], tt, dt);
       if (lubon)
         x_dot[a] = (1 + 2 * tt) / dt * (xx[a] - x_old[a]);
       v_rel[a] = v[a] - x_dot[a];
@@ -358,7 +360,8 @@ int assemble_fill(double tt,
     x_old = fv_old->d_rs;
     x_dot_old = fv_dot_old->d_rs;
     for (a = 0; a < VIM; a++) {
-      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv - 2. * tt * x_dot_old[a];
+      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv +
+                 time_derivative_history(xx[a], x_old[a], fv_dot->d_rs[a], x_dot_old[a], tt, dt);
     }
     for (a = 0; a < VIM; a++) {
       v_rel[a] = x_dot[a];
@@ -1601,7 +1604,8 @@ int assemble_fill_ext_v(
     x_dot_n = 0.0;
     x_dot_n_old = 0.0;
     for (a = 0; a < VIM; a++) {
-      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv - 2. * tt * x_dot_old[a];
+      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv +
+                 time_derivative_history(xx[a], x_old[a], fv_dot->x[a], x_dot_old[a], tt, dt);
       x_dot_n += x_dot[a] * lsi->normal[a];
       x_dot_n_old += x_dot_old[a] * lsi->normal[a];
     }
@@ -4029,7 +4033,8 @@ int assemble_phase_function(double time_value, double tt, double dt, double xi[D
   if (pd->TimeIntegration != STEADY && pd->v[pg->imtrx][MESH_DISPLACEMENT1]) {
     x_dot_old = fv_dot_old->x;
     for (a = 0; a < VIM; a++) {
-      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv - 2. * tt * x_dot_old[a];
+      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv +
+                 time_derivative_history(xx[a], x_old[a], fv_dot->x[a], x_dot_old[a], tt, dt);
       if (lubon)
         x_dot[a] = (1 + 2 * tt) / dt * (xx[a] - x_old[a]);
       v_rel[a] = v[a] - x_dot[a];
@@ -4042,7 +4047,8 @@ int assemble_phase_function(double time_value, double tt, double dt, double xi[D
     x_old = fv_old->d_rs;
     x_dot_old = fv_dot_old->d_rs;
     for (a = 0; a < VIM; a++) {
-      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv - 2. * tt * x_dot_old[a];
+      x_dot[a] = (1. + 2. * tt) * (xx[a] - x_old[a]) * dtinv +
+                 time_derivative_history(xx[a], x_old[a], fv_dot->d_rs[a], x_dot_old[a], tt, dt);
     }
     for (a = 0; a < VIM; a++) {
       v_rel[a] = x_dot[a];
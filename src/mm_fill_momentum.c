@@ -23,6 +23,7 @@
 #include "mm_eh.h"
 #include "mm_fill_aux.h"
 #include "mm_fill_common.h"
+#include "mm_fill_contract.h"
 #include "mm_fill_energy.h"
 #include "mm_fill_fill.h"
 #include "mm_fill_ls.h"
@@ -691,6 +692,10 @@ int assemble_momentum(dbl time,       /* current time */
       porous_brinkman_etm = pd->etm[pg->imtrx][eqn][(LOG2_POROUS_BRINK)];
       source_etm = pd->etm[pg->imtrx][eqn][(LOG2_SOURCE)];
 
+      /* J_m_v and J_m_P are formed as small GEMMs after the row loop */
+      int contract_on =
+          contraction_assembly() && supg == 0. && !porous_brinkman_on && !particle_momentum_on;
+
       phi_i_vector = bfm->phi;
 
       for (i = 0; i < ei[pg->imtrx]->dof[eqn]; i++) {
@@ -1559,7 +1564,7 @@ int assemble_momentum(dbl time,       /* current time */
           /*
            * J_m_v
            */
-          for (b = 0; b < WIM; b++) {
+          for (b = 0; b < WIM && !contract_on; b++) {
             var = VELOCITY1 + b;
             if (pdv[var]) {
               pvar = upd->vp[pg->imtrx][var];
@@ -2047,7 +2052,7 @@ int assemble_momentum(dbl time,       /* current time */
            * J_m_P
            */
 
-          if (pdv[PRESSURE]) {
+          if (pdv[PRESSURE] && !contract_on) {
             var = PRESSURE;
             pvar = upd->vp[pg->imtrx][var];
 
@@ -2464,6 +2469,92 @@ int assemble_momentum(dbl time,       /* current time */
           }
         } /* end of if(active_dofs) */
       } /* end of for(i=ei[pg->imtrx]->dof*/
+
+      /*
+       * J_m_v and J_m_P as contractions of the test function and its tensor
+       * gradient (W) with the coefficients of each column dof (T):
+       *   T[0][j]          mass, advection and source, weighted by phi_i
+       *   T[1+p*VIM+q][j]  stress sensitivity, weighted by grad_phi_e[i][a][p][q]
+       */
+      if (contract_on) {
+        struct Contract_Block blk;
+        contract_vector_test_functions(&blk, eqn, a, d_area);
+
+        for (b = 0; b < WIM; b++) {
+          var = VELOCITY1 + b;
+          if (!pdv[var])
+            continue;
+          pvar = upd->vp[pg->imtrx][var];
+          contract_zero_trial(&blk, ei[pg->imtrx]->dof[var]);
+
+          for (j = 0; j < ei[pg->imtrx]->dof[var]; j++) {
+            phi_j = bf[var]->phi[j];
+
+            mass = 0.;
+            if (transient_run && mass_on && (a == b)) {
+              mass = -(1. + 2. * tt) * phi_j / dt * rho * mass_etm;
+            }
+
+            advection = 0.;
+            if (advection_on) {
+              advection_a = phi_j * grad_v[b][a];
+              for (p = 0; p < WIM; p++) {
+                advection_a += (v[p] - x_dot[p]) * bf[var]->grad_phi_e[j][b][p][a];
+              }
+              if (upd->PSPG_advection_correction) {
+                for (p = 0; p < WIM; p++) {
+                  advection_a -= pspg[p] * bf[var]->grad_phi_e[j][b][p][a];
+                  advection_a -= d_pspg.v[p][b][j] * grad_v[p][a];
+                }
+              }
+              advection = -rho * advection_a * advection_etm;
+            }
+
+            source = 0.;
+            if (source_on) {
+              source = df->v[a][b][j] * source_etm;
+            }
+
+            blk.T[0][j] = mass + advection + source;
+
+            for (p = 0; p < VIM; p++) {
+              if (diffusion_on) {
+                for (q = 0; q < VIM; q++) {
+                  blk.T[1 + p * VIM + q][j] = -d_Pi->v[q][p][b][j] * d_area * diffusion_etm;
+                }
+              }
+              if (Cont_GLS) {
+                blk.T[1 + p * VIM + p][j] += d_cont_gls->v[b][j] * d_area;
+              }
+            }
+          }
+          contract_jacobian_block(&blk, eqn, peqn, pvar, ei[pg->imtrx]->dof[var], TRUE);
+        }
+
+        var = PRESSURE;
+        if (pdv[var]) {
+          pvar = upd->vp[pg->imtrx][var];
+          contract_zero_trial(&blk, ei[pg->imtrx]->dof[var]);
+
+          for (j = 0; j < ei[pg->imtrx]->dof[var]; j++) {
+            if (upd->PSPG_advection_correction) {
+              advection = 0.;
+              for (p = 0; p < WIM; p++) {
+                advection += d_pspg.P[p][j] * grad_v[p][a];
+              }
+              blk.T[0][j] = rho * advection * advection_etm;
+            }
+            if (diffusion_on) {
+              for (p = 0; p < VIM; p++) {
+                for (q = 0; q < VIM; q++) {
+                  blk.T[1 + p * VIM + q][j] = -d_Pi->P[q][p][j] * d_area * diffusion_etm;
+                }
+              }
+            }
+          }
+          contract_jacobian_block(&blk, eqn, peqn, pvar, ei[pg->imtrx]->dof[var], TRUE);
+        }
+      }
     }
   }
   safe_free((void *)n_dof);
@@ -6,6 +6,7 @@
 #include "az_aztec.h"
 #include "density.h"
 #include "el_elm.h"
+#include "load_field_variables.h"
 #include "mm_as.h"
 #include "mm_as_const.h"
 #include "mm_as_structs.h"
@@ -20,22 +21,11 @@
 #include "rf_fem.h"
 #include "rf_fem_const.h"
 #include "std.h"
+#include "util/tridiag_eigen.h"
 
 /* GOMA include files */
 #define GOMA_MM_FILL_POPULATION_C
 
-extern FSUB_TYPE dsyev_(char *JOBZ,
-                        char *UPLO,
-                        int *N,
-                        double *A,
-                        int *LDA,
-                        double *W,
-                        double *WORK,
-                        int *LWORK,
-                        int *INFO,
-                        int len_jobz,
-                        int len_uplo);
-
 static void moments_set_lognormal(
     int mom_index_1, int mom_index_2, int n_moments, double *moments, double *log_norm_moments);
 
@@ -94,41 +84,25 @@ static void moment_correction_wright(double *moments, int n_moments, double *mom
 
 static void compute_nodes_weights(
     int N, double Jac[N + 1][N + 1], double *weights, double *nodes, double *moments) {
-  int LDA = N;
-  int i, j;
-
-  int INFO;
-  int LWORK = 20;
-  double WORK[LWORK];
-  memset(WORK, 0, sizeof(double) * (size_t)LWORK);
-
-  double A[N * N];
-  memset(A, 0.0, sizeof(double) * (size_t)(N * N));
+  int i;
+  double diag[N];
+  double offdiag[N];
+  double W[N];
+  double U0[N];
 
-  // convert to column major
+  // Jac is symmetric tridiagonal
   for (i = 0; i < N; i++) {
-    for (j = 0; j < N; j++) {
-      A[i * N + j] = Jac[j][i];
-    }
+    diag[i] = Jac[i][i];
+    offdiag[i] = Jac[i][i + 1];
   }
 
-  double W[N];
-
-  // eig solver
-  dsyev_("V", "U", &N, A, &LDA, W, WORK, &LWORK, &INFO, 1, 1);
-
-  double U[N][N];
-
-  // transpose (revert to row major)
-  for (i = 0; i < N; i++) {
-    for (j = 0; j < N; j++) {
-      U[i][j] = A[j * N + i];
-    }
+  if (goma_tridiag_eigen(N, diag, offdiag, W, U0) != 0) {
+    GOMA_EH(GOMA_ERROR, "Eigensolver failed in compute_nodes_weights");
   }
 
-  // Eigenvalues of conformation tensor
+  // weights from the first eigenvector components (Golub-Welsch)
   for (i = 0; i < N; i++) {
-    weights[i] = U[0][i] * U[0][i] * moments[0];
+    weights[i] = U0[i] * U0[i] * moments[0];
     nodes[i] = W[i];
     if (nodes[i] < 0) {
       GOMA_EH(GOMA_ERROR, "Negative nodes in compute_nodes_weights");
@@ -310,32 +284,19 @@ void adaptive_wheeler(
       return;
     }
 
-    double z[n1 * n1];
-    memset(z, 0.0, sizeof(double) * (size_t)(n1 * n1));
+    double offdiag[MAX_MOMENTS];
     for (int i = 0; i < n1 - 1; i++) {
-      z[i * n1 + i] = a[i];
-      double tmp = sqrt(b[i + 1]);
-      z[(i + 1) * n1 + i] = tmp;
-      z[i * n1 + i + 1] = tmp;
+      offdiag[i] = sqrt(b[i + 1]);
     }
-    z[(n1 - 1) * n1 + n1 - 1] = a[n1 - 1];
 
-    int LDA = n1;
-    int INFO;
-    int LWORK = 20;
-    double WORK[LWORK];
-    double eigenvalues[n1];
-    dsyev_("V", "U", &n1, z, &LDA, eigenvalues, WORK, &LWORK, &INFO, 1, 1);
-
-    double eigenvectors[n1][n1];
-    for (int i = 0; i < n1; i++) {
-      for (int j = 0; j < n1; j++) {
-        eigenvectors[i][j] = z[j * n1 + i];
-      }
+    double eigenvalues[MAX_MOMENTS];
+    double eigenvectors0[MAX_MOMENTS];
+    if (goma_tridiag_eigen(n1, a, offdiag, eigenvalues, eigenvectors0) != 0) {
+      GOMA_EH(GOMA_ERROR, "Eigensolver failed in adaptive_wheeler");
     }
 
     for (int i = 0; i < n1; i++) {
-      weights[i] = moments[0] * SQUARE(eigenvectors[0][i]);
+      weights[i] = moments[0] * SQUARE(eigenvectors0[i]);
       nodes[i] = eigenvalues[i];
     }
 
@@ -1277,6 +1238,49 @@ int coalescence_kernel_model(
   return 0;
 }
 
+/*
+ * Quadrature of the bubble size distribution from the old moments.  The
+ * moment, species, heat and volume sources all ask for it at the same
+ * quadrature point, so the last inversion is kept until the field variables
+ * are reloaded.  rmin and eabs are fixed by the one caller.
+ */
+static struct {
+  int valid;
+  unsigned long load_id;
+  const struct Diet_Field_Variables *fv_old;
+  int n;
+  int n_out;
+  double moments[MAX_MOMENTS];
+  double weights[MAX_MOMENTS];
+  double nodes[MAX_MOMENTS];
+} pbe_quad_cache;
+
+static void pbe_quadrature(
+    int N, double *moments, double *rmin, double eabs, double *weights, double *nodes, int *n_out) {
+  size_t mom_size = sizeof(double) * (size_t)(2 * N);
+  size_t node_size = sizeof(double) * (size_t)N;
+  if (pbe_quad_cache.valid && pbe_quad_cache.load_id == fv_load_id &&
+      pbe_quad_cache.fv_old == fv_old && pbe_quad_cache.n == N &&
+      memcmp(pbe_quad_cache.moments, moments, mom_size) == 0) {
+    *n_out = pbe_quad_cache.n_out;
+    memcpy(weights, pbe_quad_cache.weights, node_size);
+    memcpy(nodes, pbe_quad_cache.nodes, node_size);
+    return;
+  }
+
+  adaptive_wheeler(N, moments, rmin, eabs, weights, nodes, n_out);
+
+  // moments may have been corrected in place, key on what the next caller sees
+  pbe_quad_cache.valid = TRUE;
+  pbe_quad_cache.load_id = fv_load_id;
+  pbe_quad_cache.fv_old = fv_old;
+  pbe_quad_cache.n = N;
+  pbe_quad_cache.n_out = *n_out;
+  memcpy(pbe_quad_cache.moments, moments, mom_size);
+  memcpy(pbe_quad_cache.weights, weights, node_size);
+  memcpy(pbe_quad_cache.nodes, nodes, node_size);
+}
+
 int get_moment_growth_rate_term(struct moment_growth_rate *MGR) {
   int nnodes = 2; // currently hardcoded for 2 Nodes (4 Moments)
   double weights[nnodes], nodes[nnodes];
@@ -1294,7 +1298,7 @@ int get_moment_growth_rate_term(struct moment_growth_rate *MGR) {
 
   /* Get quad weights and nodes */
   int nnodes_out;
-  adaptive_wheeler(nnodes, fv_old->moment, rmin, eabs, weights, nodes, &nnodes_out);
+  pbe_quadrature(nnodes, fv_old->moment, rmin, eabs, weights, nodes, &nnodes_out);
 
   switch (mp->MomentSourceModel) {
   case FOAM_PBE: {
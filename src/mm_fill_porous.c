@@ -48,6 +48,7 @@
 #include "mm_std_models_shell.h"
 #include "rf_allo.h"
 #include "rf_bc_const.h"
+#include "rf_bdf.h"
 #include "rf_element_storage_struct.h"
 #include "rf_fem.h"
 #include "rf_fem_const.h"
@@ -1779,6 +1780,35 @@ double get_supg_terms_porous(double hsquare[DIM], double hh[DIM][DIM])
 /**************************************************************************/
 /**************************************************************************/
 
+/*
+ * History part of the time derivative of a porous media inventory, see
+ * time_derivative_history().  The theta method uses the chain rule rate
+ * inventory_dot_old.  With BDF the inventory is linearized about the old
+ * solution, with derivatives d_pl, d_pg, d_por and d_T with respect to
+ * the porous unknowns, and takes the history of each unknown.
+ */
+static double porous_inventory_history(const double d_pl,
+                                       const double d_pg,
+                                       const double d_por,
+                                       const double d_T,
+                                       const double inventory_dot_old,
+                                       const double tt,
+                                       const double dt) {
+  if (tran->bdf_max_order == 0) {
+    return -2.0 * tt * inventory_dot_old;
+  }
+  return d_pl * time_derivative_history(fv->p_liq, fv_old->p_liq, fv_dot->p_liq,
+                                        fv_dot_old->p_liq, tt, dt) +
+         d_pg * time_derivative_history(fv->p_gas, fv_old->p_gas, fv_dot->p_gas,
+                                        fv_dot_old->p_gas, tt, dt) +
+         d_por * time_derivative_history(fv->porosity, fv_old->porosity, fv_dot->porosity,
+                                         fv_dot_old->porosity, tt, dt) +
+         d_T * time_derivative_history(fv->T, fv_old->T, fv_dot->T, fv_dot_old->T, tt, dt);
+}
+/**************************************************************************/
+/**************************************************************************/
+/**************************************************************************/
+
 void load_nodal_porous_properties(double tt, double dt)
 
 /*********************************************************************
@@ -1925,8 +1955,12 @@ void load_nodal_porous_properties(double tt, double dt)
       pmv_ml->Inventory_Solvent_dot[idof][i_pl] =
           (1.0 + 2.0 * tt) *
               (pmv_ml->Inventory_Solvent[idof][i_pl] - pmv_ml->Inventory_Solvent_old[idof][i_pl]) /
-              dt -
-          2.0 * tt * pmv_ml->Inventory_Solvent_dot_old[idof][i_pl];
+              dt +
+          porous_inventory_history(pmv_ml->d_Bulk_Density_old[idof][i_pl][POR_LIQ_PRES],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pl][POR_GAS_PRES],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pl][POR_POROSITY],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pl][POR_TEMP],
+                                   pmv_ml->Inventory_Solvent_dot_old[idof][i_pl], tt, dt);
 
       pmv_ml->Inventory_Solvent_dot_old[idof][i_pg] =
           fv_dot_old->p_liq * pmv_ml->d_Bulk_Density_old[idof][i_pg][POR_LIQ_PRES] +
@@ -1937,8 +1971,12 @@ void load_nodal_porous_properties(double tt, double dt)
       pmv_ml->Inventory_Solvent_dot[idof][i_pg] =
           (1.0 + 2.0 * tt) *
               (pmv_ml->Inventory_Solvent[idof][i_pg] - pmv_ml->Inventory_Solvent_old[idof][i_pg]) /
-              dt -
-          2.0 * tt * pmv_ml->Inventory_Solvent_dot_old[idof][i_pg];
+              dt +
+          porous_inventory_history(pmv_ml->d_Bulk_Density_old[idof][i_pg][POR_LIQ_PRES],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pg][POR_GAS_PRES],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pg][POR_POROSITY],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pg][POR_TEMP],
+                                   pmv_ml->Inventory_Solvent_dot_old[idof][i_pg], tt, dt);
 
       pmv_ml->Inventory_Solvent_dot_old[idof][i_pe] =
           fv_dot_old->p_liq * pmv_ml->d_Bulk_Density_old[idof][i_pe][POR_LIQ_PRES] +
@@ -1949,8 +1987,12 @@ void load_nodal_porous_properties(double tt, double dt)
       pmv_ml->Inventory_Solvent_dot[idof][i_pe] =
           (1.0 + 2.0 * tt) *
               (pmv_ml->Inventory_Solvent[idof][i_pe] - pmv_ml->Inventory_Solvent_old[idof][i_pe]) /
-              dt -
-          2.0 * tt * pmv_ml->Inventory_Solvent_dot_old[idof][i_pe];
+              dt +
+          porous_inventory_history(pmv_ml->d_Bulk_Density_old[idof][i_pe][POR_LIQ_PRES],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pe][POR_GAS_PRES],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pe][POR_POROSITY],
+                                   pmv_ml->d_Bulk_Density_old[idof][i_pe][POR_TEMP],
+                                   pmv_ml->Inventory_Solvent_dot_old[idof][i_pe], tt, dt);
 
     } else {
       pmv_ml->Inventory_Solvent_dot[idof][i_pl] =
@@ -2102,18 +2144,31 @@ void load_nodal_shell_porous_properties(double tt, double dt, int eqn)
      *
      */
     if (tt > 0.0) {
+      double hist;
       pmv_ml->Inventory_Solvent_dot_old[idof][i_pl] =
           fv_dot_old->sh_p_open * H * mp->porosity * mp_old->d_saturation[SHELL_PRESS_OPEN];
-      if (eqn == R_SHELL_SAT_OPEN_2)
+      hist = H * mp->porosity * mp_old->d_saturation[SHELL_PRESS_OPEN] *
+             time_derivative_history(fv->sh_p_open, fv_old->sh_p_open, fv_dot->sh_p_open,
+                                     fv_dot_old->sh_p_open, tt, dt);
+      if (eqn == R_SHELL_SAT_OPEN_2) {
         pmv_ml->Inventory_Solvent_dot_old[idof][i_pl] = fv_dot_old->sh_p_open_2 * H *
                                                         mp_old->porosity *
                                                         mp_old->d_saturation[SHELL_PRESS_OPEN_2];
+        hist = H * mp_old->porosity * mp_old->d_saturation[SHELL_PRESS_OPEN_2] *
+               time_derivative_history(fv->sh_p_open_2, fv_old->sh_p_open_2, fv_dot->sh_p_open_2,
+                                       fv_dot_old->sh_p_open_2, tt, dt);
+      }
+
+      /* BDF takes the history of the pressure, the saturation linearized about the old one */
+      if (tran->bdf_max_order == 0) {
+        hist = -2.0 * tt * pmv_ml->Inventory_Solvent_dot_old[idof][i_pl];
+      }
 
       pmv_ml->Inventory_Solvent_dot[idof][i_pl] =
           (1.0 + 2.0 * tt) *
               (pmv_ml->Inventory_Solvent[idof][i_pl] - pmv_ml->Inventory_Solvent_old[idof][i_pl]) /
-              dt -
-          2.0 * tt * pmv_ml->Inventory_Solvent_dot_old[idof][i_pl];
+              dt +
+          hist;
 
     } else {
       pmv_ml->Inventory_Solvent_dot[idof][i_pl] =
@@ -2244,8 +2299,12 @@ int get_porous_part_sat_terms(struct Porous_Media_Terms *pmt,
         fv_dot_old->T * pmv_old->d_bulk_density[i_pl][POR_TEMP];
 
     pmt->Inventory_solvent_dot[i_pl] =
-        (1.0 + 2.0 * tt) * (pmt->Inventory_solvent[i_pl] - pmt->Inventory_solvent_old[i_pl]) / dt -
-        2.0 * tt * pmt->Inventory_solvent_dot_old[i_pl];
+        (1.0 + 2.0 * tt) * (pmt->Inventory_solvent[i_pl] - pmt->Inventory_solvent_old[i_pl]) / dt +
+        porous_inventory_history(pmv_old->d_bulk_density[i_pl][POR_LIQ_PRES],
+                                 pmv_old->d_bulk_density[i_pl][POR_GAS_PRES],
+                                 pmv_old->d_bulk_density[i_pl][POR_POROSITY],
+                                 pmv_old->d_bulk_density[i_pl][POR_TEMP],
+                                 pmt->Inventory_solvent_dot_old[i_pl], tt, dt);
 
     /*
      * Gas solvent component, e.g. air
@@ -2268,8 +2327,13 @@ int get_porous_part_sat_terms(struct Porous_Media_Terms *pmt,
        * at the current gauss point
        */
       pmt->Inventory_solvent_dot[i_pg] =
-          (1 + 2. * tt) * (pmt->Inventory_solvent[i_pg] - pmt->Inventory_solvent_old[i_pg]) / dt -
-          2. * tt * pmt->Inventory_solvent_dot_old[i_pg];
+          (1.0 + 2.0 * tt) * (pmt->Inventory_solvent[i_pg] - pmt->Inventory_solvent_old[i_pg]) /
+              dt +
+          porous_inventory_history(pmv_old->d_bulk_density[i_pg][POR_LIQ_PRES],
+                                   pmv_old->d_bulk_density[i_pg][POR_GAS_PRES],
+                                   pmv_old->d_bulk_density[i_pg][POR_POROSITY],
+                                   pmv_old->d_bulk_density[i_pg][POR_TEMP],
+                                   pmt->Inventory_solvent_dot_old[i_pg], tt, dt);
     }
 
     /*
@@ -2289,8 +2353,12 @@ int get_porous_part_sat_terms(struct Porous_Media_Terms *pmt,
 
       pmt->Inventory_solvent_dot[i_pe] =
           (1.0 + 2.0 * tt) * (pmt->Inventory_solvent[i_pe] - pmt->Inventory_solvent_old[i_pe]) /
-              dt -
-          2.0 * tt * pmt->Inventory_solvent_dot_old[i_pe];
+              dt +
+          porous_inventory_history(pmv_old->d_bulk_density[i_pe][POR_LIQ_PRES],
+                                   pmv_old->d_bulk_density[i_pe][POR_GAS_PRES],
+                                   pmv_old->d_bulk_density[i_pe][POR_POROSITY],
+                                   pmv_old->d_bulk_density[i_pe][POR_TEMP],
+                                   pmt->Inventory_solvent_dot_old[i_pe], tt, dt);
     }
 
   } else {
@@ -3383,8 +3451,10 @@ int get_porous_fully_sat_terms(struct Porous_Media_Terms *pmt, double tt, double
 
         pmt->Inventory_solvent_dot[i_pl] =
             ((1 + 2. * tt) * (pmt->Inventory_solvent[i_pl] - pmt->Inventory_solvent_old[i_pl]) /
-                 dt -
-             2. * tt * pmt->Inventory_solvent_dot_old[i_pl]);
+                 dt +
+             porous_inventory_history(mp_old->d_porosity[POR_LIQ_PRES] * mp_old->density, 0.0,
+                                      mp_old->d_porosity[POR_POROSITY] * mp->density, 0.0,
+                                      pmt->Inventory_solvent_dot_old[i_pl], tt, dt));
       } else {
         pmt->Inventory_solvent_dot[i_pl] = 0.0;
       }
@@ -38,6 +38,7 @@
 #include "mm_chemkin.h"
 #include "mm_eh.h"
 #include "mm_elem_block_structs.h"
+#include "mm_fill_contract.h"
 #include "mm_fill_energy.h"
 #include "mm_fill_ls.h"
 #include "mm_fill_population.h"
@@ -54,6 +55,7 @@
 #include "rf_allo.h"
 #include "rf_bc.h"
 #include "rf_bc_const.h"
+#include "rf_bdf.h"
 #include "rf_fem.h"
 #include "rf_fem_const.h"
 #include "sl_aux.h"
@@ -728,6 +730,11 @@ int assemble_mass_transport(double time, /* present time valuel; KSC
         coeff_rho = small_c; /*  RSL 9/27/01  */
       }
 
+      /* J_s_c is formed as small GEMMs after the row loop */
+      int contract_on = contraction_assembly() && !taylor_galerkin[w] &&
+                        mp->SpeciesSourceModel[w] != ELECTRODE_KINETICS &&
+                        mp->SpeciesSourceModel[w] != ION_REACTIONS;
+
       for (i = 0; i < ei[pg->imtrx]->dof[eqn]; i++) {
         ledof = ei[pg->imtrx]->lvdof_to_ledof[eqn][i];
         if (ei[pg->imtrx]->active_interp_ledof[ledof]) {
@@ -761,7 +768,7 @@ int assemble_mass_transport(double time, /* present time valuel; KSC
            *       unknowns
            */
           var = MASS_FRACTION;
-          if (pd->e[pg->imtrx][eqn] && pd->v[pg->imtrx][var]) {
+          if (pd->e[pg->imtrx][eqn] && pd->v[pg->imtrx][var] && !contract_on) {
             for (w1 = 0; w1 < pd->Num_Species_Eqn; w1++) {
               for (j = 0; j < ei[pg->imtrx]->dof[var]; j++) {
                 phi_j = bf[var]->phi[j];
@@ -1684,12 +1691,85 @@ int assemble_mass_transport(double time, /* present time valuel; KSC
 
         } /* if active_dofs */
       } /* for (i) .... */
+
+      /*
+       * J_s_c as contractions of [phi_i, grad_phi_i] (W) with the column
+       * coefficients (T).  The SUPG weight splits into the phi_i and
+       * grad_phi_i columns as in assemble_energy.
+       */
+      var = MASS_FRACTION;
+      if (contract_on && pd->v[pg->imtrx][var]) {
+        struct Contract_Block blk;
+        dbl dV = h3 * det_J * wt;
+
+        contract_scalar_test_functions(&blk, eqn, dV);
+
+        for (w1 = 0; w1 < pd->Num_Species_Eqn; w1++) {
+          contract_zero_trial(&blk, ei[pg->imtrx]->dof[var]);
+
+          for (j = 0; j < ei[pg->imtrx]->dof[var]; j++) {
+            mass = 0.;
+            if (pd->TimeIntegration != STEADY) {
+              if (pd->e[pg->imtrx][eqn] & T_MASS) {
+                mass = coeff_rho * s_terms.d_Y_dot_dc[w][w1][j];
+                if (coeff_rho_nonunity) {
+                  mass += d_rho->C[w1][j] * s_terms.Y_dot[w];
+                }
+                mass *= -pd->etm[pg->imtrx][eqn][(LOG2_MASS)];
+              }
+            }
+
+            advection = 0.;
+            if (pd->e[pg->imtrx][eqn] & T_ADVECTION) {
+              for (p = 0; p < VIM; p++) {
+                advection += coeff_rho * s_terms.d_conv_flux_dc[w][p][w1][j];
+                if (coeff_rho_nonunity) {
+                  advection += d_rho->C[w1][j] * s_terms.conv_flux[w][p];
+                }
+              }
+              advection *= -pd->etm[pg->imtrx][eqn][(LOG2_ADVECTION)] * mp->AdvectiveScaling[w];
+            }
+
+            source = 0.;
+            if (pd->e[pg->imtrx][eqn] & T_SOURCE) {
+              source = s_terms.d_MassSource_dc[w][w1][j] * pd->etm[pg->imtrx][eqn][(LOG2_SOURCE)];
+            }
+
+            /* everything weighted by wt_func */
+            dbl weighted = Heaviside * (mass + advection) + source;
+            blk.T[0][j] = weighted;
+
+            if (supg != 0.0) {
+              for (p = 0; p < dim; p++) {
+                blk.T[1 + p][j] += supg * supg_terms.supg_tau * fv->v[p] * weighted * dV;
+              }
+            }
+
+            if (pd->e[pg->imtrx][eqn] & T_DIFFUSION) {
+              for (p = 0; p < VIM; p++) {
+                blk.T[1 + p][j] += s_terms.d_diff_flux_dc[w][p][w1][j] * dV *
+                                   pd->etm[pg->imtrx][eqn][(LOG2_DIFFUSION)];
+              }
+            }
+
+            if (shock_capture) {
+              for (p = 0; p < VIM; p++) {
+                blk.T[1 + p][j] += yzbeta * bf[var]->grad_phi[j][p] * dV *
+                                   pd->etm[pg->imtrx][eqn][(LOG2_DIFFUSION)];
+              }
+            }
+          }
+          contract_jacobian_block(&blk, eqn, MAX_PROB_VAR + w, MAX_PROB_VAR + w1,
+                                  ei[pg->imtrx]->dof[var], TRUE);
+        }
+      }
     } /* if ( assemble Jacobian ) */
   } /* for (w) ... */
 
   return (status);
 
 } /* end of assemble_mass_transport */
+
 /*****************************************************************************/
 /*****************************************************************************/
 /*****************************************************************************/
@@ -8236,7 +8316,9 @@ void kin_bc_electrodeposition(double func[],
     nxdot[p] = 0.;
     if (pd->TimeIntegration != STEADY) {
       if (pd->v[pg->imtrx][R_MESH1]) {
-        nxdot[p] -= (1. + 2. * tt) * (fv->x[p] - fv_old->x[p]) / dt - 2. * tt * fv_dot->x[p];
+        nxdot[p] -= (1. + 2. * tt) * (fv->x[p] - fv_old->x[p]) / dt +
+                    time_derivative_history(fv->x[p], fv_old->x[p], fv_dot->x[p], fv_dot->x[p],
+                                            tt, dt);
       }
     }
   }
@@ -59,6 +59,7 @@
 #include "rf_vars_const.h"
 #include "sl_util_structs.h"
 #include "std.h"
+#include "util/goma_memory.h"
 
 #define GOMA_MM_FILL_UTIL_C
 
@@ -2922,6 +2923,7 @@ Revised:	   1997/10/28 16:48 MST pasacki@sandia.gov
     max_neigh_elem = MAX_SUR_ELEM_3D; /* 20 deg solid angle gives 60 elems */
   }
 
+  goma_mem_push_tag(GOMA_MEM_MATRIX);
   if (Fill) {
     nnz = find_problem_graph_fill(&ija_temp, itotal_nodes, max_neigh_elem, node_to_fill, exo);
   } else {
@@ -3023,6 +3025,8 @@ Revised:	   1997/10/28 16:48 MST pasacki@sandia.gov
     DPRINTF(stdout, "\n%-30s= %d\n", "Number of matrix nonzeroes", nnz);
   }
 
+  goma_mem_pop_tag();
+
   *ptr_ija = ija;
   *ptr_a = a;
   *ptr_a_old = a_old;
@@ -3044,6 +3048,7 @@ void alloc_VBR_sparse_arrays(struct GomaLinearSolverData *ams, Exo_DB *exo, Dpi
   row_nodes = dpi->num_internal_nodes + dpi->num_boundary_nodes;
   col_nodes = dpi->num_universe_nodes;
 
+  goma_mem_push_tag(GOMA_MEM_MATRIX);
   nnz = find_VBR_problem_graph(&(ams->indx), &(ams->bindx), &(ams->bpntr), &(ams->rpntr),
                                &(ams->cpntr), row_nodes, col_nodes, exo);
 
@@ -3078,6 +3083,7 @@ void alloc_VBR_sparse_arrays(struct GomaLinearSolverData *ams, Exo_DB *exo, Dpi
   if (save_old_A) {
     asdv(&(ams->val_old), nnz);
   }
+  goma_mem_pop_tag();
 
   /*
    *   calculate the total number of degrees of freedom in the problem
@@ -88,6 +88,90 @@ static int load_fv_sens(void);
 
 static int load_fv_grads_sens(void);
 
+/*
+ * Running sums for one flux request while its side set is swept.  The "0"
+ * copies hold the sums at the previous quadrature point so that only
+ * contributions from elements owned by this processor reach proc_*.
+ */
+struct flux_accum {
+  struct Flux_Request *rq;
+  double flux, flux_conv, area, Torque[DIM];
+  double flux0, flux_conv0, area0, Torque0[DIM];
+  double proc_flux, proc_flux_conv, proc_area, proc_Torque[DIM];
+  double ad_wt[9]; /* level set adaptive quadrature weights */
+  int ierr;
+};
+
+/*
+ * Quantities whose integrand reloads the basis functions or the shell normal
+ * at the quadrature point cannot share the geometry of other requests.
+ */
+static int flux_quantity_fusable(const struct Flux_Request *rq) {
+  if (rq->profile_flag)
+    return FALSE;
+  switch (rq->quantity) {
+  case SHELL_VOLUME_FLUX:
+  case SHELL_FORCE_NORMAL:
+  case LS_DCA:
+    return FALSE;
+  default:
+    return TRUE;
+  }
+}
+
+static void flux_print_header(const struct Flux_Request *rq, const dbl time_value) {
+  FILE *jfp;
+  if ((jfp = fopen(rq->filenm, "a")) != NULL) {
+    fprintf(jfp, "Time/iteration = %e \n", time_value);
+    fprintf(jfp, " %s  Side_Set  %d Block  %d Species %d\n", rq->qtity_str, rq->ss_id, rq->blk_id,
+            rq->species_id);
+    if (rq->profile_flag) {
+      fprintf(jfp, " x  y  z  flux  flux_conv");
+      if (rq->profile_flag & 1)
+        fprintf(jfp, " shear_rate viscosity");
+      if (rq->profile_flag & 2)
+        fprintf(jfp, " evalue1 evalue2 evalue3");
+      if (rq->profile_flag & 4)
+        fprintf(jfp, " surf_tens");
+      if (rq->profile_flag & 8)
+        fprintf(jfp, " temperature pressure");
+      if (rq->profile_flag & 16)
+        fprintf(jfp, " x-normal y-normal z-normal");
+      fprintf(jfp, " \n");
+    }
+    fflush(jfp);
+    fclose(jfp);
+  }
+}
+
+static void flux_print_result(struct Flux_Request *rq) {
+  int b;
+  FILE *jfp;
+  if ((jfp = fopen(rq->filenm, "a")) != NULL) {
+    if (rq->quantity == TORQUE) {
+      if (pd->CoordinateSystem == SWIRLING || pd->CoordinateSystem == CYLINDRICAL) {
+        fprintf(jfp, " torque= %g   \n", rq->flux);
+      } else { /* CARTESIAN */
+        fprintf(jfp, " torque= %g %g %g area= %g\n", rq->Torque[0], rq->Torque[1], rq->Torque[2],
+                rq->area);
+      }
+      fprintf(jfp, "\n");
+      fflush(jfp);
+    } else {
+      fprintf(jfp, " flux=  %g %g  area= %g  ", rq->flux, rq->flux_conv, rq->area);
+      if (rq->quantity == REPULSIVE_FORCE) {
+        for (b = 0; b < DIM; b++) {
+          rq->Torque[b] /= rq->flux;
+        }
+        fprintf(jfp, " centers=  %g %g %g  ", rq->Torque[0], rq->Torque[1], rq->Torque[2]);
+      }
+      fprintf(jfp, "\n\n");
+      fflush(jfp);
+    }
+    fclose(jfp);
+  }
+}
+
 /* evaluate_flux() -- sum up flux contributions along a sideset, print out
  *
  * Author:          P. R. Schunk
@@ -109,21 +193,18 @@ static int load_fv_grads_sens(void);
  *	(5) add viscoelastic stress terms
  *   10/99  - added sensitivity section, tabaer
  *   1/2002 - added sections on charged-species flux and electrical current, kschen
+ *   10/2026 - all requests on one side set and block are integrated in a single
+ *             sweep; entry points are evaluate_flux() and evaluate_flux_batch()
  */
 
-double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh information */
+static int evaluate_flux_set(const Exo_DB *exo,       /* ptr to basic exodus ii mesh information */
                      const Dpi *dpi,         /* distributed processing info */
                      const int side_set_id,  /* on which SSID to evaluate flux */
-                     const int quantity,     /* to pick HEAT_FLUX, FORCE_NORMAL, etc. */
-                     const char *qtity_str,  /* quantity string */
                      const int blk_id,       /* material identification */
-                     const int species_id,   /* species identification */
-                     const char *filenm,     /* File name pointer */
-                     const int profile_flag, /*  flag for printing flux profiles  */
+                             const int nreq,          /* number of requests on this SSID */
+                             struct flux_accum **acc, /* requests and running sums */
                      dbl *x,                 /* solution vector */
                      dbl *xdot,              /* dx/dt vector */
-                     double J_AC[],          /* vector for augmenting condition sensitivities.
-                              May be NULL */
                      const double delta_t,   /* time-step size */
                      const dbl time_value,   /* current time */
                      const int print_flag)   /*  flag for printing results,1=print*/
@@ -143,7 +224,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
   int ip_total, ielem_type, gnn, ledof, matIndex;
   int num_local_nodes, iconnect_ptr, dim, ielem_dim, current_id;
   int nset_id, sset_id;
-  double Tract[DIM], Torque[DIM], local_Torque[DIM];
+  double Tract[DIM], local_Torque[DIM];
   double Mag_real[DIM], Mag_imag[DIM], E_real[DIM], E_imag[DIM];
 
   /*
@@ -223,30 +304,16 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
 
   double s, t, u; /* Gaussian-quadrature point locations          */
   double det;
-  double local_flux = 0.0;      /* these are actually the integrated contact and*/
-  double local_flux_conv = 0.0; /*  convective fluxes  */
-  double local_area = 0.0;
   double local_q = 0; /* these are the actual fluxes  */
   double local_qconv = 0;
 
   double param[3] = {0., 0., 0.};
 
 #ifdef PARALLEL
-  double local_flux0 = 0.0;      /* old flux sum */
-  double local_flux_conv0 = 0.0; /* old convective flux sum */
-  double local_area0 = 0.0;      /* old area sum */
-  double proc_flux = 0.0;        /* current flux sum on this proc */
-  double proc_flux_conv = 0.0;   /* current convective flux sum on this proc */
-  double proc_area = 0.0;        /* current area sum on this proc */
   double delta_flux = 0.0;       /* increment of flux             */
   double delta_flux_conv = 0.0;  /* increment of convective flux  */
   double delta_area = 0.0;       /* increment of area */
-  double global_flux = 0.0;      /* flux sum over all procs */
-  double global_flux_conv = 0.0; /* convective flux sum over all procs */
-  double global_area = 0.0;      /* area sum over all procs */
-  double global_Torque[DIM] = {0, 0, 0}, proc_Torque[DIM] = {0, 0, 0},
-         delta_Torque[DIM] = {0, 0, 0};
-  double Torque0[DIM] = {0, 0, 0};
+  double delta_Torque[DIM] = {0, 0, 0};
 #endif
 
   double xi[DIM]; /* Local element coordinates of Gauss point. */
@@ -275,18 +342,31 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
   double FRT;                /* product of FF/R/T                           */
 
 #ifndef PARALLEL
-  static const char yo[] = "evaluate_flux";
+  static const char yo[] = "evaluate_flux_set";
 #endif
 
   /*  variables for adaptive quadrature weight calculation   */
-  double ls_F[9], ad_wt[9], xf[2];
-  int ierr = 0, wt_type;
+  double ls_F[9], xf[2];
+  int wt_type;
   const int Jac_state = af->Assemble_Jacobian;
 
+  /*  the request currently being integrated  */
+  int iq;
+  struct flux_accum *fa = NULL;
+  int quantity = -1, species_id = 0, profile_flag = 0;
+  const char *filenm = NULL;
+  double *J_AC = NULL;
+  int profile_any = 0, any_J_AC = FALSE;
+
   for (a = 0; a < DIM; a++) {
     base_normal[a] = 0;
   }
-  memset(Torque, 0, sizeof(double) * DIM);
+
+  for (iq = 0; iq < nreq; iq++) {
+  profile_any |= acc[iq]->rq->profile_flag;
+  if (acc[iq]->rq->J_AC != NULL)
+    any_J_AC = TRUE;
+  }
 
   dim = pd_glob[0]->Num_Dim;
 
@@ -294,31 +374,13 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
   err = stress_eqn_pointer(v_s);
 
   af->Assemble_Jacobian = TRUE;
-  /* first right time stamp or run stamp to separate the sets */
 
-  if (print_flag && ProcID == 0) {
-    FILE *jfp;
-    if ((jfp = fopen(filenm, "a")) != NULL) {
-      fprintf(jfp, "Time/iteration = %e \n", time_value);
-      fprintf(jfp, " %s  Side_Set  %d Block  %d Species %d\n", qtity_str, side_set_id, blk_id,
-              species_id);
-      if (profile_flag) {
-        fprintf(jfp, " x  y  z  flux  flux_conv");
-        if (profile_flag & 1)
-          fprintf(jfp, " shear_rate viscosity");
-        if (profile_flag & 2)
-          fprintf(jfp, " evalue1 evalue2 evalue3");
-        if (profile_flag & 4)
-          fprintf(jfp, " surf_tens");
-        if (profile_flag & 8)
-          fprintf(jfp, " temperature pressure");
-        if (profile_flag & 16)
-          fprintf(jfp, " x-normal y-normal z-normal");
-        fprintf(jfp, " \n");
-      }
-      fflush(jfp);
-      fclose(jfp);
-    }
+  /*
+   * Profiles are written while sweeping the side set, so their header has to
+   * go out first.  Profile requests are always evaluated on their own.
+   */
+  if (print_flag && ProcID == 0 && profile_any) {
+    flux_print_header(acc[0]->rq, time_value);
   }
 
   current_id = in_list(side_set_id, 0, exo->num_side_sets, exo->ss_id);
@@ -350,7 +412,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
 
       /* Now start element sweep */
 
-      for (i = 0, local_flux = local_flux_conv = local_area = 0.; i < num_elem_in_set; i++) {
+      for (i = 0; i < num_elem_in_set; i++) {
         ei[pg->imtrx]->ielem = elem_list[i];
 
         mn = find_mat_number(ei[pg->imtrx]->ielem, exo);
@@ -385,6 +447,11 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                                    id_local_elem_coord, exo);
           }
 
+          // clang-format off
+          for (iq = 0; iq < nreq; iq++) {
+          fa = acc[iq];
+          quantity = fa->rq->quantity;
+          species_id = fa->rq->species_id;
           if (ls != NULL && ielem_dim == 2 &&
               (quantity == POS_LS_FLUX || quantity == NEG_LS_FLUX || quantity == DELTA ||
                quantity == LS_DCA)) {
@@ -495,11 +562,13 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               wt_type = 2;
               break;
             }
-            ierr = adaptive_weight(ad_wt, ip_total, ielem_dim - 1, ls_F, 0.0, wt_type,
-                                   ei[pg->imtrx]->ielem_type);
-            if (ierr == -1)
-              printf("adaptive wt problem %d %g %g %g\n", ierr, ls_F[0], ls_F[1], ls_F[2]);
+            fa->ierr = adaptive_weight(fa->ad_wt, ip_total, ielem_dim - 1, ls_F, 0.0, wt_type,
+                                       ei[pg->imtrx]->ielem_type);
+            if (fa->ierr == -1)
+              printf("adaptive wt problem %d %g %g %g\n", fa->ierr, ls_F[0], ls_F[1], ls_F[2]);
           }
+          } /* requests on this side set */
+          // clang-format on
 
           if (ls != NULL && ls->elem_overlap_state && ls->Integration_Depth > 0) {
             Subgrid_Int.active = TRUE;
@@ -516,9 +585,6 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
           /* Surface integration over element */
 
           for (ip = 0; ip < ip_total; ip++) {
-            /*   zero local fluxes  */
-            local_q = local_qconv = 0.;
-            memset(local_Torque, 0, DIM * sizeof(double));
 
             if (ls != NULL && ls->elem_overlap_state && ls->Integration_Depth > 0) {
               ls->Elem_Sign = 0;
@@ -641,7 +707,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   TT[0][2] = 0.;
                 }
               }
-              if (profile_flag & 2) {
+              if (profile_any & 2) {
                 /*  try for Trig solution of cubic equation     */
                 I_T = TT[0][0] + TT[1][1] + TT[2][2];
                 II_T = TT[0][0] * TT[1][1] + TT[0][0] * TT[2][2] + TT[1][1] * TT[2][2] -
@@ -705,7 +771,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 TT[1][2] = 0.;
                 TT[0][2] = 0.;
               }
-              if (profile_flag & 2) {
+              if (profile_any & 2) {
                 /*  try for Trig solution of cubic equation     */
                 I_T = TT[0][0] + TT[1][1] + TT[2][2];
                 II_T = TT[0][0] * TT[1][1] + TT[0][0] * TT[2][2] + TT[1][1] * TT[2][2] -
@@ -775,10 +841,10 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   vs[a][b] = mu * gamma[a][b] - fv->P * delta(a, b);
                 }
               }
-              if (profile_flag & 1) {
+              if (profile_any & 1) {
                 calc_shearrate(&gamma_dot, gamma, NULL, NULL);
               }
-              if (profile_flag & 2) {
+              if (profile_any & 2) {
                 memset(TT, 0, sizeof(dbl) * DIM * DIM);
                 for (a = 0; a < VIM; a++) {
                   for (b = 0; b < VIM; b++) {
@@ -837,7 +903,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 }
               }
               perm = mp->permittivity;
-              if (J_AC != NULL) {
+              if (any_J_AC) {
                 memset(d_p_dV, 0, sizeof(double) * MDE);
                 memset(d_p_dT, 0, sizeof(double) * MDE);
                 memset(d_p_dX, 0, sizeof(double) * MDE * DIM);
@@ -878,19 +944,32 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                                   }
                                 }*/
 
+            // clang-format off
+            for (iq = 0; iq < nreq; iq++) {
+            fa = acc[iq];
+            quantity = fa->rq->quantity;
+            species_id = fa->rq->species_id;
+            filenm = fa->rq->filenm;
+            profile_flag = fa->rq->profile_flag;
+            J_AC = fa->rq->J_AC;
+
+            /*   zero local fluxes  */
+            local_q = local_qconv = 0.;
+            memset(local_Torque, 0, DIM * sizeof(double));
+
             switch (quantity) {
             case AREA:
 
-              local_flux += weight * fv->sdet;
-              local_flux_conv = 0.0;
+              fa->flux += weight * fv->sdet;
+              fa->flux_conv = 0.0;
 
               break;
 
             case VOL_REVOLUTION:
 
               local_q += 0.5 * fv->x[1] * fabs(fv->snormal[1]);
-              local_flux += weight * det * local_q;
-              local_flux_conv = 0.0;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv = 0.0;
               /*                      local_flux_conv += weight*det*mp->surface_tension ;*/
 
               break;
@@ -919,8 +998,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   }
                 }
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case ACOUSTIC_FLUX_NORMAL:
@@ -933,8 +1012,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 local_q += -kR_inv * fv->snormal[a] * fv->grad_api[a];
                 local_qconv += kR_inv * fv->snormal[a] * fv->grad_apr[a];
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case ACOUSTIC_FLUX_TANGENT1:
@@ -947,8 +1026,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 local_q += -kR_inv * fv->stangent[0][a] * fv->grad_api[a];
                 local_qconv += kR_inv * fv->stangent[0][a] * fv->grad_apr[a];
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case ACOUSTIC_FLUX_TANGENT2:
@@ -961,8 +1040,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 local_q += -kR_inv * fv->stangent[1][a] * fv->grad_api[a];
                 local_qconv += kR_inv * fv->stangent[1][a] * fv->grad_apr[a];
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case ACOUSTIC_FLUX_X:
@@ -973,8 +1052,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
 
               local_q += -kR_inv * fv->grad_api[0];
               local_qconv += kR_inv * fv->grad_apr[0];
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case ACOUSTIC_FLUX_Y:
@@ -985,8 +1064,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
 
               local_q += -kR_inv * fv->grad_api[1];
               local_qconv += kR_inv * fv->grad_apr[1];
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case ACOUSTIC_FLUX_Z:
@@ -997,8 +1076,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
 
               local_q += -kR_inv * fv->grad_api[2];
               local_qconv += kR_inv * fv->grad_apr[2];
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case VOLUME_FLUX:
@@ -1015,7 +1094,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                             "Inconsistency in volume-flux specification. Contact Developers");
                 }
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
 
             case SHELL_VOLUME_FLUX:
@@ -1038,7 +1117,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               for (a = 0; a < VIM; a++) {
                 local_q += base_normal[a] * LubAux->q[a];
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               /* clean-up */
               safe_free((void *)n_dof);
               break;
@@ -1056,8 +1135,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 local_q += H * (fv->v[a] - x_dot[a]) * fv->snormal[a];
                 local_qconv += (fv->v[a] - x_dot[a]) * fv->snormal[a];
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += ad_wt[ip_total - ip - 1] * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += fa->ad_wt[ip_total - ip - 1] * det * local_qconv;
 
             } break;
 
@@ -1067,12 +1146,12 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               for (a = 0; a < WIM; a++) {
                 local_q += fv->snormal[a] * fv->pv[a];
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
 
             case EXT_VELOCITY: /* This is already a normal velocity */
               local_q += fv->ext_v;
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
 
             case EFIELD1:
@@ -1081,7 +1160,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               for (a = 0; a < VIM; a++) {
                 local_q += fv->snormal[a] * fv->E_field[a];
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
 
             case SPECIES_FLUX:
@@ -1117,8 +1196,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 }
                 local_qconv += (fv->snormal[a] * (fv->v[a] - x_dot[a]) * fv->c[species_id]);
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case SPECIES_FLUX_REVOLUTION:
@@ -1132,8 +1211,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               }
               local_q *= 0.5 * fv->x[1] * fabs(fv->snormal[1]);
               local_qconv *= 0.5 * fv->x[1] * fabs(fv->snormal[1]);
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case CHARGED_SPECIES_FLUX:
@@ -1172,8 +1251,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                      kapta[species_id] * fv->snormal[a] * fv->grad_V[a]);
                 local_qconv += (fv->snormal[a] * (fv->v[a] - x_dot[a]) * fv->c[species_id]);
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case CURRENT_FICKIAN:
@@ -1213,8 +1292,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                      kapta[species_id] * fv->snormal[a] * fv->grad_V[a]);
                 local_qconv += (fv->snormal[a] * (fv->v[a] - x_dot[a]) * fv->c[species_id]);
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case CURRENT:
@@ -1228,8 +1307,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               for (a = 0; a < VIM; a++) {
                 local_q += -k * fv->snormal[a] * fv->grad_V[a];
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv = 0.0;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv = 0.0;
               break;
 
             case ELEC_FORCE_NORMAL:
@@ -1238,7 +1317,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   local_q += (fv->snormal[a] * perm * es[a][b] * fv->snormal[b]);
                 }
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
             case ELEC_FORCE_TANGENT1:
               for (a = 0; a < VIM; a++) {
@@ -1246,7 +1325,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   local_q += (fv->stangent[0][a] * perm * es[a][b] * fv->snormal[b]);
                 }
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
             case ELEC_FORCE_TANGENT2:
               if (pd->Num_Dim == 3) {
@@ -1258,19 +1337,19 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               } else {
                 GOMA_EH(GOMA_ERROR, "Illegal flux type");
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
             case ELEC_FORCE_X:
               for (a = 0; a < VIM; a++) {
                 local_q += (perm * es[0][a] * fv->snormal[a]);
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
             case ELEC_FORCE_Y:
               for (a = 0; a < VIM; a++) {
                 local_q += (perm * es[1][a] * fv->snormal[a]);
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
             case ELEC_FORCE_Z:
               if (pd->Num_Dim == 3) {
@@ -1280,13 +1359,13 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               } else {
                 GOMA_EH(GOMA_ERROR, "Illegal flux type");
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
             case NET_SURF_CHARGE:
               for (a = 0; a < VIM; a++) {
                 local_q += (-perm * fv->snormal[a] * efield[a]);
               }
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
               break;
 
             case TORQUE:
@@ -1318,8 +1397,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                     }
                   }
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else if (pd->CoordinateSystem == CARTESIAN) {
                 if (WIM == 2) {
                   fv->x[2] = 0.0;
@@ -1351,9 +1430,9 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   }
                 }
                 for (a = 0; a < DIM; a++) {
-                  Torque[a] += weight * det * local_Torque[a];
+                  fa->Torque[a] += weight * det * local_Torque[a];
                 }
-                local_flux = Torque[2];
+                fa->flux = fa->Torque[2];
               } else {
                 GOMA_EH(GOMA_ERROR, "Torque cannot be calculated in this case.");
               }
@@ -1367,16 +1446,16 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               if (mp->PorousMediaType == POROUS_SATURATED) {
 
                 for (a = 0; a < VIM; a++) {
-                  local_flux +=
+                  fa->flux +=
                       weight * det * mp->density * pmv->liq_darcy_velocity[a] * fv->snormal[a];
-                  local_flux_conv += 0.;
+                  fa->flux_conv += 0.;
                 }
               } else if (mp->PorousMediaType == POROUS_UNSATURATED ||
                          mp->PorousMediaType == POROUS_TWO_PHASE) {
 
                 for (a = 0; a < VIM; a++) {
-                  local_flux += weight * det * pmv->rel_mass_flux[0][a] * fv->snormal[a];
-                  local_flux_conv += 0.;
+                  fa->flux += weight * det * pmv->rel_mass_flux[0][a] * fv->snormal[a];
+                  fa->flux_conv += 0.;
                 }
               } else {
                 GOMA_EH(GOMA_ERROR, "unrecognized porous media type in mm_flux.c");
@@ -1393,15 +1472,15 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                         (-rho * fv->snormal[a] * (fv->v[a] - x_dot[a]) * fv->v[b] * fv->snormal[b]);
                   }
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else {
                 for (a = 0; a < VIM; a++) {
                   for (b = 0; b < VIM; b++) {
                     local_q += (fv->snormal[a] * TT[a][b] * fv->snormal[b]);
                   }
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1415,15 +1494,15 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                                     fv->snormal[b]);
                   }
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else {
                 for (a = 0; a < VIM; a++) {
                   for (b = 0; b < VIM; b++) {
                     local_q += (fv->stangent[0][a] * TT[a][b] * fv->snormal[b]);
                   }
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1438,8 +1517,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                                       fv->snormal[b]);
                     }
                   }
-                  local_flux += weight * det * local_q;
-                  local_flux_conv += weight * det * local_qconv;
+                  fa->flux += weight * det * local_q;
+                  fa->flux_conv += weight * det * local_qconv;
                 } else {
                   GOMA_EH(GOMA_ERROR, "Illegal flux type");
                 }
@@ -1449,7 +1528,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                     local_q += (fv->stangent[1][a] * TT[a][b] * fv->snormal[b]);
                   }
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1473,8 +1552,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                                   base_normal[b]);
                 }
               }
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               /* clean-up */
               safe_free((void *)n_dof);
               break;
@@ -1485,13 +1564,13 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   local_q += ((vs[0][a] + ves[0][a]) * fv->snormal[a]);
                   local_qconv += (-rho * (fv->v[0] - x_dot[0]) * fv->v[a] * fv->snormal[a]);
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else {
                 for (a = 0; a < VIM; a++) {
                   local_q += (TT[0][a] * fv->snormal[a]);
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1504,8 +1583,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q < 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else {
                 for (a = 0; a < VIM; a++) {
                   local_q += (TT[0][a] * fv->snormal[a]);
@@ -1513,7 +1592,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q < 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1526,8 +1605,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q > 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else {
                 for (a = 0; a < VIM; a++) {
                   local_q += (TT[0][a] * fv->snormal[a]);
@@ -1535,7 +1614,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q > 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1545,13 +1624,13 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   local_q += ((vs[1][a] + ves[1][a]) * fv->snormal[a]);
                   local_qconv += (-rho * (fv->v[1] - x_dot[1]) * fv->v[a] * fv->snormal[a]);
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else {
                 for (a = 0; a < VIM; a++) {
                   local_q += (TT[1][a] * fv->snormal[a]);
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1564,8 +1643,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q < 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else {
                 for (a = 0; a < VIM; a++) {
                   local_q += (TT[1][a] * fv->snormal[a]);
@@ -1573,7 +1652,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q < 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1586,8 +1665,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q > 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
-                local_flux_conv += weight * det * local_qconv;
+                fa->flux += weight * det * local_q;
+                fa->flux_conv += weight * det * local_qconv;
               } else {
                 for (a = 0; a < VIM; a++) {
                   local_q += (TT[1][a] * fv->snormal[a]);
@@ -1595,7 +1674,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q > 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
               break;
 
@@ -1607,8 +1686,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
 
                     local_qconv += (-rho * (fv->v[2] - x_dot[2]) * fv->v[a] * fv->snormal[a]);
                   }
-                  local_flux += weight * det * local_q;
-                  local_flux_conv += weight * det * local_qconv;
+                  fa->flux += weight * det * local_q;
+                  fa->flux_conv += weight * det * local_qconv;
                 } else {
                   GOMA_EH(GOMA_ERROR, "Illegal flux type");
                 }
@@ -1616,7 +1695,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 for (a = 0; a < VIM; a++) {
                   local_q += (TT[2][a] * fv->snormal[a]);
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
 
               break;
@@ -1632,8 +1711,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   if (local_q < 0) {
                     local_q = 0;
                   }
-                  local_flux += weight * det * local_q;
-                  local_flux_conv += weight * det * local_qconv;
+                  fa->flux += weight * det * local_q;
+                  fa->flux_conv += weight * det * local_qconv;
                 } else {
                   GOMA_EH(GOMA_ERROR, "Illegal flux type");
                 }
@@ -1644,7 +1723,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q < 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
 
               break;
@@ -1660,8 +1739,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   if (local_q > 0) {
                     local_q = 0;
                   }
-                  local_flux += weight * det * local_q;
-                  local_flux_conv += weight * det * local_qconv;
+                  fa->flux += weight * det * local_q;
+                  fa->flux_conv += weight * det * local_qconv;
                 } else {
                   GOMA_EH(GOMA_ERROR, "Illegal flux type");
                 }
@@ -1672,7 +1751,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 if (local_q > 0) {
                   local_q = 0;
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               }
 
               break;
@@ -1680,7 +1759,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
             case AVERAGE_CONC:
 
               local_q += fv->c[species_id];
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
 
               break;
 
@@ -1822,10 +1901,10 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 }
               }
 
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               for (b = 0; b < DIM; b++) {
-                Torque[b] += local_Torque[b] * weight * det;
+                fa->Torque[b] += local_Torque[b] * weight * det;
               }
               break;
 
@@ -1840,8 +1919,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 }
               }
 
-              local_flux += weight * det * local_q;
-              local_flux_conv += weight * det * local_qconv;
+              fa->flux += weight * det * local_q;
+              fa->flux_conv += weight * det * local_qconv;
               break;
 
             case POYNTING_X:
@@ -1861,7 +1940,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   pd->CoordinateSystem == CARTESIAN_2pt5D)
                 GOMA_EH(
                     GOMA_ERROR,
-                    "POYNTING has not been updated for the PROJECTED_CARTESIAN coordinate system.");
+                    "POYNTING has not been updated for the PROJECTED_CARTESIAN "
+                    "coordinate system.");
 
               if (pd->CoordinateSystem == SWIRLING || pd->CoordinateSystem == CYLINDRICAL) {
                 GOMA_EH(GOMA_ERROR, "POYNTING has not been checked for CYLINDRICAL yet.");
@@ -1876,7 +1956,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                     local_q += (fv->x[1] * e_theta[a] * (vs[a][b] + ves[a][b]) * fv->snormal[b]);
                   }
                 }
-                local_flux += weight * det * local_q;
+                fa->flux += weight * det * local_q;
               } else if (pd->CoordinateSystem == CARTESIAN) {
                 Mag_imag[0] = kR_inv * fv->grad_apr[1];
                 Mag_imag[1] = -kR_inv * fv->grad_apr[0];
@@ -1894,9 +1974,9 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                   }
                 }
                 for (a = 0; a < DIM; a++) {
-                  Torque[a] += weight * det * local_Torque[a];
+                  fa->Torque[a] += weight * det * local_Torque[a];
                 }
-                local_flux = Torque[quantity - POYNTING_X];
+                fa->flux = fa->Torque[quantity - POYNTING_X];
               } else {
                 GOMA_EH(GOMA_ERROR, "Torque cannot be calculated in this case.");
               }
@@ -1954,7 +2034,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 local_q += creal((1 / S0) * P[a]) * fv->snormal[a];
               }
 
-              local_flux += weight * det * local_q;
+              fa->flux += weight * det * local_q;
             } break;
 
             case N_DOT_X:
@@ -1968,7 +2048,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 local_q += (fv->x[a] - param[a]) * fv->snormal[a];
               }
 
-              local_flux += weight * det * local_q / (double)dim;
+              fa->flux += weight * det * local_q / (double)dim;
 
               break;
 
@@ -1977,14 +2057,14 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               load_lsi(ls->Length_Scale);
               local_q = lsi->delta;
               local_qconv = lsi->delta;
-              local_flux += weight * det * lsi->delta;
-              local_flux_conv += ad_wt[ip_total - ip - 1] * det * lsi->delta;
+              fa->flux += weight * det * lsi->delta;
+              fa->flux_conv += fa->ad_wt[ip_total - ip - 1] * det * lsi->delta;
               break;
 
             case LS_DCA:
               load_lsi(ls->Length_Scale);
-              ierr = interface_crossing_1DQ(ls_F, xf);
-              if (ierr && ip == 0) {
+              fa->ierr = interface_crossing_1DQ(ls_F, xf);
+              if (fa->ierr && ip == 0) {
                 switch (id_side) {
                 case 1:
                   xi[0] = xf[0];
@@ -2084,8 +2164,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 }
                 local_q = acos(local_q) * 180 / M_PIE;
                 local_qconv = sqrt(local_qconv);
-                local_flux = local_q;
-                local_flux_conv = local_qconv;
+                fa->flux = local_q;
+                fa->flux_conv = local_qconv;
               }
               break;
 
@@ -2095,32 +2175,32 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
               break;
             } /*  end of switch */
 
-            local_area += weight * det;
+            fa->area += weight * det;
 #ifdef PARALLEL
-            delta_flux = local_flux - local_flux0;
-            delta_flux_conv = local_flux_conv - local_flux_conv0;
-            delta_area = local_area - local_area0;
+            delta_flux = fa->flux - fa->flux0;
+            delta_flux_conv = fa->flux_conv - fa->flux_conv0;
+            delta_area = fa->area - fa->area0;
             for (a = 0; a < DIM; a++) {
-              delta_Torque[a] = Torque[a] - Torque0[a];
+              delta_Torque[a] = fa->Torque[a] - fa->Torque0[a];
             }
             if (Num_Proc > 1 && dpi->elem_owner[elem_list[i]] == ProcID) {
-              proc_flux += delta_flux;
-              proc_flux_conv += delta_flux_conv;
-              proc_area += delta_area;
+              fa->proc_flux += delta_flux;
+              fa->proc_flux_conv += delta_flux_conv;
+              fa->proc_area += delta_area;
               for (a = 0; a < DIM; a++) {
-                proc_Torque[a] += delta_Torque[a];
+                fa->proc_Torque[a] += delta_Torque[a];
               }
             }
 
-            local_flux0 = local_flux;
-            local_flux_conv0 = local_flux_conv;
-            local_area0 = local_area;
+            fa->flux0 = fa->flux;
+            fa->flux_conv0 = fa->flux_conv;
+            fa->area0 = fa->area;
             for (a = 0; a < DIM; a++) {
-              Torque0[a] = Torque[a];
+              fa->Torque0[a] = fa->Torque[a];
             }
 #endif
 
-            if (profile_flag && print_flag && (quantity != LS_DCA || (ierr && ip == 0))) {
+            if (profile_flag && print_flag && (quantity != LS_DCA || (fa->ierr && ip == 0))) {
               FILE *jfp;
               if ((jfp = fopen(filenm, "a")) != NULL) {
                 if (quantity == TORQUE &&
@@ -3699,6 +3779,8 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 break;
               }
             }
+            } /* requests on this side set */
+            // clang-format on
 
           } /*  surface integration over element */
 
@@ -3716,6 +3798,15 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
   } /*   sset id   */
   else {
 
+    // clang-format off
+    for (iq = 0; iq < nreq; iq++) {
+    fa = acc[iq];
+    quantity = fa->rq->quantity;
+    species_id = fa->rq->species_id;
+    filenm = fa->rq->filenm;
+    profile_flag = fa->rq->profile_flag;
+    J_AC = fa->rq->J_AC;
+
     /**  Apply end point conditions when the nset is not found   **/
     nset_id = in_list(side_set_id, 0, exo->num_node_sets, exo->ns_id);
     if (nset_id != -1) {
@@ -3847,7 +3938,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
 
                 if (cr->MeshMotion == ARBITRARY) {
                   if (pd->CoordinateSystem == CARTESIAN) {
-                    local_flux += sign * mp->surface_tension * fv->stangent[0][dir];
+                    fa->flux += sign * mp->surface_tension * fv->stangent[0][dir];
 
                     if (J_AC != NULL) {
                       for (p = 0; p < dim; p++) {
@@ -3881,7 +3972,7 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                     }
                   } else if (pd->CoordinateSystem == SWIRLING ||
                              pd->CoordinateSystem == CYLINDRICAL) {
-                    local_flux +=
+                    fa->flux +=
                         2 * M_PIE * fv->x[1] * sign * mp->surface_tension * fv->stangent[0][dir];
                     if (J_AC != NULL) {
                       for (p = 0; p < dim; p++) {
@@ -3927,30 +4018,30 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
                 break;
               } /*  end of switch */
 #ifdef PARALLEL
-              delta_flux = local_flux - local_flux0;
-              delta_flux_conv = local_flux_conv - local_flux_conv0;
-              delta_area = local_area - local_area0;
+              delta_flux = fa->flux - fa->flux0;
+              delta_flux_conv = fa->flux_conv - fa->flux_conv0;
+              delta_area = fa->area - fa->area0;
               for (a = 0; a < DIM; a++) {
-                delta_Torque[a] = Torque[a] - Torque0[a];
+                delta_Torque[a] = fa->Torque[a] - fa->Torque0[a];
               }
 
               if (Num_Proc > 1 && dpi->elem_owner[elem_list[i]] == ProcID) {
-                proc_flux += delta_flux;
-                proc_flux_conv += delta_flux_conv;
-                proc_area += delta_area;
+                fa->proc_flux += delta_flux;
+                fa->proc_flux_conv += delta_flux_conv;
+                fa->proc_area += delta_area;
                 for (a = 0; a < DIM; a++) {
-                  proc_Torque[a] += delta_Torque[a];
+                  fa->proc_Torque[a] += delta_Torque[a];
                 }
               }
 
-              local_flux0 = local_flux;
-              local_flux_conv0 = local_flux_conv;
-              local_area0 = local_area;
+              fa->flux0 = fa->flux;
+              fa->flux_conv0 = fa->flux_conv;
+              fa->area0 = fa->area;
               for (a = 0; a < DIM; a++) {
-                Torque0[a] = Torque[a];
+                fa->Torque0[a] = fa->Torque[a];
               }
 #endif
-              if (profile_flag && print_flag && (quantity != LS_DCA || (ierr && ip == 0))) {
+              if (profile_flag && print_flag && (quantity != LS_DCA || (fa->ierr && ip == 0))) {
                 FILE *jfp;
                 if ((jfp = fopen(filenm, "a")) != NULL) {
                   fprintf(jfp, " %g  %g  %g  %g  %g", fv->x[0], fv->x[1], fv->x[2], local_q,
@@ -4042,55 +4133,225 @@ double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh info
       GOMA_EH(GOMA_ERROR, Err_Msg);
 #endif
     }
+    } /* requests on this side set */
+    // clang-format on
+  }
+
+  af->Assemble_Jacobian = Jac_state;
+  return (0);
+}
+
+/*
+ * Sum the per-processor pieces of every request of the batch with a single
+ * reduction and print the results in the order the requests were given.
+ */
+static void flux_reduce_and_print(const int nreq,
+                                  struct flux_accum *acc,
+                                  const dbl time_value,
+                                  const int print_flag) {
+  int iq, a;
+  const int nval = 3 + DIM;
+
+  for (iq = 0; iq < nreq; iq++) {
+    acc[iq].rq->flux = acc[iq].flux;
+    acc[iq].rq->flux_conv = acc[iq].flux_conv;
+    acc[iq].rq->area = acc[iq].area;
+    for (a = 0; a < DIM; a++) {
+      acc[iq].rq->Torque[a] = acc[iq].Torque[a];
+    }
   }
 
 #ifdef PARALLEL
   if (Num_Proc > 1) {
-    MPI_Allreduce(&proc_flux, &global_flux, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    MPI_Allreduce(&proc_flux_conv, &global_flux_conv, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-
-    MPI_Allreduce(&proc_area, &global_area, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    MPI_Allreduce(proc_Torque, global_Torque, DIM, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
-    local_flux = global_flux;
-    local_flux_conv = global_flux_conv;
-    local_area = global_area;
+    double *proc_sum = alloc_dbl_1(nval * nreq, 0.0);
+    double *global_sum = alloc_dbl_1(nval * nreq, 0.0);
+
+    for (iq = 0; iq < nreq; iq++) {
+      proc_sum[nval * iq] = acc[iq].proc_flux;
+      proc_sum[nval * iq + 1] = acc[iq].proc_flux_conv;
+      proc_sum[nval * iq + 2] = acc[iq].proc_area;
+      for (a = 0; a < DIM; a++) {
+        proc_sum[nval * iq + 3 + a] = acc[iq].proc_Torque[a];
+      }
+    }
+    MPI_Allreduce(proc_sum, global_sum, nval * nreq, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    for (iq = 0; iq < nreq; iq++) {
+      acc[iq].rq->flux = global_sum[nval * iq];
+      acc[iq].rq->flux_conv = global_sum[nval * iq + 1];
+      acc[iq].rq->area = global_sum[nval * iq + 2];
     for (a = 0; a < DIM; a++) {
-      Torque[a] = global_Torque[a];
+        acc[iq].rq->Torque[a] = global_sum[nval * iq + 3 + a];
     }
   }
+    safe_free((void *)proc_sum);
+    safe_free((void *)global_sum);
+  }
 #endif
 
   /**   skip this section if not printing - i.e. for AC conditions  **/
 
   if (print_flag && ProcID == 0) {
-    FILE *jfp;
-    if ((jfp = fopen(filenm, "a")) != NULL) {
-      if (quantity == TORQUE) {
-        if (pd->CoordinateSystem == SWIRLING || pd->CoordinateSystem == CYLINDRICAL) {
-          fprintf(jfp, " torque= %g   \n", local_flux);
-        } else { /* CARTESIAN */
-          fprintf(jfp, " torque= %g %g %g area= %g\n", Torque[0], Torque[1], Torque[2], local_area);
+    for (iq = 0; iq < nreq; iq++) {
+      if (!acc[iq].rq->profile_flag) {
+        flux_print_header(acc[iq].rq, time_value);
         }
-        fprintf(jfp, "\n");
-        fflush(jfp);
-      } else {
-        fprintf(jfp, " flux=  %g %g  area= %g  ", local_flux, local_flux_conv, local_area);
-        if (quantity == REPULSIVE_FORCE) {
-          for (b = 0; b < DIM; b++) {
-            Torque[b] /= local_flux;
+      flux_print_result(acc[iq].rq);
           }
-          fprintf(jfp, " centers=  %g %g %g  ", Torque[0], Torque[1], Torque[2]);
         }
-        fprintf(jfp, "\n\n");
-        fflush(jfp);
       }
-      fclose(jfp);
+
+/* evaluate_flux_batch() -- evaluate several side set flux/force requests
+ *
+ * Requests on the same side set and block are integrated together, so the
+ * basis functions, field variables, mesh derivatives and stresses at each
+ * surface quadrature point are computed once for all of them, and the whole
+ * batch is summed over the processors with one MPI_Allreduce. Requests that
+ * print profiles, and quantities that reload the quadrature point, are
+ * integrated on their own. Each request may carry its own J_AC vector.
+ *
+ * Results are returned in rq[].flux, flux_conv, area and Torque, and the
+ * output files are written exactly as separate evaluate_flux() calls would.
+ * A nonzero return is the error from a failed solid stress evaluation.
+ */
+int evaluate_flux_batch(const Exo_DB *exo,
+                        const Dpi *dpi,
+                        const int nreq,
+                        struct Flux_Request *rq,
+                        dbl *x,
+                        dbl *xdot,
+                        const double delta_t,
+                        const dbl time_value,
+                        const int print_flag) {
+  int iq, jq, ngroup, start, end, err = 0;
+  struct flux_accum *acc;
+  struct flux_accum **group;
+  int *done;
+
+  if (nreq <= 0)
+    return (0);
+
+  acc = alloc_struct_1(struct flux_accum, nreq);
+  group = (struct flux_accum **)alloc_ptr_1(nreq);
+  done = alloc_int_1(nreq, FALSE);
+
+  for (iq = 0; iq < nreq; iq++) {
+    acc[iq].rq = &rq[iq];
+    }
+
+  /*
+   * A profile request writes to its file during the sweep, so it closes the
+   * current batch to keep the output files in request order.
+   */
+  for (start = 0; start < nreq; start = end) {
+    end = start + 1;
+    if (!rq[start].profile_flag) {
+      while (end < nreq && !rq[end].profile_flag) {
+        end++;
+  }
+}
+
+    for (iq = start; iq < end; iq++) {
+      if (done[iq])
+        continue;
+      ngroup = 0;
+      group[ngroup++] = &acc[iq];
+      done[iq] = TRUE;
+      if (flux_quantity_fusable(&rq[iq])) {
+        for (jq = iq + 1; jq < end; jq++) {
+          if (!done[jq] && rq[jq].ss_id == rq[iq].ss_id && rq[jq].blk_id == rq[iq].blk_id &&
+              flux_quantity_fusable(&rq[jq])) {
+            group[ngroup++] = &acc[jq];
+            done[jq] = TRUE;
+          }
+        }
+      }
+      err = evaluate_flux_set(exo, dpi, rq[iq].ss_id, rq[iq].blk_id, ngroup, group, x, xdot,
+                              delta_t, time_value, print_flag);
+      if (err)
+        break;
     }
+    if (err)
+      break;
+
+    flux_reduce_and_print(end - start, &acc[start], time_value, print_flag);
   }
-  af->Assemble_Jacobian = Jac_state;
-  return (local_flux + local_flux_conv); /* failsafe default? */
+
+  safe_free((void *)done);
+  safe_free((void *)group);
+  safe_free((void *)acc);
+  return (err);
 }
 
+double evaluate_flux(const Exo_DB *exo,      /* ptr to basic exodus ii mesh information */
+                     const Dpi *dpi,         /* distributed processing info */
+                     const int side_set_id,  /* on which SSID to evaluate flux */
+                     const int quantity,     /* to pick HEAT_FLUX, FORCE_NORMAL, etc. */
+                     const char *qtity_str,  /* quantity string */
+                     const int blk_id,       /* material identification */
+                     const int species_id,   /* species identification */
+                     const char *filenm,     /* File name pointer */
+                     const int profile_flag, /*  flag for printing flux profiles  */
+                     dbl *x,                 /* solution vector */
+                     dbl *xdot,              /* dx/dt vector */
+                     double J_AC[],          /* vector for augmenting condition sensitivities.
+                              May be NULL */
+                     const double delta_t,   /* time-step size */
+                     const dbl time_value,   /* current time */
+                     const int print_flag)   /*  flag for printing results,1=print*/
+{
+  int err;
+  struct Flux_Request rq;
+
+  memset(&rq, 0, sizeof(struct Flux_Request));
+  rq.ss_id = side_set_id;
+  rq.quantity = quantity;
+  rq.qtity_str = qtity_str;
+  rq.blk_id = blk_id;
+  rq.species_id = species_id;
+  rq.filenm = filenm;
+  rq.profile_flag = profile_flag;
+  rq.J_AC = J_AC;
+
+  err = evaluate_flux_batch(exo, dpi, 1, &rq, x, xdot, delta_t, time_value, print_flag);
+  if (err)
+    return (err);
+
+  return (rq.flux + rq.flux_conv); /* failsafe default? */
+}
+
+/* evaluate_pp_fluxes() -- all FLUX post processing requests of the input
+ * deck, in one batch
+ */
+void evaluate_pp_fluxes(const Exo_DB *exo,
+                        const Dpi *dpi,
+                        dbl *x,
+                        dbl *xdot,
+                        const double delta_t,
+                        const dbl time_value) {
+  int i;
+  struct Flux_Request *rq;
+
+  if (nn_post_fluxes <= 0)
+    return;
+
+  rq = alloc_struct_1(struct Flux_Request, nn_post_fluxes);
+  for (i = 0; i < nn_post_fluxes; i++) {
+    rq[i].ss_id = pp_fluxes[i]->ss_id;
+    rq[i].quantity = pp_fluxes[i]->flux_type;
+    rq[i].qtity_str = pp_fluxes[i]->flux_type_name;
+    rq[i].blk_id = pp_fluxes[i]->blk_id;
+    rq[i].species_id = pp_fluxes[i]->species_number;
+    rq[i].filenm = pp_fluxes[i]->flux_filenm;
+    rq[i].profile_flag = pp_fluxes[i]->profile_flag;
+    rq[i].J_AC = NULL;
+  }
+
+  evaluate_flux_batch(exo, dpi, nn_post_fluxes, rq, x, xdot, delta_t, time_value, 1);
+
+  safe_free((void *)rq);
+}
+
+
 /* evalutate_volume_integral - integrate a volumetric quantity and print out
  *
  * Author: T.A. Baer
@@ -29,6 +29,7 @@
 
 #include "ac_particles.h"
 #include "ac_stability_util.h"
+#include "dp_reorder.h"
 #include "el_elm.h"
 #include "el_elm_info.h"
 #include "mm_as.h"
@@ -46,6 +47,7 @@
 #include "rd_mesh.h"
 #include "rf_allo.h"
 #include "rf_bc_const.h"
+#include "rf_bdf.h"
 #include "rf_fem.h"
 #include "rf_fem_const.h"
 #include "rf_io.h"
@@ -56,6 +58,7 @@
 #include "rf_solve.h"
 #include "rf_solver.h"
 #include "rf_solver_const.h"
+#include "sl_teko_blocks.h"
 #include "sl_util.h"
 #include "std.h"
 #include "util/aprepro_helper.h"
@@ -798,6 +801,25 @@ void rd_file_specs(FILE *ifp, char *input) {
     ECHO(echo_string, echo_file);
   }
 
+  Mesh_Reorder_Type = MESH_REORDER_NONE;
+  foundBrkFile = look_for_optional(ifp, "Mesh Reordering", input, '=');
+  if (foundBrkFile == 1) {
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    if (strcasecmp(input, "none") == 0) {
+      Mesh_Reorder_Type = MESH_REORDER_NONE;
+    } else if (strcasecmp(input, "rcm") == 0) {
+      Mesh_Reorder_Type = MESH_REORDER_RCM;
+    } else if (strcasecmp(input, "hilbert") == 0) {
+      Mesh_Reorder_Type = MESH_REORDER_HILBERT;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Unexpected input for Mesh Reordering: %s, expected none, rcm or hilbert",
+              input);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Mesh Reordering", input);
+    ECHO(echo_string, echo_file);
+  }
+
   /*
    *   look_for Optional Domain mapping file, the usage of the default
    *   will be indicated by the null character string in the name.
@@ -1509,6 +1531,7 @@ void rd_timeint_specs(FILE *ifp, char *input) {
      stab problems.  Needed once PRS started using tran
      structure as a global variable for poroelastic probs */
   tran->theta = 0.0;
+  tran->bdf_max_order = 0;
 
   /* set default frequency to 0 */
   tran->fix_freq = 0;
@@ -1578,6 +1601,28 @@ void rd_timeint_specs(FILE *ifp, char *input) {
     snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %.4g", "Time step parameter", tran->theta);
     ECHO(echo_string, echo_file);
 
+    iread = look_for_optional(ifp, "Time Integration Method", input, '=');
+    if (iread == 1) {
+      (void)read_string(ifp, input, '\n');
+      strip(input);
+      stringup(input);
+      if (strcmp(input, "THETA") == 0) {
+        tran->bdf_max_order = 0;
+      } else if (strncmp(input, "BDF", 3) == 0) {
+        tran->bdf_max_order = BDF_MAX_ORDER;
+        if (sscanf(input + 3, "%d", &tran->bdf_max_order) == 1 &&
+            (tran->bdf_max_order < 1 || tran->bdf_max_order > BDF_MAX_ORDER)) {
+          GOMA_EH(GOMA_ERROR, "Time Integration Method BDF order must be between 1 and %d",
+                  BDF_MAX_ORDER);
+        }
+      } else {
+        GOMA_EH(GOMA_ERROR, "Time Integration Method must be THETA or BDF [max order], got %s",
+                input);
+      }
+      snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %s", "Time Integration Method", input);
+      ECHO(echo_string, echo_file);
+    }
+
     look_for(ifp, "Time step error", input, '=');
     if (fscanf(ifp, "%le", &eps) != 1) {
       GOMA_EH(GOMA_ERROR, "error reading Time step error, expected at least one float");
@@ -1882,6 +1927,7 @@ void rd_timeint_specs(FILE *ifp, char *input) {
     GOMA_EH(GOMA_ERROR, "Expected ALE Adapt Frequency card since ALE Adapt = yes");
   }
 
+  int ale_adapt_iso_size_read = FALSE;
   iread = look_for_optional(ifp, "ALE Adapt ISO Size", input, '=');
   if (iread == 1) {
     tran->ale_adapt_iso_size = read_dbl(ifp, "ALE Adapt ISO Size");
@@ -1891,9 +1937,179 @@ void rd_timeint_specs(FILE *ifp, char *input) {
     snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %g", "ALE Adapt ISO Size",
              tran->ale_adapt_iso_size);
     ECHO(echo_string, echo_file);
-  } else if (tran->ale_adapt) {
+    ale_adapt_iso_size_read = TRUE;
+  }
+
+  /* Target metric and trigger for Omega_h adaptation */
+  tran->adapt_metric = ADAPT_METRIC_DEFAULT;
+  tran->adapt_num_vars = 0;
+  tran->adapt_error_tol = 0.1;
+  tran->adapt_min_length = 1e-6;
+  tran->adapt_max_length = 0.6;
+  tran->adapt_min_elems = 0.0;
+  tran->adapt_max_elems = 0.0;
+  tran->adapt_error_threshold = 0.0;
+
+  iread = look_for_optional(ifp, "Adapt Metric", input, '=');
+  if (iread == 1) {
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    stringup(input);
+
+    if (strcmp(input, "ISO") == 0) {
+      tran->adapt_metric = ADAPT_METRIC_ISO;
+    } else if (strcmp(input, "LEVEL_SET") == 0) {
+      tran->adapt_metric = ADAPT_METRIC_LEVEL_SET;
+    } else if (strcmp(input, "ZZ") == 0) {
+      tran->adapt_metric = ADAPT_METRIC_ZZ;
+    } else if (strcmp(input, "HESSIAN") == 0) {
+      tran->adapt_metric = ADAPT_METRIC_HESSIAN;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Expected ISO, LEVEL_SET, ZZ or HESSIAN for Adapt Metric, got %s",
+              input);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Adapt Metric", input);
+    ECHO(echo_string, echo_file);
+  }
+
+  if (tran->ale_adapt && !ale_adapt_iso_size_read &&
+      (tran->adapt_metric == ADAPT_METRIC_DEFAULT || tran->adapt_metric == ADAPT_METRIC_ISO)) {
     GOMA_EH(GOMA_ERROR, "Expected ALE Adapt ISO Size card since ALE Adapt = yes");
   }
+
+  iread = look_for_optional(ifp, "Adapt Metric Variables", input, '=');
+  if (iread == 1) {
+    char *name = input;
+    int nchar;
+
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    while (sscanf(name, "%31s%n", tran->adapt_vars[tran->adapt_num_vars], &nchar) == 1) {
+      name += nchar;
+      if (++tran->adapt_num_vars == MAX_ADAPT_VARS)
+        break;
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Adapt Metric Variables", input);
+    ECHO(echo_string, echo_file);
+  }
+  if ((tran->adapt_metric == ADAPT_METRIC_ZZ || tran->adapt_metric == ADAPT_METRIC_HESSIAN) &&
+      tran->adapt_num_vars == 0) {
+    GOMA_EH(GOMA_ERROR, "Expected Adapt Metric Variables card for a ZZ or HESSIAN Adapt Metric");
+  }
+
+  iread = look_for_optional(ifp, "Adapt Error Tolerance", input, '=');
+  if (iread == 1) {
+    tran->adapt_error_tol = read_dbl(ifp, "Adapt Error Tolerance");
+    if (tran->adapt_error_tol <= 0) {
+      GOMA_EH(GOMA_ERROR, "Expected Adapt Error Tolerance > 0");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %g", "Adapt Error Tolerance",
+             tran->adapt_error_tol);
+  } else {
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %g %s", "Adapt Error Tolerance",
+             tran->adapt_error_tol, default_string);
+  }
+  ECHO(echo_string, echo_file);
+
+  iread = look_for_optional(ifp, "Adapt Length Limits", input, '=');
+  if (iread == 1) {
+    if (fscanf(ifp, "%lf %lf", &tran->adapt_min_length, &tran->adapt_max_length) != 2) {
+      GOMA_EH(GOMA_ERROR, "Expected minimum and maximum lengths for Adapt Length Limits");
+    }
+    if (tran->adapt_min_length <= 0 || tran->adapt_max_length < tran->adapt_min_length) {
+      GOMA_EH(GOMA_ERROR, "Expected 0 < minimum <= maximum for Adapt Length Limits");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %g %g", "Adapt Length Limits",
+             tran->adapt_min_length, tran->adapt_max_length);
+  } else {
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %g %g %s", "Adapt Length Limits",
+             tran->adapt_min_length, tran->adapt_max_length, default_string);
+  }
+  ECHO(echo_string, echo_file);
+
+  iread = look_for_optional(ifp, "Adapt Element Count", input, '=');
+  if (iread == 1) {
+    if (fscanf(ifp, "%lf %lf", &tran->adapt_min_elems, &tran->adapt_max_elems) != 2) {
+      GOMA_EH(GOMA_ERROR, "Expected minimum and maximum counts for Adapt Element Count");
+    }
+    if (tran->adapt_min_elems < 0 || tran->adapt_max_elems < tran->adapt_min_elems) {
+      GOMA_EH(GOMA_ERROR, "Expected 0 <= minimum <= maximum for Adapt Element Count");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %g %g", "Adapt Element Count",
+             tran->adapt_min_elems, tran->adapt_max_elems);
+    ECHO(echo_string, echo_file);
+  }
+
+  iread = look_for_optional(ifp, "Adapt Error Threshold", input, '=');
+  if (iread == 1) {
+    tran->adapt_error_threshold = read_dbl(ifp, "Adapt Error Threshold");
+    if (tran->adapt_error_threshold < 0) {
+      GOMA_EH(GOMA_ERROR, "Expected Adapt Error Threshold >= 0");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %g", "Adapt Error Threshold",
+             tran->adapt_error_threshold);
+    ECHO(echo_string, echo_file);
+  }
+
+  /* Binary checkpoint/restart of the transient state */
+  tran->checkpoint_freq = 0;
+  tran->checkpoint_aggregate = FALSE;
+  tran->checkpoint_restart = FALSE;
+  strcpy(tran->checkpoint_file, "checkpoint.bin");
+
+  iread = look_for_optional(ifp, "Checkpoint File", input, '=');
+  if (iread == 1) {
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    strncpy(tran->checkpoint_file, input, MAX_FNL - 1);
+    tran->checkpoint_file[MAX_FNL - 1] = '\0';
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %s", "Checkpoint File",
+             tran->checkpoint_file);
+    ECHO(echo_string, echo_file);
+  }
+
+  iread = look_for_optional(ifp, "Checkpoint Frequency", input, '=');
+  if (iread == 1) {
+    tran->checkpoint_freq = read_int(ifp, "Checkpoint Frequency");
+    if (tran->checkpoint_freq < 0) {
+      GOMA_EH(GOMA_ERROR, "Expected Checkpoint Frequency >= 0, got %d", tran->checkpoint_freq);
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %d", "Checkpoint Frequency",
+             tran->checkpoint_freq);
+    ECHO(echo_string, echo_file);
+  }
+
+  iread = look_for_optional(ifp, "Checkpoint Aggregate", input, '=');
+  if (iread == 1) {
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    stringup(input);
+    if ((strcmp(input, "ON") == 0) || (strcmp(input, "YES") == 0)) {
+      tran->checkpoint_aggregate = TRUE;
+    } else if ((strcmp(input, "OFF") == 0) || (strcmp(input, "NO") == 0)) {
+      tran->checkpoint_aggregate = FALSE;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Expected either yes or no for Checkpoint Aggregate");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %s", "Checkpoint Aggregate", input);
+    ECHO(echo_string, echo_file);
+  }
+
+  iread = look_for_optional(ifp, "Restart From Checkpoint", input, '=');
+  if (iread == 1) {
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    stringup(input);
+    if ((strcmp(input, "ON") == 0) || (strcmp(input, "YES") == 0)) {
+      tran->checkpoint_restart = TRUE;
+    } else if ((strcmp(input, "OFF") == 0) || (strcmp(input, "NO") == 0)) {
+      tran->checkpoint_restart = FALSE;
+    } else {
+      GOMA_EH(GOMA_ERROR, "Expected either yes or no for Restart From Checkpoint");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %s", "Restart From Checkpoint", input);
+    ECHO(echo_string, echo_file);
+  }
 }
 /* rd_timeint_specs -- read input file for time integration specifications */
 
@@ -6145,6 +6361,87 @@ void rd_solver_specs(FILE *ifp, char *input) {
     strcpy(Stratimikos_File[i], Stratimikos_File[0]);
   }
 
+  /* Field block preconditioning through Teko, Stratimikos path only */
+  strcpy(search_string, "Teko Block Preconditioner");
+  iread = look_for_optional(ifp, search_string, input, '=');
+  Teko_Block_Preconditioner = TEKO_BLOCK_NONE;
+  strcpy(Teko_Block_Preconditioner_Name, "");
+  if (iread == 1) {
+    read_string(ifp, input, '\n');
+    strip(input);
+    strcpy(Teko_Block_Preconditioner_Name, input);
+    stringup(input);
+    if (!strcmp(input, "NONE")) {
+      Teko_Block_Preconditioner = TEKO_BLOCK_NONE;
+    } else if (!strcmp(input, "BLOCK_JACOBI")) {
+      Teko_Block_Preconditioner = TEKO_BLOCK_JACOBI;
+    } else if (!strcmp(input, "BLOCK_TRIANGULAR")) {
+      Teko_Block_Preconditioner = TEKO_BLOCK_TRIANGULAR;
+    } else if (!strcmp(input, "LSC")) {
+      Teko_Block_Preconditioner = TEKO_BLOCK_LSC;
+    } else if (!strcmp(input, "PCD")) {
+      Teko_Block_Preconditioner = TEKO_BLOCK_PCD;
+    } else {
+      /* Name of an inverse in the "Teko Inverse Library" sublist */
+      Teko_Block_Preconditioner = TEKO_BLOCK_USER;
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, search_string,
+             Teko_Block_Preconditioner_Name);
+    ECHO(echo_string, echo_file);
+  }
+
+  strcpy(search_string, "Teko Block Inverse");
+  iread = look_for_optional(ifp, search_string, input, '=');
+  if (iread == 1) {
+    read_string(ifp, input, '\n');
+    strip(input);
+    strcpy(Teko_Block_Inverse, input);
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, search_string, input);
+    ECHO(echo_string, echo_file);
+  } else {
+    strcpy(Teko_Block_Inverse, "Ifpack");
+    if (Teko_Block_Preconditioner != TEKO_BLOCK_NONE) {
+      snprintf(echo_string, MAX_CHAR_ECHO_INPUT, def_form, search_string, "Ifpack",
+               default_string);
+      ECHO(echo_string, echo_file);
+    }
+  }
+
+  /* Reuse of the Stratimikos solver and preconditioner between linear solves */
+  strcpy(search_string, "Stratimikos Preconditioner Reuse");
+  iread = look_for_optional(ifp, search_string, input, '=');
+  Stratimikos_Prec_Reuse = PREC_REUSE_REBUILD;
+  Stratimikos_Prec_Reuse_Max_Solves = 10;
+  if (iread == 1) {
+    char reuse_type[MAX_CHAR_IN_INPUT];
+    int max_solves;
+    read_string(ifp, input, '\n');
+    strip(input);
+    int nread = sscanf(input, "%s %d", reuse_type, &max_solves);
+    stringup(reuse_type);
+    if (nread >= 1 && !strcmp(reuse_type, "REBUILD")) {
+      Stratimikos_Prec_Reuse = PREC_REUSE_REBUILD;
+    } else if (nread >= 1 && !strcmp(reuse_type, "REFRESH")) {
+      Stratimikos_Prec_Reuse = PREC_REUSE_REFRESH;
+    } else if (nread >= 1 && !strcmp(reuse_type, "KEEP")) {
+      Stratimikos_Prec_Reuse = PREC_REUSE_KEEP;
+      if (nread == 2) {
+        if (max_solves < 1) {
+          GOMA_EH(GOMA_ERROR, "Stratimikos Preconditioner Reuse: solves must be at least 1");
+        }
+        Stratimikos_Prec_Reuse_Max_Solves = max_solves;
+      }
+    } else {
+      GOMA_EH(GOMA_ERROR, "Stratimikos Preconditioner Reuse must be REBUILD, REFRESH or KEEP");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, search_string, input);
+    ECHO(echo_string, echo_file);
+  } else {
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, def_form, search_string, "REBUILD",
+             default_string);
+    ECHO(echo_string, echo_file);
+  }
+
   strcpy(search_string, "Amesos2 File");
   iread = look_for_optional(ifp, search_string, input, '=');
   if (iread == 1) {
@@ -6623,6 +6920,33 @@ void rd_solver_specs(FILE *ifp, char *input) {
     Time_Jacobian_Reformation_stride = 0;
   }
 
+  Jacobian_Reuse = FALSE;
+  Jacobian_Reuse_Max_Age = 10;
+  Jacobian_Reuse_Rate_Tol = 0.5;
+  Jacobian_Reuse_Mass_Tol = 0.2;
+  iread = look_for_optional(ifp, "Jacobian Reuse", input, '=');
+  if (iread == 1) {
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    if (strncmp(input, "yes", 3) == 0) {
+      char temp_string[80];
+      Jacobian_Reuse = TRUE;
+      modified_newton = TRUE;
+      (void)sscanf(input, "%s %d %le %le", temp_string, &Jacobian_Reuse_Max_Age,
+                   &Jacobian_Reuse_Rate_Tol, &Jacobian_Reuse_Mass_Tol);
+      if (Jacobian_Reuse_Max_Age < 1) {
+        GOMA_EH(GOMA_ERROR, "Jacobian Reuse maximum age must be at least 1");
+      }
+      if (Jacobian_Reuse_Rate_Tol <= 0. || Jacobian_Reuse_Mass_Tol < 0.) {
+        GOMA_EH(GOMA_ERROR, "Jacobian Reuse tolerances must be positive");
+      }
+    } else if (strncmp(input, "no", 2) != 0) {
+      GOMA_EH(GOMA_ERROR, "invalid choice for Jacobian Reuse: must be yes or no");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, "%s = %s", "Jacobian Reuse", input);
+    ECHO(echo_string, echo_file);
+  }
+
   char ls_type[MAX_CHAR_IN_INPUT] = "FULL_STEP";
   ;
   Newton_Line_Search_Type = NLS_FULL_STEP;
@@ -7058,6 +7382,24 @@ void rd_solver_specs(FILE *ifp, char *input) {
     ECHO("(Use AutoDiff Assembly = no) (default)", echo_file);
   }
 
+  iread = look_for_optional(ifp, "Use Contraction Assembly", input, '=');
+  if (iread == 1) {
+    (void)read_string(ifp, input, '\n');
+    strip(input);
+    if (strcmp(input, "no") == 0 || strcmp(input, "false") == 0) {
+      upd->ContractionAssembly = false;
+    } else if (strcmp(input, "yes") == 0 || strcmp(input, "true") == 0) {
+      upd->ContractionAssembly = true;
+    } else {
+      GOMA_EH(GOMA_ERROR, "invalid choice: Use Contraction Assembly, yes (true) or no (false)");
+    }
+    snprintf(echo_string, MAX_CHAR_ECHO_INPUT, eoformat, "Use Contraction Assembly", input);
+    ECHO(echo_string, echo_file);
+  } else {
+    upd->ContractionAssembly = false;
+    ECHO("(Use Contraction Assembly = no) (default)", echo_file);
+  }
+
   /*IGBRK*/
   iread = look_for_optional(ifp, "Linear Stability", input, '=');
   if (iread == 1) {
@@ -11489,6 +11831,8 @@ void usage(const int exit_flag) {
   fprintf(stdout, "\t-bc_list                        List BC tags for continuation\n");
   fprintf(stdout, "\t-wr_int                         Turn Write Intermediate Results On\n");
   fprintf(stdout, "\t-time_pl INT                    read_exoII_file time plane (default last)\n");
+  fprintf(stdout, "\t-perf_log FILE                  Write run timings and memory to FILE\n");
+  fprintf(stdout, "\t-mem_report                     Print memory use by subsystem\n");
   fprintf(stdout, "\t-v          --version           Print code version and exit\n");
 
   exit(exit_flag);
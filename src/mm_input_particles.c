@@ -278,6 +278,8 @@ void rd_particle_specs(FILE *ifp, char *input) {
       Particle_Output_Format = TECPLOT;
     else if (!strncmp("FLAT_TEXT", s_tmp, 9))
       Particle_Output_Format = FLAT_TEXT;
+    else if (!strncmp("BINARY", s_tmp, 6))
+      Particle_Output_Format = BINARY;
     else {
       sprintf(s_tmp_save, "Unknown Output format: %s\n", s_tmp);
       GOMA_EH(GOMA_ERROR, s_tmp_save);
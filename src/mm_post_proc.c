@@ -1535,7 +1535,7 @@ static int calc_standard_fields(double **post_proc_vect,
         local_lumped[MOMENT_SOURCES + mom] = 1.;
       }
     }
-    free(d_msource);
+    safe_free(d_msource);
   }
 
   if (YZBETA != -1 && pd->v[pg->imtrx][MASS_FRACTION]) {
@@ -3927,12 +3927,12 @@ void post_process_average(double x[],            /* Solution vector for the curr
   }
 
   for (int i = 0; i < nn_average; i++) {
-    free(avg_count[i]);
-    free(avg_sum[i]);
+    safe_free(avg_count[i]);
+    safe_free(avg_sum[i]);
   }
 
-  free(avg_count);
-  free(avg_sum);
+  safe_free(avg_count);
+  safe_free(avg_sum);
 }
 
 void sum_average_nodal(double **avg_count, double **avg_sum, int global_node, double time) {
@@ -5253,7 +5253,7 @@ void post_process_nodal(double x[],            /* Solution vector for the curren
         err = midsid(post_proc_vect[STREAM], exo);
       }
 
-      free(listnd);
+      safe_free(listnd);
     }
 
     if (FLUXLINES != -1 && Num_Var_In_Type[pg->imtrx][R_MASS]) {
@@ -5272,7 +5272,7 @@ void post_process_nodal(double x[],            /* Solution vector for the curren
           err = midsid(post_proc_vect[FLUXLINES + w], exo);
         }
 
-        free(listndm[w]);
+        safe_free(listndm[w]);
       }
     }
 
@@ -5291,7 +5291,7 @@ void post_process_nodal(double x[],            /* Solution vector for the curren
         err = midsid(post_proc_vect[ENERGY_FLUXLINES], exo);
       }
 
-      free(listnde);
+      safe_free(listnde);
     }
 
   } /* end of serial processing block for streamlines */
@@ -5935,7 +5935,7 @@ void post_process_elem(double x[],     /* soln vector */
 
   /* Release the struct array memory if it exists */
   if (nn_error_metrics > 0)
-    free(pp_error_data);
+    safe_free(pp_error_data);
 }
 /*****************************************************************************/
 
@@ -6400,40 +6400,40 @@ static int calc_zz_error_vel(double x[], /* Solution vector
 
     /* Clean up memory for this patch */
     for (k = 0; k < num_elems_in_patch; k++) {
-      free(xgp_loc[k]);
-      free(ygp_loc[k]);
-      free(zgp_loc[k]);
-      free(det_gp_loc[k]);
-      free(wt_gp_loc[k]);
+      safe_free(xgp_loc[k]);
+      safe_free(ygp_loc[k]);
+      safe_free(zgp_loc[k]);
+      safe_free(det_gp_loc[k]);
+      safe_free(wt_gp_loc[k]);
     }
-    free(xgp_loc);
-    free(ygp_loc);
-    free(zgp_loc);
-    free(det_gp_loc);
-    free(wt_gp_loc);
+    safe_free(xgp_loc);
+    safe_free(ygp_loc);
+    safe_free(zgp_loc);
+    safe_free(det_gp_loc);
+    safe_free(wt_gp_loc);
 
-    free(valid_elem_mask);
+    safe_free(valid_elem_mask);
 
     for (k = 0; k < max_terms; k++) {
-      free(s_lhs[k]);
+      safe_free(s_lhs[k]);
     }
-    free(s_lhs);
-    free(rhs);
-    free(indx);
+    safe_free(s_lhs);
+    safe_free(rhs);
+    safe_free(indx);
 
     for (i = 0; i < VIM; i++) {
       for (j = 0; j < VIM; j++) {
         /* Only the upper tri diag members were malloc'd, so only free those */
         if (j >= i) {
           for (k = 0; k < num_elems_in_patch; k++) {
-            free(tau_gp_ptch[i][j][k]);
+            safe_free(tau_gp_ptch[i][j][k]);
           }
-          free(tau_gp_ptch[i][j]);
+          safe_free(tau_gp_ptch[i][j]);
         }
       }
-      free(tau_gp_ptch[i]);
+      safe_free(tau_gp_ptch[i]);
     }
-    free(tau_gp_ptch);
+    safe_free(tau_gp_ptch);
 
 #ifdef RRL_DEBUG
 #ifdef DBG_1
@@ -6664,7 +6664,7 @@ static int calc_zz_error_vel(double x[], /* Solution vector
             exo->num_elems);
 
     /* Free memory */
-    free(elem_areas);
+    safe_free(elem_areas);
   }
 
   /* Now normalize the raw values of ZZ velocity based error */
@@ -6682,14 +6682,14 @@ static int calc_zz_error_vel(double x[], /* Solution vector
     for (j = 0; j < VIM; j++) {
       /* Only the upper tri diag members were malloc'd, so only free those */
       if (j >= i) {
-        free(tau_lsp[i][j]);
+        safe_free(tau_lsp[i][j]);
       }
     }
-    free(tau_lsp[i]);
+    safe_free(tau_lsp[i]);
   }
-  free(tau_lsp);
-  free(i_node_coords);
-  free(valid_elem_mask);
+  safe_free(tau_lsp);
+  safe_free(i_node_coords);
+  safe_free(valid_elem_mask);
 
   return (status);
 }
@@ -6951,15 +6951,15 @@ static int abs_error_at_elem(int i_elem,
     for (j = 0; j < VIM; j++) {
       /* Only the upper tri diag members were malloc'd, so only free those */
       if (j >= i) {
-        free(tau_gp_fem[i][j]);
-        free(tau_gp_lsp[i][j]);
+        safe_free(tau_gp_fem[i][j]);
+        safe_free(tau_gp_lsp[i][j]);
       }
     }
-    free(tau_gp_fem[i]);
-    free(tau_gp_lsp[i]);
+    safe_free(tau_gp_fem[i]);
+    safe_free(tau_gp_lsp[i]);
   }
-  free(tau_gp_fem);
-  free(tau_gp_lsp);
+  safe_free(tau_gp_fem);
+  safe_free(tau_gp_lsp);
 
   return (status);
 }
@@ -9185,7 +9185,7 @@ void rd_post_process_specs(FILE *ifp, char *input) {
           for (int k = 0; k < nn_average; k++) {
             pp_average[k] = pp_average_tmp[k];
           }
-          free(pp_average_tmp);
+          safe_free(pp_average_tmp);
           sz = sizeof(pp_Average);
           for (int k = nn_average; k < (new_items + nn_average); k++) {
             pp_average[k] = (pp_Average *)array_alloc(1, 1, sz);
@@ -9223,7 +9223,7 @@ void rd_post_process_specs(FILE *ifp, char *input) {
           for (int k = 0; k < nn_average; k++) {
             pp_average[k] = pp_average_tmp[k];
           }
-          free(pp_average_tmp);
+          safe_free(pp_average_tmp);
           sz = sizeof(pp_Average);
           for (int k = nn_average; k < (new_items + nn_average); k++) {
             pp_average[k] = (pp_Average *)array_alloc(1, 1, sz);
@@ -9261,7 +9261,7 @@ void rd_post_process_specs(FILE *ifp, char *input) {
           for (int k = 0; k < nn_average; k++) {
             pp_average[k] = pp_average_tmp[k];
           }
-          free(pp_average_tmp);
+          safe_free(pp_average_tmp);
           sz = sizeof(pp_Average);
           for (int k = nn_average; k < (new_items + nn_average); k++) {
             pp_average[k] = (pp_Average *)array_alloc(1, 1, sz);
@@ -12276,7 +12276,7 @@ int load_elem_tkn(struct Results_Description *rd, const Exo_DB *exo, int tev, in
     }
   }
 
-  free(ev_var_mask);
+  safe_free(ev_var_mask);
 
   /* Now pick up all the post processing variables - yes, for now they must
      each be listed separately and painfully */
@@ -0,0 +1,164 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Quadrature point property store, see mm_qp_props.h
+ */
+
+#include <string.h>
+
+#include "load_field_variables.h"
+#include "mm_as.h"
+#include "mm_as_structs.h"
+#include "mm_mp.h"
+#include "mm_qp_props.h"
+#include "rf_allo.h"
+#include "std.h"
+
+/* State every property is keyed on besides the model inputs, see mm_qp_props.h */
+struct qp_prop_state {
+  unsigned long load_id;
+  int imtrx;
+  int ielem;
+  double x[DIM]; /* the quadrature point within the element */
+  const MATRL_PROP_STRUCT *mp;
+  const struct Field_Variables *fv;
+  const struct Level_Set_Data *ls;
+  /* level set state a property may be modulated by, see ls_modulate_property() */
+  int elem_sign;
+  int on_sharp_surf;
+  int near;
+  double H;
+  double delta;
+  double T;
+  double time;
+};
+
+static void get_state(struct qp_prop_state *state, const double time) {
+  int a;
+
+  /* zero the padding too, the states are compared with memcmp() */
+  memset(state, 0, sizeof(struct qp_prop_state));
+  state->load_id = fv_load_id;
+  state->imtrx = pg->imtrx;
+  state->ielem = ei[pg->imtrx]->ielem;
+  for (a = 0; a < DIM; a++) {
+    state->x[a] = fv->x[a];
+  }
+  state->mp = mp;
+  state->fv = fv;
+  state->ls = ls;
+  if (ls != NULL) {
+    state->elem_sign = ls->Elem_Sign;
+    state->on_sharp_surf = ls->on_sharp_surf;
+    if (lsi != NULL) {
+      state->near = lsi->near;
+      state->H = lsi->H;
+      state->delta = lsi->delta;
+    }
+  }
+  state->T = fv->T;
+  state->time = time;
+}
+
+struct qp_prop_entry {
+  int valid;
+  int has_d; /* dependence structure was filled in */
+  struct qp_prop_state state;
+  double value;
+  size_t key_size;
+  void *key;
+  size_t d_size;
+  void *d;
+};
+
+static struct qp_prop_entry qp_props[QP_PROP_COUNT];
+
+int qp_prop_lookup(const enum qp_prop_id prop,
+                   const double time,
+                   const void *key,
+                   const size_t key_size,
+                   void *d,
+                   const size_t d_size,
+                   double *value) {
+  const struct qp_prop_entry *e = &qp_props[prop];
+  struct qp_prop_state state;
+
+  /* A value-only evaluation is not reused for a Jacobian request and vice versa,
+   * since several properties take different paths when no dependencies are wanted */
+  if (!e->valid || e->has_d != (d != NULL) || e->key_size != key_size ||
+      (d != NULL && e->d_size != d_size)) {
+    return FALSE;
+  }
+  /* The side of the interface, the interface functions and the temperature
+   * change without reloading the field variables, e.g. across the
+   * subelement integration of a sharp interface or in a boundary condition */
+  get_state(&state, time);
+  if (memcmp(&state, &e->state, sizeof(struct qp_prop_state)) != 0 ||
+      (key_size > 0 && memcmp(key, e->key, key_size) != 0)) {
+    return FALSE;
+  }
+  if (d != NULL) {
+    memcpy(d, e->d, d_size);
+  }
+  *value = e->value;
+  return TRUE;
+}
+
+void qp_prop_store(const enum qp_prop_id prop,
+                   const double time,
+                   const void *key,
+                   const size_t key_size,
+                   const void *d,
+                   const size_t d_size,
+                   const double value) {
+  struct qp_prop_entry *e = &qp_props[prop];
+
+  if (key_size > 0) {
+    if (e->key_size != key_size) {
+      safer_free(&e->key);
+      e->key = smalloc((int)key_size);
+    }
+    memcpy(e->key, key, key_size);
+  }
+  e->key_size = key_size;
+  if (d != NULL) {
+    if (e->d_size != d_size) {
+      safer_free(&e->d);
+      e->d = smalloc((int)d_size);
+      e->d_size = d_size;
+    }
+    memcpy(e->d, d, d_size);
+  }
+  e->valid = TRUE;
+  e->has_d = (d != NULL);
+  get_state(&e->state, time);
+  e->value = value;
+}
+
+void qp_prop_invalidate(void) {
+  for (int i = 0; i < QP_PROP_COUNT; i++) {
+    qp_props[i].valid = FALSE;
+  }
+}
+
+void qp_prop_free(void) {
+  for (int i = 0; i < QP_PROP_COUNT; i++) {
+    safer_free(&qp_props[i].key);
+    qp_props[i].key_size = 0;
+    safer_free(&qp_props[i].d);
+    qp_props[i].d_size = 0;
+    qp_props[i].valid = FALSE;
+  }
+}
@@ -85,6 +85,7 @@
 #include "sl_util.h"
 #include "std.h"
 #include "util/distance_helpers.h"
+#include "util/goma_perf_log.h"
 #include "wr_exo.h"
 #include "wr_side_data.h"
 
@@ -99,6 +100,24 @@
 
 static int first_linear_solver_call = TRUE;
 
+/*
+ * Jacobian reuse state, one entry per matrix. With the Jacobian Reuse card
+ * the assembled (and, where the solver allows, factored) Jacobian is kept
+ * across Newton iterations and time steps until one of the refresh tests
+ * in solve_nonlinear_problem() marks it stale.
+ */
+static struct {
+  int valid;        /* matrix holds a Jacobian that may be reused */
+  int age;          /* Newton solves done with it */
+  int nnz;          /* matrix size when it was assembled */
+  int num_unknowns;
+  double mass_coef; /* (1 + 2 theta) / delta_t when it was assembled */
+} jac_reuse[MAX_NUM_MATRICES];
+
+static struct Jacobian_Reuse_Stats jac_reuse_stats[MAX_NUM_MATRICES];
+
+static int jacobian_reuse_stale(struct GomaLinearSolverData *, const double, const double);
+
 /*
  * Default: do not attempt to use Harwell MA28 linear solver. Kundert's is
  *          more robust and Harwell has a better successor to MA28 that you
@@ -363,6 +382,8 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
   int Norm_below_tolerance;      /* Boolean for modified newton test*/
   int Rate_above_tolerance;      /* Boolean for modified newton test*/
   int step_reform;               /* counter for Jacobian reformation */
+  int jac_lagged_step = FALSE;   /* this Newton step uses a reused Jacobian */
+  int jac_lagged_prev = FALSE;   /* and the one before it did */
 
   double Reltol = 1.0e-2, Abstol = 1.0e-6; /* LOCA convergence criteria */
   int continuation_converged = TRUE;
@@ -641,6 +662,10 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
     Rate_above_tolerance = FALSE;
   }
 
+  if (Jacobian_Reuse) {
+    Norm_below_tolerance = Rate_above_tolerance = !jacobian_reuse_stale(ams, theta, delta_t);
+  }
+
   Resid_Norm_stack[2] = Resid_Norm_stack[1] = Resid_Norm_stack[0] = 0.1;
   Soln_Norm_stack[2] = Soln_Norm_stack[1] = Soln_Norm_stack[0] = 0.1;
   AC_Resid_Norm_stack[2] = AC_Resid_Norm_stack[1] = AC_Resid_Norm_stack[0] = 0.1;
@@ -770,14 +795,16 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
   while ((!(*converged)) && (inewton < Max_Newton_Steps)) {
     init_vec_value(resid_vector, 0.0, numProcUnknowns);
     init_vec_value(delta_x, 0.0, numProcUnknowns);
-    /* Zero matrix values */
-    if (ams->GomaMatrixData != NULL) {
-      GomaSparseMatrix matrix = (GomaSparseMatrix)ams->GomaMatrixData;
-      matrix->put_scalar(matrix, 0.0);
-    } else if (strcmp(Matrix_Format, "petsc") == 0) {
-      petsc_zero_mat(ams);
-    } else {
-      init_vec_value(a, 0.0, ams->nnz);
+    /* Zero matrix values, unless the last Jacobian is kept for reuse */
+    if (!Jacobian_Reuse || !Norm_below_tolerance || !Rate_above_tolerance) {
+      if (ams->GomaMatrixData != NULL) {
+        GomaSparseMatrix matrix = (GomaSparseMatrix)ams->GomaMatrixData;
+        matrix->put_scalar(matrix, 0.0);
+      } else if (strcmp(Matrix_Format, "petsc") == 0) {
+        petsc_zero_mat(ams);
+      } else {
+        init_vec_value(a, 0.0, ams->nnz);
+      }
     }
     get_time(ctod);
 
@@ -890,6 +917,22 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
         af->Assemble_LSA_Jacobian_Matrix = FALSE;
         af->Assemble_LSA_Mass_Matrix = FALSE;
       }
+      if (Jacobian_Reuse) {
+        jac_lagged_prev = jac_lagged_step;
+        jac_lagged_step = !af->Assemble_Jacobian;
+        if (af->Assemble_Jacobian) {
+          jac_reuse[pg->imtrx].valid = TRUE;
+          jac_reuse[pg->imtrx].age = 1;
+          jac_reuse[pg->imtrx].nnz = ams->nnz;
+          jac_reuse[pg->imtrx].num_unknowns = NumUnknowns[pg->imtrx];
+          jac_reuse[pg->imtrx].mass_coef =
+              (TimeIntegration != STEADY && delta_t > 0.) ? (1.0 + 2.0 * theta) / delta_t : 0.;
+          jac_reuse_stats[pg->imtrx].assemblies++;
+        } else {
+          jac_reuse[pg->imtrx].age++;
+          jac_reuse_stats[pg->imtrx].assemblies_saved++;
+        }
+      }
       a_start = ut();
       a_end = a_start;
 
@@ -1366,6 +1409,11 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
         } else {
           GOMA_EH(GOMA_ERROR, "Unknown factorization reuse specification.");
         }
+        /* A reused Jacobian can keep its preconditioner as well */
+        if (Jacobian_Reuse && Norm_below_tolerance && Rate_above_tolerance &&
+            ams->options[AZ_keep_info]) {
+          ams->options[AZ_pre_calc] = AZ_reuse;
+        }
       }
 
       linear_solver_blk = 0;     /* count calls to AZ_solve() */
@@ -1534,6 +1582,17 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
       break;
     }
     s_end = ut();
+
+    if (Jacobian_Reuse) {
+      /* Only these solvers skip the factorization for an unchanged matrix */
+      if (Norm_below_tolerance && Rate_above_tolerance &&
+          (Linear_Solver == UMFPACK2 || Linear_Solver == SPARSE13a ||
+           (Linear_Solver == AZTEC && ams->options[AZ_pre_calc] == AZ_reuse))) {
+        jac_reuse_stats[pg->imtrx].factorizations_saved++;
+      } else {
+        jac_reuse_stats[pg->imtrx].factorizations++;
+      }
+    }
     /**************************************************************************
      *        END OF LINEAR SYSTEM SOLVE SECTION
      **************************************************************************/
@@ -2035,6 +2094,20 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
       /* do nothing different*/
     }
 
+    if (Jacobian_Reuse) {
+      /*
+       * Refresh a Jacobian that has been used Jacobian_Reuse_Max_Age times,
+       * or if the last step taken with a reused one cut the residual by less
+       * than the rate tolerance.
+       */
+      int refresh = (jac_reuse[pg->imtrx].age >= Jacobian_Reuse_Max_Age);
+      if (inewton > 0 && jac_lagged_prev &&
+          Resid_Norm_stack[2] > Jacobian_Reuse_Rate_Tol * Resid_Norm_stack[1]) {
+        refresh = TRUE;
+      }
+      Norm_below_tolerance = Rate_above_tolerance = !refresh;
+    }
+
     log_msg("%-38s = %23.16e", "correction norm (L_oo)", Norm[1][0]);
     log_msg("%-38s = %23.16e", "correction norm (L_1)", Norm[1][1]);
     log_msg("%-38s = %23.16e", "correction norm (L_2)", Norm[1][2]);
@@ -2277,6 +2350,10 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
 
       af->Assemble_Jacobian = save_jacobian;
       af->Assemble_Residual = save_residual;
+      /* A damped step means the Jacobian is a poor model here */
+      if (Jacobian_Reuse && best_damp < 1.0) {
+        Norm_below_tolerance = Rate_above_tolerance = FALSE;
+      }
       free(w);
       free(R);
       free(x_save);
@@ -2573,6 +2650,7 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
 
     asmslv_time = (a_end - a_start);
     slv_time = (s_end - s_start);
+    goma_perf_log_newton(&Goma_Perf_Log, asmslv_time, slv_time);
     if (Solver_Output_Format & 512)
       DPRINTF(stdout, "%7.1e/%7.1e ", asmslv_time, slv_time);
     if (Solver_Output_Format & 1024)
@@ -2626,6 +2704,8 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
         DPRINTF(stdout, "%s ", stringer_AC);
       asmslv_time = (ac_end - ac_start);
       slv_time = (sc_end - sc_start);
+      Goma_Perf_Log.assembly_s += asmslv_time;
+      Goma_Perf_Log.solve_s += slv_time;
       if (Solver_Output_Format & 512)
         DPRINTF(stdout, "%7.1e/%7.1e ", asmslv_time, slv_time);
       if (Solver_Output_Format & 1024)
@@ -2877,6 +2957,14 @@ int solve_nonlinear_problem(struct GomaLinearSolverData *ams,
    */
 
 free_and_clear:
+  /*
+   * Only a converged solve leaves a Jacobian worth carrying into the next
+   * one; LOCA may overwrite the matrix between calls.
+   */
+  if (Jacobian_Reuse && (!*converged || con_ptr != NULL)) {
+    jac_reuse[pg->imtrx].valid = FALSE;
+  }
+
   if (Num_Proc > 1 && strcmp(Matrix_Format, "msr") == 0) {
     if (Continuation != LOCA && dofs_hidden) {
       show_external(num_universe_dofs[pg->imtrx],
@@ -3784,4 +3872,57 @@ static int soln_sens(double lambda,  /*  parameter */
 
   return (err);
 } /*   end of routine soln_sens()   */
+
+/*
+ * Decide at the start of a Newton solve whether the Jacobian kept from the
+ * last one may still be used.
+ */
+static int jacobian_reuse_stale(struct GomaLinearSolverData *ams,
+                                const double theta,
+                                const double delta_t) {
+  const int imtrx = pg->imtrx;
+
+  if (!jac_reuse[imtrx].valid || first_linear_solver_call) {
+    return TRUE;
+  }
+  if (jac_reuse[imtrx].nnz != ams->nnz || jac_reuse[imtrx].num_unknowns != NumUnknowns[imtrx]) {
+    return TRUE;
+  }
+  if (jac_reuse[imtrx].age >= Jacobian_Reuse_Max_Age) {
+    return TRUE;
+  }
+  if (TimeIntegration != STEADY && delta_t > 0.) {
+    double mass_coef = (1.0 + 2.0 * theta) / delta_t;
+    if (fabs(mass_coef - jac_reuse[imtrx].mass_coef) >
+        Jacobian_Reuse_Mass_Tol * fabs(jac_reuse[imtrx].mass_coef)) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/*
+ * Forget the kept Jacobians, e.g. after the mesh or the matrix graph changed.
+ */
+void jacobian_reuse_invalidate(void) {
+  for (int imtrx = 0; imtrx < MAX_NUM_MATRICES; imtrx++) {
+    jac_reuse[imtrx].valid = FALSE;
+  }
+}
+
+void jacobian_reuse_get_stats(const int imtrx, struct Jacobian_Reuse_Stats *stats) {
+  *stats = jac_reuse_stats[imtrx];
+}
+
+void jacobian_reuse_print_stats(void) {
+  if (!Jacobian_Reuse) {
+    return;
+  }
+  for (int imtrx = 0; imtrx < upd->Total_Num_Matrices; imtrx++) {
+    const struct Jacobian_Reuse_Stats *st = &jac_reuse_stats[imtrx];
+    DPRINTF(stdout, "\nJacobian reuse, matrix %d: %d assembled, %d reused; ", imtrx,
+            st->assemblies, st->assemblies_saved);
+    DPRINTF(stdout, "%d factored, %d reused\n", st->factorizations, st->factorizations_saved);
+  }
+}
 /* end of file mm_sol_nonlinear.c */
@@ -485,7 +485,7 @@ void setup_local_nodal_vars(Exo_DB *exo, Dpi *dpi)
     }
     safer_free((void **)&(tmp_nodal_vars[imtrx]));
   }
-  free(tmp_nodal_vars);
+  safe_free(tmp_nodal_vars);
 
   /*
    *  When in debug mode, print out a complete listing of variables at
@@ -691,10 +691,10 @@ void setup_external_nodal_vars(Exo_DB *exo, Dpi *dpi, Comm_Ex **cx)
 
     if (dpi->num_neighbors > 0) {
       for (int i = 0; i < upd->Total_Num_Matrices; i++) {
-        free(np_base[i]);
+        safe_free(np_base[i]);
         //        free(nvp_save[i]);
-        free(nvp_send[i]);
-        free(nvp_recv[i]);
+        safe_free(nvp_send[i]);
+        safe_free(nvp_recv[i]);
       }
     }
     safer_free((void **)&np_base);
@@ -21,6 +21,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* GOMA include files */
 #include "ad_turbulence.h"
@@ -36,6 +37,7 @@
 #include "mm_mp.h"
 #include "mm_mp_const.h"
 #include "mm_mp_structs.h"
+#include "mm_qp_props.h"
 #include "mm_viscosity.h"
 #include "models/fluidity.h"
 #include "rf_allo.h"
@@ -46,6 +48,7 @@
 #include "std.h"
 #include "user_mp.h"
 #include "user_mp_gen.h"
+#include "util/gn_viscosity.h"
 
 #define GOMA_MM_VISCOSITY_C
 
@@ -75,6 +78,40 @@
  *        ls_modulate_viscosity()
  *     copy_pF_to_F()
  */
+/*
+ * The shear-rate dependent models are evaluated several times at each
+ * quadrature point (momentum, continuity stabilization, stress and post
+ * processing all ask for the viscosity).  Their last result is kept in the
+ * quadrature point property store (mm_qp_props.h), keyed on the model and
+ * the strain rate, and reused when the same model is asked again.
+ */
+struct gn_visc_key {
+  const struct Generalized_Newtonian *gn;
+  dbl gamma_dot[DIM][DIM];
+};
+
+static int gn_visc_memoizable(const struct Generalized_Newtonian *gn_local) {
+  switch (gn_local->ConstitutiveEquation) {
+  case POWER_LAW:
+  case CARREAU:
+  case CARREAU_WLF:
+  case BINGHAM:
+  case BINGHAM_WLF:
+  case HERSCHEL_BULKLEY:
+    return TRUE;
+  default:
+    return FALSE;
+  }
+}
+
+static void gn_visc_key(struct gn_visc_key *key,
+                        const struct Generalized_Newtonian *gn_local,
+                        dbl gamma_dot[DIM][DIM]) {
+  memset(key, 0, sizeof(struct gn_visc_key));
+  key->gn = gn_local;
+  memcpy(key->gamma_dot, gamma_dot, sizeof(key->gamma_dot));
+}
+
 /*******************************************************************************
  * viscosity(): Calculate the viscosity and derivatives of viscosity
  *              with respect to solution unknowns at the Gauss point. Most
@@ -128,6 +165,15 @@ double viscosity(struct Generalized_Newtonian *gn_local,
   /* Zero out sensitivities */
   zeroStructures(d_mu, 1);
 
+  struct gn_visc_key memo_key;
+  int memoizable = gn_visc_memoizable(gn_local);
+  int memo_hit = FALSE;
+  if (memoizable) {
+    gn_visc_key(&memo_key, gn_local, gamma_dot);
+    memo_hit = qp_prop_lookup(QP_PROP_VISCOSITY, tran->time_value, &memo_key, sizeof(memo_key),
+                              d_mu, sizeof(VISCOSITY_DEPENDENCE_STRUCT), &mu);
+  }
+
   /* this section is for all Newtonian models */
 
   if ((gn_local->ConstitutiveEquation == NEWTONIAN) ||
@@ -627,6 +673,8 @@ double viscosity(struct Generalized_Newtonian *gn_local,
         }
       }
     }
+  } else if (memo_hit) {
+    /* reused from the last evaluation at this quadrature point */
   } else if (gn_local->ConstitutiveEquation == POWER_LAW) {
     mu = power_law_viscosity(gn_local, gamma_dot, d_mu);
   } else if (gn_local->ConstitutiveEquation == CARREAU) {
@@ -661,6 +709,11 @@ double viscosity(struct Generalized_Newtonian *gn_local,
     GOMA_EH(GOMA_ERROR, "Unrecognized viscosity model for non-Newtonian fluid");
   }
 
+  if (memoizable && !memo_hit) {
+    qp_prop_store(QP_PROP_VISCOSITY, tran->time_value, &memo_key, sizeof(memo_key), d_mu,
+                  sizeof(VISCOSITY_DEPENDENCE_STRUCT), mu);
+  }
+
   if (ls != NULL && gn_local->ConstitutiveEquation != VE_LEVEL_SET &&
       mp->ViscosityModel != LEVEL_SET && mp->ViscosityModel != LS_QUADRATIC && mp->mp2nd != NULL &&
       (mp->mp2nd->ViscosityModel == CONSTANT || mp->mp2nd->ViscosityModel == RATIO ||
@@ -757,7 +810,7 @@ double power_law_viscosity(struct Generalized_Newtonian *gn_local,
   dbl d_gd_dmesh[DIM][MDE]; /* derivative of strain rate invariant
                                wrt mesh */
 
-  dbl val;
+  dbl dmu_dgd;
   dbl mu0;
   dbl nexp;
   dbl offset;
@@ -777,18 +830,16 @@ double power_law_viscosity(struct Generalized_Newtonian *gn_local,
   nexp = gn_local->nexp;
   offset = 0.00001;
 
-  val = pow(gammadot + offset, nexp - 1.);
-  mu = mu0 * val;
-  /*
-   * d( mu )/dmesh
-   */
-
-  val = pow(gammadot + offset, nexp - 2.);
+  mu = goma_power_law(gammadot, mu0, nexp, offset, &dmu_dgd);
 
   if (d_mu != NULL) {
-    d_mu->gd = mu0 * (nexp - 1.0) * val;
+    d_mu->gd = dmu_dgd;
   }
 
+  /*
+   * d( mu )/dmesh
+   */
+
   if (d_mu != NULL && pd->e[pg->imtrx][R_MESH1]) {
     for (b = 0; b < VIM; b++) {
       for (j = 0; j < mdofs; j++) {
@@ -992,7 +1043,7 @@ double carreau_viscosity(struct Generalized_Newtonian *gn_local,
   dbl d_gd_dmesh[DIM][MDE]; /* derivative of strain rate invariant
                                wrt mesh */
 
-  dbl val, val1, val2;
+  dbl gd, dmu_dgd;
   dbl mu = 0.;
   dbl mu0;
   dbl muinf;
@@ -1061,26 +1112,12 @@ double carreau_viscosity(struct Generalized_Newtonian *gn_local,
     }
   }
 
-  if (DOUBLE_NONZERO(gammadot)) {
-    val2 = pow(lambda * gammadot, aexp);
-  } else {
-    val2 = 0.;
-  }
-  val = pow(1. + val2, (nexp - 1.) / aexp);
-  mu = muinf + (mu0 - muinf) * val;
-
-  /* gammadot = 0.0; */
-  /* this effectively turns off the viscosity Jac terms */
-
-  if (DOUBLE_NONZERO(gammadot)) {
-    val = pow(lambda * gammadot, aexp - 1.);
-  } else {
-    val = 0.;
-  }
-  val1 = pow(1. + val2, (nexp - 1. - aexp) / aexp);
+  /* A zero shear rate turns off the viscosity Jacobian terms */
+  gd = DOUBLE_NONZERO(gammadot) ? gammadot : 0.;
+  mu = goma_carreau(gd, 1., mu0, muinf, nexp, aexp, lambda, &dmu_dgd, NULL);
 
   if (d_mu != NULL)
-    d_mu->gd = (mu0 - muinf) * (nexp - 1.) * lambda * val * val1;
+    d_mu->gd = dmu_dgd;
 
   /*
    * d( mu )/dmesh
@@ -1511,9 +1548,7 @@ double carreau_wlf_viscosity(struct Generalized_Newtonian *gn_local,
   dbl d_gd_dmesh[DIM][MDE]; /* derivative of strain rate invariant
                                wrt mesh */
 
-  dbl val1;
-  dbl shear, visc_cy;
-  dbl d_shear, d_visc_cy, d_shear_d_at;
+  dbl gd, dmu_dgd, dmu_dat;
   dbl mu = 0.;
   dbl mu0;
   dbl muinf;
@@ -1521,7 +1556,7 @@ double carreau_wlf_viscosity(struct Generalized_Newtonian *gn_local,
   dbl nexp;
   dbl atexp;
   dbl aexp;
-  dbl at_shift;
+  dbl at_shift, dat_dT;
   dbl lambda;
   dbl wlf_denom = 0.0;
   dbl wlfc2;
@@ -1617,32 +1652,17 @@ double carreau_wlf_viscosity(struct Generalized_Newtonian *gn_local,
   }
 
   at_shift = 1.;
+  dat_dT = 0.;
   wlf_denom = wlfc2 + temp - mp->reference[TEMPERATURE];
   if (DOUBLE_NONZERO(wlf_denom)) {
-    at_shift = exp(atexp * (mp->reference[TEMPERATURE] - temp) / wlf_denom);
-    if (!isfinite(at_shift)) {
-      at_shift = DBL_MAX;
-    }
+    at_shift = goma_wlf_shift(temp, mp->reference[TEMPERATURE], atexp, wlfc2, &dat_dT);
   }
 
-  if (DOUBLE_NONZERO(gammadot)) {
-    shear = pow(at_shift * lambda * gammadot, aexp);
-    val1 = pow(at_shift * lambda * gammadot, aexp - 1.);
-    d_shear = aexp * at_shift * lambda * val1;
-    d_shear_d_at = aexp * gammadot * lambda * val1;
-  } else {
-    shear = 0.;
-    d_shear = 0.;
-    d_shear_d_at = 0.;
-  }
-
-  visc_cy = pow(1. + shear, (nexp - 1.) / aexp);
-  d_visc_cy = (nexp - 1.) / aexp * pow(1. + shear, (nexp - 1. - aexp) / aexp);
-
-  mu = at_shift * (muinf + (mu0 - muinf) * visc_cy);
+  gd = DOUBLE_NONZERO(gammadot) ? gammadot : 0.;
+  mu = goma_carreau(gd, at_shift, mu0, muinf, nexp, aexp, lambda, &dmu_dgd, &dmu_dat);
 
   if (d_mu != NULL)
-    d_mu->gd = at_shift * ((mu0 - muinf) * d_visc_cy * d_shear);
+    d_mu->gd = dmu_dgd;
 
   /*
    * d( mu )/dT
@@ -1651,8 +1671,7 @@ double carreau_wlf_viscosity(struct Generalized_Newtonian *gn_local,
   var = TEMPERATURE;
   if (d_mu != NULL && pd->e[pg->imtrx][var]) {
     if (DOUBLE_NONZERO(wlf_denom)) {
-      dmudT = mu + at_shift * at_shift * (mu0 - muinf) * d_visc_cy * d_shear_d_at;
-      dmudT *= -atexp * wlfc2 / (wlf_denom * wlf_denom);
+      dmudT = dmu_dat * dat_dT;
       if (!isfinite(dmudT)) {
         dmudT = DBL_MAX;
       }
@@ -0,0 +1,62 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * particle2tec -- convert a BINARY particle trajectory file written by
+ * Goma into the TECPLOT (or, with -flat, FLAT_TEXT) text that the
+ * particle output would otherwise have produced.
+ *
+ *   particle2tec [-flat] input_file [output_file]
+ *
+ * Without an output file the text goes to stdout.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "util/particle_trajectory.h"
+
+int main(int argc, char **argv) {
+  int tecplot_header = 1;
+  int arg = 1;
+  FILE *out = stdout;
+
+  if (arg < argc && !strcmp(argv[arg], "-flat")) {
+    tecplot_header = 0;
+    arg++;
+  }
+  if (arg >= argc || argc - arg > 2) {
+    fprintf(stderr, "usage: %s [-flat] input_file [output_file]\n", argv[0]);
+    return 1;
+  }
+
+  if (argc - arg == 2) {
+    out = fopen(argv[arg + 1], "w");
+    if (out == NULL) {
+      fprintf(stderr, "%s: could not open %s for writing\n", argv[0], argv[arg + 1]);
+      return 1;
+    }
+  }
+
+  if (goma_ptrj_to_tecplot(argv[arg], out, tecplot_header)) {
+    fprintf(stderr, "%s: could not convert %s\n", argv[0], argv[arg]);
+    if (out != stdout)
+      fclose(out);
+    return 1;
+  }
+
+  if (out != stdout)
+    fclose(out);
+  return 0;
+}
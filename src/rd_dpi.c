@@ -48,135 +48,22 @@
     }                                                                 \
   } while (0)
 
-int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
-  init_dpi_struct(d);
-  float version = -4.98; /* initialize. ex_open() changes this. */
-  int comp_wordsize = sizeof(dbl);
-  int io_wordsize = 0;
-  int exoid = ex_open(fn, EX_READ, &comp_wordsize, &io_wordsize, &version);
-  CHECK_EX_ERROR(exoid, "ex_open");
-  int ex_error;
-
-  ex_error = ex_get_init_global(exoid, &d->num_nodes_global, &d->num_elems_global,
-                                &d->num_elem_blocks_global, &d->num_node_sets_global,
-                                &d->num_side_sets_global);
-
-  CHECK_EX_ERROR(ex_error, "ex_get_init_global");
-
-  // Node Set Global
-  d->ns_id_global = alloc_int_1(d->num_node_sets_global, 0);
-  d->num_ns_global_node_counts = alloc_int_1(d->num_node_sets_global, 0);
-  d->num_ns_global_df_counts = alloc_int_1(d->num_node_sets_global, 0);
-  ex_error = ex_get_ns_param_global(exoid, d->ns_id_global, d->num_ns_global_node_counts,
-                                    d->num_ns_global_df_counts);
-  CHECK_EX_ERROR(ex_error, "ex_get_ns_param_global");
-  // Side Set Global
-  d->ss_id_global = alloc_int_1(d->num_side_sets_global, 0);
-  d->num_ss_global_side_counts = alloc_int_1(d->num_side_sets_global, 0);
-  d->num_ss_global_df_counts = alloc_int_1(d->num_side_sets_global, 0);
-  ex_error = ex_get_ss_param_global(exoid, d->ss_id_global, d->num_ss_global_side_counts,
-                                    d->num_ss_global_df_counts);
-
-  CHECK_EX_ERROR(ex_error, "ex_get_ss_param_global");
-  // Block Global
-  d->global_elem_block_ids = alloc_int_1(d->num_elem_blocks_global, 0);
-  d->global_elem_block_counts = alloc_int_1(d->num_elem_blocks_global, 0);
-  ex_error = ex_get_eb_info_global(exoid, d->global_elem_block_ids, d->global_elem_block_counts);
-  CHECK_EX_ERROR(ex_error, "ex_get_eb_info_global");
-
-  // Nemesis Info
-  d->rank = ProcID;
-  ex_error = ex_get_init_info(exoid, &d->num_proc, &d->num_proc_in_file, &d->ftype);
-  CHECK_EX_ERROR(ex_error, "ex_get_init_info");
-  if (d->num_proc != Num_Proc) {
-    GOMA_EH(GOMA_ERROR, "Nemesis mesh error num_proc != number of mpi processes");
-  }
-  if (d->num_proc_in_file != 1) {
-    GOMA_EH(GOMA_ERROR, "Nemesis mesh error expected num_proc_in_file == 1");
-  }
-  if (d->num_proc != Num_Proc) {
-    GOMA_EH(GOMA_ERROR, "Nemesis mesh error num_proc != number of mpi processes");
-  }
-  if (d->ftype != 'p') {
-    GOMA_EH(GOMA_ERROR, "Nemesis mesh error ftype expected 'p'");
-  }
-  // global indices
-  d->node_index_global = alloc_int_1(exo->num_nodes, 0);
-  d->elem_index_global = alloc_int_1(exo->num_elems, 0);
-  ex_error = ex_get_id_map(exoid, EX_NODE_MAP, d->node_index_global);
-  CHECK_EX_ERROR(ex_error, "ex_get_id_map EX_NODE_MAP");
-  ex_error = ex_get_id_map(exoid, EX_ELEM_MAP, d->elem_index_global);
-  CHECK_EX_ERROR(ex_error, "ex_get_id_map EX_ELEM_MAP");
-
+/*
+ * Everything in the distributed processing information that is derived
+ * from the raw Nemesis data (global set and block parameters, load
+ * balance parameters, processor node maps and communication maps, all
+ * still 1-based as stored in the file): global side set and block
+ * lists, base mesh maps, node and element owners, ghost elements and the
+ * external node ordering.  Used by rd_dpi() and by the in-memory mesh
+ * transfer after Omega_h adaptation, which fills the raw data directly.
+ */
+void setup_dpi(Exo_DB *exo, Dpi *d, bool parallel_call) {
   // set base mesh  global indices
   exo->base_mesh->node_map = alloc_int_1(exo->num_nodes, 0);
   exo->base_mesh->elem_map = alloc_int_1(exo->num_elems, 0);
   memcpy(exo->base_mesh->node_map, d->node_index_global, sizeof(int) * exo->num_nodes);
   memcpy(exo->base_mesh->elem_map, d->elem_index_global, sizeof(int) * exo->num_elems);
 
-  // Load Balance Information
-  ex_error = ex_get_loadbal_param(
-      exoid, &d->num_internal_nodes, &d->num_boundary_nodes, &d->num_external_nodes,
-      &d->num_internal_elems, &d->num_border_elems, &d->num_node_cmaps, &d->num_elem_cmaps, ProcID);
-  CHECK_EX_ERROR(ex_error, "ex_get_loadbal_param");
-
-  d->base_internal_nodes = d->num_internal_nodes;
-  d->base_boundary_nodes = d->num_boundary_nodes;
-  d->base_external_nodes = d->num_external_nodes;
-  d->base_internal_elems = d->num_internal_elems;
-  d->base_border_elems = d->num_border_elems;
-
-  d->proc_node_internal = alloc_int_1(d->num_internal_nodes, 0);
-  if (d->num_boundary_nodes > 0) {
-    d->proc_node_boundary = alloc_int_1(d->num_boundary_nodes, 0);
-  }
-  if (d->num_external_nodes > 0) {
-    d->proc_node_external = alloc_int_1(d->num_external_nodes, 0);
-  }
-
-  ex_error = ex_get_processor_node_maps(exoid, d->proc_node_internal, d->proc_node_boundary,
-                                        d->proc_node_external, ProcID);
-  CHECK_EX_ERROR(ex_error, "ex_get_processor_node_maps");
-
-  d->node_cmap_ids = alloc_int_1(d->num_node_cmaps, 0);
-  d->node_cmap_node_counts = alloc_int_1(d->num_node_cmaps, 0);
-  if (d->num_elem_cmaps > 0) {
-    d->elem_cmap_ids = alloc_int_1(d->num_elem_cmaps, 0);
-    d->elem_cmap_elem_counts = alloc_int_1(d->num_elem_cmaps, 0);
-  }
-
-  ex_error = ex_get_cmap_params(exoid, d->node_cmap_ids, d->node_cmap_node_counts, d->elem_cmap_ids,
-                                d->elem_cmap_elem_counts, ProcID);
-  CHECK_EX_ERROR(ex_error, "ex_get_cmake_params");
-
-  d->node_map_node_ids = calloc(d->num_node_cmaps, sizeof(int *));
-  d->node_map_proc_ids = calloc(d->num_node_cmaps, sizeof(int *));
-
-  for (int i = 0; i < d->num_node_cmaps; i++) {
-    d->node_map_node_ids[i] = alloc_int_1(d->node_cmap_node_counts[i], 0);
-    d->node_map_proc_ids[i] = alloc_int_1(d->node_cmap_node_counts[i], 0);
-    ex_error = ex_get_node_cmap(exoid, d->node_cmap_ids[i], d->node_map_node_ids[i],
-                                d->node_map_proc_ids[i], ProcID);
-    CHECK_EX_ERROR(ex_error, "ex_get_node_cmap %d", i);
-  }
-
-  if (d->num_elem_cmaps > 0) {
-    d->elem_cmap_elem_ids = calloc(d->num_elem_cmaps, sizeof(int *));
-    d->elem_cmap_side_ids = calloc(d->num_elem_cmaps, sizeof(int *));
-    d->elem_cmap_proc_ids = calloc(d->num_elem_cmaps, sizeof(int *));
-  }
-
-  for (int i = 0; i < d->num_elem_cmaps; i++) {
-    d->elem_cmap_elem_ids[i] = alloc_int_1(d->elem_cmap_elem_counts[i], 0);
-    d->elem_cmap_side_ids[i] = alloc_int_1(d->elem_cmap_elem_counts[i], 0);
-    d->elem_cmap_proc_ids[i] = alloc_int_1(d->elem_cmap_elem_counts[i], 0);
-    ex_error = ex_get_elem_cmap(exoid, d->elem_cmap_ids[i], d->elem_cmap_elem_ids[i],
-                                d->elem_cmap_side_ids[i], d->elem_cmap_proc_ids[i], ProcID);
-    CHECK_EX_ERROR(ex_error, "ex_get_elem_cmap %d", i);
-  }
-
-  // Setup old dpi information
-
   d->eb_id_global = calloc(d->num_elem_blocks_global, sizeof(int));
   int *eb_num_nodes_local = calloc(d->num_elem_blocks_global, sizeof(int));
   d->eb_num_nodes_per_elem_global = calloc(d->num_elem_blocks_global, sizeof(int));
@@ -255,8 +142,8 @@ int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
         d->ss_block_index_global[ss_id + 1] = ss_block_index;
       }
 
-      free(ss_block_count_proc);
-      free(ss_block_count_global);
+      safe_free(ss_block_count_proc);
+      safe_free(ss_block_count_global);
     }
   }
   d->elem_owner = alloc_int_1(exo->num_elems, ProcID);
@@ -273,8 +160,8 @@ int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
 
     MPI_Waitall(num_mpi_async, request_array, MPI_STATUSES_IGNORE);
 
-    free(local_ss_internal);
-    free(global_ss_internal);
+    safe_free(local_ss_internal);
+    safe_free(global_ss_internal);
 
     int min_external;
     MPI_Allreduce(&d->num_external_nodes, &min_external, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
@@ -282,9 +169,7 @@ int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
       GOMA_EH(-1, "Found > 0 external nodes, use element decomposition");
     }
   }
-  free(eb_num_nodes_local);
-  ex_error = ex_close(exoid);
-  CHECK_EX_ERROR(ex_error, "ex_close");
+  safe_free(eb_num_nodes_local);
 
   d->num_universe_nodes = d->num_internal_nodes + d->num_boundary_nodes + d->num_external_nodes;
 
@@ -385,7 +270,7 @@ int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
     }
 
     MPI_Waitall(d->num_neighbors * 2, requests, MPI_STATUSES_IGNORE);
-    free(requests);
+    safe_free(requests);
 
     // verify we have the send nodes
     for (int i = 0; i < d->num_neighbors; i++) {
@@ -421,10 +306,10 @@ int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
         GOMA_EH(GOMA_ERROR, "Inconsistent node owners");
       }
     }
-    free(global_owners_min);
-    free(global_owners_max);
-    free(all_global_owners_max);
-    free(all_global_owners_min);
+    safe_free(global_owners_min);
+    safe_free(global_owners_max);
+    safe_free(all_global_owners_max);
+    safe_free(all_global_owners_min);
 
 #endif
 
@@ -459,7 +344,7 @@ int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
       d->node_index_global[d->num_internal_nodes + d->num_boundary_nodes + i] =
           old_global_indices[new_external_node_order[i]];
     }
-    free(old_global_indices);
+    safe_free(old_global_indices);
     double *x_old = alloc_dbl_1(d->num_external_nodes, 0);
     double *y_old = alloc_dbl_1(d->num_external_nodes, 0);
     double *z_old = alloc_dbl_1(d->num_external_nodes, 0);
@@ -481,9 +366,9 @@ int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
         exo->z_coord[offset + i] = z_old[new_external_node_order[i]];
       }
     }
-    free(x_old);
-    free(y_old);
-    free(z_old);
+    safe_free(x_old);
+    safe_free(y_old);
+    safe_free(z_old);
 
     // conn
     for (int block = 0; block < exo->num_elem_blocks; block++) {
@@ -527,18 +412,145 @@ int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
     d->num_owned_nodes = d->num_internal_nodes + d->num_boundary_nodes;
     d->num_universe_nodes = d->num_internal_nodes + d->num_boundary_nodes + d->num_external_nodes;
 
-    free(new_external_node_order);
-    free(old_to_new_external_node_order);
-    free(old_node_owner);
-    free(num_send_nodes);
-    free(num_recv_nodes);
+    safe_free(new_external_node_order);
+    safe_free(old_to_new_external_node_order);
+    safe_free(old_node_owner);
+    safe_free(num_send_nodes);
+    safe_free(num_recv_nodes);
     for (int i = 0; i < d->num_neighbors; i++) {
-      free(global_send_nodes[i]);
-      free(global_recv_nodes[i]);
+      safe_free(global_send_nodes[i]);
+      safe_free(global_recv_nodes[i]);
     }
-    free(global_send_nodes);
-    free(global_recv_nodes);
+    safe_free(global_send_nodes);
+    safe_free(global_recv_nodes);
   }
+}
+
+int rd_dpi(Exo_DB *exo, Dpi *d, char *fn, bool parallel_call) {
+  init_dpi_struct(d);
+  float version = -4.98; /* initialize. ex_open() changes this. */
+  int comp_wordsize = sizeof(dbl);
+  int io_wordsize = 0;
+  int exoid = ex_open(fn, EX_READ, &comp_wordsize, &io_wordsize, &version);
+  CHECK_EX_ERROR(exoid, "ex_open");
+  int ex_error;
+
+  ex_error = ex_get_init_global(exoid, &d->num_nodes_global, &d->num_elems_global,
+                                &d->num_elem_blocks_global, &d->num_node_sets_global,
+                                &d->num_side_sets_global);
+
+  CHECK_EX_ERROR(ex_error, "ex_get_init_global");
+
+  // Node Set Global
+  d->ns_id_global = alloc_int_1(d->num_node_sets_global, 0);
+  d->num_ns_global_node_counts = alloc_int_1(d->num_node_sets_global, 0);
+  d->num_ns_global_df_counts = alloc_int_1(d->num_node_sets_global, 0);
+  ex_error = ex_get_ns_param_global(exoid, d->ns_id_global, d->num_ns_global_node_counts,
+                                    d->num_ns_global_df_counts);
+  CHECK_EX_ERROR(ex_error, "ex_get_ns_param_global");
+  // Side Set Global
+  d->ss_id_global = alloc_int_1(d->num_side_sets_global, 0);
+  d->num_ss_global_side_counts = alloc_int_1(d->num_side_sets_global, 0);
+  d->num_ss_global_df_counts = alloc_int_1(d->num_side_sets_global, 0);
+  ex_error = ex_get_ss_param_global(exoid, d->ss_id_global, d->num_ss_global_side_counts,
+                                    d->num_ss_global_df_counts);
+
+  CHECK_EX_ERROR(ex_error, "ex_get_ss_param_global");
+  // Block Global
+  d->global_elem_block_ids = alloc_int_1(d->num_elem_blocks_global, 0);
+  d->global_elem_block_counts = alloc_int_1(d->num_elem_blocks_global, 0);
+  ex_error = ex_get_eb_info_global(exoid, d->global_elem_block_ids, d->global_elem_block_counts);
+  CHECK_EX_ERROR(ex_error, "ex_get_eb_info_global");
+
+  // Nemesis Info
+  d->rank = ProcID;
+  ex_error = ex_get_init_info(exoid, &d->num_proc, &d->num_proc_in_file, &d->ftype);
+  CHECK_EX_ERROR(ex_error, "ex_get_init_info");
+  if (d->num_proc != Num_Proc) {
+    GOMA_EH(GOMA_ERROR, "Nemesis mesh error num_proc != number of mpi processes");
+  }
+  if (d->num_proc_in_file != 1) {
+    GOMA_EH(GOMA_ERROR, "Nemesis mesh error expected num_proc_in_file == 1");
+  }
+  if (d->num_proc != Num_Proc) {
+    GOMA_EH(GOMA_ERROR, "Nemesis mesh error num_proc != number of mpi processes");
+  }
+  if (d->ftype != 'p') {
+    GOMA_EH(GOMA_ERROR, "Nemesis mesh error ftype expected 'p'");
+  }
+  // global indices
+  d->node_index_global = alloc_int_1(exo->num_nodes, 0);
+  d->elem_index_global = alloc_int_1(exo->num_elems, 0);
+  ex_error = ex_get_id_map(exoid, EX_NODE_MAP, d->node_index_global);
+  CHECK_EX_ERROR(ex_error, "ex_get_id_map EX_NODE_MAP");
+  ex_error = ex_get_id_map(exoid, EX_ELEM_MAP, d->elem_index_global);
+  CHECK_EX_ERROR(ex_error, "ex_get_id_map EX_ELEM_MAP");
+
+  // Load Balance Information
+  ex_error = ex_get_loadbal_param(
+      exoid, &d->num_internal_nodes, &d->num_boundary_nodes, &d->num_external_nodes,
+      &d->num_internal_elems, &d->num_border_elems, &d->num_node_cmaps, &d->num_elem_cmaps, ProcID);
+  CHECK_EX_ERROR(ex_error, "ex_get_loadbal_param");
+
+  d->base_internal_nodes = d->num_internal_nodes;
+  d->base_boundary_nodes = d->num_boundary_nodes;
+  d->base_external_nodes = d->num_external_nodes;
+  d->base_internal_elems = d->num_internal_elems;
+  d->base_border_elems = d->num_border_elems;
+
+  d->proc_node_internal = alloc_int_1(d->num_internal_nodes, 0);
+  if (d->num_boundary_nodes > 0) {
+    d->proc_node_boundary = alloc_int_1(d->num_boundary_nodes, 0);
+  }
+  if (d->num_external_nodes > 0) {
+    d->proc_node_external = alloc_int_1(d->num_external_nodes, 0);
+  }
+
+  ex_error = ex_get_processor_node_maps(exoid, d->proc_node_internal, d->proc_node_boundary,
+                                        d->proc_node_external, ProcID);
+  CHECK_EX_ERROR(ex_error, "ex_get_processor_node_maps");
+
+  d->node_cmap_ids = alloc_int_1(d->num_node_cmaps, 0);
+  d->node_cmap_node_counts = alloc_int_1(d->num_node_cmaps, 0);
+  if (d->num_elem_cmaps > 0) {
+    d->elem_cmap_ids = alloc_int_1(d->num_elem_cmaps, 0);
+    d->elem_cmap_elem_counts = alloc_int_1(d->num_elem_cmaps, 0);
+  }
+
+  ex_error = ex_get_cmap_params(exoid, d->node_cmap_ids, d->node_cmap_node_counts, d->elem_cmap_ids,
+                                d->elem_cmap_elem_counts, ProcID);
+  CHECK_EX_ERROR(ex_error, "ex_get_cmake_params");
+
+  d->node_map_node_ids = calloc(d->num_node_cmaps, sizeof(int *));
+  d->node_map_proc_ids = calloc(d->num_node_cmaps, sizeof(int *));
+
+  for (int i = 0; i < d->num_node_cmaps; i++) {
+    d->node_map_node_ids[i] = alloc_int_1(d->node_cmap_node_counts[i], 0);
+    d->node_map_proc_ids[i] = alloc_int_1(d->node_cmap_node_counts[i], 0);
+    ex_error = ex_get_node_cmap(exoid, d->node_cmap_ids[i], d->node_map_node_ids[i],
+                                d->node_map_proc_ids[i], ProcID);
+    CHECK_EX_ERROR(ex_error, "ex_get_node_cmap %d", i);
+  }
+
+  if (d->num_elem_cmaps > 0) {
+    d->elem_cmap_elem_ids = calloc(d->num_elem_cmaps, sizeof(int *));
+    d->elem_cmap_side_ids = calloc(d->num_elem_cmaps, sizeof(int *));
+    d->elem_cmap_proc_ids = calloc(d->num_elem_cmaps, sizeof(int *));
+  }
+
+  for (int i = 0; i < d->num_elem_cmaps; i++) {
+    d->elem_cmap_elem_ids[i] = alloc_int_1(d->elem_cmap_elem_counts[i], 0);
+    d->elem_cmap_side_ids[i] = alloc_int_1(d->elem_cmap_elem_counts[i], 0);
+    d->elem_cmap_proc_ids[i] = alloc_int_1(d->elem_cmap_elem_counts[i], 0);
+    ex_error = ex_get_elem_cmap(exoid, d->elem_cmap_ids[i], d->elem_cmap_elem_ids[i],
+                                d->elem_cmap_side_ids[i], d->elem_cmap_proc_ids[i], ProcID);
+    CHECK_EX_ERROR(ex_error, "ex_get_elem_cmap %d", i);
+  }
+
+  ex_error = ex_close(exoid);
+  CHECK_EX_ERROR(ex_error, "ex_close");
+
+  setup_dpi(exo, d, parallel_call);
 
   d->goma_dpi_data = false;
   // read ns and ss consistency data
@@ -766,75 +778,75 @@ void uni_dpi(Dpi *dpi, Exo_DB *exo) {
  */
 
 void free_dpi(Dpi *d) {
-  free(d->ns_id_global);
-  free(d->num_ns_global_node_counts);
-  free(d->num_ns_global_df_counts);
-  free(d->ss_id_global);
-  free(d->num_ss_global_side_counts);
-  free(d->num_ss_global_df_counts);
-  free(d->global_elem_block_ids);
-  free(d->global_elem_block_counts);
-  free(d->node_index_global);
-  free(d->elem_index_global);
-  free(d->proc_elem_internal);
+  safe_free(d->ns_id_global);
+  safe_free(d->num_ns_global_node_counts);
+  safe_free(d->num_ns_global_df_counts);
+  safe_free(d->ss_id_global);
+  safe_free(d->num_ss_global_side_counts);
+  safe_free(d->num_ss_global_df_counts);
+  safe_free(d->global_elem_block_ids);
+  safe_free(d->global_elem_block_counts);
+  safe_free(d->node_index_global);
+  safe_free(d->elem_index_global);
+  safe_free(d->proc_elem_internal);
   if (d->num_border_elems > 0) {
-    free(d->proc_elem_border);
+    safe_free(d->proc_elem_border);
   }
-  free(d->proc_node_internal);
+  safe_free(d->proc_node_internal);
   if (d->num_boundary_nodes > 0) {
-    free(d->proc_node_boundary);
+    safe_free(d->proc_node_boundary);
   }
   if (d->num_external_nodes > 0) {
-    free(d->proc_node_external);
+    safe_free(d->proc_node_external);
   }
-  free(d->node_cmap_ids);
-  free(d->node_cmap_node_counts);
+  safe_free(d->node_cmap_ids);
+  safe_free(d->node_cmap_node_counts);
   if (d->num_elem_cmaps > 0) {
-    free(d->elem_cmap_ids);
-    free(d->elem_cmap_elem_counts);
+    safe_free(d->elem_cmap_ids);
+    safe_free(d->elem_cmap_elem_counts);
   }
 
   for (int i = 0; i < d->num_node_cmaps; i++) {
-    free(d->node_map_node_ids[i]);
-    free(d->node_map_proc_ids[i]);
+    safe_free(d->node_map_node_ids[i]);
+    safe_free(d->node_map_proc_ids[i]);
   }
-  free(d->node_map_node_ids);
-  free(d->node_map_proc_ids);
+  safe_free(d->node_map_node_ids);
+  safe_free(d->node_map_proc_ids);
 
   for (int i = 0; i < d->num_elem_cmaps; i++) {
-    free(d->elem_cmap_elem_ids[i]);
-    free(d->elem_cmap_side_ids[i]);
-    free(d->elem_cmap_proc_ids[i]);
+    safe_free(d->elem_cmap_elem_ids[i]);
+    safe_free(d->elem_cmap_side_ids[i]);
+    safe_free(d->elem_cmap_proc_ids[i]);
   }
 
   if (d->num_elem_cmaps > 0) {
-    free(d->elem_cmap_elem_ids);
-    free(d->elem_cmap_side_ids);
-    free(d->elem_cmap_proc_ids);
+    safe_free(d->elem_cmap_elem_ids);
+    safe_free(d->elem_cmap_side_ids);
+    safe_free(d->elem_cmap_proc_ids);
   }
 
-  free(d->eb_id_global);
-  free(d->eb_num_nodes_per_elem_global);
-  free(d->ss_index_global);
+  safe_free(d->eb_id_global);
+  safe_free(d->eb_num_nodes_per_elem_global);
+  safe_free(d->ss_index_global);
 
-  free(d->ss_internal_global);
+  safe_free(d->ss_internal_global);
 
   if (d->num_side_sets_global > 0) {
-    free(d->ss_block_index_global);
-    free(d->ss_block_list_global);
+    safe_free(d->ss_block_index_global);
+    safe_free(d->ss_block_list_global);
   }
 
-  free(d->elem_owner);
-  free(d->neighbor);
-  free(d->node_owner);
-  free(d->num_node_recv);
-  free(d->num_node_send);
-  free(d->exodus_to_omega_h_node);
+  safe_free(d->elem_owner);
+  safe_free(d->neighbor);
+  safe_free(d->node_owner);
+  safe_free(d->num_node_recv);
+  safe_free(d->num_node_send);
+  safe_free(d->exodus_to_omega_h_node);
 
   if (d->goma_dpi_data) {
-    free(d->global_ns_nodes);
-    free(d->global_ss_elems);
-    free(d->global_ss_sides);
+    safe_free(d->global_ns_nodes);
+    safe_free(d->global_ss_elems);
+    safe_free(d->global_ss_sides);
   }
 }
 /************************************************************************/
@@ -866,7 +878,7 @@ void free_dpi_uni(Dpi *d) {
   safer_free((void **)&(d->node_index_global));
   safer_free((void **)&(d->neighbor));
   safer_free((void **)&(d->ss_index_global));
-  free(d->ss_internal_global);
+  safe_free(d->ss_internal_global);
 
   return;
 }
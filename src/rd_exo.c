@@ -1050,96 +1050,96 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
   int i;
   int j;
 
-  free(x->path);
+  safe_free(x->path);
 
-  free(x->title);
+  safe_free(x->title);
 
   if (x->num_qa_rec > 0) {
     for (i = 0; i < x->num_qa_rec; i++) {
       for (j = 0; j < 4; j++) {
-        free(x->qa_record[i][j]);
+        safe_free(x->qa_record[i][j]);
       }
     }
-    free(x->qa_record);
+    safe_free(x->qa_record);
   }
 
   if (x->num_info > 0) {
     for (i = 0; i < x->num_info; i++) {
-      free(x->info[i]);
+      safe_free(x->info[i]);
     }
-    free(x->info);
+    safe_free(x->info);
   }
 
   if (x->elem_map_exists) {
-    free(x->elem_map);
+    safe_free(x->elem_map);
   }
 
   if (x->node_map_exists) {
-    free(x->node_map);
+    safe_free(x->node_map);
   }
 
   safer_free((void **)&(x->elem_order_map));
 
   if (x->num_dim > 0) {
-    free(x->x_coord);
+    safe_free(x->x_coord);
   }
 
   if (x->num_dim > 1) {
-    free(x->y_coord);
+    safe_free(x->y_coord);
   }
 
   if (x->num_dim > 2) {
-    free(x->z_coord);
+    safe_free(x->z_coord);
   }
 
   if (x->num_dim > 0) {
     for (i = 0; i < x->num_dim; i++) {
-      free(x->coord_names[i]);
+      safe_free(x->coord_names[i]);
     }
-    free(x->coord_names);
+    safe_free(x->coord_names);
   }
 
   if (x->num_elems > 0) {
-    free(x->elem_eb);
+    safe_free(x->elem_eb);
   }
 
   if (x->num_elem_blocks > 0) {
     for (i = 0; i < x->num_elem_blocks; i++) {
-      free(x->eb_elem_type[i]);
+      safe_free(x->eb_elem_type[i]);
       if (x->eb_num_elems[i] > 0) {
-        free(x->eb_conn[i]);
+        safe_free(x->eb_conn[i]);
       }
       if ((x->eb_num_elems[i] * x->eb_num_attr[i]) > 0) {
-        free(x->eb_attr[i]);
+        safe_free(x->eb_attr[i]);
       }
     }
 
-    free(x->eb_ptr);
+    safe_free(x->eb_ptr);
 
-    free(x->eb_id);
-    free(x->eb_num_elems);
-    free(x->eb_num_nodes_per_elem);
-    free(x->eb_num_attr);
+    safe_free(x->eb_id);
+    safe_free(x->eb_num_elems);
+    safe_free(x->eb_num_nodes_per_elem);
+    safe_free(x->eb_num_attr);
 
-    free(x->eb_elem_type);
-    free(x->eb_elem_itype);
-    free(x->eb_conn);
-    free(x->eb_attr);
+    safe_free(x->eb_elem_type);
+    safe_free(x->eb_elem_itype);
+    safe_free(x->eb_conn);
+    safe_free(x->eb_attr);
   }
 
   if (x->num_node_sets > 0) {
-    free(x->ns_id);
-    free(x->ns_num_nodes);
-    free(x->ns_num_distfacts);
-    free(x->ns_node_index);
-    free(x->ns_distfact_index);
+    safe_free(x->ns_id);
+    safe_free(x->ns_num_nodes);
+    safe_free(x->ns_num_distfacts);
+    safe_free(x->ns_node_index);
+    safe_free(x->ns_distfact_index);
 
     if (x->ns_node_len > 0) {
-      free(x->ns_node_list);
+      safe_free(x->ns_node_list);
     }
 
     if (x->ns_distfact_len > 0) {
-      free(x->ns_distfact_list);
+      safe_free(x->ns_distfact_list);
       x->ns_distfact_list = NULL;
     }
   }
@@ -1148,28 +1148,28 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
 
     if (x->ss_node_list_exists) {
       for (i = 0; i < x->num_side_sets; i++) {
-        free(x->ss_node_cnt_list[i]);
-        free(x->ss_node_list[i]);
-        free(x->ss_node_side_index[i]);
+        safe_free(x->ss_node_cnt_list[i]);
+        safe_free(x->ss_node_list[i]);
+        safe_free(x->ss_node_side_index[i]);
       }
-      free(x->ss_node_cnt_list);
-      free(x->ss_node_list);
-      free(x->ss_node_side_index);
+      safe_free(x->ss_node_cnt_list);
+      safe_free(x->ss_node_list);
+      safe_free(x->ss_node_side_index);
     }
 
-    free(x->ss_id);
-    free(x->ss_num_sides);
-    free(x->ss_num_distfacts);
-    free(x->ss_elem_index);
-    free(x->ss_distfact_index);
+    safe_free(x->ss_id);
+    safe_free(x->ss_num_sides);
+    safe_free(x->ss_num_distfacts);
+    safe_free(x->ss_elem_index);
+    safe_free(x->ss_distfact_index);
 
     if (x->ss_elem_len > 0) {
-      free(x->ss_elem_list);
-      free(x->ss_side_list);
+      safe_free(x->ss_elem_list);
+      safe_free(x->ss_side_list);
     }
 
     if (x->ss_distfact_len > 0) {
-      free(x->ss_distfact_list);
+      safe_free(x->ss_distfact_list);
       x->ss_distfact_list = NULL;
     }
   }
@@ -1184,11 +1184,11 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
 
   if (x->ns_num_props > 0 && x->ns_prop_name != NULL && x->ns_prop != NULL) {
     for (i = 0; i < x->ns_num_props; i++) {
-      free(x->ns_prop_name[i]);
-      free(x->ns_prop[i]);
+      safe_free(x->ns_prop_name[i]);
+      safe_free(x->ns_prop[i]);
     }
-    free(x->ns_prop_name);
-    free(x->ns_prop);
+    safe_free(x->ns_prop_name);
+    safe_free(x->ns_prop);
   }
 
   /*
@@ -1197,11 +1197,11 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
 
   if (x->ss_num_props > 0 && x->ss_prop_name != NULL && x->ss_prop != NULL) {
     for (i = 0; i < x->ss_num_props; i++) {
-      free(x->ss_prop_name[i]);
-      free(x->ss_prop[i]);
+      safe_free(x->ss_prop_name[i]);
+      safe_free(x->ss_prop[i]);
     }
-    free(x->ss_prop_name);
-    free(x->ss_prop);
+    safe_free(x->ss_prop_name);
+    safe_free(x->ss_prop);
   }
 
   /*
@@ -1210,11 +1210,11 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
 
   if (x->eb_num_props > 0 && x->eb_prop_name != NULL && x->eb_prop != NULL) {
     for (i = 0; i < x->eb_num_props; i++) {
-      free(x->eb_prop_name[i]);
-      free(x->eb_prop[i]);
+      safe_free(x->eb_prop_name[i]);
+      safe_free(x->eb_prop[i]);
     }
-    free(x->eb_prop_name);
-    free(x->eb_prop);
+    safe_free(x->eb_prop_name);
+    safe_free(x->eb_prop);
   }
 
   /*
@@ -1223,9 +1223,9 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
 
   if (x->num_glob_vars > 0) {
     for (i = 0; i < x->num_glob_vars; i++) {
-      free(x->glob_var_names[i]);
+      safe_free(x->glob_var_names[i]);
     }
-    free(x->glob_var_names);
+    safe_free(x->glob_var_names);
   }
 
   if (x->num_elem_vars > 0) {
@@ -1233,20 +1233,20 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
       /* Sanity check - we may have elem vars but when they are not
          read in, these arrays were never malloc'd. The names are then
          constructed in wr_result_prelim_exo */
-      free(x->elem_var_names[i]);
+      safe_free(x->elem_var_names[i]);
     }
-    free(x->elem_var_names);
+    safe_free(x->elem_var_names);
   }
 
   if (x->num_node_vars > 0) {
     for (i = 0; i < x->num_node_vars; i++) {
-      free(x->node_var_names[i]);
+      safe_free(x->node_var_names[i]);
     }
-    free(x->node_var_names);
+    safe_free(x->node_var_names);
   }
 
   if (x->num_times > 0) {
-    free(x->time_vals);
+    safe_free(x->time_vals);
   }
 
 #if 0
@@ -1257,9 +1257,9 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
     {
       for ( i=0; i<x->num_node_vars; i++)
 	{
-	  free(x->node_var_vals[i]);
+	  safe_free(x->node_var_vals[i]);
 	}
-      free(x->node_var_vals);
+      safe_free(x->node_var_vals);
     }
 #endif
 
@@ -1269,13 +1269,13 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
    */
 
   if (x->elem_node_conn_exists) {
-    free(x->elem_ptr);
-    free(x->node_list);
+    safe_free(x->elem_ptr);
+    safe_free(x->node_list);
   }
 
   if (x->node_elem_conn_exists) {
-    free(x->node_elem_pntr);
-    free(x->node_elem_list);
+    safe_free(x->node_elem_pntr);
+    safe_free(x->node_elem_list);
   }
 
   if (x->elem_elem_conn_exists) {
@@ -1288,23 +1288,23 @@ int free_exo(Exo_DB *x) /* pointer to EXODUS II FE db structure */
   }
 
   if (x->node_node_conn_exists) {
-    free(x->node_node_pntr);
-    free(x->node_node_list);
-    free(x->centroid_list);
+    safe_free(x->node_node_pntr);
+    safe_free(x->node_node_list);
+    safe_free(x->centroid_list);
   }
 
   if (x->elem_var_tab_exists) {
-    free(x->truth_table_existance_key);
+    safe_free(x->truth_table_existance_key);
   }
 
-  free(x->elem_var_tab);
-  free(x->ghost_node_to_base);
+  safe_free(x->elem_var_tab);
+  safe_free(x->ghost_node_to_base);
   for (int i = 0; i < x->num_elem_blocks; i++) {
     if (x->eb_ghost_elem_to_base) {
-      free(x->eb_ghost_elem_to_base[i]);
+      safe_free(x->eb_ghost_elem_to_base[i]);
     }
   }
-  free(x->eb_ghost_elem_to_base);
+  safe_free(x->eb_ghost_elem_to_base);
   free_base_mesh(x);
   return (0);
 }
@@ -1824,7 +1824,7 @@ void free_exo_ev(Exo_DB *x) {
     /*      GOMA_EH(GOMA_ERROR, "Can't free what was never in chains.");*/
   }
 
-  free(x->ev_time_indeces);
+  safe_free(x->ev_time_indeces);
 
   for (i = 0; i < x->num_ev_time_indeces; i++) {
 
@@ -1832,13 +1832,13 @@ void free_exo_ev(Exo_DB *x) {
       for (k = 0; k < x->num_elem_vars; k++) {
         index = j * x->num_elem_vars + k;
         if (x->elem_var_tab == NULL || x->elem_var_tab[index] != 0) {
-          free(x->ev[i][index]);
+          safe_free(x->ev[i][index]);
         }
       }
     }
-    free(x->ev[i]);
+    safe_free(x->ev[i]);
   }
-  free(x->ev);
+  safe_free(x->ev);
 
   /*
    * Indicate that this memory structure no longer has space allocated for
@@ -1858,13 +1858,13 @@ void free_exo_gv(Exo_DB *x) {
     /*      GOMA_EH(GOMA_ERROR, "Can't free what was never in chains.");*/
   }
 
-  free(x->gv_time_indeces);
+  safe_free(x->gv_time_indeces);
 
   for (i = 0; i < x->num_gv_time_indeces; i++) {
-    free(x->gv[i]);
+    safe_free(x->gv[i]);
   }
 
-  free(x->gv);
+  safe_free(x->gv);
 
   /*
    * Indicate that this memory structure no longer has space allocated for
@@ -1885,17 +1885,17 @@ void free_exo_nv(Exo_DB *x) {
     /*       GOMA_EH(GOMA_ERROR, "Can't free what was never in chains.");*/
   }
 
-  free(x->nv_indeces);
+  safe_free(x->nv_indeces);
 
-  free(x->nv_time_indeces);
+  safe_free(x->nv_time_indeces);
 
   for (i = 0; i < x->num_nv_time_indeces; i++) {
     for (j = 0; j < x->num_nv_indeces; j++) {
-      free(x->nv[i][j]);
+      safe_free(x->nv[i][j]);
     }
-    free(x->nv[i]);
+    safe_free(x->nv[i]);
   }
-  free(x->nv);
+  safe_free(x->nv);
 
   /*
    * Indicate that this memory structure no longer has space allocated for
@@ -36,6 +36,7 @@
 #include <string.h>
 
 #include "base_mesh.h"
+#include "dp_reorder.h"
 #include "dp_utils.h"
 #include "dpi.h"
 #include "el_elm.h" /* Must be after exodusII.h */
@@ -60,6 +61,8 @@
 #include "rf_io.h"
 #include "rf_io_const.h"
 #include "rf_mp.h"
+#include "rf_solver.h"
+#include "rf_solver_const.h"
 #include "std.h"
 
 #define GOMA_RD_MESH_C
@@ -150,13 +153,7 @@ extern int _brk_(int, char **, char **);
  */
 
 int read_mesh_exoII(Exo_DB *exo, Dpi *dpi) {
-  static char yo[] = "read_mesh_exoII";
-
   int error;
-  int i;
-  int len;
-  int max;
-  int *arr;
 
   multiname(ExoFile, ProcID, Num_Proc);
   error =
@@ -196,6 +193,37 @@ int read_mesh_exoII(Exo_DB *exo, Dpi *dpi) {
     check_parallel_error("Error in reading Distributed Processing Information");
   }
 
+  /*
+   * The frontal solver follows the element order map of the file, leave the
+   * mesh alone for it.
+   */
+  if (Mesh_Reorder_Type != MESH_REORDER_NONE && Linear_Solver != FRONT) {
+    error = reorder_mesh(exo, dpi, Mesh_Reorder_Type);
+    GOMA_EH(error, "reorder_mesh");
+  }
+
+  return setup_mesh_exoII(exo, dpi);
+}
+
+/*
+ * setup_mesh_exoII() -- derived mesh information for a mesh already in memory
+ *
+ * Everything read_mesh_exoII() does once the raw EXODUS II mesh and the
+ * distributed processing information are in place (0-based): internal side
+ * sets, the old style dpi and exo fields, mesh/input consistency checks,
+ * the element block to material map and the connectivity tables. Also used
+ * after Omega_h adaptation, which fills exo and dpi directly rather than
+ * reading them back from a file.
+ */
+
+int setup_mesh_exoII(Exo_DB *exo, Dpi *dpi) {
+  static char yo[] = "setup_mesh_exoII";
+
+  int i;
+  int len;
+  int max;
+  int *arr;
+
   // SS_Internal_Boundary uses the dpi values
   SS_Internal_Boundary = alloc_int_1(exo->num_side_sets, INT_NOINIT);
   for (int ss_index = 0; ss_index < exo->num_side_sets; ss_index++) {
@@ -348,8 +376,8 @@ int *find_ss_internal_boundary(Exo_DB *e) {
       }
     }
   }
-  free(other_side_node_list);
-  free(first_side_node_list);
+  safe_free(other_side_node_list);
+  safe_free(first_side_node_list);
   return ss_is_internal;
 }
 
@@ -831,7 +859,7 @@ void check_sidesets(Exo_DB *e,                       /* EXODUS II FE db has all
     DPRINTF(stderr, "\n");
   }
 
-  free(unused_ss);
+  safe_free(unused_ss);
 
   return;
 }
@@ -918,7 +946,7 @@ void check_nodesets(Exo_DB *e,                       /* EXODUS II FE db has all
     DPRINTF(stderr, "\n");
   }
 
-  free(unused_ns);
+  safe_free(unused_ns);
 
   return;
 }
@@ -1364,7 +1392,7 @@ void sseb_conn(Exo_DB *e,                    /* see exo_struct.h for full def
   *side_set_pointers = ssp;
   *element_block_list = ebl;
 
-  free(list);
+  safe_free(list);
 
   return;
 }
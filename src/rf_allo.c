@@ -41,6 +41,7 @@ static int ALLO_errorOption = 1;
 #include "rf_allo.h"
 #include "rf_io.h"
 #include "std.h"
+#include "util/goma_memory.h"
 
 extern int ProcID;
 
@@ -294,8 +295,10 @@ void *safe_malloc(const int n, const char *filename, const int line)
       fprintf(stderr, "smalloc ERROR P_%d:  Memory allocation failure for %ld bytes", ProcID,
               (long int)nn);
       fprint_location(filename, line);
+      goma_mem_print_local(stderr);
       exit(-1);
     }
+    goma_mem_track_alloc(pntr, nn);
 #ifdef DEBUG_MEMORY
     if ((int)pntr == ALLOC_PROBLEM_ADDRESS) {
       (void)fprintf(stderr, "smalloc: FOUND address %x malloced at location", pntr);
@@ -329,6 +332,7 @@ void safe_free(void *ptr)
   }
 #endif
   if (ptr != NULL) {
+    goma_mem_track_free(ptr);
     free(ptr);
   }
 #if DEBUG_LEVEL > 1
@@ -405,6 +409,7 @@ void safer_free(void **ptr)
       fprintf(stderr, "safer_free: FOUND IT!\n");
     }
 #endif
+    goma_mem_track_free(*ptr);
     free(*ptr);
     *ptr = NULL;
   }
@@ -0,0 +1,446 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Variable order (1 to 5), variable step BDF time integration in fixed
+ * leading coefficient form.  The predictor is the polynomial through the
+ * last order + 1 solutions, the corrector differentiates the polynomial
+ * through the new solution and the last order solutions.  Following
+ * Brenan, Campbell & Petzold (DASSL), the local truncation error at
+ * order q is estimated from the difference between the converged
+ * solution and the order q prediction,
+ *
+ *   LTE_q ~ (t_n+1 - t_n) / (t_n+1 - t_n-q) || x_n+1 - x_pred,q ||
+ *
+ * and the next step size and order are picked from the estimates at the
+ * current order and its neighbors.
+ */
+
+#include <math.h>
+#include <mpi.h>
+#include <string.h>
+
+#include "mm_as.h"
+#include "mm_eh.h"
+#include "rf_allo.h"
+#include "rf_bdf.h"
+#include "rf_fem.h"
+#include "rf_fem_const.h"
+#include "rf_mp.h"
+#include "rf_util.h"
+#include "util/bdf_coefficients.h"
+
+void bdf_init(struct BDF_History *h, const int max_order, const int num_unknowns, const int nAC) {
+  int j;
+
+  if (max_order < 1 || max_order > BDF_MAX_ORDER) {
+    GOMA_EH(GOMA_ERROR, "BDF order must be between 1 and %d, got %d", BDF_MAX_ORDER, max_order);
+  }
+
+  memset(h, 0, sizeof(struct BDF_History));
+  h->max_order = max_order;
+  h->order = 1;
+  h->next_order = 1;
+  h->num_unknowns = num_unknowns;
+  h->nAC = nAC;
+  for (j = 0; j <= max_order; j++) {
+    h->x[j] = alloc_dbl_1(num_unknowns, 0.0);
+    h->x_AC[j] = alloc_dbl_1(nAC, 0.0);
+  }
+  h->work = alloc_dbl_1(num_unknowns, 0.0);
+  h->work_AC = alloc_dbl_1(nAC, 0.0);
+}
+
+void bdf_free(struct BDF_History *h) {
+  int j;
+
+  for (j = 0; j <= h->max_order; j++) {
+    safer_free((void **)&h->x[j]);
+    safer_free((void **)&h->x_AC[j]);
+  }
+  safer_free((void **)&h->work);
+  safer_free((void **)&h->work_AC);
+  h->num_hist = 0;
+}
+
+/*
+ * Restart from a single solution at order 1, as after level set
+ * renormalization or mesh adaptation.  The number of unknowns may have
+ * changed since the last reset.
+ */
+void bdf_reset(struct BDF_History *h,
+               const int num_unknowns,
+               const double x[],
+               const double x_AC[],
+               const double time) {
+  int j;
+
+  if (num_unknowns != h->num_unknowns) {
+    for (j = 0; j <= h->max_order; j++) {
+      realloc_dbl_1(&h->x[j], num_unknowns, h->num_unknowns);
+    }
+    realloc_dbl_1(&h->work, num_unknowns, h->num_unknowns);
+    h->num_unknowns = num_unknowns;
+  }
+
+  dcopy1(num_unknowns, x, h->x[0]);
+  if (h->nAC > 0)
+    dcopy1(h->nAC, x_AC, h->x_AC[0]);
+  h->t[0] = time;
+  h->num_hist = 1;
+  h->order = 1;
+  h->next_order = 1;
+  h->steps_at_order = 0;
+}
+
+/* Add the converged solution at time to the history */
+void bdf_push(struct BDF_History *h, const double x[], const double x_AC[], const double time) {
+  int j;
+  double *x_last = h->x[h->max_order];
+  double *x_AC_last = h->x_AC[h->max_order];
+
+  for (j = h->max_order; j > 0; j--) {
+    h->x[j] = h->x[j - 1];
+    h->x_AC[j] = h->x_AC[j - 1];
+    h->t[j] = h->t[j - 1];
+  }
+  h->x[0] = x_last;
+  h->x_AC[0] = x_AC_last;
+  h->t[0] = time;
+  dcopy1(h->num_unknowns, x, h->x[0]);
+  if (h->nAC > 0)
+    dcopy1(h->nAC, x_AC, h->x_AC[0]);
+  h->num_hist = MIN(h->num_hist + 1, h->max_order + 1);
+
+  if (h->next_order == h->order) {
+    h->steps_at_order++;
+  } else {
+    h->steps_at_order = 0;
+  }
+}
+
+static void bdf_extrapolate(const struct BDF_History *h,
+                            const int q,
+                            const double time1,
+                            double x[],
+                            double x_AC[]) {
+  int i, j;
+  double w[BDF_MAX_ORDER + 1];
+
+  goma_bdf_extrapolation_weights(q, time1, h->t, w);
+
+  for (i = 0; i < h->num_unknowns; i++) {
+    x[i] = w[0] * h->x[0][i];
+  }
+  for (j = 1; j <= q; j++) {
+    for (i = 0; i < h->num_unknowns; i++) {
+      x[i] += w[j] * h->x[j][i];
+    }
+  }
+
+  for (i = 0; i < h->nAC; i++) {
+    x_AC[i] = 0.0;
+    for (j = 0; j <= q; j++) {
+      x_AC[i] += w[j] * h->x_AC[j][i];
+    }
+  }
+}
+
+/*
+ * Set up the corrector for the step to time1 and return the time step
+ * parameter theta that makes the assembled mass coefficient
+ * (1 + 2 theta) / delta_t equal the BDF leading coefficient alpha[0].
+ */
+double bdf_begin_step(struct BDF_History *h, const double time1) {
+  h->order = MIN(h->next_order, h->num_hist);
+  goma_bdf_derivative_coefficients(h->order, time1, h->t, h->alpha);
+
+  return 0.5 * (h->alpha[0] * (time1 - h->t[0]) - 1.0);
+}
+
+/*
+ * Predict the solution at time1 from the history and set xdot to be
+ * consistent with it.  Newton updates then keep xdot consistent, since
+ * they change it by alpha[0] times the update to x.
+ */
+void bdf_predict(const struct BDF_History *h,
+                 const double time1,
+                 double x[],
+                 double xdot[],
+                 double x_AC[],
+                 double x_AC_dot[]) {
+  int i, j;
+  int q = MIN(h->order, h->num_hist - 1);
+
+  bdf_extrapolate(h, q, time1, x, x_AC);
+
+  for (i = 0; i < h->num_unknowns; i++) {
+    xdot[i] = h->alpha[0] * x[i];
+  }
+  for (j = 1; j <= h->order; j++) {
+    for (i = 0; i < h->num_unknowns; i++) {
+      xdot[i] += h->alpha[j] * h->x[j - 1][i];
+    }
+  }
+
+  for (i = 0; i < h->nAC; i++) {
+    x_AC_dot[i] = h->alpha[0] * x_AC[i];
+    for (j = 1; j <= h->order; j++) {
+      x_AC_dot[i] += h->alpha[j] * h->x_AC[j - 1][i];
+    }
+  }
+}
+
+/*
+ * RMS norm of x - x_pred over the variables selected in use_var_norm[],
+ * with the same per variable type scaling as time_step_control(): for a
+ * negative eps each variable type is normalized by its maximum value.
+ */
+static double bdf_error_norm(const struct BDF_History *h,
+                             const double x[],
+                             const double x_pred[],
+                             const double x_AC[],
+                             const double x_AC_pred[],
+                             const double eps,
+                             const int use_var_norm[]) {
+  int i, var;
+  int num_unknowns = 0;
+  int ncp[MAX_VARIABLE_TYPES];
+  double ecp[MAX_VARIABLE_TYPES];
+  double max[MAX_VARIABLE_TYPES];
+  double err = 0.0;
+  int num_owned = num_internal_dofs[pg->imtrx] + num_boundary_dofs[pg->imtrx];
+
+  memset(ncp, 0, sizeof(int) * MAX_VARIABLE_TYPES);
+  init_vec_value(ecp, 0.0, MAX_VARIABLE_TYPES);
+  init_vec_value(max, 0.0, MAX_VARIABLE_TYPES);
+
+  for (i = 0; i < num_owned; i++) {
+    var = idv[pg->imtrx][i][0];
+    if (!time_step_norm_var(var, use_var_norm))
+      continue;
+    ecp[var] += SQUARE(x[i] - x_pred[i]);
+    ncp[var]++;
+    if (fabs(x[i]) > max[var])
+      max[var] = fabs(x[i]);
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, ecp, MAX_VARIABLE_TYPES, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, max, MAX_VARIABLE_TYPES, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, ncp, MAX_VARIABLE_TYPES, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  for (var = 0; var < MAX_VARIABLE_TYPES; var++) {
+    if (ncp[var] == 0)
+      continue;
+    if (eps < 0.0 && max[var] > DBL_SEMI_SMALL) {
+      ecp[var] /= SQUARE(max[var]);
+    }
+    err += ecp[var];
+    num_unknowns += ncp[var];
+  }
+
+  if (use_var_norm[9]) {
+    for (i = 0; i < h->nAC; i++) {
+      double e = SQUARE(x_AC[i] - x_AC_pred[i]);
+      if (eps < 0.0 && fabs(x_AC[i]) > 0.0)
+        e /= SQUARE(x_AC[i]);
+      err += e;
+      num_unknowns++;
+    }
+  }
+
+  if (num_unknowns == 0) {
+    GOMA_EH(GOMA_ERROR, "\"Time step error\" norm includes no active variables!");
+  }
+
+  return sqrt(err / num_unknowns);
+}
+
+/* Estimated local truncation error of the step at order q, -1 if unavailable */
+static double bdf_error_estimate(struct BDF_History *h,
+                                 const int q,
+                                 const double time1,
+                                 const double x[],
+                                 const double x_AC[],
+                                 const double eps,
+                                 const int use_var_norm[]) {
+  if (q < 1 || q > h->max_order || h->num_hist < q + 1)
+    return -1.0;
+
+  bdf_extrapolate(h, q, time1, h->work, h->work_AC);
+  return (time1 - h->t[0]) / (time1 - h->t[q]) *
+         bdf_error_norm(h, x, h->work, x_AC, h->work_AC, eps, use_var_norm);
+}
+
+/* Step size factor for a truncation error err at order q, as in time_step_control() */
+static double bdf_step_factor(const double err, const int q, const double abs_eps) {
+  const double alpha = TIME_STEP_ALPHA;
+
+  if (err <= 0.0)
+    return (abs_eps > 0.0) ? TIME_STEP_GROWTH_CAP : 1.0;
+  if (err > abs_eps)
+    return pow(abs_eps / err, 1.0 / (q + 1));
+  if (err >= abs_eps / alpha)
+    return 1.0;
+  return pow(abs_eps / (alpha * err), 1.0 / (q + 1));
+}
+
+/*
+ * Accept or reject the converged step to time1 from its estimated
+ * truncation error, choose the order of the next step and return the
+ * recommended time step.  The order changes only after order + 1 steps
+ * at the current order: it drops when the order - 1 estimate is no
+ * larger than the current one and rises when the order + 1 estimate is
+ * smaller.  A rejected step drops the order if that looks favorable.
+ */
+double bdf_step_control(struct BDF_History *h,
+                        const double time1,
+                        const int const_delta_t,
+                        const double x[],
+                        const double x_AC[],
+                        const double eps,
+                        int *success_dt,
+                        const int use_var_norm[]) {
+  const double beta = TIME_STEP_BETA;
+  const double abs_eps = fabs(eps);
+  const double delta_t = time1 - h->t[0];
+  const int k = h->order;
+  int q = k;
+  double err, err_lower, err_higher, delta_t_new;
+
+  static const char yo[] = "bdf_step_control";
+
+  err = bdf_error_estimate(h, k, time1, x, x_AC, eps, use_var_norm);
+  if (err < 0.0) {
+    /* not enough history to estimate the error at this order yet */
+    *success_dt = TRUE;
+    h->next_order = k;
+    DPRINTF(stdout, "\nBDF%d startup step\n", k);
+    return delta_t;
+  }
+  err_lower = bdf_error_estimate(h, k - 1, time1, x, x_AC, eps, use_var_norm);
+  err_higher = bdf_error_estimate(h, k + 1, time1, x, x_AC, eps, use_var_norm);
+
+  *success_dt = const_delta_t || (err < beta * abs_eps);
+
+  if (!*success_dt) {
+    if (err_lower >= 0.0 && err_lower <= err)
+      h->next_order = k - 1;
+    DPRINTF(stdout, "\nYUK BDF%d %7.1e > %3g %7.1e, next try BDF%d\n", k, err, beta, abs_eps,
+            h->next_order);
+    log_msg("BDF%d truncation error was YUK, %g > %g * %g", k, err, beta, eps);
+    return (delta_t / 2.);
+  }
+
+  if (h->steps_at_order >= k) {
+    if (err_lower >= 0.0 && err_lower <= err) {
+      q = k - 1;
+    } else if (err_higher >= 0.0 && err_higher < err) {
+      q = k + 1;
+    }
+  }
+  h->next_order = q;
+
+  if (const_delta_t) {
+    delta_t_new = delta_t;
+    DPRINTF(stdout, "\nCONSTANT DELTA_T BDF%d %7.1e, next step BDF%d\n", k, err, q);
+  } else {
+    double err_next = (q == k - 1) ? err_lower : ((q == k + 1) ? err_higher : err);
+    delta_t_new = delta_t * MIN(bdf_step_factor(err_next, q, abs_eps), TIME_STEP_GROWTH_CAP);
+    DPRINTF(stdout, "\nOK  BDF%d %7.1e < %3g %7.1e, next step BDF%d\n", k, err, beta, abs_eps, q);
+  }
+  log_msg("BDF%d truncation error was OK, next step BDF%d, dt = %g", k, q, delta_t_new);
+
+  return delta_t_new;
+}
+
+/*
+ * Assembly code that forms the time derivative of a quantity q itself,
+ * rather than taking it from the assembled solution derivative, writes
+ *
+ *   q_dot = (1 + 2 tt) / dt (q - q_old) + time_derivative_history(...)
+ *
+ * For the theta method the history part is -2 tt q_dot_old.  For BDF it
+ * is alpha[0] q_old + sum_{j >= 1} alpha[j] q at the history solutions,
+ * since (1 + 2 tt) / dt = alpha[0].  When q is a solution field, or a
+ * quantity linearized about q_old, its assembled derivative q_dot (e.g.
+ * fv_dot) already holds that sum, and the history part is what remains
+ * of it after the leading term.
+ */
+double time_derivative_history(const double q,
+                               const double q_old,
+                               const double q_dot,
+                               const double q_dot_old,
+                               const double tt,
+                               const double dt) {
+  if (tran->bdf_max_order > 0) {
+    return q_dot - (1.0 + 2.0 * tt) / dt * (q - q_old);
+  }
+  return -2.0 * tt * q_dot_old;
+}
+
+/*
+ * The history is part of the time integrator state: without it a run
+ * restarted from a checkpoint would drop back to BDF1 and take different
+ * steps than the uninterrupted run.  The reader must have been set up by
+ * bdf_init() with the same maximum order and sizes.
+ */
+int write_bdf_checkpoint(goma_ckpt_buffer *b, const struct BDF_History *h) {
+  int err = 0;
+  int j;
+
+  err |= goma_ckpt_put_int(b, h->max_order);
+  err |= goma_ckpt_put_int(b, h->order);
+  err |= goma_ckpt_put_int(b, h->next_order);
+  err |= goma_ckpt_put_int(b, h->steps_at_order);
+  err |= goma_ckpt_put_int(b, h->num_hist);
+  err |= goma_ckpt_put_int(b, h->num_unknowns);
+  err |= goma_ckpt_put_int(b, h->nAC);
+  err |= goma_ckpt_put_doubles(b, h->t, h->num_hist);
+  for (j = 0; j < h->num_hist; j++) {
+    err |= goma_ckpt_put_doubles(b, h->x[j], h->num_unknowns);
+    if (h->nAC > 0)
+      err |= goma_ckpt_put_doubles(b, h->x_AC[j], h->nAC);
+  }
+  return err ? -1 : 0;
+}
+
+int read_bdf_checkpoint(goma_ckpt_buffer *b, struct BDF_History *h) {
+  int max_order, num_unknowns, nAC;
+  int j;
+
+  if (goma_ckpt_get_int(b, &max_order) || goma_ckpt_get_int(b, &h->order) ||
+      goma_ckpt_get_int(b, &h->next_order) || goma_ckpt_get_int(b, &h->steps_at_order) ||
+      goma_ckpt_get_int(b, &h->num_hist) || goma_ckpt_get_int(b, &num_unknowns) ||
+      goma_ckpt_get_int(b, &nAC)) {
+    return -1;
+  }
+  if (max_order != h->max_order || num_unknowns != h->num_unknowns || nAC != h->nAC ||
+      h->num_hist < 0 || h->num_hist > h->max_order + 1) {
+    GOMA_WH(-1, "Checkpoint BDF history does not match this problem (maximum order %d)",
+            max_order);
+    h->num_hist = 0;
+    return -1;
+  }
+  if (goma_ckpt_get_doubles(b, h->t, h->num_hist)) {
+    return -1;
+  }
+  for (j = 0; j < h->num_hist; j++) {
+    if (goma_ckpt_get_doubles(b, h->x[j], h->num_unknowns) ||
+        (h->nAC > 0 && goma_ckpt_get_doubles(b, h->x_AC[j], h->nAC))) {
+      return -1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,622 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Kernel benchmarks run on a fully set up problem, see rf_benchmark.h.
+ *
+ * Element kernels are timed one quadrature point at a time: everything a
+ * kernel depends on (load_elem_dofptr, the basis functions, ...) is
+ * evaluated first, outside of the timed region, in the same order as
+ * matrix_fill.  Each repetition is one sweep over all elements of this
+ * processor, so the results are reported per element and per quadrature
+ * point as well as per repetition.  In parallel the times are those of the
+ * slowest processor and the work counts those of the largest.
+ */
+
+#include "rf_benchmark.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bc/rotate.h"
+#include "bc_colloc.h"
+#include "bc_contact.h"
+#include "density.h"
+#include "dp_comm.h"
+#include "el_elm.h"
+#include "el_elm_info.h"
+#include "linalg/sparse_matrix.h"
+#include "load_field_variables.h"
+#include "mm_as.h"
+#include "mm_as_alloc.h"
+#include "mm_as_structs.h"
+#include "mm_eh.h"
+#include "mm_fill.h"
+#include "mm_fill_aux.h"
+#include "mm_fill_common.h"
+#include "mm_fill_momentum.h"
+#include "mm_fill_ptrs.h"
+#include "mm_fill_stress.h"
+#include "mm_fill_util.h"
+#include "mm_mp.h"
+#include "mm_mp_const.h"
+#include "mm_mp_structs.h"
+#include "mpi.h"
+#include "rd_mesh.h"
+#include "rf_allo.h"
+#include "rf_bc.h"
+#include "rf_bc_const.h"
+#include "rf_fem.h"
+#include "rf_fem_const.h"
+#include "rf_io.h"
+#include "rf_mp.h"
+#include "rf_solver.h"
+#include "rf_solver_const.h"
+#include "rf_util.h"
+#include "sl_util_structs.h"
+#include "std.h"
+#include "util/goma_benchmark.h"
+
+Benchmark_Options Goma_Benchmark_Options = {FALSE, 10, "goma_benchmarks.json", ""};
+
+/* quadrature point stages, in the order matrix_fill evaluates them */
+enum {
+  BENCH_QP_BASIS = 0,   /* load_basis_functions */
+  BENCH_QP_BEER_BELLY,  /* beer_belly */
+  BENCH_QP_LOAD_FV,     /* load_fv */
+  BENCH_QP_GRADIENTS,   /* load_bf_grad ... computeCommonMaterialProps_gp */
+  BENCH_QP_MOMENTUM     /* assemble_momentum */
+};
+
+/* number of calls timed together for the very short kernels */
+#define BENCH_EXCHANGE_CALLS 100
+#define BENCH_TABLE_POINTS   4096
+#define BENCH_EXP_S_MATRICES 1024
+
+typedef struct {
+  struct GomaLinearSolverData *ams;
+  double *x;
+  double *x_old;
+  double *x_older;
+  double *xdot;
+  double *xdot_old;
+  double *resid_vector;
+  double *x_update;
+  double time_value;
+  double h_elem_avg;
+  double U_norm;
+  Exo_DB *exo;
+  Dpi *dpi;
+  Comm_Ex *cx;
+  int stage; /* quadrature point stage timed by the element sweeps */
+  struct Data_Table *table;
+  double (*table_points)[3];
+  double (*s_matrices)[DIM][DIM];
+  /* work done by one sweep */
+  double elements;
+  double quadrature_points;
+  double calls;
+} Bench_Ctx;
+
+typedef int (*Bench_Sweep)(Bench_Ctx *, double *elapsed_ns);
+
+int benchmark_parse_args(int *argc, char **argv) {
+  Benchmark_Options *opt = &Goma_Benchmark_Options;
+  int n = 1;
+
+  for (int i = 1; i < *argc; i++) {
+    int has_value = (i + 1 < *argc);
+    if (strncmp(argv[i], "-bench", 6) != 0) {
+      argv[n++] = argv[i];
+      continue;
+    }
+    opt->enabled = TRUE;
+    if (strcmp(argv[i], "-bench_out") == 0 && has_value) {
+      snprintf(opt->output_file, MAX_FNL, "%s", argv[++i]);
+    } else if (strcmp(argv[i], "-bench_reps") == 0 && has_value) {
+      opt->repetitions = atoi(argv[++i]);
+      if (opt->repetitions < 1) {
+        return -1;
+      }
+    } else if (strcmp(argv[i], "-bench_filter") == 0 && has_value) {
+      snprintf(opt->filter, MAX_FNL, "%s", argv[++i]);
+    } else if (strcmp(argv[i], "-bench") != 0) {
+      return -1;
+    }
+  }
+  argv[n] = NULL;
+  *argc = n;
+  return 0;
+}
+
+/******************************************************************************/
+/* Element kernels                                                            */
+/******************************************************************************/
+
+static int bench_element_setup(Bench_Ctx *c, int ielem, PG_DATA *pg_data) {
+  int err = load_elem_dofptr(ielem, c->exo, c->x, c->x_old, c->xdot, c->xdot_old, 0);
+  if (err) {
+    return err;
+  }
+  err = bf_mp_init(pd);
+  if (err) {
+    return err;
+  }
+  int mn = ei[pg->imtrx]->mn;
+  for (int mode = 0; mode < vn->modes; mode++) {
+    ve[mode] = ve_glob[mn][mode];
+  }
+
+  memset(pg_data, 0, sizeof(PG_DATA));
+  pg_data->h_elem_avg = c->h_elem_avg;
+  pg_data->U_norm = c->U_norm;
+  return 0;
+}
+
+/* element averages used by the stabilized momentum terms, see matrix_fill */
+static void bench_element_centroid(Bench_Ctx *c, int ielem, PG_DATA *pg_data) {
+  double xi[DIM] = {0.0, 0.0, 0.0};
+  (void)load_basis_functions(xi, bfd);
+  setup_shop_at_point(ielem, xi, c->exo);
+  pg_data->mu_avg = element_viscosity();
+  pg_data->rho_avg = density(NULL, c->time_value);
+  h_elem_siz(pg_data->hsquared, pg_data->hhv, pg_data->dhv_dxnode, pd->e[pg->imtrx][R_MESH1]);
+  element_velocity(pg_data->v_avg, pg_data->dv_dnode, c->exo);
+}
+
+static int bench_qp_stage(Bench_Ctx *c, int stage, double xi[DIM], const PG_DATA *pg_data) {
+  int err = 0;
+  switch (stage) {
+  case BENCH_QP_BASIS:
+    err = load_basis_functions(xi, bfd);
+    break;
+  case BENCH_QP_BEER_BELLY:
+    err = beer_belly();
+    break;
+  case BENCH_QP_LOAD_FV:
+    err = load_fv();
+    break;
+  case BENCH_QP_GRADIENTS:
+    err = load_bf_grad();
+    if (!err) {
+      err = load_fv_vector();
+    }
+    if (!err && pd->gv[R_MESH1]) {
+      err = load_bf_mesh_derivs();
+    }
+    if (!err) {
+      err = load_fv_grads();
+    }
+    if (!err && pd->gv[R_MESH1]) {
+      err = load_fv_mesh_derivs(1);
+    }
+    computeCommonMaterialProps_gp(c->time_value);
+    break;
+  case BENCH_QP_MOMENTUM:
+    err = assemble_momentum(c->time_value, 0.0, 0.0, c->h_elem_avg, pg_data, xi, c->exo);
+    break;
+  }
+  return err;
+}
+
+static int bench_element_kernel(Bench_Ctx *c, double *elapsed_ns) {
+  Exo_DB *exo = c->exo;
+  PG_DATA pg_data;
+  double elapsed = 0.0;
+
+  c->elements = 0;
+  c->quadrature_points = 0;
+  c->calls = 0;
+  for (int ielem = exo->eb_ptr[0]; ielem < exo->eb_ptr[exo->num_elem_blocks]; ielem++) {
+    int ebn = find_elemblock_index(ielem, exo);
+    if (Matilda[ebn] < 0) {
+      continue;
+    }
+    if (bench_element_setup(c, ielem, &pg_data)) {
+      return -1;
+    }
+    if (c->stage == BENCH_QP_MOMENTUM) {
+      if (!pd->e[pg->imtrx][R_MOMENTUM1]) {
+        continue;
+      }
+      bench_element_centroid(c, ielem, &pg_data);
+    }
+
+    int ielem_type = ei[pg->imtrx]->ielem_type;
+    int ip_total = elem_info(NQUAD, ielem_type);
+    for (int ip = 0; ip < ip_total; ip++) {
+      double xi[DIM] = {0.0, 0.0, 0.0};
+      find_stu(ip, ielem_type, &xi[0], &xi[1], &xi[2]);
+      fv->wt = Gq_weight(ip, ielem_type);
+
+      for (int stage = BENCH_QP_BASIS; stage < c->stage; stage++) {
+        if (bench_qp_stage(c, stage, xi, &pg_data)) {
+          return -1;
+        }
+      }
+      double start = goma_benchmark_now_ns();
+      int err = bench_qp_stage(c, c->stage, xi, &pg_data);
+      elapsed += goma_benchmark_now_ns() - start;
+      if (err || neg_elem_volume || zero_detJ) {
+        return -1;
+      }
+    }
+    c->elements++;
+    c->quadrature_points += ip_total;
+    c->calls += ip_total;
+  }
+  *elapsed_ns = elapsed;
+  return 0;
+}
+
+/* local element contributions are inserted as they are, the cost of the
+ * insertion does not depend on the values */
+static int bench_load_lec(Bench_Ctx *c, double *elapsed_ns) {
+  Exo_DB *exo = c->exo;
+  PG_DATA pg_data;
+  double elapsed = 0.0;
+  GomaSparseMatrix matrix = (GomaSparseMatrix)c->ams->GomaMatrixData;
+
+  c->elements = 0;
+  c->quadrature_points = 0;
+  c->calls = 0;
+  for (int ielem = exo->eb_ptr[0]; ielem < exo->eb_ptr[exo->num_elem_blocks]; ielem++) {
+    int ebn = find_elemblock_index(ielem, exo);
+    if (Matilda[ebn] < 0) {
+      continue;
+    }
+    if (bench_element_setup(c, ielem, &pg_data)) {
+      return -1;
+    }
+    double start = goma_benchmark_now_ns();
+    if (c->stage) {
+      GomaSparseMatrix_LoadLec(matrix, ielem, lec, c->resid_vector);
+    } else {
+      load_lec(exo, ielem, c->ams, c->x, c->resid_vector, NULL);
+    }
+    elapsed += goma_benchmark_now_ns() - start;
+    c->elements++;
+    c->calls++;
+  }
+  *elapsed_ns = elapsed;
+  return 0;
+}
+
+static void bench_zero_system(Bench_Ctx *c) {
+  struct GomaLinearSolverData *ams = c->ams;
+  init_vec_value(c->resid_vector, 0.0, NumUnknowns[pg->imtrx] + NumExtUnknowns[pg->imtrx]);
+  if (ams->GomaMatrixData != NULL) {
+    GomaSparseMatrix matrix = (GomaSparseMatrix)ams->GomaMatrixData;
+    matrix->put_scalar(matrix, 0.0);
+  } else if (ams->val != NULL) {
+    init_vec_value(ams->val, 0.0, ams->nnz);
+  }
+}
+
+static int bench_matrix_fill_full(Bench_Ctx *c, double *elapsed_ns) {
+  double delta_t = 0.0;
+  double theta = 0.0;
+  int num_total_nodes = c->dpi->num_universe_nodes;
+
+  bench_zero_system(c);
+  if (Num_ROT > 0) {
+    calculate_all_rotation_vectors(c->exo, c->x);
+  } else if (Use_2D_Rotation_Vectors == TRUE) {
+    calculate_2D_rotation_vectors(c->exo, c->x);
+  }
+  exchange_dof(c->cx, c->dpi, c->x, pg->imtrx);
+
+  double start = goma_benchmark_now_ns();
+  int err = matrix_fill_full(c->ams, c->x, c->resid_vector, c->x_old, c->x_older, c->xdot,
+                             c->xdot_old, c->x_update, &delta_t, &theta,
+                             First_Elem_Side_BC_Array[pg->imtrx], &c->time_value, c->exo, c->dpi,
+                             &num_total_nodes, &c->h_elem_avg, &c->U_norm, NULL);
+  *elapsed_ns = goma_benchmark_now_ns() - start;
+
+  c->elements = c->exo->num_elems;
+  c->quadrature_points = 0;
+  c->calls = 1;
+  return err;
+}
+
+static int bench_exchange_dof(Bench_Ctx *c, double *elapsed_ns) {
+  double start = goma_benchmark_now_ns();
+  for (int i = 0; i < BENCH_EXCHANGE_CALLS; i++) {
+    exchange_dof(c->cx, c->dpi, c->x, pg->imtrx);
+  }
+  *elapsed_ns = goma_benchmark_now_ns() - start;
+  c->elements = 0;
+  c->quadrature_points = 0;
+  c->calls = BENCH_EXCHANGE_CALLS;
+  return 0;
+}
+
+/******************************************************************************/
+/* Kernels on synthetic inputs                                                */
+/******************************************************************************/
+
+/* fixed pseudo random sequence in [0, 1) so every run sees the same inputs */
+static double bench_random(uint64_t *state) {
+  *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (double)(*state >> 11) / (double)(1ULL << 53);
+}
+
+static struct Data_Table *bench_table_alloc(int interp_method) {
+  struct Data_Table *table = calloc(1, sizeof(struct Data_Table));
+  int n = 64;
+  if (interp_method == LINEAR) {
+    table->columns = 2;
+    table->tablelength = 16 * n;
+  } else {
+    table->columns = 3;
+    table->tablelength = n * n;
+  }
+  table->interp_method = interp_method;
+  table->t = calloc(table->tablelength, sizeof(double));
+  table->t2 = calloc(table->tablelength, sizeof(double));
+  table->f = calloc(table->tablelength, sizeof(double));
+  for (int i = 0; i < table->tablelength; i++) {
+    if (interp_method == LINEAR) {
+      table->t[i] = (double)i / (table->tablelength - 1);
+      table->f[i] = sin(4.0 * table->t[i]);
+    } else {
+      /* n sets of n points, the first abscissa constant within a set */
+      table->t[i] = (double)(i / n) / (n - 1);
+      table->t2[i] = (double)(i % n) / (n - 1);
+      table->f[i] = sin(4.0 * table->t[i]) * cos(3.0 * table->t2[i]);
+    }
+  }
+  return table;
+}
+
+static void bench_table_free(struct Data_Table *table) {
+  free(table->t);
+  free(table->t2);
+  free(table->f);
+  free(table);
+}
+
+static int bench_interpolate_table(Bench_Ctx *c, double *elapsed_ns) {
+  double sum = 0.0;
+  double start = goma_benchmark_now_ns();
+  for (int i = 0; i < BENCH_TABLE_POINTS; i++) {
+    double slope;
+    double dfunc_dx[3];
+    sum += interpolate_table(c->table, c->table_points[i], &slope, dfunc_dx);
+  }
+  *elapsed_ns = goma_benchmark_now_ns() - start;
+  c->elements = 0;
+  c->quadrature_points = 0;
+  c->calls = BENCH_TABLE_POINTS;
+  return isfinite(sum) ? 0 : -1;
+}
+
+static int bench_compute_exp_s(Bench_Ctx *c, double *elapsed_ns) {
+  double sum = 0.0;
+  double start = goma_benchmark_now_ns();
+  for (int i = 0; i < BENCH_EXP_S_MATRICES; i++) {
+    double exp_s[DIM][DIM];
+    double eig_values[DIM];
+    double R[DIM][DIM];
+    compute_exp_s(c->s_matrices[i], exp_s, eig_values, R);
+    sum += exp_s[0][0];
+  }
+  *elapsed_ns = goma_benchmark_now_ns() - start;
+  c->elements = 0;
+  c->quadrature_points = 0;
+  c->calls = BENCH_EXP_S_MATRICES;
+  return isfinite(sum) ? 0 : -1;
+}
+
+/******************************************************************************/
+/* Driver                                                                     */
+/******************************************************************************/
+
+static int benchmark_selected(const char *name) {
+  return Goma_Benchmark_Options.filter[0] == '\0' ||
+         strstr(name, Goma_Benchmark_Options.filter) != NULL;
+}
+
+static void run_benchmark(goma_benchmark_suite *suite,
+                          Bench_Ctx *c,
+                          const char *name,
+                          Bench_Sweep sweep) {
+  if (!benchmark_selected(name)) {
+    return;
+  }
+  int reps = Goma_Benchmark_Options.repetitions;
+  double *samples = calloc(reps + 3, sizeof(double));
+  double warm_up;
+
+  /* one untimed sweep to warm caches and lazily built state */
+  int err = sweep(c, &warm_up);
+  for (int i = 0; i < reps && !err; i++) {
+    err = sweep(c, &samples[i]);
+  }
+
+  samples[reps] = c->elements;
+  samples[reps + 1] = c->quadrature_points;
+  samples[reps + 2] = c->calls;
+#ifdef PARALLEL
+  MPI_Allreduce(MPI_IN_PLACE, &err, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, samples, reps + 3, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+
+  if (err) {
+    GOMA_WH_MANY(GOMA_ERROR, "benchmark %s failed on this problem", name);
+    goma_benchmark_suite_skip(suite, name, "kernel returned an error");
+  } else {
+    goma_benchmark_result result;
+    memset(&result, 0, sizeof(result));
+    snprintf(result.name, GOMA_BENCHMARK_NAME_LEN, "%s", name);
+    result.elements = samples[reps];
+    result.quadrature_points = samples[reps + 1];
+    result.calls = samples[reps + 2];
+    goma_benchmark_stats(samples, reps, &result);
+    goma_benchmark_suite_add(suite, &result);
+  }
+  free(samples);
+}
+
+static void run_element_benchmark(goma_benchmark_suite *suite,
+                                  Bench_Ctx *c,
+                                  const char *name,
+                                  int stage) {
+  c->stage = stage;
+  run_benchmark(suite, c, name, bench_element_kernel);
+}
+
+int run_kernel_benchmarks(struct GomaLinearSolverData *ams,
+                          double x[],
+                          double x_old[],
+                          double x_older[],
+                          double xdot[],
+                          double xdot_old[],
+                          double resid_vector[],
+                          double x_update[],
+                          double time_value,
+                          Exo_DB *exo,
+                          Dpi *dpi,
+                          Comm_Ex *cx) {
+  goma_benchmark_suite suite;
+  Bench_Ctx c;
+  char buf[MAX_FNL];
+
+  memset(&c, 0, sizeof(c));
+  c.ams = ams;
+  c.x = x;
+  c.x_old = x_old;
+  c.x_older = x_older;
+  c.xdot = xdot;
+  c.xdot_old = xdot_old;
+  c.resid_vector = resid_vector;
+  c.x_update = x_update;
+  c.time_value = time_value;
+  c.exo = exo;
+  c.dpi = dpi;
+  c.cx = cx;
+
+  goma_benchmark_suite_init(&suite);
+  goma_benchmark_suite_set_context(&suite, "goma_version", GOMA_VERSION);
+  goma_benchmark_suite_set_context(&suite, "input_file", Input_File);
+  goma_benchmark_suite_set_context(&suite, "mesh_file", ExoFile);
+  goma_benchmark_suite_set_context(&suite, "matrix_format", Matrix_Format);
+  snprintf(buf, MAX_FNL, "%d", Num_Proc);
+  goma_benchmark_suite_set_context(&suite, "num_procs", buf);
+  snprintf(buf, MAX_FNL, "%d", Goma_Benchmark_Options.repetitions);
+  goma_benchmark_suite_set_context(&suite, "repetitions", buf);
+
+  DPRINTF(stdout, "\nRunning kernel benchmarks, %d repetitions each...\n",
+          Goma_Benchmark_Options.repetitions);
+
+  /* same assembly flags and stabilization averages as the first Newton step */
+  af->Assemble_Residual = TRUE;
+  af->Assemble_Jacobian = TRUE;
+  af->Assemble_LSA_Jacobian_Matrix = FALSE;
+  af->Assemble_LSA_Mass_Matrix = FALSE;
+  if (upd->matrix_index[VELOCITY1] == pg->imtrx &&
+      ((PSPG && Num_Var_In_Type[pg->imtrx][PRESSURE]) ||
+       (Cont_GLS && Num_Var_In_Type[pg->imtrx][VELOCITY1]))) {
+    c.h_elem_avg = global_h_elem_siz(x, x_old, xdot, resid_vector, exo, dpi);
+    c.U_norm = global_velocity_norm(x, exo, dpi);
+  }
+  exchange_dof(cx, dpi, x, pg->imtrx);
+
+  run_element_benchmark(&suite, &c, "load_basis_functions", BENCH_QP_BASIS);
+  run_element_benchmark(&suite, &c, "beer_belly", BENCH_QP_BEER_BELLY);
+  run_element_benchmark(&suite, &c, "load_fv", BENCH_QP_LOAD_FV);
+  if (upd->ep[pg->imtrx][R_MOMENTUM1] >= 0) {
+    run_element_benchmark(&suite, &c, "assemble_momentum", BENCH_QP_MOMENTUM);
+  } else if (benchmark_selected("assemble_momentum")) {
+    goma_benchmark_suite_skip(&suite, "assemble_momentum", "no momentum equation");
+  }
+
+  if (Linear_Solver == FRONT) {
+    goma_benchmark_suite_skip(&suite, "load_lec", "frontal solver assembles its own matrix");
+  } else {
+    c.stage = 0;
+    run_benchmark(&suite, &c, "load_lec", bench_load_lec);
+  }
+  if (ams->GomaMatrixData != NULL) {
+    c.stage = 1;
+    run_benchmark(&suite, &c, "GomaSparseMatrix_LoadLec", bench_load_lec);
+  } else if (benchmark_selected("GomaSparseMatrix_LoadLec")) {
+    goma_benchmark_suite_skip(&suite, "GomaSparseMatrix_LoadLec",
+                              "matrix format does not use GomaSparseMatrix");
+  }
+
+  run_benchmark(&suite, &c, "exchange_dof", bench_exchange_dof);
+
+  int multi_contact_line = FALSE;
+  for (int mn = 0; mn < upd->Num_Mat; mn++) {
+    multi_contact_line |= (elc_glob[mn]->lame_mu_model == MULTI_CONTACT_LINE);
+  }
+  if (Linear_Solver == FRONT || multi_contact_line) {
+    goma_benchmark_suite_skip(&suite, "matrix_fill_full", "needs the solver's prefill");
+  } else {
+    run_benchmark(&suite, &c, "matrix_fill_full", bench_matrix_fill_full);
+  }
+
+  /* synthetic inputs, independent of the problem */
+  uint64_t seed = 20240611ULL;
+  c.table_points = calloc(BENCH_TABLE_POINTS, sizeof(double[3]));
+  for (int i = 0; i < BENCH_TABLE_POINTS; i++) {
+    c.table_points[i][0] = 0.01 + 0.98 * bench_random(&seed);
+    c.table_points[i][1] = 0.01 + 0.98 * bench_random(&seed);
+    c.table_points[i][2] = 0.0;
+  }
+  c.table = bench_table_alloc(LINEAR);
+  run_benchmark(&suite, &c, "interpolate_table_linear", bench_interpolate_table);
+  bench_table_free(c.table);
+  c.table = bench_table_alloc(BILINEAR);
+  run_benchmark(&suite, &c, "interpolate_table_bilinear", bench_interpolate_table);
+  bench_table_free(c.table);
+  free(c.table_points);
+
+  /* symmetric positive definite, as the log-conformation tensor's exp(s) */
+  c.s_matrices = calloc(BENCH_EXP_S_MATRICES, sizeof(double[DIM][DIM]));
+  for (int i = 0; i < BENCH_EXP_S_MATRICES; i++) {
+    for (int a = 0; a < DIM; a++) {
+      for (int b = 0; b <= a; b++) {
+        double v = bench_random(&seed) - 0.5;
+        c.s_matrices[i][a][b] = c.s_matrices[i][b][a] = (a == b) ? 2.0 + v : v;
+      }
+    }
+  }
+  run_benchmark(&suite, &c, "compute_exp_s", bench_compute_exp_s);
+  free(c.s_matrices);
+
+  int err = 0;
+  if (ProcID == 0) {
+    goma_benchmark_suite_print(&suite, stdout);
+    FILE *file = fopen(Goma_Benchmark_Options.output_file, "w");
+    if (file == NULL) {
+      err = -1;
+    } else {
+      err = goma_benchmark_suite_write_json(&suite, file);
+      fclose(file);
+    }
+    if (err) {
+      GOMA_WH(GOMA_ERROR, "could not write benchmark results to %s",
+              Goma_Benchmark_Options.output_file);
+    } else {
+      DPRINTF(stdout, "Benchmark results written to %s\n", Goma_Benchmark_Options.output_file);
+    }
+  }
+  goma_benchmark_suite_free(&suite);
+  return err;
+}
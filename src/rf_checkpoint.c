@@ -0,0 +1,442 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Binary checkpoint/restart of the full transient state.
+ *
+ * Unlike the ASCII solution file or an exodus time plane, a checkpoint
+ * holds everything the time integrator carries between steps: the
+ * solution and time derivative history, the time step history, the
+ * augmenting condition history, the BDF history, element storage and
+ * particles.  A run
+ * restarted from it takes the same steps as the uninterrupted run.
+ *
+ * By default each processor writes its own file ("name.N.P", as for the
+ * exodus files).  With aggregation all processors write one file through
+ * MPI-IO: a table of per-processor payload sizes and checksums followed
+ * by the payloads.  Either way the file is written under a temporary
+ * name and renamed into place once complete.  Restarting requires the
+ * same decomposition.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ac_particles.h"
+#include "exo_struct.h"
+#include "mm_as.h"
+#include "mm_as_structs.h"
+#include "mm_eh.h"
+#include "mm_elem_block_structs.h"
+#include "mm_mp.h"
+#include "mpi.h"
+#include "rd_mesh.h"
+#include "rf_checkpoint.h"
+#include "rf_element_storage_const.h"
+#include "rf_io.h"
+#include "rf_mp.h"
+#include "std.h"
+#include "util/checkpoint_io.h"
+
+static const char ckpt_aggregate_magic[8] = {'G', 'O', 'M', 'A', 'C', 'K', 'P', 'A'};
+static const int ckpt_byte_order = 0x01020304;
+
+/* Number of level set renormalization countdowns carried in the state */
+static int num_renorm_countdowns(void) {
+  int count = (ls != NULL) ? 1 : 0;
+  if (pfd != NULL) {
+    count += pfd->num_phase_funcs;
+  }
+  return count;
+}
+
+static int *renorm_countdown(int i) {
+  if (ls != NULL) {
+    if (i == 0)
+      return &ls->Renorm_Countdown;
+    i--;
+  }
+  return &pfd->ls[i]->Renorm_Countdown;
+}
+
+static int checkpoint_pack(goma_ckpt_buffer *b, const struct Checkpoint_State *st) {
+  int err = 0;
+  int i;
+
+  err |= goma_ckpt_put_int(b, Num_Proc);
+  err |= goma_ckpt_put_int(b, ProcID);
+  err |= goma_ckpt_put_int(b, st->num_unknowns);
+  err |= goma_ckpt_put_int(b, st->nAC);
+
+  err |= goma_ckpt_put_double(b, st->time);
+  err |= goma_ckpt_put_double(b, st->delta_t);
+  err |= goma_ckpt_put_double(b, st->delta_t_old);
+  err |= goma_ckpt_put_double(b, st->delta_t_older);
+  err |= goma_ckpt_put_double(b, st->delta_t_oldest);
+  err |= goma_ckpt_put_double(b, st->time_print);
+  err |= goma_ckpt_put_int(b, st->n);
+  err |= goma_ckpt_put_int(b, st->nt);
+  err |= goma_ckpt_put_int(b, st->step_print);
+  err |= goma_ckpt_put_int(b, st->last_renorm_nt);
+  err |= goma_ckpt_put_int(b, st->failed_recently_countdown);
+
+  err |= goma_ckpt_put_doubles(b, st->x, st->num_unknowns);
+  err |= goma_ckpt_put_doubles(b, st->x_old, st->num_unknowns);
+  err |= goma_ckpt_put_doubles(b, st->x_older, st->num_unknowns);
+  err |= goma_ckpt_put_doubles(b, st->x_oldest, st->num_unknowns);
+  err |= goma_ckpt_put_doubles(b, st->xdot, st->num_unknowns);
+  err |= goma_ckpt_put_doubles(b, st->xdot_old, st->num_unknowns);
+  err |= goma_ckpt_put_doubles(b, st->xdot_older, st->num_unknowns);
+
+  if (st->nAC > 0) {
+    err |= goma_ckpt_put_doubles(b, st->x_AC, st->nAC);
+    err |= goma_ckpt_put_doubles(b, st->x_AC_old, st->nAC);
+    err |= goma_ckpt_put_doubles(b, st->x_AC_older, st->nAC);
+    err |= goma_ckpt_put_doubles(b, st->x_AC_oldest, st->nAC);
+    err |= goma_ckpt_put_doubles(b, st->x_AC_dot, st->nAC);
+    err |= goma_ckpt_put_doubles(b, st->x_AC_dot_old, st->nAC);
+    err |= goma_ckpt_put_doubles(b, st->x_AC_dot_older, st->nAC);
+  }
+
+  err |= goma_ckpt_put_int(b, tran->solid_inertia);
+  if (tran->solid_inertia) {
+    err |= goma_ckpt_put_doubles(b, tran->xdbl_dot, st->num_unknowns);
+    err |= goma_ckpt_put_doubles(b, tran->xdbl_dot_old, st->num_unknowns);
+  }
+
+  err |= goma_ckpt_put_int(b, st->bdf != NULL);
+  if (st->bdf != NULL) {
+    err |= write_bdf_checkpoint(b, st->bdf);
+  }
+
+  err |= goma_ckpt_put_int(b, num_renorm_countdowns());
+  for (i = 0; i < num_renorm_countdowns(); i++) {
+    err |= goma_ckpt_put_int(b, *renorm_countdown(i));
+  }
+
+  err |= goma_ckpt_put_int(b, EXO_ptr->num_elem_blocks);
+  for (i = 0; i < EXO_ptr->num_elem_blocks; i++) {
+    double *base;
+    int span = element_storage_span(Element_Blocks + i, &base);
+    err |= goma_ckpt_put_doubles(b, base, span);
+  }
+
+  err |= goma_ckpt_put_int(b, Particle_Dynamics);
+  if (Particle_Dynamics) {
+    err |= write_particle_checkpoint(b);
+  }
+
+  return err ? -1 : 0;
+}
+
+static int checkpoint_unpack(goma_ckpt_buffer *b, struct Checkpoint_State *st) {
+  int num_proc, proc_id, num_unknowns, nAC, flag, count;
+  int i;
+
+  if (goma_ckpt_get_int(b, &num_proc) || goma_ckpt_get_int(b, &proc_id) ||
+      goma_ckpt_get_int(b, &num_unknowns) || goma_ckpt_get_int(b, &nAC)) {
+    return -1;
+  }
+  if (num_proc != Num_Proc || proc_id != ProcID) {
+    GOMA_WH(-1, "Checkpoint was written by processor %d of %d, this is processor %d of %d",
+            proc_id, num_proc, ProcID, Num_Proc);
+    return -1;
+  }
+  if (num_unknowns != st->num_unknowns || nAC != st->nAC) {
+    GOMA_WH(-1, "Checkpoint has %d unknowns and %d augmenting conditions, expected %d and %d",
+            num_unknowns, nAC, st->num_unknowns, st->nAC);
+    return -1;
+  }
+
+  if (goma_ckpt_get_double(b, &st->time) || goma_ckpt_get_double(b, &st->delta_t) ||
+      goma_ckpt_get_double(b, &st->delta_t_old) || goma_ckpt_get_double(b, &st->delta_t_older) ||
+      goma_ckpt_get_double(b, &st->delta_t_oldest) || goma_ckpt_get_double(b, &st->time_print) ||
+      goma_ckpt_get_int(b, &st->n) || goma_ckpt_get_int(b, &st->nt) ||
+      goma_ckpt_get_int(b, &st->step_print) || goma_ckpt_get_int(b, &st->last_renorm_nt) ||
+      goma_ckpt_get_int(b, &st->failed_recently_countdown)) {
+    return -1;
+  }
+
+  if (goma_ckpt_get_doubles(b, st->x, st->num_unknowns) ||
+      goma_ckpt_get_doubles(b, st->x_old, st->num_unknowns) ||
+      goma_ckpt_get_doubles(b, st->x_older, st->num_unknowns) ||
+      goma_ckpt_get_doubles(b, st->x_oldest, st->num_unknowns) ||
+      goma_ckpt_get_doubles(b, st->xdot, st->num_unknowns) ||
+      goma_ckpt_get_doubles(b, st->xdot_old, st->num_unknowns) ||
+      goma_ckpt_get_doubles(b, st->xdot_older, st->num_unknowns)) {
+    return -1;
+  }
+
+  if (st->nAC > 0) {
+    if (goma_ckpt_get_doubles(b, st->x_AC, st->nAC) ||
+        goma_ckpt_get_doubles(b, st->x_AC_old, st->nAC) ||
+        goma_ckpt_get_doubles(b, st->x_AC_older, st->nAC) ||
+        goma_ckpt_get_doubles(b, st->x_AC_oldest, st->nAC) ||
+        goma_ckpt_get_doubles(b, st->x_AC_dot, st->nAC) ||
+        goma_ckpt_get_doubles(b, st->x_AC_dot_old, st->nAC) ||
+        goma_ckpt_get_doubles(b, st->x_AC_dot_older, st->nAC)) {
+      return -1;
+    }
+  }
+
+  if (goma_ckpt_get_int(b, &flag) || flag != tran->solid_inertia) {
+    return -1;
+  }
+  if (tran->solid_inertia) {
+    if (goma_ckpt_get_doubles(b, tran->xdbl_dot, st->num_unknowns) ||
+        goma_ckpt_get_doubles(b, tran->xdbl_dot_old, st->num_unknowns)) {
+      return -1;
+    }
+  }
+
+  if (goma_ckpt_get_int(b, &flag) || flag != (st->bdf != NULL)) {
+    GOMA_WH(-1, "Checkpoint and input disagree on BDF time integration");
+    return -1;
+  }
+  if (st->bdf != NULL && read_bdf_checkpoint(b, st->bdf)) {
+    return -1;
+  }
+
+  if (goma_ckpt_get_int(b, &count) || count != num_renorm_countdowns()) {
+    return -1;
+  }
+  for (i = 0; i < count; i++) {
+    if (goma_ckpt_get_int(b, renorm_countdown(i))) {
+      return -1;
+    }
+  }
+
+  if (goma_ckpt_get_int(b, &count) || count != EXO_ptr->num_elem_blocks) {
+    return -1;
+  }
+  for (i = 0; i < count; i++) {
+    double *base;
+    int span = element_storage_span(Element_Blocks + i, &base);
+    if (goma_ckpt_get_doubles(b, base, span)) {
+      return -1;
+    }
+  }
+
+  if (goma_ckpt_get_int(b, &flag) || flag != Particle_Dynamics) {
+    return -1;
+  }
+  if (Particle_Dynamics && read_particle_checkpoint(b)) {
+    return -1;
+  }
+
+  return 0;
+}
+
+/* MPI-IO counts are ints, so large payloads go in pieces */
+#define CKPT_IO_PIECE (1 << 30)
+
+static int write_at(MPI_File fh, MPI_Offset offset, const char *data, size_t n) {
+  MPI_Status status;
+  while (n > 0) {
+    int piece = (n > CKPT_IO_PIECE) ? CKPT_IO_PIECE : (int)n;
+    if (MPI_File_write_at(fh, offset, (void *)data, piece, MPI_BYTE, &status) != MPI_SUCCESS) {
+      return -1;
+    }
+    offset += piece;
+    data += piece;
+    n -= piece;
+  }
+  return 0;
+}
+
+static int read_at(MPI_File fh, MPI_Offset offset, char *data, size_t n) {
+  MPI_Status status;
+  while (n > 0) {
+    int piece = (n > CKPT_IO_PIECE) ? CKPT_IO_PIECE : (int)n;
+    int got;
+    if (MPI_File_read_at(fh, offset, data, piece, MPI_BYTE, &status) != MPI_SUCCESS) {
+      return -1;
+    }
+    MPI_Get_count(&status, MPI_BYTE, &got);
+    if (got != piece) {
+      return -1;
+    }
+    offset += piece;
+    data += piece;
+    n -= piece;
+  }
+  return 0;
+}
+
+/* Header of an aggregated file: magic, version, byte order, Num_Proc */
+#define CKPT_AGGREGATE_HEADER (sizeof(ckpt_aggregate_magic) + 3 * sizeof(int))
+
+static int write_aggregated(const char *filename, const goma_ckpt_buffer *b) {
+  uint64_t mine[2] = {(uint64_t)b->size, goma_ckpt_checksum(b->data, b->size)};
+  uint64_t *table = malloc(2 * sizeof(uint64_t) * Num_Proc);
+  char tmpname[MAX_FNL + 4];
+  MPI_File fh;
+  MPI_Offset offset;
+  int err = 0, global_err = 0;
+  int p;
+
+  if (table == NULL) {
+    GOMA_EH(GOMA_ERROR, "Could not allocate checkpoint size table");
+  }
+  MPI_Allgather(mine, 2, MPI_UINT64_T, table, 2, MPI_UINT64_T, MPI_COMM_WORLD);
+
+  offset = CKPT_AGGREGATE_HEADER + 2 * sizeof(uint64_t) * Num_Proc;
+  for (p = 0; p < ProcID; p++) {
+    offset += table[2 * p];
+  }
+
+  snprintf(tmpname, sizeof(tmpname), "%s.tmp", filename);
+  if (MPI_File_open(MPI_COMM_WORLD, tmpname, MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL,
+                    &fh) != MPI_SUCCESS) {
+    free(table);
+    return -1;
+  }
+  MPI_File_set_size(fh, 0);
+
+  if (ProcID == 0) {
+    int header[3] = {GOMA_CKPT_VERSION, ckpt_byte_order, Num_Proc};
+    err |= write_at(fh, 0, ckpt_aggregate_magic, sizeof(ckpt_aggregate_magic));
+    err |= write_at(fh, sizeof(ckpt_aggregate_magic), (const char *)header, sizeof(header));
+    err |= write_at(fh, CKPT_AGGREGATE_HEADER, (const char *)table,
+                    2 * sizeof(uint64_t) * Num_Proc);
+  }
+  err |= write_at(fh, offset, b->data, b->size);
+  if (MPI_File_sync(fh) != MPI_SUCCESS) {
+    err = -1;
+  }
+  MPI_File_close(&fh);
+  free(table);
+
+  MPI_Allreduce(&err, &global_err, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if (ProcID == 0) {
+    if (global_err == 0 && rename(tmpname, filename) != 0) {
+      global_err = -1;
+    }
+    if (global_err != 0) {
+      remove(tmpname);
+    }
+  }
+  MPI_Bcast(&global_err, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return global_err;
+}
+
+static int read_aggregated(const char *filename, goma_ckpt_buffer *b) {
+  char magic[sizeof(ckpt_aggregate_magic)];
+  int header[3];
+  uint64_t *table;
+  MPI_File fh;
+  MPI_Offset offset;
+  int p;
+
+  if (MPI_File_open(MPI_COMM_WORLD, (char *)filename, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) !=
+      MPI_SUCCESS) {
+    return -1;
+  }
+  if (read_at(fh, 0, magic, sizeof(magic)) ||
+      memcmp(magic, ckpt_aggregate_magic, sizeof(magic)) != 0 ||
+      read_at(fh, sizeof(magic), (char *)header, sizeof(header)) ||
+      header[0] != GOMA_CKPT_VERSION || header[1] != ckpt_byte_order || header[2] != Num_Proc) {
+    MPI_File_close(&fh);
+    return -1;
+  }
+
+  table = malloc(2 * sizeof(uint64_t) * Num_Proc);
+  if (table == NULL ||
+      read_at(fh, CKPT_AGGREGATE_HEADER, (char *)table, 2 * sizeof(uint64_t) * Num_Proc)) {
+    free(table);
+    MPI_File_close(&fh);
+    return -1;
+  }
+  offset = CKPT_AGGREGATE_HEADER + 2 * sizeof(uint64_t) * Num_Proc;
+  for (p = 0; p < ProcID; p++) {
+    offset += table[2 * p];
+  }
+
+  goma_ckpt_buffer_free(b);
+  b->data = malloc(table[2 * ProcID] > 0 ? table[2 * ProcID] : 1);
+  if (b->data == NULL || read_at(fh, offset, b->data, table[2 * ProcID])) {
+    free(table);
+    MPI_File_close(&fh);
+    return -1;
+  }
+  b->size = b->capacity = table[2 * ProcID];
+  b->pos = 0;
+  MPI_File_close(&fh);
+
+  if (goma_ckpt_checksum(b->data, b->size) != table[2 * ProcID + 1]) {
+    free(table);
+    return -1;
+  }
+  free(table);
+  return 0;
+}
+
+/*
+ * Write a checkpoint of the transient state.  Collective; returns 0 on
+ * every processor if the checkpoint was written everywhere.
+ */
+int write_checkpoint(const char *filename,
+                     const struct Checkpoint_State *state,
+                     const int aggregate) {
+  goma_ckpt_buffer b;
+  int err, global_err;
+
+  goma_ckpt_buffer_init(&b);
+  err = checkpoint_pack(&b, state);
+  MPI_Allreduce(&err, &global_err, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+  if (global_err == 0) {
+    if (aggregate) {
+      global_err = write_aggregated(filename, &b);
+    } else {
+      char name[MAX_FNL];
+      strncpy(name, filename, MAX_FNL - 1);
+      name[MAX_FNL - 1] = '\0';
+      multiname(name, ProcID, Num_Proc);
+      err = goma_ckpt_write_file(name, &b);
+      MPI_Allreduce(&err, &global_err, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    }
+  }
+  goma_ckpt_buffer_free(&b);
+  return global_err;
+}
+
+/*
+ * Restore the transient state from a checkpoint.  The state's vectors
+ * and sizes must already be set up; everything else is overwritten.
+ */
+int read_checkpoint(const char *filename, struct Checkpoint_State *state, const int aggregate) {
+  goma_ckpt_buffer b;
+  int err, global_err;
+
+  goma_ckpt_buffer_init(&b);
+  if (aggregate) {
+    err = read_aggregated(filename, &b);
+  } else {
+    char name[MAX_FNL];
+    strncpy(name, filename, MAX_FNL - 1);
+    name[MAX_FNL - 1] = '\0';
+    multiname(name, ProcID, Num_Proc);
+    err = goma_ckpt_read_file(name, &b);
+  }
+  if (!err) {
+    err = checkpoint_unpack(&b, state);
+  }
+  goma_ckpt_buffer_free(&b);
+
+  MPI_Allreduce(&err, &global_err, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  return global_err;
+}
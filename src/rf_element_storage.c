@@ -465,6 +465,42 @@ void free_elemStorage(ELEM_BLK_STRUCT *eb_ptr)
 /************************************************************************/
 /************************************************************************/
 
+int element_storage_span(ELEM_BLK_STRUCT *eb_ptr, double **base)
+
+/*****************************************************************
+ *
+ * element_storage_span()
+ *
+ *  Returns the number of doubles in the single chunk holding the
+ *  element storage of a block, and its start in *base.  Returns 0
+ *  (and a NULL base) if the block has no storage.  Used to write
+ *  and read checkpoints.
+ *****************************************************************/
+{
+  ELEMENT_STORAGE_STRUCT *s_ptr = eb_ptr->ElemStorage;
+  int numStorage;
+
+  *base = NULL;
+  if (!s_ptr || eb_ptr->Num_Elems_In_Block <= 0) {
+    return 0;
+  }
+  numStorage = eb_ptr->IP_total;
+  if (eb_ptr->MatlProp_ptr->Porous_Mass_Lump) {
+    numStorage += eb_ptr->Num_Nodes_Per_Elem;
+  }
+  if (s_ptr->Sat_QP_tn) {
+    *base = s_ptr->Sat_QP_tn;
+    return 4 * numStorage * eb_ptr->Num_Elems_In_Block;
+  } else if (s_ptr->solidified) {
+    *base = s_ptr->solidified;
+    return numStorage * eb_ptr->Num_Elems_In_Block;
+  }
+  return 0;
+}
+/************************************************************************/
+/************************************************************************/
+/************************************************************************/
+
 double get_nodalSat_tnm1_FromES(int lnn)
 
 /*****************************************************************
@@ -57,6 +57,7 @@
 #include "mm_mp_structs.h"
 #include "mm_post_def.h"
 #include "mm_post_proc.h"
+#include "mm_qp_props.h"
 #include "mm_sol_nonlinear.h"
 #include "mm_unknown_map.h"
 #include "mm_viscosity.h"
@@ -65,8 +66,11 @@
 #include "rd_exo.h"
 #include "rd_mesh.h"
 #include "rf_allo.h"
+#include "rf_benchmark.h"
 #include "rf_bc.h"
 #include "rf_bc_const.h"
+#include "rf_bdf.h"
+#include "rf_checkpoint.h"
 #include "rf_fem.h"
 #include "rf_fem_const.h"
 #include "rf_io.h"
@@ -86,6 +90,8 @@
 #include "sl_util_structs.h"
 #include "std.h"
 #include "usr_print.h"
+#include "util/goma_memory.h"
+#include "util/goma_perf_log.h"
 #include "wr_dpi.h"
 #include "wr_exo.h"
 #include "wr_soln.h"
@@ -122,6 +128,12 @@ int discard_previous_time_step(
 
 static void shift_nodal_values(int, double, double *, int);
 
+static void set_checkpoint_vectors(struct Checkpoint_State *,
+                                   int,
+                                   double *[7], /* x, x_old, ..., xdot_older */
+                                   int,
+                                   double *[7]); /* x_AC, x_AC_old, ..., x_AC_dot_older */
+
 extern FSUB_TYPE dsyev_(char *JOBZ,
                         char *UPLO,
                         int *N,
@@ -340,8 +352,11 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
   int num_pvector = 0;      /* number of solution sensitivity vectors   */
 #ifdef GOMA_ENABLE_OMEGA_H
   int adapt_step = 0;
+  int mesh_adapted; /* Omega_h changed the mesh this step */
+  int adapt_on_error; /* adapt only if the error estimate exceeds its threshold */
 #endif
   int last_adapt_nt = 0;
+  struct BDF_History bdf = {0}; /* solution history for "Time Integration Method = BDF" */
 
   /* sparse variables for fill equation subcycling */
 
@@ -369,6 +384,9 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
   int converged = TRUE;  /* success or failure of Newton iteration   */
   int success_dt = TRUE; /* success or failure of time step          */
   int failed_recently_countdown = 0;
+  int n_start = 0;              /* first time step, nonzero on checkpoint restart */
+  int checkpoint_restarted = FALSE;
+  struct Checkpoint_State ckpt; /* binary checkpoint of the transient state */
   int i, num_total_nodes;
   int numProcUnknowns;
   int const_delta_t, const_delta_ts, step_print;
@@ -625,6 +643,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
    * the EXODUS II output file later - do only once if in library mode.
    */
 
+  goma_mem_push_tag(GOMA_MEM_POST);
   if (callnum == 1) {
     gvec_elem = (double ***)alloc_ptr_1(exo->num_elem_blocks);
     if ((tev + tev_post) > 0) {
@@ -643,6 +662,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
    */
 
   asdv(&gvec, Num_Node);
+  goma_mem_pop_tag();
 
   /*
    * Allocate space and manipulate for all the nodes that this processor
@@ -653,6 +673,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
 
   numProcUnknowns = NumUnknowns[pg->imtrx] + NumExtUnknowns[pg->imtrx];
 
+  goma_mem_push_tag(GOMA_MEM_SOLUTION);
   asdv(&resid_vector, numProcUnknowns);
   asdv(&resid_vector_sens, numProcUnknowns);
   asdv(&scale, numProcUnknowns);
@@ -684,6 +705,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
     xdot_older = alloc_dbl_1(numProcUnknowns, 0.0);
   }
   x_update = alloc_dbl_1(numProcUnknowns + numProcUnknowns, 0.0);
+  goma_mem_pop_tag();
 
   /* Initialize solid inertia flag */
   set_solid_inertia();
@@ -936,7 +958,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
 
     log_msg("sl_init()...");
     sl_init(matrix_systems_mask, ams, exo, dpi, cx[0]);
-    if (nAC > 0 || nn_post_fluxes_sens > 0 || nn_post_data_sens > 0)
+    if (nAC > 0 || nn_post_fluxes_sens > 0 || nn_post_data_sens > 0 || Jacobian_Reuse)
       ams[JAC]->options[AZ_keep_info] = 1;
 
       /*
@@ -953,6 +975,15 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
     check_parallel_error("Solver initialization problems");
 #endif /* PARALLEL */
 
+#ifdef GOMA_BENCHMARKS
+    if (Goma_Benchmark_Options.enabled) {
+      err = run_kernel_benchmarks(ams[JAC], x, x_old, x_older, xdot, xdot_old, resid_vector,
+                                  x_update, time1, exo, dpi, cx[0]);
+      GOMA_EH(err, "Problem from run_kernel_benchmarks.");
+      goto free_and_clear;
+    }
+#endif
+
     if (nEQM > 0) {
       DPRINTF(stdout, "\nINITIAL ELEMENT QUALITY CHECK---\n");
       good_mesh = element_quality(exo, x, ams[0]->proc_config);
@@ -1046,12 +1077,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
     /* Integrate fluxes, forces  (only if converged)
      */
     if (converged) {
-      for (i = 0; i < nn_post_fluxes; i++) {
-        (void)evaluate_flux(exo, dpi, pp_fluxes[i]->ss_id, pp_fluxes[i]->flux_type,
-                            pp_fluxes[i]->flux_type_name, pp_fluxes[i]->blk_id,
-                            pp_fluxes[i]->species_number, pp_fluxes[i]->flux_filenm,
-                            pp_fluxes[i]->profile_flag, x, xdot, NULL, delta_t, time1, 1);
-      }
+      evaluate_pp_fluxes(exo, dpi, x, xdot, delta_t, time1);
 
       /* Compute flux, force sensitivities
        */
@@ -1241,6 +1267,8 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
      */
     if (callnum == 1)
       sl_init(matrix_systems_mask, ams, exo, dpi, cx[0]);
+    if (Jacobian_Reuse)
+      ams[JAC]->options[AZ_keep_info] = 1;
 
     /*
      * make sure the Aztec was properly initialized
@@ -1253,16 +1281,52 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
     const_delta_ts = const_delta_t;
     last_renorm_nt = 0;
 
+    if (tran->bdf_max_order > 0)
+      bdf_init(&bdf, tran->bdf_max_order, numProcUnknowns, nAC);
+
     if (Particle_Dynamics)
       initialize_particles(exo, x, x_old, xdot, xdot_old, resid_vector);
 
+    /*
+     * Pick up the full transient state (solution and time step history,
+     * element storage, particles) where a checkpointed run left off.
+     */
+    if (tran->checkpoint_restart) {
+      double *sol_hist[7] = {x, x_old, x_older, x_oldest, xdot, xdot_old, xdot_older};
+      double *ac_hist[7] = {x_AC,     x_AC_old,     x_AC_older,    x_AC_oldest,
+                            x_AC_dot, x_AC_dot_old, x_AC_dot_older};
+      set_checkpoint_vectors(&ckpt, numProcUnknowns, sol_hist, nAC, ac_hist);
+      ckpt.bdf = (tran->bdf_max_order > 0) ? &bdf : NULL;
+      err = read_checkpoint(tran->checkpoint_file, &ckpt, tran->checkpoint_aggregate);
+      GOMA_EH(err, "Could not restart from checkpoint %s", tran->checkpoint_file);
+
+      time = time1 = ckpt.time;
+      tran->time_value = tran->time_value_old = time;
+      delta_t = ckpt.delta_t;
+      delta_t_old = ckpt.delta_t_old;
+      delta_t_older = ckpt.delta_t_older;
+      delta_t_oldest = ckpt.delta_t_oldest;
+      tran->delta_t = delta_t;
+      tran->delta_t_old = delta_t_old;
+      tran->delta_t_avg = 0.25 * (delta_t + delta_t_old + delta_t_older + delta_t_oldest);
+      time_print = ckpt.time_print;
+      step_print = ckpt.step_print;
+      nt = ckpt.nt;
+      n_start = ckpt.n;
+      last_renorm_nt = ckpt.last_renorm_nt;
+      failed_recently_countdown = ckpt.failed_recently_countdown;
+      checkpoint_restarted = TRUE;
+      DPRINTF(stdout, "\nRestarted from checkpoint \"%s\" at t=%g, step %d, dt=%g\n",
+              tran->checkpoint_file, time, nt, delta_t);
+    }
+
     /*
      * Write out the initial solution to an ascii file
      * and to the exodus output file, if requested to do so by
      * an optional flag in the input file
      *  -> Helpful in debugging what's going on.
      */
-    if (Write_Initial_Solution) {
+    if (Write_Initial_Solution && !checkpoint_restarted) {
       if (file != NULL) {
         error = write_ascii_soln(x, resid_vector, numProcUnknowns, x_AC, nAC, time, file);
         if (error != 0)
@@ -1294,7 +1358,9 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
      *  TOP OF THE TIME STEP LOOP -> Loop over time steps whether
      *                               they be successful or not
      *******************************************************************/
-    for (n = 0; n < max_time_steps; n++) {
+    for (n = n_start; n < max_time_steps; n++) {
+      goma_perf_log_time_step(&Goma_Perf_Log);
+
       /*
        * Calculate the absolute time for the current step, time1
        */
@@ -1388,6 +1454,17 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
          */
       }
 
+      /*
+       * The BDF integrator restarts at first order with the theta
+       * method, then takes theta from its own coefficients.
+       */
+      if (tran->bdf_max_order > 0) {
+        if (bdf.num_hist == 0 || (nt - last_renorm_nt) == 0 || (nt - last_adapt_nt) == 0) {
+          bdf_reset(&bdf, numProcUnknowns, x_old, x_AC_old, time);
+        }
+        theta = bdf_begin_step(&bdf, time1);
+      }
+
       /* Reset the node->DBC[] arrays to -1 where set
        * so that the boundary conditions are set correctly
        * at each time step.
@@ -1706,7 +1783,9 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
       }
 
       if (ProcID == 0) {
-        if (theta == 0.0)
+        if (tran->bdf_max_order > 0)
+          sprintf(tspstring, "(BDF%d)", bdf.order);
+        else if (theta == 0.0)
           strcpy(tspstring, "(BE)");
         else if (theta == 0.5)
           strcpy(tspstring, "(CN)");
@@ -1727,8 +1806,12 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
        */
 
       if (!nonconv_roll) {
-        predict_solution(numProcUnknowns, delta_t, delta_t_old, delta_t_older, theta, x, x_old,
-                         x_older, x_oldest, xdot, xdot_old, xdot_older);
+        if (tran->bdf_max_order > 0) {
+          bdf_predict(&bdf, time1, x, xdot, x_AC, x_AC_dot);
+        } else {
+          predict_solution(numProcUnknowns, delta_t, delta_t_old, delta_t_older, theta, x, x_old,
+                           x_older, x_oldest, xdot, xdot_old, xdot_older);
+        }
 
         if (tran->solid_inertia) {
           predict_solution_newmark(num_total_nodes, delta_t, x, x_old, xdot, xdot_old);
@@ -1785,7 +1868,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
 
       if (nAC > 0) {
 
-        if (!nonconv_roll) {
+        if (!nonconv_roll && tran->bdf_max_order == 0) {
           predict_solution(nAC, delta_t, delta_t_old, delta_t_older, theta, x_AC, x_AC_old,
                            x_AC_older, x_AC_oldest, x_AC_dot, x_AC_dot_old, x_AC_dot_older);
         }
@@ -1833,16 +1916,25 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
       if ((tran->ale_adapt || (ls != NULL && ls->adapt)) && tran->theta != 0) {
         GOMA_EH(GOMA_ERROR, "Error theta time step parameter = %g only 0.0 supported", tran->theta);
       }
+      mesh_adapted = FALSE;
+      /* with an Adapt Error Threshold the estimate decides at every step, not the schedule */
+      adapt_on_error = nt > 0 && tran->adapt_error_threshold > 0.0;
       if ((tran->ale_adapt || (ls != NULL && ls->adapt)) && pg->imtrx == 0 &&
-          (nt == 0 || ((ls != NULL && nt % ls->adapt_freq == 0) ||
-                       (tran->ale_adapt && nt % tran->ale_adapt_freq == 0)))) {
+          (nt == 0 || adapt_on_error || (ls != NULL && nt % ls->adapt_freq == 0) ||
+           (tran->ale_adapt && nt % tran->ale_adapt_freq == 0))) {
+        int step = adapt_step;
         if (last_adapt_nt == nt && adapt_step > 0) {
-          adapt_step--;
+          step--;
+        }
+        mesh_adapted =
+            adapt_mesh_omega_h(ams, exo, dpi, &x, &x_old, &x_older, &xdot, &xdot_old, &x_oldest,
+                               &resid_vector, &x_update, &scale, step, adapt_on_error);
+        if (mesh_adapted) {
+          last_adapt_nt = nt;
+          adapt_step = step + 1;
         }
-        last_adapt_nt = nt;
-        adapt_mesh_omega_h(ams, exo, dpi, &x, &x_old, &x_older, &xdot, &xdot_old, &x_oldest,
-                           &resid_vector, &x_update, &scale, adapt_step);
-        adapt_step++;
+      }
+      if (mesh_adapted) {
         num_total_nodes = dpi->num_universe_nodes;
         num_total_nodes = dpi->num_universe_nodes;
         numProcUnknowns = NumUnknowns[pg->imtrx] + NumExtUnknowns[pg->imtrx];
@@ -1868,6 +1960,7 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
         memset(resid_vector, 0, sizeof(double) * numProcUnknowns);
         memset(scale, 0, sizeof(double) * numProcUnknowns);
         memset(x_update, 0, sizeof(double) * (numProcUnknowns + numProcUnknowns));
+        jacobian_reuse_invalidate();
         dcopy1(numProcUnknowns, xdot, xdot_old);
         wr_result_prelim_exo(rd, exo, ExoFileOut, gvec_elem);
         nprint = 0;
@@ -1879,6 +1972,10 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
         //        nprint++;
         nullify_dirichlet_bcs();
         find_and_set_Dirichlet(x, xdot, exo, dpi);
+        if (tran->bdf_max_order > 0) {
+          bdf_reset(&bdf, numProcUnknowns, x_old, x_AC_old, time);
+          theta = bdf_begin_step(&bdf, time1);
+        }
       }
 #endif
 
@@ -1979,8 +2076,13 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
             P0PRINTF("Floored %d values\n", global_floored);
         }
 
-        delta_t_new = time_step_control(delta_t, delta_t_old, const_delta_t, x, x_pred, x_old, x_AC,
-                                        x_AC_pred, eps, &success_dt, tran->use_var_norm);
+        if (tran->bdf_max_order > 0) {
+          delta_t_new = bdf_step_control(&bdf, time1, const_delta_t, x, x_AC, eps, &success_dt,
+                                         tran->use_var_norm);
+        } else {
+          delta_t_new = time_step_control(delta_t, delta_t_old, const_delta_t, x, x_pred, x_old,
+                                          x_AC, x_AC_pred, eps, &success_dt, tran->use_var_norm);
+        }
         if (const_delta_t) {
           success_dt = TRUE;
           delta_t_new = delta_t;
@@ -2367,14 +2469,36 @@ void solve_problem(Exo_DB *exo, /* ptr to the finite element mesh database  */
           dcopy1(nAC, x_AC, x_AC_old);
         }
 
+        if (tran->bdf_max_order > 0)
+          bdf_push(&bdf, x, x_AC, time);
+
+        /* Everything the next step needs is in place; checkpoint it */
+        if (tran->checkpoint_freq > 0 && nt % tran->checkpoint_freq == 0) {
+          double *sol_hist[7] = {x, x_old, x_older, x_oldest, xdot, xdot_old, xdot_older};
+          double *ac_hist[7] = {x_AC,     x_AC_old,     x_AC_older,    x_AC_oldest,
+                                x_AC_dot, x_AC_dot_old, x_AC_dot_older};
+          set_checkpoint_vectors(&ckpt, numProcUnknowns, sol_hist, nAC, ac_hist);
+          ckpt.bdf = (tran->bdf_max_order > 0) ? &bdf : NULL;
+          ckpt.time = time;
+          ckpt.delta_t = delta_t;
+          ckpt.delta_t_old = delta_t_old;
+          ckpt.delta_t_older = delta_t_older;
+          ckpt.delta_t_oldest = delta_t_oldest;
+          ckpt.time_print = time_print;
+          ckpt.n = n + 1;
+          ckpt.nt = nt;
+          ckpt.step_print = step_print;
+          ckpt.last_renorm_nt = last_renorm_nt;
+          ckpt.failed_recently_countdown = failed_recently_countdown;
+          err = write_checkpoint(tran->checkpoint_file, &ckpt, tran->checkpoint_aggregate);
+          if (err) {
+            GOMA_WH(-1, "Could not write checkpoint %s at step %d", tran->checkpoint_file, nt);
+          }
+        }
+
         /* Integrate fluxes, forces
          */
-        for (i = 0; i < nn_post_fluxes; i++) {
-          (void)evaluate_flux(exo, dpi, pp_fluxes[i]->ss_id, pp_fluxes[i]->flux_type,
-                              pp_fluxes[i]->flux_type_name, pp_fluxes[i]->blk_id,
-                              pp_fluxes[i]->species_number, pp_fluxes[i]->flux_filenm,
-                              pp_fluxes[i]->profile_flag, x, xdot, NULL, delta_t_old, time, 1);
-        }
+        evaluate_pp_fluxes(exo, dpi, x, xdot, delta_t_old, time);
 
         /* Compute flux, force sensitivities
          */
@@ -2615,6 +2739,12 @@ free_and_clear:
 
   /* Free a bunch of variables that aren't needed anymore */
 
+  close_trans_vectors_from_exoII();
+  if (Particle_Dynamics) {
+    close_particle_output();
+    free_particles();
+  }
+
   for (i = 0; i < Num_ROT; i++) {
     safer_free((void **)&(ROT_Types[i].elems));
   }
@@ -2652,8 +2782,14 @@ free_and_clear:
   }
 
   safer_free((void **)&x_pred);
+  if (tran->bdf_max_order > 0)
+    bdf_free(&bdf);
+
+  if (last_call)
+    jacobian_reuse_print_stats();
 
   if (last_call) {
+    qp_prop_free();
     safer_free((void **)&x_save);
     safer_free((void **)&xdot_save);
     safer_free((void **)&x_old);
@@ -2665,8 +2801,8 @@ free_and_clear:
   }
 
   if (tran->solid_inertia) {
-    free(tran->xdbl_dot);
-    free(tran->xdbl_dot_old);
+    safe_free(tran->xdbl_dot);
+    safe_free(tran->xdbl_dot_old);
   }
   safer_free((void **)&x_update);
 
@@ -2726,11 +2862,11 @@ free_and_clear:
     safer_free((void **)&gvec_elem);
     safer_free((void **)&rd);
     for (int i = 0; i < num_total_nodes; i++) {
-      free(Local_Offset[0][i]);
-      free(Dolphin[0][i]);
+      safe_free(Local_Offset[0][i]);
+      safe_free(Dolphin[0][i]);
     }
-    free(Dolphin[0]);
-    free(Local_Offset[0]);
+    safe_free(Dolphin[0]);
+    safe_free(Local_Offset[0]);
     safer_free((void **)&Local_Offset);
     safer_free((void **)&Dolphin);
   }
@@ -2890,6 +3026,36 @@ static void predict_solution_newmark(
   }
 } /* END of routine predict_solution_newmark  */
 
+/*
+ * Point a checkpoint state at the solution history (x, x_old, x_older,
+ * x_oldest, xdot, xdot_old, xdot_older) and the augmenting condition
+ * history (x_AC, x_AC_old, x_AC_older, x_AC_oldest, x_AC_dot,
+ * x_AC_dot_old, x_AC_dot_older).
+ */
+static void set_checkpoint_vectors(struct Checkpoint_State *ckpt,
+                                   int num_unknowns,
+                                   double *sol_hist[7],
+                                   int nAC,
+                                   double *ac_hist[7]) {
+  ckpt->num_unknowns = num_unknowns;
+  ckpt->x = sol_hist[0];
+  ckpt->x_old = sol_hist[1];
+  ckpt->x_older = sol_hist[2];
+  ckpt->x_oldest = sol_hist[3];
+  ckpt->xdot = sol_hist[4];
+  ckpt->xdot_old = sol_hist[5];
+  ckpt->xdot_older = sol_hist[6];
+
+  ckpt->nAC = nAC;
+  ckpt->x_AC = ac_hist[0];
+  ckpt->x_AC_old = ac_hist[1];
+  ckpt->x_AC_older = ac_hist[2];
+  ckpt->x_AC_oldest = ac_hist[3];
+  ckpt->x_AC_dot = ac_hist[4];
+  ckpt->x_AC_dot_old = ac_hist[5];
+  ckpt->x_AC_dot_older = ac_hist[6];
+}
+
 int discard_previous_time_step(int num_unks,
                                double *x,
                                double *x_old,
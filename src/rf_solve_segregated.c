@@ -66,6 +66,7 @@
 #include "sl_util.h"
 #include "sl_util_structs.h"
 #include "std.h"
+#include "util/goma_perf_log.h"
 #include "wr_exo.h"
 #include "wr_soln.h"
 #ifdef GOMA_ENABLE_OMEGA_H
@@ -697,6 +698,9 @@ void solve_problem_segregated(Exo_DB *exo, /* ptr to the finite element mesh dat
       tran->init_time = timeValueRead[0];
       DPRINTF(stdout, "\n Initial Simulation Time Has been set to %g\n", timeValueRead[0]);
     }
+    if (tran->bdf_max_order > 0) {
+      GOMA_EH(GOMA_ERROR, "BDF time integration is not available in the segregated solver");
+    }
   }
 
   for (iAC = 0; iAC < nAC; iAC++) {
@@ -1012,13 +1016,7 @@ void solve_problem_segregated(Exo_DB *exo, /* ptr to the finite element mesh dat
         if (distance < tran->steady_state_tolerance) {
 
           pg->imtrx = 0;
-          for (i = 0; i < nn_post_fluxes; i++) {
-            (void)evaluate_flux(exo, dpi, pp_fluxes[i]->ss_id, pp_fluxes[i]->flux_type,
-                                pp_fluxes[i]->flux_type_name, pp_fluxes[i]->blk_id,
-                                pp_fluxes[i]->species_number, pp_fluxes[i]->flux_filenm,
-                                pp_fluxes[i]->profile_flag, x[pg->imtrx], xdot[pg->imtrx], NULL,
-                                delta_t_old, time, 1);
-          }
+          evaluate_pp_fluxes(exo, dpi, x[pg->imtrx], xdot[pg->imtrx], delta_t_old, time);
 
           write_solution_segregated(ExoFileOut, resid_vector, x, x_old, xdot, xdot_old, tev_post,
                                     gv, rd, gvec, gvec_elem, &nprint, delta_t, theta, time1, NULL,
@@ -1372,11 +1370,14 @@ void solve_problem_segregated(Exo_DB *exo, /* ptr to the finite element mesh dat
      *******************************************************************/
 #ifdef GOMA_ENABLE_OMEGA_H
     int adapt_step = 0;
+    int mesh_adapted; /* Omega_h changed the mesh this step */
+    int adapt_on_error; /* adapt only if the error estimate exceeds its threshold */
 #endif
     int last_adapt_nt = 0;
     for (n = 0; n < MaxTimeSteps; n++) {
 
       tran->step = n;
+      goma_perf_log_time_step(&Goma_Perf_Log);
 
       for (int subcycle = 0;
            subcycle < upd->SegregatedSubcycles || subcycle < renorm_subcycle_count; subcycle++) {
@@ -1407,16 +1408,25 @@ void solve_problem_segregated(Exo_DB *exo, /* ptr to the finite element mesh dat
             GOMA_EH(GOMA_ERROR, "Error theta time step parameter = %g only 0.0 supported",
                     tran->theta);
           }
+          mesh_adapted = FALSE;
+          /* with an Adapt Error Threshold the estimate decides at every step, not the schedule */
+          adapt_on_error = nt > 0 && tran->adapt_error_threshold > 0.0;
           if (subcycle == 0 && (tran->ale_adapt || (ls != NULL && ls->adapt)) && pg->imtrx == 0 &&
-              (nt == 0 || ((ls != NULL && nt % ls->adapt_freq == 0) ||
-                           (tran->ale_adapt && nt % tran->ale_adapt_freq == 0)))) {
+              (nt == 0 || adapt_on_error || (ls != NULL && nt % ls->adapt_freq == 0) ||
+               (tran->ale_adapt && nt % tran->ale_adapt_freq == 0))) {
+            int step = adapt_step;
             if (last_adapt_nt == nt && adapt_step > 0) {
-              adapt_step--;
+              step--;
+            }
+            mesh_adapted =
+                adapt_mesh_omega_h(ams, exo, dpi, x, x_old, x_older, xdot, xdot_old, x_oldest,
+                                   resid_vector, x_update, scale, step, adapt_on_error);
+            if (mesh_adapted) {
+              last_adapt_nt = nt;
+              adapt_step = step + 1;
             }
-            last_adapt_nt = nt;
-            adapt_mesh_omega_h(ams, exo, dpi, x, x_old, x_older, xdot, xdot_old, x_oldest,
-                               resid_vector, x_update, scale, adapt_step);
-            adapt_step++;
+          }
+          if (mesh_adapted) {
             num_total_nodes = dpi->num_universe_nodes;
             num_total_nodes = dpi->num_universe_nodes;
             if (nt == 0) {
@@ -2268,13 +2278,7 @@ void solve_problem_segregated(Exo_DB *exo, /* ptr to the finite element mesh dat
         }
 
         pg->imtrx = 0;
-        for (i = 0; i < nn_post_fluxes; i++) {
-          (void)evaluate_flux(exo, dpi, pp_fluxes[i]->ss_id, pp_fluxes[i]->flux_type,
-                              pp_fluxes[i]->flux_type_name, pp_fluxes[i]->blk_id,
-                              pp_fluxes[i]->species_number, pp_fluxes[i]->flux_filenm,
-                              pp_fluxes[i]->profile_flag, x[pg->imtrx], xdot[pg->imtrx], NULL,
-                              delta_t_old, time, 1);
-        }
+        evaluate_pp_fluxes(exo, dpi, x[pg->imtrx], xdot[pg->imtrx], delta_t_old, time);
 
         for (i = 0; i < nn_volume; i++) {
           evaluate_volume_integral(
@@ -2675,6 +2679,8 @@ free_and_clear:
       }
     }
   }
+  close_trans_vectors_from_exoII();
+
   free(matrix_nAC);
   free(x_AC);
   free(x_AC_old);
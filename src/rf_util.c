@@ -63,6 +63,7 @@
 #include "rf_util.h"
 #include "rf_vars_const.h"
 #include "std.h"
+#include "util/goma_time_planes.h"
 /************ R O U T I N E S   I N   T H I S   F I L E  **********************
 
        NAME            		TYPE        		CALL BY
@@ -468,6 +469,118 @@ int filter_conc(const int N, /* number of nodes */
 } /* END of routine filter_conc */
 /***************************************************************************/
 
+/*
+ * Shell, lubrication and shell rheology unknowns, all of which are
+ * lumped under use_var_norm[9] in the time step error norm.
+ */
+static const int shell_eqns[9] = {SURF_CHARGE,   SHELL_CURVATURE, SHELL_CURVATURE2,
+                                  SHELL_TENSION, SHELL_X,         SHELL_Y,
+                                  SHELL_USER,    SHELL_ANGLE1,    SHELL_ANGLE2};
+static const int lub_eqns[24] = {LUBP,
+                                 LUBP_2,
+                                 SHELL_SAT_CLOSED,
+                                 SHELL_PRESS_OPEN,
+                                 SHELL_PRESS_OPEN_2,
+                                 SHELL_SAT_1,
+                                 SHELL_SAT_2,
+                                 SHELL_SAT_3,
+                                 SHELL_SAT_GASN,
+                                 SHELL_LUB_CURV,
+                                 SHELL_LUB_CURV_2,
+                                 SHELL_DIFF_FLUX,
+                                 SHELL_DIFF_CURVATURE,
+                                 SHELL_LUBP,
+                                 SHELL_FILMP,
+                                 SHELL_FILMH,
+                                 SHELL_PARTC,
+                                 SHELL_TEMPERATURE,
+                                 SHELL_DELTAH,
+                                 SHELL_SHEAR_TOP,
+                                 SHELL_SHEAR_BOT,
+                                 SHELL_CROSS_SHEAR,
+                                 TFMP_PRES,
+                                 TFMP_SAT};
+static const int rheo_eqns[9] = {SHELL_SURF_DIV_V, SHELL_SURF_CURV, SHELL_NORMAL1,
+                                 SHELL_NORMAL2,    SHELL_NORMAL3,   N_DOT_CURL_V,
+                                 GRAD_S_V_DOT_N1,  GRAD_S_V_DOT_N2, GRAD_S_V_DOT_N3};
+
+/*
+ * Returns TRUE if variable type var contributes to the time step error
+ * norm, according to the "Time step error" selections in use_var_norm[].
+ * Both time_step_control() and the BDF error estimate use it.
+ */
+int time_step_norm_var(const int var, const int use_var_norm[]) {
+  int i;
+
+  switch (var) {
+  case MESH_DISPLACEMENT1:
+  case MESH_DISPLACEMENT2:
+  case MESH_DISPLACEMENT3:
+  case MAX_STRAIN:
+  case CUR_STRAIN:
+    return use_var_norm[0];
+  case VELOCITY1:
+  case VELOCITY2:
+  case VELOCITY3:
+  case PVELOCITY1:
+  case PVELOCITY2:
+  case PVELOCITY3:
+    return use_var_norm[1];
+  case TEMPERATURE:
+    return use_var_norm[2];
+  case MASS_FRACTION:
+  case POR_LIQ_PRES:
+  case POR_GAS_PRES:
+  case POR_POROSITY:
+  case POR_SATURATION:
+  case POR_SINK_MASS:
+    return use_var_norm[3];
+  case PRESSURE:
+    return use_var_norm[4];
+  case VOLTAGE:
+    return use_var_norm[6];
+  case SOLID_DISPLACEMENT1:
+  case SOLID_DISPLACEMENT2:
+  case SOLID_DISPLACEMENT3:
+    return use_var_norm[7];
+  case FILL:
+  case PHASE1:
+  case PHASE2:
+  case PHASE3:
+  case PHASE4:
+  case PHASE5:
+    return use_var_norm[8];
+  case SHELL_BDYVELO:
+    return use_var_norm[9];
+  case ACOUS_PREAL:
+  case ACOUS_PIMAG:
+  case ACOUS_REYN_STRESS:
+  case LIGHT_INTP:
+  case LIGHT_INTM:
+  case LIGHT_INTD:
+  case RESTIME:
+  case TURB_K:
+  case TURB_OMEGA:
+    return TRUE;
+  default:
+    break;
+  }
+
+  if ((var >= POLYMER_STRESS11 && var <= POLYMER_STRESS33) ||
+      (var >= POLYMER_STRESS11_1 && var <= POLYMER_STRESS33_7)) {
+    return use_var_norm[5];
+  }
+  for (i = 0; i < 9; i++) {
+    if (var == shell_eqns[i] || var == rheo_eqns[i])
+      return use_var_norm[9];
+  }
+  for (i = 0; i < 24; i++) {
+    if (var == lub_eqns[i])
+      return use_var_norm[9];
+  }
+  return FALSE;
+}
+
 double time_step_control(const double delta_t,
                          const double delta_t_old,
                          const int const_delta_t,
@@ -564,35 +677,6 @@ double time_step_control(const double delta_t,
 #else
   int bit_DM_scale = FALSE;
 #endif
-  int shell_eqns[9] = {SURF_CHARGE, SHELL_CURVATURE, SHELL_CURVATURE2, SHELL_TENSION, SHELL_X,
-                       SHELL_Y,     SHELL_USER,      SHELL_ANGLE1,     SHELL_ANGLE2};
-  int lub_eqns[24] = {LUBP,
-                      LUBP_2,
-                      SHELL_SAT_CLOSED,
-                      SHELL_PRESS_OPEN,
-                      SHELL_PRESS_OPEN_2,
-                      SHELL_SAT_1,
-                      SHELL_SAT_2,
-                      SHELL_SAT_3,
-                      SHELL_SAT_GASN,
-                      SHELL_LUB_CURV,
-                      SHELL_LUB_CURV_2,
-                      SHELL_DIFF_FLUX,
-                      SHELL_DIFF_CURVATURE,
-                      SHELL_LUBP,
-                      SHELL_FILMP,
-                      SHELL_FILMH,
-                      SHELL_PARTC,
-                      SHELL_TEMPERATURE,
-                      SHELL_DELTAH,
-                      SHELL_SHEAR_TOP,
-                      SHELL_SHEAR_BOT,
-                      SHELL_CROSS_SHEAR,
-                      TFMP_PRES,
-                      TFMP_SAT};
-  int rheo_eqns[9] = {SHELL_SURF_DIV_V, SHELL_SURF_CURV, SHELL_NORMAL1,
-                      SHELL_NORMAL2,    SHELL_NORMAL3,   N_DOT_CURL_V,
-                      GRAD_S_V_DOT_N1,  GRAD_S_V_DOT_N2, GRAD_S_V_DOT_N3};
 
   static const char yo[] = "time_step_control";
 
@@ -717,132 +801,18 @@ double time_step_control(const double delta_t,
   /*
    * Construct a single error norm from each variable's contribution
    * depending on user selection specification in the input deck.
+   * time_step_norm_var() holds the grouping, so the BDF error estimate
+   * in rf_bdf.c measures the same unknowns.
    */
-  if (use_var_norm[0]) {
-    Err_norm += ecp[MESH_DISPLACEMENT1];
-    Err_norm += ecp[MESH_DISPLACEMENT2];
-    Err_norm += ecp[MESH_DISPLACEMENT3];
-    Err_norm += ecp[MAX_STRAIN];
-    Err_norm += ecp[CUR_STRAIN];
-    num_unknowns += ncp[MESH_DISPLACEMENT1];
-    num_unknowns += ncp[MESH_DISPLACEMENT2];
-    num_unknowns += ncp[MESH_DISPLACEMENT3];
-    num_unknowns += ncp[MAX_STRAIN];
-    num_unknowns += ncp[CUR_STRAIN];
-  }
-
-  if (use_var_norm[1]) {
-    Err_norm += ecp[VELOCITY1];
-    Err_norm += ecp[VELOCITY2];
-    Err_norm += ecp[VELOCITY3];
-    num_unknowns += ncp[VELOCITY1];
-    num_unknowns += ncp[VELOCITY2];
-    num_unknowns += ncp[VELOCITY3];
-
-    /*
-     * Looks like Matt's particle momentum is considered lumped together
-     * with solvent phase momentum equations for the purposes of computing
-     * a global time step norm...
-     */
-    Err_norm += ecp[PVELOCITY1];
-    Err_norm += ecp[PVELOCITY2];
-    Err_norm += ecp[PVELOCITY3];
-    num_unknowns += ncp[PVELOCITY1];
-    num_unknowns += ncp[PVELOCITY2];
-    num_unknowns += ncp[PVELOCITY3];
-  }
-
-  if (use_var_norm[2]) {
-    Err_norm += ecp[TEMPERATURE];
-    num_unknowns += ncp[TEMPERATURE];
-  }
-
-  if (use_var_norm[3]) { /* Maybe someday we can discriminate between
-                          * individual species at fault for predictor
-                          * missing the corrector. */
-    Err_norm += ecp[MASS_FRACTION];
-    Err_norm += ecp[POR_LIQ_PRES];
-    Err_norm += ecp[POR_GAS_PRES];
-    Err_norm += ecp[POR_POROSITY];
-    Err_norm += ecp[POR_SATURATION];
-    Err_norm += ecp[POR_SINK_MASS];
-
-    num_unknowns += ncp[MASS_FRACTION];
-    num_unknowns += ncp[POR_LIQ_PRES];
-    num_unknowns += ncp[POR_GAS_PRES];
-    num_unknowns += ncp[POR_POROSITY];
-    num_unknowns += ncp[POR_SATURATION];
-    num_unknowns += ncp[POR_SINK_MASS];
-  }
-
-  if (use_var_norm[4]) { /* Pressure, even though there is no dP/dt
-                          * term in any of the equations for
-                          * incompressible flow... */
-    Err_norm += ecp[PRESSURE];
-    num_unknowns += ncp[PRESSURE];
-  }
-
-  if (use_var_norm[5]) { /* Polymer extra stress contribution */
-    Err_norm += ecp[POLYMER_STRESS11];
-    Err_norm += ecp[POLYMER_STRESS12];
-    Err_norm += ecp[POLYMER_STRESS22];
-    Err_norm += ecp[POLYMER_STRESS13];
-    Err_norm += ecp[POLYMER_STRESS23];
-    Err_norm += ecp[POLYMER_STRESS33];
-
-    num_unknowns += ncp[POLYMER_STRESS11];
-    num_unknowns += ncp[POLYMER_STRESS12];
-    num_unknowns += ncp[POLYMER_STRESS22];
-    num_unknowns += ncp[POLYMER_STRESS13];
-    num_unknowns += ncp[POLYMER_STRESS23];
-    num_unknowns += ncp[POLYMER_STRESS33];
-
-    /*
-     * Hey, lots of multi-mode Giesekus stress equations, too!
-     */
-    for (eqn = POLYMER_STRESS11_1; eqn <= POLYMER_STRESS33_7; eqn++) {
+  for (eqn = 0; eqn < MAX_VARIABLE_TYPES; eqn++) {
+    if (time_step_norm_var(eqn, use_var_norm)) {
       Err_norm += ecp[eqn];
       num_unknowns += ncp[eqn];
     }
   }
 
-  if (use_var_norm[6]) {
-    Err_norm += ecp[VOLTAGE];
-    num_unknowns += ncp[VOLTAGE];
-  }
-
-  if (use_var_norm[7]) {
-    Err_norm += ecp[SOLID_DISPLACEMENT1];
-    Err_norm += ecp[SOLID_DISPLACEMENT2];
-    Err_norm += ecp[SOLID_DISPLACEMENT3];
-
-    num_unknowns += ncp[SOLID_DISPLACEMENT1];
-    num_unknowns += ncp[SOLID_DISPLACEMENT2];
-    num_unknowns += ncp[SOLID_DISPLACEMENT3];
-  }
-
-  if (use_var_norm[8]) /* LS equation is set with special card in Level Set section */
-  {
-    Err_norm += ecp[FILL];
-    num_unknowns += ncp[FILL];
-    Err_norm += ecp[PHASE1];
-    Err_norm += ecp[PHASE2];
-    Err_norm += ecp[PHASE3];
-    Err_norm += ecp[PHASE4];
-    Err_norm += ecp[PHASE5];
-    num_unknowns += ncp[PHASE1];
-    num_unknowns += ncp[PHASE2];
-    num_unknowns += ncp[PHASE3];
-    num_unknowns += ncp[PHASE4];
-    num_unknowns += ncp[PHASE5];
-  }
-
-  /** add in shell element components  */
+  /** break down the shell element components for printing */
   if (use_var_norm[9]) {
-    for (i = 0; i < 9; i++) {
-      Err_norm += ecp[shell_eqns[i]];
-      num_unknowns += ncp[shell_eqns[i]];
-    }
     e_qs = ecp[SURF_CHARGE];
     e_shk = ecp[SHELL_CURVATURE] + ecp[SHELL_CURVATURE2];
     e_sht = ecp[SHELL_TENSION];
@@ -850,20 +820,14 @@ double time_step_control(const double delta_t,
     e_shu = ecp[SHELL_USER];
     for (i = 0; i < 24; i++) {
       e_sh_lub += ecp[lub_eqns[i]];
-      num_unknowns += ncp[lub_eqns[i]];
       if (ncp[lub_eqns[i]])
         lub_present = 1;
     }
-    Err_norm += e_sh_lub;
     for (i = 0; i < 9; i++) {
       e_rheo += ecp[rheo_eqns[i]];
-      num_unknowns += ncp[rheo_eqns[i]];
       if (ncp[rheo_eqns[i]])
         rheo_present = 1;
     }
-    Err_norm += e_rheo;
-    Err_norm += ecp[SHELL_BDYVELO];
-    num_unknowns += ncp[SHELL_BDYVELO];
   }
   if (nAC > 0) /* Don't we want to include the AC unknowns in time step control ? */
   {
@@ -875,29 +839,6 @@ double time_step_control(const double delta_t,
     }
   }
 
-  /** add in extra stuff  */
-  Err_norm += ecp[ACOUS_PREAL];
-  Err_norm += ecp[ACOUS_PIMAG];
-  Err_norm += ecp[ACOUS_REYN_STRESS];
-  Err_norm += ecp[LIGHT_INTP];
-  Err_norm += ecp[LIGHT_INTM];
-  Err_norm += ecp[LIGHT_INTD];
-  Err_norm += ecp[RESTIME];
-  /*    Err_norm      += ecp[EXT_VELOCITY];  */
-  Err_norm += ecp[TURB_K];
-  Err_norm += ecp[TURB_OMEGA];
-
-  num_unknowns += ncp[ACOUS_PREAL];
-  num_unknowns += ncp[ACOUS_PIMAG];
-  num_unknowns += ncp[ACOUS_REYN_STRESS];
-  num_unknowns += ncp[LIGHT_INTP];
-  num_unknowns += ncp[LIGHT_INTM];
-  num_unknowns += ncp[LIGHT_INTD];
-  num_unknowns += ncp[RESTIME];
-  /*    num_unknowns += ncp[EXT_VELOCITY];  */
-  num_unknowns += ncp[TURB_K];
-  num_unknowns += ncp[TURB_OMEGA];
-
 #if 0 /* ------------------- maybe someday you'll want these, too... -----*/
   if (use_var_norm["index for shear rate equation"] ) {
     Err_norm      += ecp[SHEAR_RATE];
@@ -2729,6 +2670,95 @@ int rd_vectors_from_exoII(double u[],
 /*****************************************************************************/
 /*****************************************************************************/
 /*****************************************************************************/
+/*
+ * Transient external fields are read a time plane at a time.  The file of
+ * each field stays open through the time loop with its time values and
+ * variable index looked up once, and the two planes bracketing the current
+ * time are kept, so as time advances each plane is read from the file once
+ * instead of opening the file and reading two planes every time step.
+ */
+struct trans_efv_file {
+  int open;
+  int exoid;
+  char file_nm[MAX_FNL];
+  int num_nodes;
+  int vdex; /* nodal variable index in the file, -1 when missing */
+  int num_times;
+  double *times;
+  int slot_plane[GOMA_TIME_PLANE_SLOTS];
+  double *plane[GOMA_TIME_PLANE_SLOTS];
+};
+
+static struct trans_efv_file Trans_Efv_File[MAX_EXTERNAL_FIELD];
+
+static void open_trans_efv_file(struct trans_efv_file *f, const char *file_nm, int variable_no) {
+  int error, num_dim, num_elem, num_elem_blk, num_node_sets, num_side_sets;
+  float version;
+  char title[MAX_LINE_LENGTH];
+  int num_vars;
+  char **var_names = NULL;
+
+  CPU_word_size = sizeof(double);
+  IO_word_size = 0;
+
+  f->exoid = ex_open(file_nm, EX_READ, &CPU_word_size, &IO_word_size, &version);
+  GOMA_EH(f->exoid, "ex_open");
+  f->open = TRUE;
+  strncpy(f->file_nm, file_nm, MAX_FNL - 1);
+
+  error = ex_get_init(f->exoid, title, &num_dim, &f->num_nodes, &num_elem, &num_elem_blk,
+                      &num_node_sets, &num_side_sets);
+  GOMA_EH(error, "ex_get_init for efv or init guess");
+
+  f->num_times = ex_inquire_int(f->exoid, EX_INQ_TIME);
+  f->times = alloc_dbl_1(MAX(f->num_times, 1), 0.0);
+  if (f->num_times > 0) {
+    error = ex_get_all_times(f->exoid, f->times);
+    GOMA_EH(error, "ex_get_all_times");
+  }
+
+  error = ex_get_variable_param(f->exoid, EX_NODAL, &num_vars);
+  GOMA_EH(error, "ex_get_variable_param nodal");
+  f->vdex = -1;
+  if (num_vars > 0) {
+    var_names = alloc_VecFixedStrings(num_vars, (MAX_STR_LENGTH + 1));
+    error = ex_get_variable_names(f->exoid, EX_NODAL, num_vars, var_names);
+    GOMA_EH(error, "ex_get_variable_names nodal");
+    for (int i = 0; i < num_vars; i++) {
+      strip(var_names[i]);
+      if (strcmp(var_names[i], efv->name[variable_no]) == 0) {
+        f->vdex = i + 1;
+      }
+    }
+  } else {
+    fprintf(stderr, "Warning: no nodal variables stored in exoII input file.\n");
+  }
+  safer_free((void **)&var_names);
+
+  for (int s = 0; s < GOMA_TIME_PLANE_SLOTS; s++) {
+    f->slot_plane[s] = 0;
+    f->plane[s] = NULL;
+  }
+}
+
+static void close_trans_efv_file(struct trans_efv_file *f) {
+  if (f->open) {
+    int error = ex_close(f->exoid);
+    GOMA_EH(error, "ex_close");
+    safer_free((void **)&f->times);
+    for (int s = 0; s < GOMA_TIME_PLANE_SLOTS; s++) {
+      safer_free((void **)&f->plane[s]);
+    }
+  }
+  memset(f, 0, sizeof(struct trans_efv_file));
+}
+
+void close_trans_vectors_from_exoII(void) {
+  for (int w = 0; w < MAX_EXTERNAL_FIELD; w++) {
+    close_trans_efv_file(&Trans_Efv_File[w]);
+  }
+}
+
 int rd_trans_vectors_from_exoII(double u[],
                                 const char *file_nm,
                                 const int variable_no,
@@ -2740,7 +2770,7 @@ int rd_trans_vectors_from_exoII(double u[],
 
 /*******************************************************************
  *
- * rd_vectors_from_exoII:
+ * rd_trans_vectors_from_exoII:
  *
  * Read time dependent extenal fields from exoIIv2 file
  *
@@ -2753,154 +2783,62 @@ int rd_trans_vectors_from_exoII(double u[],
  *      timeValueIn = current time value of the solution process
  *                     time value to be matched in the external field
  *
+ * The field is interpolated linearly in time between the planes on either
+ * side of timeValueIn (extrapolated past the last one).  Planes are read
+ * only when the time moves past the ones already held, see
+ * Trans_Efv_File above, and close_trans_vectors_from_exoII() closes the
+ * files at the end of the run.
+ *
  * out:	u	        initial guess to solution vector.
  *******************************************************************/
 {
-  int i, k, error, vdex, num_dim, num_nodes;
-  int num_elem, num_elem_blk, num_node_sets, num_side_sets, time_step;
-  float version;               /* version number of EXODUS II */
-  int exoid;                   /* ID of the open EXODUS II file */
-  char title[MAX_LINE_LENGTH]; /* title of the EXODUS II database */
-  float ret_float;             /* any returned float */
-  char ret_char[3];            /* any returned character */
-  int num_vars;                /* number of var_type variables */
-  char **var_names = NULL;     /* array containing num_vars variable names */
-  int num_elem_vars = 0;
-  double ftimeValue, time_higher, time_lower;
-  double *val_low, *val_high, slope, yint;
-  int time_step_read, time_step_higher, time_step_lower, time_step_max;
-#ifdef DEBUG
-  static const char yo[] = "rd_trans_vectors_from_exoII";
-#endif
-
-  CPU_word_size = sizeof(double);
-  IO_word_size = 0;
-
-  exoid = ex_open(file_nm, EX_READ, &CPU_word_size, &IO_word_size, &version);
-  GOMA_EH(exoid, "ex_open");
+  int error, lower, higher, slot[2], load[GOMA_TIME_PLANE_SLOTS];
+  double weight;
+  struct trans_efv_file *f = &Trans_Efv_File[variable_no];
 
-  error = ex_get_init(exoid, title, &num_dim, &num_nodes, &num_elem, &num_elem_blk, &num_node_sets,
-                      &num_side_sets);
-  GOMA_EH(error, "ex_get_init for efv or init guess");
-
-  /*
-   * Obtain the number of time steps in the exodus file, time_step,
-   */
-  error = ex_inquire(exoid, EX_INQ_TIME, &time_step, &ret_float, ret_char);
-  GOMA_EH(error, "ex_inquire");
-
-  /* Figure out what time step to select. Will select the closest time
-   * step to the current time in the solution procedure.
-   * The lower limit in exodus is 1.
-   */
-  time_step_max = time_step;
-  time_step_read = 1;
-  time_step_lower = time_step_read;
-  time_lower = 0.0;
-
-  error = ex_get_time(exoid, time_step_read, &ftimeValue);
-  if (error == -1) {
-    ftimeValue = 0.0;
+  if (!efv->ev) {
+    return 0;
   }
 
-  /* Cycle through the external time values, stop when the time value desired
-   * has been passed.
-   */
-  while ((*timeValueIn > ftimeValue) && (time_step_read < time_step_max)) {
-    time_step_lower = time_step_read;
-    time_lower = ftimeValue;
-    time_step_read++;
-    ex_get_time(exoid, time_step_read, &ftimeValue);
+  if (f->open && strcmp(f->file_nm, file_nm) != 0) {
+    close_trans_efv_file(f);
   }
-
-  /*if ((*timeValueIn <= ftimeValue) || (time_step_read >= time_step_max))
-    {
-      time_higher = ftimeValue;
-    }
-   */
-  /* Calculate which external time plane is closest to the desired time */
-  time_step_higher = time_step_read;
-  time_higher = ftimeValue;
-
-  // Return the value of the time
-  /*error = ex_get_time(exoid, time_step, &ftimeValue);
-  if (error == -1) {
-    ftimeValue = 0.0;
+  if (!f->open) {
+    open_trans_efv_file(f, file_nm, variable_no);
   }
-  if (timeValueIn) {
-    *timeValueIn = ftimeValue;
-  } */
-
-  // Open file to write results for debug info
-  /*ofp = fopen("Trans_EFV", "a");
-  fprintf(ofp,"Time value passed to function %e\n", *timeValueIn);
-  fprintf(ofp, "time_step_higher %d\n", time_step_higher);
-  fprintf(ofp, "time_step_lower %d\n", time_step_lower);
-  fprintf(ofp, "time_higher %e\n", time_higher);
-  fprintf(ofp, "time_lower %e\n", time_lower);
-  //fclose(ofp);*/
 
-  /*
-   * Get the number of nodal variables in the file, and allocate
-   * space for storage of their names.
-   */
-  error = ex_get_variable_param(exoid, EX_NODAL, &num_vars);
-  GOMA_EH(error, "ex_get_variable_param nodal");
-  error = ex_get_variable_param(exoid, EX_ELEM_BLOCK, &num_elem_vars);
-  GOMA_EH(error, "ex_get_variable_param elem");
-
-  /* First extract all nodal variable names in exoII database */
-  if (num_vars > 0) {
-    var_names = alloc_VecFixedStrings(num_vars, (MAX_STR_LENGTH + 1));
-    error = ex_get_variable_names(exoid, EX_NODAL, num_vars, var_names);
-    GOMA_EH(error, "ex_get_variable_names nodal");
-    for (i = 0; i < num_vars; i++)
-      strip(var_names[i]);
-  } else {
-    fprintf(stderr, "Warning: no nodal variables stored in exoII input file.\n");
+  if (desired_time_step == 0) {
+    fprintf(stderr, "rd_trans_vectors_from_exoII: Into existing field %d for %s at %p\n",
+            variable_no, efv->name[variable_no], (void *)efv->ext_fld_ndl_val[variable_no]);
   }
 
-  if (efv->ev) {
-    /*
-     * Already allocated this in rd_vectors_from_exoII for external field variable arrays
-     */
-    // efv->ext_fld_ndl_val[variable_no] = alloc_dbl_1(num_nodes, 0.0);
-    val_low = alloc_dbl_1(num_nodes, 0.0);
-    val_high = alloc_dbl_1(num_nodes, 0.0);
-
-    if (desired_time_step == 0) {
-      fprintf(stderr, "rd_trans_vectors_from_exoII: Into existing field %d for %s at %p\n",
-              variable_no, efv->name[variable_no], (void *)efv->ext_fld_ndl_val[variable_no]);
-    }
-    vdex = -1;
-    for (i = 0; i < num_vars; i++) {
-      if (strcmp(var_names[i], efv->name[variable_no]) == 0) {
-        vdex = i + 1;
+  if (f->vdex == -1) {
+    DPRINTF(stdout, "\n Cannot find external fields in exoII database, setting to null");
+  } else if (goma_time_plane_bracket(f->times, f->num_times, *timeValueIn, &lower, &higher,
+                                     &weight) == 0) {
+    goma_time_plane_slots(f->slot_plane, lower, higher, slot, load);
+    for (int s = 0; s < GOMA_TIME_PLANE_SLOTS; s++) {
+      if (load[s]) {
+        if (f->plane[s] == NULL) {
+          f->plane[s] = alloc_dbl_1(f->num_nodes, 0.0);
+        }
+        error =
+            ex_get_var(f->exoid, f->slot_plane[s], EX_NODAL, f->vdex, 1, f->num_nodes, f->plane[s]);
+        GOMA_EH(error, "ex_get_var nodal");
       }
     }
-    if (vdex == -1) {
-      DPRINTF(stdout, "\n Cannot find external fields in exoII database, setting to null");
-    } else {
-      error = ex_get_var(exoid, time_step_lower, EX_NODAL, vdex, 1, num_nodes, val_low);
-      error = ex_get_var(exoid, time_step_higher, EX_NODAL, vdex, 1, num_nodes, val_high);
-      GOMA_EH(error, "ex_get_var nodal");
-
-      for (k = 0; k < exo->num_nodes; k++) {
-        int base_index = exo->ghost_node_to_base[k];
-        if (base_index != -1) {
-          slope = (val_high[base_index] - val_low[base_index]) / (time_higher - time_lower);
-          yint = val_low[base_index] - slope * time_lower;
-          efv->ext_fld_ndl_val[variable_no][k] = slope * (*timeValueIn) + yint;
-        }
+
+    const double *val_low = f->plane[slot[0]];
+    const double *val_high = f->plane[slot[1]];
+    for (int k = 0; k < exo->num_nodes; k++) {
+      int base_index = exo->ghost_node_to_base[k];
+      if (base_index != -1) {
+        efv->ext_fld_ndl_val[variable_no][k] =
+            val_low[base_index] + weight * (val_high[base_index] - val_low[base_index]);
       }
     }
   }
 
-  safer_free((void **)&var_names);
-  error = ex_close(exoid);
-  GOMA_EH(error, "ex_close");
-  // fclose(ofp);
-
   /*
    *  Exchange the degrees of freedom with neighboring processors
    */
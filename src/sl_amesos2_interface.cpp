@@ -61,15 +61,9 @@ int amesos2_solve(struct GomaLinearSolverData *ams,
       tpetra_data->matrix->endAssembly();
     }
 
-    RCP<VEC> tpetra_x = rcp(new VEC(tpetra_data->matrix->getDomainMap()));
-    RCP<VEC> tpetra_b = rcp(new VEC(tpetra_data->matrix->getRangeMap()));
-
-    for (size_t i = 0; i < tpetra_x->getLocalLength(); i++) {
-      tpetra_x->replaceGlobalValue(matrix->global_ids[i], x_[i]);
-    }
-    for (size_t i = 0; i < tpetra_b->getLocalLength(); i++) {
-      tpetra_b->replaceGlobalValue(matrix->global_ids[i], b_[i]);
-    }
+    g_tpetra_load_solve_vectors(matrix, &x_, &b_, 1);
+    RCP<MV> tpetra_x = tpetra_data->x_vec;
+    RCP<MV> tpetra_b = tpetra_data->b_vec;
 
     if (solver_data->solver.is_null()) {
       Teuchos::RCP<MAT> crs_matrix = Teuchos::rcp_dynamic_cast<MAT>(tpetra_data->matrix);
@@ -94,12 +88,7 @@ int amesos2_solve(struct GomaLinearSolverData *ams,
     Teuchos::RCP<Teuchos::FancyOStream> outstream = Teuchos::VerboseObjectBase::getDefaultOStream();
 
     /* Convert solution vector */
-    int NumMyRows = matrix->n_rows;
-
-    auto x_data = tpetra_x->getData();
-    for (int i = 0; i < NumMyRows; i++) {
-      x_[i] = x_data[i];
-    }
+    g_tpetra_store_solution(matrix, &x_, 1);
     tpetra_data->matrix->beginAssembly();
   }
   TEUCHOS_STANDARD_CATCH_STATEMENTS(verbose, std::cerr, success)
@@ -58,6 +58,7 @@
 #include "Epetra_CrsMatrix.h"
 #include "Epetra_LinearProblem.h"
 #include "Epetra_Map.h"
+#include "Epetra_MultiVector.h"
 #include "Epetra_Vector.h"
 #include "Trilinos_Util.h"
 #include "linalg/sparse_matrix.h"
@@ -65,12 +66,41 @@
 #include "sl_util_structs.h"
 
 static void GomaMsr2EpetraCsr(struct GomaLinearSolverData *ams, Epetra_CrsMatrix *A, int newmatrix);
+static void amesos_solve_block(char *choice,
+                               struct GomaLinearSolverData *ams,
+                               double **x_,
+                               double **b_,
+                               int nrhs,
+                               int imtrx);
+
 void amesos_solve(char *choice,
                   struct GomaLinearSolverData *ams,
                   double *x_,
                   double *b_,
                   int NewMatrix,
                   int imtrx) {
+  amesos_solve_block(choice, ams, &x_, &b_, 1, imtrx);
+}
+
+/*
+ * Solve A X = B for nrhs right hand sides with a single numeric
+ * factorization, x_[k] and b_[k] are the k-th solution and rhs
+ */
+void amesos_solve_multi(char *choice,
+                        struct GomaLinearSolverData *ams,
+                        double **x_,
+                        double **b_,
+                        int nrhs,
+                        int imtrx) {
+  amesos_solve_block(choice, ams, x_, b_, nrhs, imtrx);
+}
+
+static void amesos_solve_block(char *choice,
+                               struct GomaLinearSolverData *ams,
+                               double **x_,
+                               double **b_,
+                               int nrhs,
+                               int imtrx) {
 
   /* Initialize MPI communications */
 #ifdef EPETRA_MPI
@@ -99,8 +129,8 @@ void amesos_solve(char *choice,
     A[imtrx] = dynamic_cast<Epetra_CrsMatrix *>(epetra_matrix->matrix.get());
   }
   const Epetra_Map &map = A[imtrx]->RowMatrixRowMap();
-  Epetra_Vector x(Copy, map, x_);
-  Epetra_Vector b(Copy, map, b_);
+  Epetra_MultiVector x(Copy, map, x_, nrhs);
+  Epetra_MultiVector b(Copy, map, b_, nrhs);
 
 #if 0
   EpetraExt::RowMatrixToMatrixMarketFile("Jep.mm", *A[imtrx]);
@@ -167,10 +197,12 @@ void amesos_solve(char *choice,
   A_Base[imtrx]->NumericFactorization();
   A_Base[imtrx]->Solve();
 
-  /* Convert solution vector */
+  /* Convert solution vectors */
   int NumMyRows = map.NumMyElements();
-  for (int i = 0; i < NumMyRows; i++) {
-    x_[i] = x[i];
+  for (int k = 0; k < nrhs; k++) {
+    for (int i = 0; i < NumMyRows; i++) {
+      x_[k][i] = x[k][i];
+    }
   }
 
   /* Cleanup problem */
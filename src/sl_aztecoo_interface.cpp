@@ -66,7 +66,7 @@ void aztecoo_solve_epetra(struct GomaLinearSolverData *ams, double *x_, double *
   Epetra_LinearProblem Problem;
 
   Epetra_Map map = A->RowMatrixRowMap();
-  Epetra_Vector x(Copy, map, x_);
+  Epetra_Vector x(View, map, x_); /* the solution is written straight into x_ */
   Epetra_Vector b(Copy, map, b_);
 
   /* Assemble linear problem */
@@ -86,12 +86,6 @@ void aztecoo_solve_epetra(struct GomaLinearSolverData *ams, double *x_, double *
   /* Solve problem */
   solver.Iterate(max_iterations, tolerance);
   solver.GetAllAztecStatus(ams->status);
-
-  /* Convert solution vector */
-  int NumMyRows = map.NumMyElements();
-  for (int i = 0; i < NumMyRows; i++) {
-    x_[i] = x[i];
-  }
 }
 
 } /* extern "C" */
@@ -29,6 +29,7 @@
 #include <Thyra_LinearOpWithSolveBase_decl.hpp>
 #include <Thyra_LinearOpWithSolveFactoryBase_decl.hpp>
 #include <Thyra_LinearOpWithSolveFactoryHelpers.hpp>
+#include <Thyra_MultiVectorBase.hpp>
 #include <Thyra_OperatorVectorTypes.hpp>
 #include <Thyra_SolveSupportTypes.hpp>
 #include <Thyra_VectorBase.hpp>
@@ -39,6 +40,7 @@
 
 #ifdef GOMA_ENABLE_TPETRA
 #include <Thyra_TpetraLinearOp.hpp>
+#include <Thyra_TpetraMultiVector.hpp>
 #include <Thyra_TpetraThyraWrappers.hpp>
 #include <Thyra_TpetraVector.hpp>
 #include <linalg/sparse_matrix_tpetra.h>
@@ -49,7 +51,17 @@
 
 #ifdef GOMA_ENABLE_TEKO
 // Teko-Package includes
+#include <Epetra_Import.h>
+#include <Epetra_IntVector.h>
+#include <Teko_BlockedEpetraOperator.hpp>
+#include <Teko_EpetraBlockPreconditioner.hpp>
+#include <Teko_InverseLibrary.hpp>
+#include <Teko_PreconditionerInverseFactory.hpp>
+#include <Teko_RequestCallback.hpp>
+#include <Teko_RequestHandler.hpp>
 #include <Teko_StratimikosFactory.hpp>
+#include <Thyra_DefaultPreconditioner.hpp>
+#include <vector>
 #endif
 
 #ifdef HAVE_MPI
@@ -59,24 +71,143 @@
 
 #include "sl_stratimikos_interface.h"
 #include <Epetra_Map.h>
+#include <Epetra_MultiVector.h>
 #include <Epetra_RowMatrix.h>
 #include <Epetra_Vector.h>
 #include <linalg/sparse_matrix.h>
 #include <linalg/sparse_matrix_epetra.h>
 extern "C" {
 #include <sl_util_structs.h>
+#define DISABLE_CPP
+#include "rf_solver.h"
+#ifdef GOMA_ENABLE_TEKO
+#include "dpi.h"
+#include "exo_struct.h"
+#include "mm_as.h"
+#include "rf_fem.h"
+#include "sl_teko_blocks.h"
+#endif
+#undef DISABLE_CPP
 }
 
+#ifdef GOMA_ENABLE_TEKO
+/*
+ * Supplies the auxiliary pressure operators Teko's Schur complement
+ * approximations ask for (pressure mass matrix, pressure Laplacian and
+ * the PCD convection-diffusion operator).  They are assembled by Goma
+ * on the pressure dofs and renumbered into the contiguous pressure
+ * block numbering Teko's blocked Epetra operators use.
+ */
+class GomaPressureOperators : public Teko::RequestCallback<Teko::LinearOp> {
+public:
+  GomaPressureOperators(GomaSparseMatrix matrix,
+                        const std::vector<int> &pressure_gids,
+                        const Epetra_Comm &comm) {
+    int n_p = static_cast<int>(pressure_gids.size());
+    Epetra_Map gid_map(-1, n_p, pressure_gids.data(), 0, comm);
+    contig_map_ = Teuchos::rcp(new Epetra_Map(-1, n_p, 0, comm));
+
+    Epetra_IntVector owned_contig(gid_map);
+    for (int k = 0; k < n_p; k++) {
+      owned_contig[k] = contig_map_->GID(k);
+    }
+
+    // Pressure dofs this processor sees, owned or external
+    std::vector<int> col_dofs, col_gids;
+    for (int dof = 0; dof < matrix->n_cols; dof++) {
+      if (idv[pg->imtrx][dof][0] == PRESSURE) {
+        col_dofs.push_back(dof);
+        col_gids.push_back(static_cast<int>(matrix->global_ids[dof]));
+      }
+    }
+    Epetra_Map col_map(-1, static_cast<int>(col_gids.size()), col_gids.data(), 0, comm);
+    Epetra_IntVector col_contig(col_map);
+    Epetra_Import importer(col_map, gid_map);
+    col_contig.Import(owned_contig, importer, Insert);
+
+    dof_to_contig_.assign(matrix->n_cols, -1);
+    for (size_t k = 0; k < col_dofs.size(); k++) {
+      dof_to_contig_[col_dofs[k]] = col_contig[static_cast<int>(k)];
+    }
+
+    ops_ = Pressure_Aux_Operators{};
+  }
+
+  ~GomaPressureOperators() { free_pressure_aux_operators(&ops_); }
+
+  // Rebuild the operators from the current solution
+  void assemble() {
+    goma_error err = assemble_pressure_aux_operators(
+        &ops_, EXO_ptr, DPI_ptr, pg->matrices[pg->imtrx].x, pg->matrices[pg->imtrx].x_old,
+        pg->matrices[pg->imtrx].xdot, pg->matrices[pg->imtrx].xdot_old);
+    GOMA_EH(err, "assemble_pressure_aux_operators");
+
+    Mp_ = Teuchos::rcp(new Epetra_CrsMatrix(Copy, *contig_map_, 0));
+    Ap_ = Teuchos::rcp(new Epetra_CrsMatrix(Copy, *contig_map_, 0));
+    Fp_ = Teuchos::rcp(new Epetra_CrsMatrix(Copy, *contig_map_, 0));
+    // Repeated entries are summed by FillComplete
+    for (int k = 0; k < ops_.nnz; k++) {
+      int row = dof_to_contig_[ops_.row[k]];
+      int col = dof_to_contig_[ops_.col[k]];
+      Mp_->InsertGlobalValues(row, 1, &ops_.Mp[k], &col);
+      Ap_->InsertGlobalValues(row, 1, &ops_.Ap[k], &col);
+      Fp_->InsertGlobalValues(row, 1, &ops_.Fp[k], &col);
+    }
+    Mp_->FillComplete();
+    Ap_->FillComplete();
+    Fp_->FillComplete();
+  }
+
+  bool handlesRequest(const Teko::RequestMesg &rm) override {
+    const std::string &name = rm.getName();
+    return name == "Pressure Mass Matrix" || name == "Pressure Laplace Operator" ||
+           name == "Laplace Operator" || name == "PCD Operator";
+  }
+
+  Teko::LinearOp request(const Teko::RequestMesg &rm) override {
+    const std::string &name = rm.getName();
+    if (name == "Pressure Mass Matrix") {
+      return Thyra::epetraLinearOp(Mp_);
+    } else if (name == "PCD Operator") {
+      return Thyra::epetraLinearOp(Fp_);
+    }
+    return Thyra::epetraLinearOp(Ap_);
+  }
+
+  void preRequest(const Teko::RequestMesg &rm) override {}
+
+private:
+  Teuchos::RCP<Epetra_Map> contig_map_;
+  std::vector<int> dof_to_contig_;
+  Pressure_Aux_Operators ops_;
+  Teuchos::RCP<Epetra_CrsMatrix> Mp_, Ap_, Fp_;
+};
+#endif
+
 struct Stratimikos_Solver_Data {
   Teuchos::RCP<Thyra::LinearOpWithSolveBase<double>> solver;
   Teuchos::RCP<Teuchos::ParameterList> solverParams;
   Teuchos::RCP<Thyra::LinearOpWithSolveFactoryBase<double>> solverFactory;
   Teuchos::RCP<const Thyra::LinearOpBase<double>> A;
+  // Kept between solves unless Stratimikos Preconditioner Reuse = REBUILD
+  Teuchos::RCP<Stratimikos::DefaultLinearSolverBuilder> solverBuilder;
+  int solvesSinceSetup; // solves with the current preconditioner values
+#ifdef GOMA_ENABLE_TEKO
+  // Field block preconditioning, built once per matrix
+  Teuchos::RCP<Teuchos::ParameterList> tekoLibrary;
+  Teuchos::RCP<Teko::InverseLibrary> tekoInverseLibrary;
+  Teuchos::RCP<Teko::Epetra::BlockedEpetraOperator> tekoBlockedA;
+  Teuchos::RCP<GomaPressureOperators> tekoPressureOps;
+  Teuchos::RCP<Teko::Epetra::EpetraBlockPreconditioner> tekoPrec;
+  std::string tekoInverseName;
+#endif
 
   Stratimikos_Solver_Data() {
     solver = Teuchos::null;
     solverParams = Teuchos::null;
     solverFactory = Teuchos::null;
+    solverBuilder = Teuchos::null;
+    solvesSinceSetup = 0;
   }
 };
 
@@ -96,68 +227,285 @@ static std::string get_file_extension(const std::string &filename) {
 extern "C" void stratimikos_solver_destroy(struct GomaLinearSolverData *ams) {
   auto solver_data = static_cast<Stratimikos_Solver_Data *>(ams->SolverData);
   solver_data->solver = Teuchos::null;
+  solver_data->solverFactory = Teuchos::null;
+  solver_data->solverBuilder = Teuchos::null;
   solver_data->solverParams = Teuchos::null;
   delete solver_data;
 }
 
 using Teuchos::RCP;
 
+/*
+ * True when the next solve keeps the preconditioner of an earlier solve
+ * as is (Stratimikos Preconditioner Reuse = KEEP)
+ */
+static bool stratimikos_keep_preconditioner(const Stratimikos_Solver_Data *solver_data) {
+  return Stratimikos_Prec_Reuse == PREC_REUSE_KEEP && !solver_data->solver.is_null() &&
+         solver_data->solvesSinceSetup < Stratimikos_Prec_Reuse_Max_Solves;
+}
+
+/*
+ * Readies solver_data->solver for a solve with A.
+ *
+ * With REBUILD (the default) the builder, factory and solver are created
+ * from scratch every solve.  Otherwise they are created for the first
+ * solve and kept: REFRESH re-initializes the existing solver, so the
+ * preconditioner factories recompute values on their existing
+ * preconditioner objects (Ifpack keeps its graph, MueLu follows its
+ * "reuse: type" parameter), and KEEP additionally leaves the
+ * preconditioner itself untouched for Stratimikos_Prec_Reuse_Max_Solves
+ * solves before refreshing it.
+ */
 static void stratimikos_solve_setup(RCP<const Thyra::LinearOpBase<double>> A,
                                     Stratimikos_Solver_Data *solver_data,
                                     std::string stratimikos_file,
-                                    bool echo_params) {
-
-  // Set up solver (only once per matrix)
-  // if (solver_data->solver.is_null()) {
-  // Setting up only once per matrix seems to cause issues with Belos solves
-  // Maybe missing a bug or logic reasoning as to why.
-  // For now just resetup the solver every iteration.
+                                    bool echo_params,
+                                    RCP<const Thyra::LinearOpBase<double>> prec = Teuchos::null) {
 
-  RCP<Teuchos::ParameterList> solverParams = solver_data->solverParams;
+  if (Stratimikos_Prec_Reuse == PREC_REUSE_REBUILD || solver_data->solverFactory.is_null()) {
+    RCP<Teuchos::ParameterList> solverParams = solver_data->solverParams;
 
-  // Set up base builder
-  Stratimikos::DefaultLinearSolverBuilder linearSolverBuilder;
+    // Set up base builder
+    RCP<Stratimikos::DefaultLinearSolverBuilder> linearSolverBuilder =
+        Teuchos::rcp(new Stratimikos::DefaultLinearSolverBuilder());
 
-  Stratimikos::enableMueLu(linearSolverBuilder);
+    Stratimikos::enableMueLu(*linearSolverBuilder);
 
 #ifdef GOMA_ENABLE_TEKO
-  Teko::addTekoToStratimikosBuilder(linearSolverBuilder);
+    Teko::addTekoToStratimikosBuilder(*linearSolverBuilder);
 #endif
 
-  linearSolverBuilder.setParameterList(solverParams);
+    linearSolverBuilder->setParameterList(solverParams);
 
-  // auto valid_params = linearSolverBuilder.getValidParameters();
-  // Teuchos::writeParameterListToYamlFile(*valid_params, "valid_params.yaml");
+    // auto valid_params = linearSolverBuilder->getValidParameters();
+    // Teuchos::writeParameterListToYamlFile(*valid_params, "valid_params.yaml");
 
-  // set up solver factory using base/params
-  RCP<Thyra::LinearOpWithSolveFactoryBase<double>> solverFactory =
-      linearSolverBuilder.createLinearSolveStrategy("");
-  solver_data->solverFactory = solverFactory;
-  // set solver verbosity
-  // solverFactory->setDefaultVerbLevel(Teuchos::VERB_LOW);
-  // solverFactory->setParameterList(solverParams);
+    // set up solver factory using base/params
+    RCP<Thyra::LinearOpWithSolveFactoryBase<double>> solverFactory =
+        linearSolverBuilder->createLinearSolveStrategy("");
+    solver_data->solverBuilder = linearSolverBuilder;
+    solver_data->solverFactory = solverFactory;
+    // set solver verbosity
+    // solverFactory->setDefaultVerbLevel(Teuchos::VERB_LOW);
+    // solverFactory->setParameterList(solverParams);
 
-  if (echo_params) {
-    std::string echo_file(stratimikos_file);
-    echo_file = "echo_" + echo_file;
-    linearSolverBuilder.writeParamsFile(*solverFactory, echo_file);
+    if (echo_params) {
+      std::string echo_file(stratimikos_file);
+      echo_file = "echo_" + echo_file;
+      linearSolverBuilder->writeParamsFile(*solverFactory, echo_file);
 #ifdef GOMA_STRATIMIKOS_WRITE_VALID_PARAMS
-    if (imtrx == 0) {
-      auto valid_params = linearSolverBuilder.getValidParameters();
-      Teuchos::writeParameterListToYamlFile(*valid_params, "stratimikos_valid_params.yaml");
-    }
+      if (imtrx == 0) {
+        auto valid_params = linearSolverBuilder->getValidParameters();
+        Teuchos::writeParameterListToYamlFile(*valid_params, "stratimikos_valid_params.yaml");
+      }
 #endif
+    }
+
+    Teuchos::RCP<Teuchos::FancyOStream> outstream =
+        Teuchos::VerboseObjectBase::getDefaultOStream();
+    // set output stream
+    solverFactory->setOStream(outstream);
+
+    solver_data->solver = solverFactory->createOp();
+  } else if (stratimikos_keep_preconditioner(solver_data)) {
+    solver_data->solvesSinceSetup++;
+    if (prec.is_null()) {
+      Thyra::initializeAndReuseOp(*(solver_data->solverFactory), A, solver_data->solver.ptr());
+    } else {
+      // An external (Teko) preconditioner is kept by its builder
+      Thyra::initializePreconditionedOp<double>(*(solver_data->solverFactory), A,
+                                                Thyra::unspecifiedPrec(prec),
+                                                solver_data->solver.ptr());
+    }
+    return;
+  }
+
+  solver_data->solvesSinceSetup = 1;
+  if (prec.is_null()) {
+    Thyra::initializeOp(*(solver_data->solverFactory), A, solver_data->solver.ptr());
+  } else {
+    Thyra::initializePreconditionedOp<double>(*(solver_data->solverFactory), A,
+                                              Thyra::unspecifiedPrec(prec),
+                                              solver_data->solver.ptr());
+  }
+}
+
+/*
+ * Releases the operator after a solve, unless the solver is kept for the
+ * next one
+ */
+static void stratimikos_solve_finish(Stratimikos_Solver_Data *solver_data) {
+  if (Stratimikos_Prec_Reuse == PREC_REUSE_REBUILD) {
+    Thyra::uninitializeOp(*(solver_data->solverFactory), solver_data->solver.ptr());
+  }
+}
+
+static void stratimikos_read_params(Stratimikos_Solver_Data *solver_data,
+                                    const std::string &stratimikos_file) {
+  if (solver_data->solverParams.is_null()) {
+    if (get_file_extension(stratimikos_file) == "yaml") {
+      solver_data->solverParams = Teuchos::getParametersFromYamlFile(stratimikos_file);
+    } else {
+      solver_data->solverParams = Teuchos::getParametersFromXmlFile(stratimikos_file);
+    }
   }
+}
 
-  Teuchos::RCP<Teuchos::FancyOStream> outstream = Teuchos::VerboseObjectBase::getDefaultOStream();
-  // set output stream
-  solverFactory->setOStream(outstream);
+#ifdef GOMA_ENABLE_TEKO
+/*
+ * Built-in Teko inverses for the Teko Block Preconditioner card.  Every
+ * diagonal (or Schur complement) solve uses the Teko Block Inverse type;
+ * entries of a "Teko Inverse Library" sublist in the Stratimikos file
+ * override these or add new ones.
+ */
+static RCP<Teuchos::ParameterList> teko_builtin_library(const std::string &sub_inverse) {
+  RCP<Teuchos::ParameterList> lib =
+      Teuchos::rcp(new Teuchos::ParameterList("Teko Inverse Library"));
+
+  Teuchos::ParameterList &jacobi = lib->sublist("Goma Block Jacobi");
+  jacobi.set("Type", "Block Jacobi");
+  jacobi.set("Inverse Type", sub_inverse);
+
+  Teuchos::ParameterList &triangular = lib->sublist("Goma Block Triangular");
+  triangular.set("Type", "Block Gauss-Seidel");
+  triangular.set("Use Upper Triangle", true);
+  triangular.set("Inverse Type", sub_inverse);
+
+  Teuchos::ParameterList &lsc = lib->sublist("Goma LSC");
+  lsc.set("Type", "NS LSC");
+  lsc.set("Strategy Name", "Basic Inverse");
+  lsc.sublist("Strategy Settings").set("Inverse Velocity Type", sub_inverse);
+  lsc.sublist("Strategy Settings").set("Inverse Pressure Type", sub_inverse);
+
+  Teuchos::ParameterList &pcd = lib->sublist("Goma PCD");
+  pcd.set("Type", "Block LU2x2");
+  pcd.set("Inverse A00 Type", sub_inverse);
+  pcd.set("Strategy Name", "NS PCD Strategy");
+  pcd.sublist("Strategy Settings").set("Inverse F Type", sub_inverse);
+  pcd.sublist("Strategy Settings").set("Inverse Laplace Type", sub_inverse);
+  pcd.sublist("Strategy Settings").set("Inverse Mass Type", sub_inverse);
+
+  return lib;
+}
 
-  solver_data->solver = solverFactory->createOp();
-  Thyra::initializeOp(*(solver_data->solverFactory), A, solver_data->solver.ptr());
-  // } else {
-  //   Thyra::initializeAndReuseOp(*(solver_data->solverFactory), A, solver_data->solver.ptr());
-  // }
+/* Schur complement preconditioners that need the 2x2 velocity/pressure split */
+static bool teko_is_saddle_point(const Teuchos::ParameterList &lib, const std::string &name) {
+  if (!lib.isSublist(name))
+    return false;
+  std::string type = lib.sublist(name).get<std::string>("Type", "");
+  return type == "NS LSC" || type == "NS SIMPLE" || type == "Block LU2x2";
+}
+
+/*
+ * Build (first call) or rebuild the Teko block preconditioner for the
+ * current Epetra matrix.  The blocked operator, inverse library and
+ * pressure operator callback are set up once per matrix; the operator
+ * values and the preconditioner itself are refreshed every solve unless
+ * the Stratimikos Preconditioner Reuse card keeps the last one.
+ */
+static RCP<const Thyra::LinearOpBase<double>>
+teko_block_preconditioner(Stratimikos_Solver_Data *solver_data,
+                          GomaSparseMatrix matrix,
+                          RCP<Epetra_CrsMatrix> epetra_A) {
+  if (Teko_Block_Preconditioner == TEKO_BLOCK_NONE) {
+    return Teuchos::null;
+  }
+
+  if (solver_data->tekoBlockedA.is_null()) {
+    RCP<Teuchos::ParameterList> lib = teko_builtin_library(Teko_Block_Inverse);
+    if (solver_data->solverParams->isSublist("Teko Inverse Library")) {
+      // Stratimikos validates its parameters, so the library is taken out of them
+      lib->setParameters(solver_data->solverParams->sublist("Teko Inverse Library"));
+      solver_data->solverParams->remove("Teko Inverse Library");
+    }
+    solver_data->tekoLibrary = lib;
+
+    switch (Teko_Block_Preconditioner) {
+    case TEKO_BLOCK_JACOBI:
+      solver_data->tekoInverseName = "Goma Block Jacobi";
+      break;
+    case TEKO_BLOCK_TRIANGULAR:
+      solver_data->tekoInverseName = "Goma Block Triangular";
+      break;
+    case TEKO_BLOCK_LSC:
+      solver_data->tekoInverseName = "Goma LSC";
+      break;
+    case TEKO_BLOCK_PCD:
+      solver_data->tekoInverseName = "Goma PCD";
+      break;
+    default:
+      solver_data->tekoInverseName = Teko_Block_Preconditioner_Name;
+      break;
+    }
+    if (!lib->isSublist(solver_data->tekoInverseName)) {
+      GOMA_EH(GOMA_ERROR, "Teko inverse \"%s\" not found in the Teko Inverse Library",
+              solver_data->tekoInverseName.c_str());
+    }
+    bool saddle_point = teko_is_saddle_point(*lib, solver_data->tekoInverseName);
+
+    // Field blocks as lists of global ids
+    std::vector<int> row_block(matrix->n_rows > 0 ? matrix->n_rows : 1);
+    int block_type[GOMA_NUM_FIELD_BLOCKS];
+    int num_blocks = goma_field_blocks(pg->imtrx, matrix->n_rows, saddle_point, row_block.data(),
+                                       block_type);
+    std::vector<std::vector<int>> block_gids(num_blocks);
+    for (int i = 0; i < matrix->n_rows; i++) {
+      block_gids[row_block[i]].push_back(static_cast<int>(matrix->global_ids[i]));
+    }
+    solver_data->tekoBlockedA =
+        Teuchos::rcp(new Teko::Epetra::BlockedEpetraOperator(block_gids, epetra_A));
+
+    solver_data->tekoInverseLibrary = Teko::InverseLibrary::buildFromParameterList(*lib);
+    if (saddle_point) {
+      int p_block = 0;
+      while (block_type[p_block] != GOMA_FIELD_BLOCK_PRESSURE)
+        p_block++;
+      solver_data->tekoPressureOps = Teuchos::rcp(
+          new GomaPressureOperators(matrix, block_gids[p_block], epetra_A->Comm()));
+      RCP<Teko::RequestHandler> handler = Teuchos::rcp(new Teko::RequestHandler());
+      handler->addRequestCallback(solver_data->tekoPressureOps);
+      solver_data->tekoInverseLibrary->setRequestHandler(handler);
+    }
+
+    RCP<Teko::PreconditionerInverseFactory> inverse =
+        Teuchos::rcp_dynamic_cast<Teko::PreconditionerInverseFactory>(
+            solver_data->tekoInverseLibrary->getInverseFactory(solver_data->tekoInverseName));
+    if (inverse.is_null()) {
+      GOMA_EH(GOMA_ERROR, "Teko inverse \"%s\" is not a block preconditioner",
+              solver_data->tekoInverseName.c_str());
+    }
+    solver_data->tekoPrec =
+        Teuchos::rcp(new Teko::Epetra::EpetraBlockPreconditioner(inverse->getPrecFactory()));
+  } else if (stratimikos_keep_preconditioner(solver_data)) {
+    return Thyra::epetraLinearOp(solver_data->tekoPrec, Thyra::NOTRANS,
+                                 Thyra::EPETRA_OP_APPLY_APPLY_INVERSE,
+                                 Thyra::EPETRA_OP_ADJOINT_UNSUPPORTED, solver_data->A->range(),
+                                 solver_data->A->domain());
+  } else {
+    solver_data->tekoBlockedA->RebuildOps();
+  }
+
+  if (!solver_data->tekoPressureOps.is_null()) {
+    solver_data->tekoPressureOps->assemble();
+  }
+  solver_data->tekoPrec->buildPreconditioner(solver_data->tekoBlockedA);
+
+  return Thyra::epetraLinearOp(solver_data->tekoPrec, Thyra::NOTRANS,
+                               Thyra::EPETRA_OP_APPLY_APPLY_INVERSE,
+                               Thyra::EPETRA_OP_ADJOINT_UNSUPPORTED, solver_data->A->range(),
+                               solver_data->A->domain());
+}
+#endif
+
+static int stratimikos_iteration_count(const Thyra::SolveStatus<double> &status) {
+  int iterations = 1;
+  if (!status.extraParameters.is_null()) {
+    try {
+      iterations = status.extraParameters.get()->get<int>("Iteration Count");
+    } catch (const Teuchos::Exceptions::InvalidParameter &excpt) {
+    }
+  }
+  return iterations;
 }
 
 extern "C" {
@@ -187,17 +535,9 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
       tpetra_data->matrix->endAssembly();
     }
 
-    RCP<Tpetra::Vector<double, LO, GO>> tpetra_x =
-        rcp(new Tpetra::Vector<double, LO, GO>(tpetra_A->getDomainMap()));
-    RCP<Tpetra::Vector<double, LO, GO>> tpetra_b =
-        rcp(new Tpetra::Vector<double, LO, GO>(tpetra_A->getRangeMap()));
-
-    for (size_t i = 0; i < tpetra_x->getLocalLength(); i++) {
-      tpetra_x->replaceGlobalValue(matrix->global_ids[i], x_[i]);
-    }
-    for (size_t i = 0; i < tpetra_b->getLocalLength(); i++) {
-      tpetra_b->replaceGlobalValue(matrix->global_ids[i], b_[i]);
-    }
+    g_tpetra_load_solve_vectors(matrix, &x_, &b_, 1);
+    RCP<Tpetra::Vector<double, LO, GO>> tpetra_x = tpetra_data->x_vec->getVectorNonConst(0);
+    RCP<Tpetra::Vector<double, LO, GO>> tpetra_b = tpetra_data->b_vec->getVectorNonConst(0);
 #if 0
     Tpetra::MatrixMarket::Writer<Tpetra::CrsMatrix<double, LO, GO>>::writeSparseFile("A.mm",
                                                                                      tpetra_A);
@@ -223,6 +563,14 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
       }
     }
 
+#ifdef GOMA_ENABLE_TEKO
+    static bool teko_warned = false;
+    if (Teko_Block_Preconditioner != TEKO_BLOCK_NONE && !teko_warned) {
+      GOMA_WH(-1, "Teko Block Preconditioner is only supported with epetra matrices, "
+                  "using the Stratimikos file preconditioner");
+      teko_warned = true;
+    }
+#endif
     stratimikos_solve_setup(solver_data->A, solver_data, stratimikos_file[imtrx],
                             param_echo[imtrx]);
     param_echo[imtrx] = false;
@@ -239,14 +587,72 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
     }
 
     /* Convert solution vector */
-    int NumMyRows = matrix->n_rows;
+    x = Teuchos::null;
+    g_tpetra_store_solution(matrix, &x_, 1);
+    stratimikos_solve_finish(solver_data);
+  }
+  TEUCHOS_STANDARD_CATCH_STATEMENTS(verbose, std::cerr, success)
+  tpetra_data->matrix->beginAssembly();
 
-    auto x_data = tpetra_x->getData();
-    for (int i = 0; i < NumMyRows; i++) {
-      x_[i] = x_data[i];
+  if (success) {
+    return 0;
+  } else {
+    return -1;
+  }
+}
+
+/*
+ * Solve A X = B for nrhs right hand sides at once, x_[k] and b_[k] are the
+ * k-th solution and rhs. The preconditioner is built once for the block and
+ * block Krylov methods (e.g. Belos "Block GMRES") share a single Krylov space
+ * across the right hand sides.
+ */
+int stratimikos_solve_tpetra_multi(struct GomaLinearSolverData *ams,
+                                   double **x_,
+                                   double **b_,
+                                   int nrhs,
+                                   int *iterations,
+                                   char stratimikos_file[MAX_NUM_MATRICES][MAX_CHAR_IN_INPUT],
+                                   int imtrx) {
+  using Teuchos::RCP;
+  auto matrix = static_cast<GomaSparseMatrix>(ams->GomaMatrixData);
+  auto *tpetra_data = static_cast<TpetraSparseMatrix *>(matrix->data);
+  bool success = true;
+  bool verbose = true;
+
+  if (ams->SolverData == NULL) {
+    ams->SolverData = new Stratimikos_Solver_Data();
+    ams->DestroySolverData = stratimikos_solver_destroy;
+  }
+  auto solver_data = static_cast<Stratimikos_Solver_Data *>(ams->SolverData);
+
+  try {
+    RCP<const Tpetra::FECrsMatrix<double, LO, GO>> tpetra_A = tpetra_data->matrix;
+    if (!tpetra_data->matrix->isFillComplete()) {
+      tpetra_data->matrix->endAssembly();
     }
+
+    g_tpetra_load_solve_vectors(matrix, x_, b_, nrhs);
+    RCP<Tpetra::MultiVector<double, LO, GO>> tpetra_x = tpetra_data->x_vec;
+    RCP<Tpetra::MultiVector<double, LO, GO>> tpetra_b = tpetra_data->b_vec;
+
+    solver_data->A = Thyra::createConstLinearOp(
+        Teuchos::rcp_dynamic_cast<const Tpetra::Operator<double, LO, GO>>(tpetra_A));
+
+    RCP<Thyra::MultiVectorBase<double>> x = Thyra::createMultiVector(tpetra_x);
+    RCP<const Thyra::MultiVectorBase<double>> b = Thyra::createMultiVector(tpetra_b);
+
+    stratimikos_read_params(solver_data, stratimikos_file[imtrx]);
+    stratimikos_solve_setup(solver_data->A, solver_data, stratimikos_file[imtrx], false);
+
+    Thyra::SolveStatus<double> status =
+        Thyra::solve<double>(*(solver_data->solver), Thyra::NOTRANS, *b, x.ptr());
+    *iterations = stratimikos_iteration_count(status);
+
+    /* Convert solution vectors */
     x = Teuchos::null;
-    Thyra::uninitializeOp(*(solver_data->solverFactory), solver_data->solver.ptr());
+    g_tpetra_store_solution(matrix, x_, nrhs);
+    stratimikos_solve_finish(solver_data);
   }
   TEUCHOS_STANDARD_CATCH_STATEMENTS(verbose, std::cerr, success)
   tpetra_data->matrix->beginAssembly();
@@ -267,6 +673,17 @@ int stratimikos_solve_tpetra(struct GomaLinearSolverData *ams,
   GOMA_EH(GOMA_ERROR, "Not built with Tpetra Stratimikos support!");
   return -1;
 }
+
+int stratimikos_solve_tpetra_multi(struct GomaLinearSolverData *ams,
+                                   double **x_,
+                                   double **b_,
+                                   int nrhs,
+                                   int *iterations,
+                                   char stratimikos_file[MAX_NUM_MATRICES][MAX_CHAR_IN_INPUT],
+                                   int imtrx) {
+  GOMA_EH(GOMA_ERROR, "Not built with Tpetra Stratimikos support!");
+  return -1;
+}
 #endif /* GOMA_ENABLE_TPETRA */
 
 int stratimikos_solve(struct GomaLinearSolverData *ams,
@@ -293,7 +710,8 @@ int stratimikos_solve(struct GomaLinearSolverData *ams,
 
     // Assign A with false so it doesn't get garbage collected.
     RCP<Epetra_CrsMatrix> epetra_A = epetra_matrix->matrix;
-    RCP<Epetra_Vector> epetra_x = Teuchos::rcp(new Epetra_Vector(Copy, map, x_));
+    // The solution is written straight into x_, which matches the row map layout
+    RCP<Epetra_Vector> epetra_x = Teuchos::rcp(new Epetra_Vector(View, map, x_));
     RCP<Epetra_Vector> epetra_b = Teuchos::rcp(new Epetra_Vector(Copy, map, b_));
 
     solver_data->A = Thyra::epetraLinearOp(epetra_A);
@@ -315,8 +733,13 @@ int stratimikos_solve(struct GomaLinearSolverData *ams,
       }
     }
 
+    RCP<const Thyra::LinearOpBase<double>> prec = Teuchos::null;
+#ifdef GOMA_ENABLE_TEKO
+    prec = teko_block_preconditioner(solver_data, matrix, epetra_A);
+#endif
+
     stratimikos_solve_setup(solver_data->A, solver_data, stratimikos_file[imtrx],
-                            param_echo[imtrx]);
+                            param_echo[imtrx], prec);
     param_echo[imtrx] = true;
 
     Thyra::SolveStatus<double> status =
@@ -331,14 +754,62 @@ int stratimikos_solve(struct GomaLinearSolverData *ams,
       } catch (const Teuchos::Exceptions::InvalidParameter &excpt) {
       }
     }
+  }
+  TEUCHOS_STANDARD_CATCH_STATEMENTS(verbose, std::cerr, success)
 
-    /* Convert solution vector */
-    int NumMyRows = map.NumMyElements();
+  if (success) {
+    return 0;
+  } else {
+    return -1;
+  }
+}
 
-    Epetra_Vector *raw_x = epetra_x.get();
-    for (int i = 0; i < NumMyRows; i++) {
-      x_[i] = (*raw_x)[i];
-    }
+/*
+ * Epetra version of stratimikos_solve_tpetra_multi
+ */
+int stratimikos_solve_multi(struct GomaLinearSolverData *ams,
+                            double **x_,
+                            double **b_,
+                            int nrhs,
+                            int *iterations,
+                            char stratimikos_file[MAX_NUM_MATRICES][MAX_CHAR_IN_INPUT],
+                            int imtrx) {
+  using Teuchos::RCP;
+  bool success = true;
+  bool verbose = true;
+
+  GomaSparseMatrix matrix = (GomaSparseMatrix)ams->GomaMatrixData;
+  EpetraSparseMatrix *epetra_matrix = static_cast<EpetraSparseMatrix *>(matrix->data);
+
+  if (ams->SolverData == NULL) {
+    ams->SolverData = new Stratimikos_Solver_Data();
+    ams->DestroySolverData = stratimikos_solver_destroy;
+  }
+  auto solver_data = static_cast<Stratimikos_Solver_Data *>(ams->SolverData);
+  try {
+    Epetra_Map map = epetra_matrix->matrix->RowMatrixRowMap();
+
+    RCP<Epetra_CrsMatrix> epetra_A = epetra_matrix->matrix;
+    RCP<Epetra_MultiVector> epetra_x = Teuchos::rcp(new Epetra_MultiVector(View, map, x_, nrhs));
+    RCP<Epetra_MultiVector> epetra_b = Teuchos::rcp(new Epetra_MultiVector(Copy, map, b_, nrhs));
+
+    solver_data->A = Thyra::epetraLinearOp(epetra_A);
+    RCP<Thyra::MultiVectorBase<double>> x =
+        Thyra::create_MultiVector(epetra_x, solver_data->A->domain());
+    RCP<const Thyra::MultiVectorBase<double>> b =
+        Thyra::create_MultiVector(epetra_b, solver_data->A->range());
+
+    stratimikos_read_params(solver_data, stratimikos_file[imtrx]);
+    RCP<const Thyra::LinearOpBase<double>> prec = Teuchos::null;
+#ifdef GOMA_ENABLE_TEKO
+    prec = teko_block_preconditioner(solver_data, matrix, epetra_A);
+#endif
+    stratimikos_solve_setup(solver_data->A, solver_data, stratimikos_file[imtrx], false, prec);
+
+    Thyra::SolveStatus<double> status =
+        Thyra::solve<double>(*(solver_data->solver), Thyra::NOTRANS, *b, x.ptr());
+    x = Teuchos::null;
+    *iterations = stratimikos_iteration_count(status);
   }
   TEUCHOS_STANDARD_CATCH_STATEMENTS(verbose, std::cerr, success)
 
@@ -378,5 +849,27 @@ int stratimikos_solve(struct GomaLinearSolverData *ams,
   GOMA_EH(GOMA_ERROR, "Not built with stratimikos support!");
   return -1;
 }
+
+int stratimikos_solve_tpetra_multi(struct GomaLinearSolverData *ams,
+                                   double **x_,
+                                   double **b_,
+                                   int nrhs,
+                                   int *iterations,
+                                   char stratimikos_file[MAX_NUM_MATRICES][MAX_CHAR_IN_INPUT],
+                                   int imtrx) {
+  GOMA_EH(GOMA_ERROR, "Not built with stratimikos support!");
+  return -1;
+}
+
+int stratimikos_solve_multi(struct GomaLinearSolverData *ams,
+                            double **x_,
+                            double **b_,
+                            int nrhs,
+                            int *iterations,
+                            char stratimikos_file[MAX_NUM_MATRICES][MAX_CHAR_IN_INPUT],
+                            int imtrx) {
+  GOMA_EH(GOMA_ERROR, "Not built with stratimikos support!");
+  return -1;
+}
 }
 #endif /* GOMA_ENABLE_STRATIMIKOS */
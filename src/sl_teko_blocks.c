@@ -0,0 +1,272 @@
+/************************************************************************ *
+* Goma - Multiphysics finite element software                             *
+* Sandia National Laboratories                                            *
+*                                                                         *
+* Copyright (c) 2022 Goma Developers, National Technology & Engineering   *
+*               Solutions of Sandia, LLC (NTESS)                          *
+*                                                                         *
+* Under the terms of Contract DE-NA0003525, the U.S. Government retains   *
+* certain rights in this software.                                        *
+*                                                                         *
+* This software is distributed under the GNU General Public License.      *
+* See LICENSE file.                                                       *
+\************************************************************************/
+
+/*
+ * Field block structure of the Goma unknowns and the auxiliary pressure
+ * operators used by Teko's block preconditioners.  These play the role
+ * that get_pressure_velocity_is() and set_pcd_matrices() play for the
+ * PETSc field split path.
+ */
+
+#include <stdlib.h>
+
+#include "density.h"
+#include "dpi.h"
+#include "el_geom.h"
+#include "load_field_variables.h"
+#include "mm_as.h"
+#include "mm_as_const.h"
+#include "mm_fill_aux.h"
+#include "mm_fill_ptrs.h"
+#include "mm_fill_terms.h"
+#include "mm_fill_util.h"
+#include "mm_mp.h"
+#include "mm_viscosity.h"
+#include "rf_allo.h"
+#include "rf_fem.h"
+#include "rf_fem_const.h"
+#include "sl_teko_blocks.h"
+
+/* Which field block a variable type belongs to. */
+int goma_field_block_of_var(const int var) {
+  if ((var >= VELOCITY1 && var <= VELOCITY3) || (var >= PVELOCITY1 && var <= PVELOCITY3))
+    return GOMA_FIELD_BLOCK_VELOCITY;
+  if (var == PRESSURE)
+    return GOMA_FIELD_BLOCK_PRESSURE;
+  if ((var >= MESH_DISPLACEMENT1 && var <= MESH_DISPLACEMENT3) ||
+      (var >= SOLID_DISPLACEMENT1 && var <= SOLID_DISPLACEMENT3))
+    return GOMA_FIELD_BLOCK_MESH;
+  if (var == MASS_FRACTION)
+    return GOMA_FIELD_BLOCK_SPECIES;
+  if ((var >= POLYMER_STRESS11 && var <= POLYMER_STRESS33) ||
+      (var >= VELOCITY_GRADIENT11 && var <= VELOCITY_GRADIENT33) ||
+      (var >= POLYMER_STRESS11_1 && var <= POLYMER_STRESS33_7))
+    return GOMA_FIELD_BLOCK_STRESS;
+  return GOMA_FIELD_BLOCK_OTHER;
+}
+
+/*
+ * Assign each owned row of matrix imtrx to a field block.  Only blocks
+ * whose variables are active in the problem (upd->vp) are kept, so the
+ * block count is the same on every processor even if a processor owns
+ * no rows of some block.  With saddle_point set, everything that is
+ * not pressure is lumped into a single leading block, which is the 2x2
+ * form the LSC and PCD Schur complement approximations expect.
+ *
+ * On return row_block[i] is the block index of row i and block_type[b]
+ * the Goma_Field_Block of block b.  Returns the number of blocks.
+ */
+int goma_field_blocks(const int imtrx,
+                      const int n_rows,
+                      const int saddle_point,
+                      int *row_block,
+                      int block_type[GOMA_NUM_FIELD_BLOCKS]) {
+  int var, b, i, num_blocks = 0;
+  int active[GOMA_NUM_FIELD_BLOCKS];
+  int block_index[GOMA_NUM_FIELD_BLOCKS];
+
+  for (b = 0; b < GOMA_NUM_FIELD_BLOCKS; b++) {
+    active[b] = FALSE;
+    block_index[b] = -1;
+  }
+
+  for (var = V_FIRST; var < V_LAST; var++) {
+    if (upd->vp[imtrx][var] >= 0) {
+      b = goma_field_block_of_var(var);
+      if (saddle_point && b != GOMA_FIELD_BLOCK_PRESSURE)
+        b = GOMA_FIELD_BLOCK_VELOCITY;
+      active[b] = TRUE;
+    }
+  }
+
+  if (saddle_point && !active[GOMA_FIELD_BLOCK_PRESSURE]) {
+    GOMA_EH(GOMA_ERROR, "Saddle point block preconditioner requested without a pressure unknown");
+  }
+
+  for (b = 0; b < GOMA_NUM_FIELD_BLOCKS; b++) {
+    if (active[b]) {
+      block_type[num_blocks] = b;
+      block_index[b] = num_blocks++;
+    }
+  }
+
+  for (i = 0; i < n_rows; i++) {
+    b = goma_field_block_of_var(idv[imtrx][i][0]);
+    if (saddle_point && b != GOMA_FIELD_BLOCK_PRESSURE)
+      b = GOMA_FIELD_BLOCK_VELOCITY;
+    row_block[i] = block_index[b];
+    if (row_block[i] < 0) {
+      GOMA_EH(GOMA_ERROR, "Row %d has variable %d outside the active field blocks", i,
+              idv[imtrx][i][0]);
+    }
+  }
+
+  return num_blocks;
+}
+
+static void pressure_aux_add(struct Pressure_Aux_Operators *ops,
+                             const int row,
+                             const int col,
+                             const double mp,
+                             const double ap,
+                             const double fp) {
+  if (ops->nnz == ops->capacity) {
+    int new_capacity = (ops->capacity > 0) ? 2 * ops->capacity : 1024;
+    realloc_int_1(&ops->row, new_capacity, ops->capacity);
+    realloc_int_1(&ops->col, new_capacity, ops->capacity);
+    realloc_dbl_1(&ops->Mp, new_capacity, ops->capacity);
+    realloc_dbl_1(&ops->Ap, new_capacity, ops->capacity);
+    realloc_dbl_1(&ops->Fp, new_capacity, ops->capacity);
+    ops->capacity = new_capacity;
+  }
+  ops->row[ops->nnz] = row;
+  ops->col[ops->nnz] = col;
+  ops->Mp[ops->nnz] = mp;
+  ops->Ap[ops->nnz] = ap;
+  ops->Fp[ops->nnz] = fp;
+  ops->nnz++;
+}
+
+/*
+ * Element assembly of the pressure mass matrix Mp, the viscosity
+ * weighted pressure Laplacian Ap and the PCD convection-diffusion
+ * operator Fp, the same operators set_pcd_matrices() builds for PETSc.
+ * Entries are accumulated per element in coordinate form; duplicates
+ * are summed when the caller builds the distributed matrix.
+ */
+goma_error assemble_pressure_aux_operators(struct Pressure_Aux_Operators *ops,
+                                           Exo_DB *exo,
+                                           Dpi *dpi,
+                                           dbl *x,
+                                           dbl *x_old,
+                                           dbl *xdot,
+                                           dbl *xdot_old) {
+  const int eqn = PRESSURE;
+
+  ops->nnz = 0;
+
+  for (int eb_index = 0; eb_index < exo->num_elem_blocks; eb_index++) {
+    int mn = Matilda[eb_index];
+
+    pd = pd_glob[mn];
+    cr = cr_glob[mn];
+    elc = elc_glob[mn];
+    elc_rs = elc_rs_glob[mn];
+    gn = gn_glob[mn];
+    mp = mp_glob[mn];
+    vn = vn_glob[mn];
+    evpl = evpl_glob[mn];
+
+    for (int mode = 0; mode < vn->modes; mode++) {
+      ve[mode] = ve_glob[mn][mode];
+    }
+
+    if (!pd->v[pg->imtrx][PRESSURE])
+      continue;
+
+    int e_start = exo->eb_ptr[eb_index];
+    int e_end = exo->eb_ptr[eb_index + 1];
+
+    for (int ielem = e_start; ielem < e_end; ielem++) {
+      int err = load_elem_dofptr(ielem, exo, x, x_old, xdot, xdot_old, 0);
+      GOMA_EH(err, "load_elem_dofptr");
+      err = bf_mp_init(pd);
+      GOMA_EH(err, "bf_mp_init");
+
+      int ielem_type = ei[pg->imtrx]->ielem_type;
+      int ip_total = elem_info(NQUAD, ielem_type);
+      int dofs = ei[pg->imtrx]->dof[eqn];
+      int *gun = ei[pg->imtrx]->gun_list[eqn];
+
+      double Me[MDE][MDE], Ae[MDE][MDE], Fe[MDE][MDE];
+      for (int i = 0; i < dofs; i++) {
+        for (int j = 0; j < dofs; j++) {
+          Me[i][j] = Ae[i][j] = Fe[i][j] = 0.0;
+        }
+      }
+
+      for (int ip = 0; ip < ip_total; ip++) {
+        dbl xi[3];
+        dbl s, t, u;
+
+        find_stu(ip, ielem_type, &s, &t, &u);
+        xi[0] = s;
+        xi[1] = t;
+        xi[2] = u;
+        fv->wt = Gq_weight(ip, ielem_type);
+
+        err = load_basis_functions(xi, bfd);
+        GOMA_EH(err, "problem from load_basis_functions");
+        err = beer_belly();
+        GOMA_EH(err, "beer_belly");
+        err = load_fv();
+        GOMA_EH(err, "load_fv");
+        err = load_bf_grad();
+        GOMA_EH(err, "load_bf_grad");
+        err = load_fv_grads();
+        GOMA_EH(err, "load_fv_grads");
+
+        double gamma[DIM][DIM];
+        for (int a = 0; a < VIM; a++) {
+          for (int b = 0; b < VIM; b++) {
+            gamma[a][b] = fv->grad_v[a][b] + fv->grad_v[b][a];
+          }
+        }
+        double mu = viscosity(gn, gamma, NULL);
+        dbl rho = density(NULL, tran->time_value);
+        dbl wt_det = fv->wt * bf[eqn]->detJ;
+        dbl mass_rate = 0.0;
+        if (pd->TimeIntegration != STEADY) {
+          mass_rate = pd->etm[pg->imtrx][VELOCITY1][LOG2_MASS] / tran->delta_t;
+        }
+
+        for (int i = 0; i < dofs; i++) {
+          for (int j = 0; j < dofs; j++) {
+            dbl phi_ij = bf[eqn]->phi[i] * bf[eqn]->phi[j] * wt_det;
+            dbl ap = 0.0, adv = 0.0;
+            for (int a = 0; a < pd->Num_Dim; a++) {
+              ap += bf[eqn]->grad_phi[i][a] * bf[eqn]->grad_phi[j][a];
+              adv += fv->v[a] * bf[eqn]->grad_phi[j][a];
+            }
+            Me[i][j] += phi_ij;
+            Ae[i][j] += mu * ap * wt_det;
+            Fe[i][j] += mu * ap * wt_det + rho * adv * bf[eqn]->phi[i] * wt_det +
+                        mass_rate * rho * phi_ij;
+          }
+        }
+      } /* END  for (ip = 0; ip < ip_total; ip++) */
+
+      for (int i = 0; i < dofs; i++) {
+        int ledof = ei[pg->imtrx]->lvdof_to_ledof[eqn][i];
+        if (!ei[pg->imtrx]->owned_ledof[ledof])
+          continue;
+        for (int j = 0; j < dofs; j++) {
+          pressure_aux_add(ops, gun[i], gun[j], Me[i][j], Ae[i][j], Fe[i][j]);
+        }
+      }
+    } /* END  for (ielem = e_start; ielem < e_end; ielem++) */
+  } /* END for (ieb loop) */
+
+  return GOMA_SUCCESS;
+}
+
+void free_pressure_aux_operators(struct Pressure_Aux_Operators *ops) {
+  safer_free((void **)&ops->row);
+  safer_free((void **)&ops->col);
+  safer_free((void **)&ops->Mp);
+  safer_free((void **)&ops->Ap);
+  safer_free((void **)&ops->Fp);
+  ops->nnz = 0;
+  ops->capacity = 0;
+}
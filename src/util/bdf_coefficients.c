@@ -0,0 +1,27 @@
+#include "util/bdf_coefficients.h"
+
+void goma_bdf_derivative_coefficients(int order, double time1, const double *t, double *alpha) {
+  alpha[0] = 0.0;
+  for (int m = 0; m < order; m++) {
+    alpha[0] += 1.0 / (time1 - t[m]);
+  }
+  for (int i = 0; i < order; i++) {
+    alpha[i + 1] = 1.0 / (t[i] - time1);
+    for (int m = 0; m < order; m++) {
+      if (m != i) {
+        alpha[i + 1] *= (time1 - t[m]) / (t[i] - t[m]);
+      }
+    }
+  }
+}
+
+void goma_bdf_extrapolation_weights(int q, double time1, const double *t, double *w) {
+  for (int j = 0; j <= q; j++) {
+    w[j] = 1.0;
+    for (int m = 0; m <= q; m++) {
+      if (m != j) {
+        w[j] *= (time1 - t[m]) / (t[j] - t[m]);
+      }
+    }
+  }
+}
@@ -0,0 +1,171 @@
+#include "util/checkpoint_io.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static const char goma_ckpt_magic[8] = {'G', 'O', 'M', 'A', 'C', 'K', 'P', 'T'};
+static const int goma_ckpt_byte_order = 0x01020304;
+
+void goma_ckpt_buffer_init(goma_ckpt_buffer *b) {
+  b->data = NULL;
+  b->size = 0;
+  b->capacity = 0;
+  b->pos = 0;
+}
+
+void goma_ckpt_buffer_free(goma_ckpt_buffer *b) {
+  free(b->data);
+  goma_ckpt_buffer_init(b);
+}
+
+static int goma_ckpt_reserve(goma_ckpt_buffer *b, size_t n) {
+  if (b->size + n <= b->capacity) {
+    return 0;
+  }
+  size_t capacity = b->capacity > 0 ? b->capacity : 4096;
+  while (capacity < b->size + n) {
+    capacity *= 2;
+  }
+  char *data = realloc(b->data, capacity);
+  if (data == NULL) {
+    return -1;
+  }
+  b->data = data;
+  b->capacity = capacity;
+  return 0;
+}
+
+int goma_ckpt_put(goma_ckpt_buffer *b, const void *p, size_t n) {
+  if (goma_ckpt_reserve(b, n)) {
+    return -1;
+  }
+  if (n > 0) {
+    memcpy(b->data + b->size, p, n);
+  }
+  b->size += n;
+  return 0;
+}
+
+int goma_ckpt_get(goma_ckpt_buffer *b, void *p, size_t n) {
+  if (b->pos + n > b->size) {
+    return -1;
+  }
+  if (n > 0) {
+    memcpy(p, b->data + b->pos, n);
+  }
+  b->pos += n;
+  return 0;
+}
+
+int goma_ckpt_put_int(goma_ckpt_buffer *b, int v) { return goma_ckpt_put(b, &v, sizeof(int)); }
+
+int goma_ckpt_get_int(goma_ckpt_buffer *b, int *v) { return goma_ckpt_get(b, v, sizeof(int)); }
+
+int goma_ckpt_put_double(goma_ckpt_buffer *b, double v) {
+  return goma_ckpt_put(b, &v, sizeof(double));
+}
+
+int goma_ckpt_get_double(goma_ckpt_buffer *b, double *v) {
+  return goma_ckpt_get(b, v, sizeof(double));
+}
+
+int goma_ckpt_put_doubles(goma_ckpt_buffer *b, const double *v, int n) {
+  if (goma_ckpt_put_int(b, n)) {
+    return -1;
+  }
+  return goma_ckpt_put(b, v, sizeof(double) * (size_t)n);
+}
+
+/* Fails if the stored array does not have exactly n values */
+int goma_ckpt_get_doubles(goma_ckpt_buffer *b, double *v, int n) {
+  int stored;
+  if (goma_ckpt_get_int(b, &stored) || stored != n) {
+    return -1;
+  }
+  return goma_ckpt_get(b, v, sizeof(double) * (size_t)n);
+}
+
+uint64_t goma_ckpt_checksum(const char *data, size_t n) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < n; i++) {
+    hash ^= (unsigned char)data[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+int goma_ckpt_write_file(const char *filename, const goma_ckpt_buffer *b) {
+  size_t len = strlen(filename);
+  char *tmpname = malloc(len + 5);
+  if (tmpname == NULL) {
+    return -1;
+  }
+  memcpy(tmpname, filename, len);
+  memcpy(tmpname + len, ".tmp", 5);
+
+  FILE *fp = fopen(tmpname, "wb");
+  if (fp == NULL) {
+    free(tmpname);
+    return -1;
+  }
+
+  int header[2] = {GOMA_CKPT_VERSION, goma_ckpt_byte_order};
+  uint64_t sizes[2] = {(uint64_t)b->size, goma_ckpt_checksum(b->data, b->size)};
+  int err = 0;
+  if (fwrite(goma_ckpt_magic, 1, sizeof(goma_ckpt_magic), fp) != sizeof(goma_ckpt_magic) ||
+      fwrite(header, sizeof(int), 2, fp) != 2 || fwrite(sizes, sizeof(uint64_t), 2, fp) != 2 ||
+      (b->size > 0 && fwrite(b->data, 1, b->size, fp) != b->size)) {
+    err = -1;
+  }
+  if (fflush(fp) != 0 || fsync(fileno(fp)) != 0) {
+    err = -1;
+  }
+  if (fclose(fp) != 0) {
+    err = -1;
+  }
+  if (!err && rename(tmpname, filename) != 0) {
+    err = -1;
+  }
+  if (err) {
+    remove(tmpname);
+  }
+  free(tmpname);
+  return err;
+}
+
+/* Reads the payload into b (replacing its contents) and rewinds it */
+int goma_ckpt_read_file(const char *filename, goma_ckpt_buffer *b) {
+  FILE *fp = fopen(filename, "rb");
+  if (fp == NULL) {
+    return -1;
+  }
+
+  char magic[sizeof(goma_ckpt_magic)];
+  int header[2];
+  uint64_t sizes[2];
+  if (fread(magic, 1, sizeof(magic), fp) != sizeof(magic) ||
+      memcmp(magic, goma_ckpt_magic, sizeof(magic)) != 0 ||
+      fread(header, sizeof(int), 2, fp) != 2 ||
+      header[0] != GOMA_CKPT_VERSION || header[1] != goma_ckpt_byte_order ||
+      fread(sizes, sizeof(uint64_t), 2, fp) != 2) {
+    fclose(fp);
+    return -1;
+  }
+
+  goma_ckpt_buffer_free(b);
+  if (goma_ckpt_reserve(b, (size_t)sizes[0]) ||
+      (sizes[0] > 0 && fread(b->data, 1, (size_t)sizes[0], fp) != (size_t)sizes[0])) {
+    fclose(fp);
+    return -1;
+  }
+  fclose(fp);
+  b->size = (size_t)sizes[0];
+  b->pos = 0;
+
+  if (goma_ckpt_checksum(b->data, b->size) != sizes[1]) {
+    return -1;
+  }
+  return 0;
+}
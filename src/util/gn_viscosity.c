@@ -0,0 +1,57 @@
+#include "util/gn_viscosity.h"
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+
+double goma_carreau(double gd,
+                    double at,
+                    double mu0,
+                    double muinf,
+                    double nexp,
+                    double aexp,
+                    double lambda,
+                    double *dmu_dgd,
+                    double *dmu_dat) {
+  const double dmu = mu0 - muinf;
+  /* shear = (at lambda gd)^a, zero at rest */
+  const double shear = (gd != 0.) ? pow(at * lambda * gd, aexp) : 0.;
+  const double visc = pow(1. + shear, (nexp - 1.) / aexp);
+  /* d(visc)/d(shear) times a shear, the common factor of both derivatives */
+  const double dvisc = (nexp - 1.) * visc * shear / (1. + shear);
+  if (dmu_dgd != NULL) {
+    *dmu_dgd = (gd != 0.) ? at * dmu * dvisc / gd : 0.;
+  }
+  if (dmu_dat != NULL) {
+    *dmu_dat = muinf + dmu * visc + dmu * dvisc;
+  }
+  return at * (muinf + dmu * visc);
+}
+
+double goma_power_law(double gd, double mu0, double nexp, double offset, double *dmu_dgd) {
+  const double g = gd + offset;
+  const double mu = mu0 * pow(g, nexp - 1.);
+  if (dmu_dgd != NULL) {
+    *dmu_dgd = (nexp - 1.) * mu / g;
+  }
+  return mu;
+}
+
+double goma_wlf_shift(double T, double tref, double c1, double c2, double *dat_dT) {
+  const double denom = c2 + T - tref;
+  double a = 1., da = 0.;
+  if (denom != 0.) {
+    a = exp(c1 * (tref - T) / denom);
+    da = -a * c1 * c2 / (denom * denom);
+    if (!isfinite(a)) {
+      a = DBL_MAX;
+    }
+    if (!isfinite(da)) {
+      da = -DBL_MAX;
+    }
+  }
+  if (dat_dT != NULL) {
+    *dat_dT = da;
+  }
+  return a;
+}
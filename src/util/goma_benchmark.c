@@ -0,0 +1,169 @@
+#include "util/goma_benchmark.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+double goma_benchmark_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return 1.0e9 * (double)ts.tv_sec + (double)ts.tv_nsec;
+}
+
+static int goma_benchmark_compare(const void *a, const void *b) {
+  double da = *(const double *)a;
+  double db = *(const double *)b;
+  return (da > db) - (da < db);
+}
+
+int goma_benchmark_stats(double *samples, int n, goma_benchmark_result *result) {
+  if (n < 1) {
+    return -1;
+  }
+  qsort(samples, n, sizeof(double), goma_benchmark_compare);
+
+  double sum = 0.0;
+  for (int i = 0; i < n; i++) {
+    sum += samples[i];
+  }
+  double mean = sum / n;
+  double var = 0.0;
+  for (int i = 0; i < n; i++) {
+    var += (samples[i] - mean) * (samples[i] - mean);
+  }
+
+  result->repetitions = n;
+  result->min_ns = samples[0];
+  result->median_ns = (n % 2) ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+  result->mean_ns = mean;
+  result->stddev_ns = (n > 1) ? sqrt(var / (n - 1)) : 0.0;
+  return 0;
+}
+
+void goma_benchmark_suite_init(goma_benchmark_suite *suite) {
+  memset(suite, 0, sizeof(goma_benchmark_suite));
+}
+
+void goma_benchmark_suite_free(goma_benchmark_suite *suite) {
+  free(suite->results);
+  goma_benchmark_suite_init(suite);
+}
+
+int goma_benchmark_suite_set_context(goma_benchmark_suite *suite,
+                                     const char *key,
+                                     const char *value) {
+  if (suite->num_context >= GOMA_BENCHMARK_MAX_CONTEXT) {
+    return -1;
+  }
+  int i = suite->num_context++;
+  snprintf(suite->context_key[i], GOMA_BENCHMARK_NAME_LEN, "%s", key);
+  snprintf(suite->context_value[i], GOMA_BENCHMARK_NOTE_LEN, "%s", value);
+  return 0;
+}
+
+int goma_benchmark_suite_add(goma_benchmark_suite *suite, const goma_benchmark_result *result) {
+  if (suite->num_results == suite->capacity) {
+    int capacity = suite->capacity > 0 ? 2 * suite->capacity : 16;
+    goma_benchmark_result *results =
+        realloc(suite->results, capacity * sizeof(goma_benchmark_result));
+    if (results == NULL) {
+      return -1;
+    }
+    suite->results = results;
+    suite->capacity = capacity;
+  }
+  suite->results[suite->num_results++] = *result;
+  return 0;
+}
+
+int goma_benchmark_suite_skip(goma_benchmark_suite *suite, const char *name, const char *reason) {
+  goma_benchmark_result result;
+  memset(&result, 0, sizeof(result));
+  snprintf(result.name, GOMA_BENCHMARK_NAME_LEN, "%s", name);
+  snprintf(result.note, GOMA_BENCHMARK_NOTE_LEN, "%s", reason);
+  result.skipped = 1;
+  return goma_benchmark_suite_add(suite, &result);
+}
+
+/* names and notes are ours, but file names in the context may hold anything */
+static void goma_benchmark_json_string(FILE *file, const char *s) {
+  fputc('"', file);
+  for (; *s != '\0'; s++) {
+    unsigned char c = (unsigned char)*s;
+    if (c == '"' || c == '\\') {
+      fprintf(file, "\\%c", c);
+    } else if (c < 0x20) {
+      fprintf(file, "\\u%04x", c);
+    } else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+static void goma_benchmark_json_per(FILE *file, const char *key, double ns, double count) {
+  if (count > 0) {
+    fprintf(file, ",\n      \"%s\": %.6g", key, ns / count);
+  }
+}
+
+int goma_benchmark_suite_write_json(const goma_benchmark_suite *suite, FILE *file) {
+  fprintf(file, "{\n  \"context\": {");
+  for (int i = 0; i < suite->num_context; i++) {
+    fprintf(file, "%s\n    ", i > 0 ? "," : "");
+    goma_benchmark_json_string(file, suite->context_key[i]);
+    fprintf(file, ": ");
+    goma_benchmark_json_string(file, suite->context_value[i]);
+  }
+  fprintf(file, "%s},\n  \"benchmarks\": [", suite->num_context > 0 ? "\n  " : "");
+
+  for (int i = 0; i < suite->num_results; i++) {
+    const goma_benchmark_result *r = &suite->results[i];
+    fprintf(file, "%s\n    {\n      \"name\": ", i > 0 ? "," : "");
+    goma_benchmark_json_string(file, r->name);
+    if (r->skipped) {
+      fprintf(file, ",\n      \"skipped\": ");
+      goma_benchmark_json_string(file, r->note);
+      fprintf(file, "\n    }");
+      continue;
+    }
+    fprintf(file, ",\n      \"repetitions\": %d", r->repetitions);
+    fprintf(file, ",\n      \"elements\": %.17g", r->elements);
+    fprintf(file, ",\n      \"quadrature_points\": %.17g", r->quadrature_points);
+    fprintf(file, ",\n      \"calls\": %.17g", r->calls);
+    fprintf(file, ",\n      \"min_ns\": %.6g", r->min_ns);
+    fprintf(file, ",\n      \"median_ns\": %.6g", r->median_ns);
+    fprintf(file, ",\n      \"mean_ns\": %.6g", r->mean_ns);
+    fprintf(file, ",\n      \"stddev_ns\": %.6g", r->stddev_ns);
+    goma_benchmark_json_per(file, "ns_per_element", r->median_ns, r->elements);
+    goma_benchmark_json_per(file, "ns_per_quadrature_point", r->median_ns, r->quadrature_points);
+    goma_benchmark_json_per(file, "ns_per_call", r->median_ns, r->calls);
+    fprintf(file, "\n    }");
+  }
+  fprintf(file, "%s]\n}\n", suite->num_results > 0 ? "\n  " : "");
+  return ferror(file) ? -1 : 0;
+}
+
+void goma_benchmark_suite_print(const goma_benchmark_suite *suite, FILE *file) {
+  fprintf(file, "%-32s %12s %12s %12s %12s %12s\n", "benchmark", "median [us]", "stddev [%]",
+          "ns/elem", "ns/qp", "ns/call");
+  for (int i = 0; i < suite->num_results; i++) {
+    const goma_benchmark_result *r = &suite->results[i];
+    if (r->skipped) {
+      fprintf(file, "%-32s skipped: %s\n", r->name, r->note);
+      continue;
+    }
+    double rel = r->mean_ns > 0 ? 100.0 * r->stddev_ns / r->mean_ns : 0.0;
+    fprintf(file, "%-32s %12.3f %12.2f", r->name, 1.0e-3 * r->median_ns, rel);
+    double counts[3] = {r->elements, r->quadrature_points, r->calls};
+    for (int j = 0; j < 3; j++) {
+      if (counts[j] > 0) {
+        fprintf(file, " %12.1f", r->median_ns / counts[j]);
+      } else {
+        fprintf(file, " %12s", "-");
+      }
+    }
+    fprintf(file, "\n");
+  }
+}
@@ -0,0 +1,221 @@
+#include "util/goma_exchange.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+  int proc;
+  int arrival;
+  size_t offset;
+  size_t bytes;
+} exchange_message;
+
+static int compare_messages(const void *a, const void *b) {
+  const exchange_message *ma = (const exchange_message *)a;
+  const exchange_message *mb = (const exchange_message *)b;
+  if (ma->proc != mb->proc) {
+    return ma->proc < mb->proc ? -1 : 1;
+  }
+  return ma->arrival - mb->arrival;
+}
+
+static int recv_alloc(goma_exchange_recv *recv, int num_procs, size_t bytes) {
+  recv->num_procs = num_procs;
+  recv->proc = (int *)malloc(sizeof(int) * (num_procs > 0 ? num_procs : 1));
+  recv->offset = (size_t *)malloc(sizeof(size_t) * (num_procs + 1));
+  recv->data = (char *)malloc(bytes > 0 ? bytes : 1);
+  if (recv->proc == NULL || recv->offset == NULL || recv->data == NULL) {
+    goma_exchange_recv_free(recv);
+    return -1;
+  }
+  recv->offset[0] = 0;
+  return 0;
+}
+
+/* append one probed message from source to buffer, growing it as needed */
+static int recv_probed(MPI_Comm comm,
+                       int tag,
+                       MPI_Status *status,
+                       char **buffer,
+                       size_t *capacity,
+                       size_t *used,
+                       exchange_message *message) {
+  int bytes;
+  if (MPI_Get_count(status, MPI_BYTE, &bytes) != MPI_SUCCESS) {
+    return -1;
+  }
+  if (*used + bytes > *capacity) {
+    size_t capacity_new = *capacity > 0 ? 2 * *capacity : 4096;
+    while (capacity_new < *used + bytes) {
+      capacity_new *= 2;
+    }
+    char *buffer_new = (char *)realloc(*buffer, capacity_new);
+    if (buffer_new == NULL) {
+      return -1;
+    }
+    *buffer = buffer_new;
+    *capacity = capacity_new;
+  }
+  if (MPI_Recv(*buffer + *used, bytes, MPI_BYTE, status->MPI_SOURCE, tag, comm,
+               MPI_STATUS_IGNORE) != MPI_SUCCESS) {
+    return -1;
+  }
+  message->proc = status->MPI_SOURCE;
+  message->offset = *used;
+  message->bytes = bytes;
+  *used += bytes;
+  return 0;
+}
+
+/* receive and drop one probed message, so that its sender can complete */
+static void recv_discard(MPI_Comm comm, int tag, int source, int bytes) {
+  char *scratch = (char *)malloc(bytes > 0 ? bytes : 1);
+  if (scratch == NULL) {
+    /* nowhere to put it and the sender cannot finish without it */
+    MPI_Abort(comm, 1);
+  }
+  MPI_Recv(scratch, bytes, MPI_BYTE, source, tag, comm, MPI_STATUS_IGNORE);
+  free(scratch);
+}
+
+int goma_exchange_sparse(MPI_Comm comm,
+                         int tag,
+                         int num_dest,
+                         const int *dest,
+                         const void *const *send,
+                         const int *send_bytes,
+                         goma_exchange_recv *recv) {
+  memset(recv, 0, sizeof(goma_exchange_recv));
+
+  char *buffer = NULL;
+  size_t capacity = 0;
+  size_t used = 0;
+  exchange_message *messages = NULL;
+  int num_messages = 0;
+  int max_messages = 0;
+  int error = 0;
+
+  /* Without requests nothing is sent, but we still take part in the
+   * exchange so that the other ranks finish theirs */
+  MPI_Request *requests = (MPI_Request *)malloc(sizeof(MPI_Request) * (num_dest + 1));
+  if (requests == NULL) {
+    error = -1;
+    num_dest = 0;
+  }
+  for (int i = 0; i < num_dest; i++) {
+    MPI_Issend((void *)send[i], send_bytes[i], MPI_BYTE, dest[i], tag, comm, &requests[i]);
+  }
+
+  MPI_Request barrier = MPI_REQUEST_NULL;
+  int barrier_active = 0;
+  int done = 0;
+  while (!done) {
+    int found;
+    MPI_Status status;
+    MPI_Iprobe(MPI_ANY_SOURCE, tag, comm, &found, &status);
+    if (found && !error && num_messages == max_messages) {
+      int max_new = max_messages > 0 ? 2 * max_messages : 16;
+      exchange_message *messages_new =
+          (exchange_message *)realloc(messages, sizeof(exchange_message) * max_new);
+      if (messages_new == NULL) {
+        error = -1;
+      } else {
+        messages = messages_new;
+        max_messages = max_new;
+      }
+    }
+    if (found && !error &&
+        recv_probed(comm, tag, &status, &buffer, &capacity, &used, &messages[num_messages])) {
+      error = -1;
+    }
+    if (found && !error) {
+      messages[num_messages].arrival = num_messages;
+      num_messages++;
+    } else if (found) {
+      /* after an error keep receiving until the barrier completes */
+      int bytes;
+      MPI_Get_count(&status, MPI_BYTE, &bytes);
+      recv_discard(comm, tag, status.MPI_SOURCE, bytes);
+    }
+
+    if (barrier_active) {
+      MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+    } else {
+      int sent;
+      MPI_Testall(num_dest, requests, &sent, MPI_STATUSES_IGNORE);
+      if (sent) {
+        MPI_Ibarrier(comm, &barrier);
+        barrier_active = 1;
+      }
+    }
+  }
+  free(requests);
+
+  if (!error) {
+    qsort(messages, num_messages, sizeof(exchange_message), compare_messages);
+    error = recv_alloc(recv, num_messages, used);
+  }
+  if (!error) {
+    for (int i = 0; i < num_messages; i++) {
+      recv->proc[i] = messages[i].proc;
+      memcpy(recv->data + recv->offset[i], buffer + messages[i].offset, messages[i].bytes);
+      recv->offset[i + 1] = recv->offset[i] + messages[i].bytes;
+    }
+  }
+  free(messages);
+  free(buffer);
+  return error;
+}
+
+int goma_exchange_neighbors(MPI_Comm comm,
+                            int tag,
+                            int num_neighbors,
+                            const int *neighbor,
+                            const void *const *send,
+                            const int *send_bytes,
+                            goma_exchange_recv *recv) {
+  memset(recv, 0, sizeof(goma_exchange_recv));
+
+  MPI_Request *requests = (MPI_Request *)malloc(sizeof(MPI_Request) * (num_neighbors + 1));
+  int *recv_bytes = (int *)malloc(sizeof(int) * (num_neighbors + 1));
+  if (requests == NULL || recv_bytes == NULL) {
+    /* the neighbors are already waiting for our messages */
+    MPI_Abort(comm, 1);
+  }
+  for (int i = 0; i < num_neighbors; i++) {
+    MPI_Isend((void *)send[i], send_bytes[i], MPI_BYTE, neighbor[i], tag, comm, &requests[i]);
+  }
+
+  /* sizes first so that the messages land directly in one buffer */
+  size_t total = 0;
+  for (int i = 0; i < num_neighbors; i++) {
+    MPI_Status status;
+    MPI_Probe(neighbor[i], tag, comm, &status);
+    MPI_Get_count(&status, MPI_BYTE, &recv_bytes[i]);
+    total += recv_bytes[i];
+  }
+
+  int error = recv_alloc(recv, num_neighbors, total);
+  for (int i = 0; i < num_neighbors; i++) {
+    if (error) {
+      recv_discard(comm, tag, neighbor[i], recv_bytes[i]);
+      continue;
+    }
+    recv->proc[i] = neighbor[i];
+    recv->offset[i + 1] = recv->offset[i] + recv_bytes[i];
+    MPI_Recv(recv->data + recv->offset[i], recv_bytes[i], MPI_BYTE, neighbor[i], tag, comm,
+             MPI_STATUS_IGNORE);
+  }
+  /* our sends must be done before the caller may free the send buffers */
+  MPI_Waitall(num_neighbors, requests, MPI_STATUSES_IGNORE);
+  free(requests);
+  free(recv_bytes);
+  return error;
+}
+
+void goma_exchange_recv_free(goma_exchange_recv *recv) {
+  free(recv->proc);
+  free(recv->offset);
+  free(recv->data);
+  memset(recv, 0, sizeof(goma_exchange_recv));
+}
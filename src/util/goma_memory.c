@@ -0,0 +1,309 @@
+#include "util/goma_memory.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GOMA_MEM_TAG_STACK_DEPTH 32
+#define GOMA_MEM_TABLE_MIN       1024
+
+static const char *goma_mem_tag_names[GOMA_MEM_NUM_TAGS] = {
+    "other", "mesh", "ghost", "matrix", "assembly", "solution", "post", "particles",
+};
+
+/* index GOMA_MEM_NUM_TAGS holds the total over all tags */
+static size_t goma_mem_current[GOMA_MEM_NUM_TAGS + 1];
+static size_t goma_mem_peak[GOMA_MEM_NUM_TAGS + 1];
+
+static goma_mem_tag goma_mem_tag_stack[GOMA_MEM_TAG_STACK_DEPTH];
+static int goma_mem_tag_depth = 0;
+
+/* off unless asked for, the track functions then return straight away */
+static int goma_mem_enabled = 0;
+
+/*
+ * Live blocks, open addressing with linear probing keyed on the address.
+ * The table itself comes straight from malloc and is not charged.
+ */
+typedef struct {
+  uintptr_t ptr; /* 0 is an empty slot */
+  size_t bytes;
+  goma_mem_tag tag;
+} goma_mem_entry;
+
+static goma_mem_entry *goma_mem_table = NULL;
+static size_t goma_mem_table_size = 0; /* power of 2 */
+static size_t goma_mem_table_count = 0;
+
+const char *goma_mem_tag_name(goma_mem_tag tag) {
+  if (tag < 0 || tag >= GOMA_MEM_NUM_TAGS) {
+    return "unknown";
+  }
+  return goma_mem_tag_names[tag];
+}
+
+void goma_mem_push_tag(goma_mem_tag tag) {
+  /* past the maximum depth the innermost tags are dropped */
+  if (goma_mem_tag_depth < GOMA_MEM_TAG_STACK_DEPTH) {
+    goma_mem_tag_stack[goma_mem_tag_depth] = tag;
+  }
+  goma_mem_tag_depth++;
+}
+
+void goma_mem_pop_tag(void) {
+  if (goma_mem_tag_depth > 0) {
+    goma_mem_tag_depth--;
+  }
+}
+
+goma_mem_tag goma_mem_current_tag(void) {
+  if (goma_mem_tag_depth == 0) {
+    return GOMA_MEM_OTHER;
+  }
+  int top = goma_mem_tag_depth < GOMA_MEM_TAG_STACK_DEPTH ? goma_mem_tag_depth
+                                                          : GOMA_MEM_TAG_STACK_DEPTH;
+  return goma_mem_tag_stack[top - 1];
+}
+
+static void goma_mem_charge(goma_mem_tag tag, size_t bytes) {
+  goma_mem_current[tag] += bytes;
+  if (goma_mem_current[tag] > goma_mem_peak[tag]) {
+    goma_mem_peak[tag] = goma_mem_current[tag];
+  }
+  goma_mem_current[GOMA_MEM_NUM_TAGS] += bytes;
+  if (goma_mem_current[GOMA_MEM_NUM_TAGS] > goma_mem_peak[GOMA_MEM_NUM_TAGS]) {
+    goma_mem_peak[GOMA_MEM_NUM_TAGS] = goma_mem_current[GOMA_MEM_NUM_TAGS];
+  }
+}
+
+static void goma_mem_release(goma_mem_tag tag, size_t bytes) {
+  goma_mem_current[tag] -= bytes < goma_mem_current[tag] ? bytes : goma_mem_current[tag];
+  size_t *total = &goma_mem_current[GOMA_MEM_NUM_TAGS];
+  *total -= bytes < *total ? bytes : *total;
+}
+
+static size_t goma_mem_hash(uintptr_t ptr) {
+  /* blocks are aligned, mix the low bits away */
+  uint64_t h = (uint64_t)ptr;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return (size_t)h;
+}
+
+static goma_mem_entry *goma_mem_find(uintptr_t ptr) {
+  if (goma_mem_table_size == 0) {
+    return NULL;
+  }
+  size_t mask = goma_mem_table_size - 1;
+  for (size_t i = goma_mem_hash(ptr) & mask;; i = (i + 1) & mask) {
+    if (goma_mem_table[i].ptr == ptr) {
+      return &goma_mem_table[i];
+    }
+    if (goma_mem_table[i].ptr == 0) {
+      return NULL;
+    }
+  }
+}
+
+static void goma_mem_insert(goma_mem_entry *table, size_t size, const goma_mem_entry *entry) {
+  size_t mask = size - 1;
+  size_t i = goma_mem_hash(entry->ptr) & mask;
+  while (table[i].ptr != 0) {
+    i = (i + 1) & mask;
+  }
+  table[i] = *entry;
+}
+
+static int goma_mem_grow(void) {
+  size_t size = goma_mem_table_size > 0 ? 2 * goma_mem_table_size : GOMA_MEM_TABLE_MIN;
+  goma_mem_entry *table = calloc(size, sizeof(goma_mem_entry));
+  if (table == NULL) {
+    return -1;
+  }
+  for (size_t i = 0; i < goma_mem_table_size; i++) {
+    if (goma_mem_table[i].ptr != 0) {
+      goma_mem_insert(table, size, &goma_mem_table[i]);
+    }
+  }
+  free(goma_mem_table);
+  goma_mem_table = table;
+  goma_mem_table_size = size;
+  return 0;
+}
+
+/* backward shift deletion keeps the probe sequences intact without tombstones */
+static void goma_mem_erase(goma_mem_entry *entry) {
+  size_t mask = goma_mem_table_size - 1;
+  size_t hole = (size_t)(entry - goma_mem_table);
+  for (size_t i = (hole + 1) & mask; goma_mem_table[i].ptr != 0; i = (i + 1) & mask) {
+    size_t home = goma_mem_hash(goma_mem_table[i].ptr) & mask;
+    /* move i into the hole unless its home lies cyclically in (hole, i] */
+    int stays = (hole <= i) ? (hole < home && home <= i) : (hole < home || home <= i);
+    if (!stays) {
+      goma_mem_table[hole] = goma_mem_table[i];
+      hole = i;
+    }
+  }
+  goma_mem_table[hole].ptr = 0;
+  goma_mem_table_count--;
+}
+
+void goma_mem_enable(int enable) { goma_mem_enabled = enable; }
+
+int goma_mem_is_enabled(void) { return goma_mem_enabled; }
+
+void goma_mem_track_alloc(const void *ptr, size_t bytes) {
+  if (!goma_mem_enabled || ptr == NULL) {
+    return;
+  }
+  goma_mem_entry entry = {(uintptr_t)ptr, bytes, goma_mem_current_tag()};
+
+  /* an earlier block at this address was released with a bare free() */
+  goma_mem_entry *stale = goma_mem_find(entry.ptr);
+  if (stale != NULL) {
+    goma_mem_release(stale->tag, stale->bytes);
+    *stale = entry;
+    goma_mem_charge(entry.tag, bytes);
+    return;
+  }
+
+  if (2 * (goma_mem_table_count + 1) > goma_mem_table_size && goma_mem_grow() != 0) {
+    /* no room to remember the block, count it but it stays charged */
+    goma_mem_charge(entry.tag, bytes);
+    return;
+  }
+  goma_mem_insert(goma_mem_table, goma_mem_table_size, &entry);
+  goma_mem_table_count++;
+  goma_mem_charge(entry.tag, bytes);
+}
+
+void goma_mem_track_free(const void *ptr) {
+  if (!goma_mem_enabled || ptr == NULL) {
+    return;
+  }
+  goma_mem_entry *entry = goma_mem_find((uintptr_t)ptr);
+  if (entry != NULL) {
+    goma_mem_release(entry->tag, entry->bytes);
+    goma_mem_erase(entry);
+  }
+}
+
+void goma_mem_track_realloc(const void *old_ptr, const void *new_ptr, size_t bytes) {
+  if (!goma_mem_enabled) {
+    return;
+  }
+  if (old_ptr == NULL) {
+    goma_mem_track_alloc(new_ptr, bytes);
+    return;
+  }
+  goma_mem_entry *entry = goma_mem_find((uintptr_t)old_ptr);
+  if (entry == NULL || new_ptr == NULL) {
+    return;
+  }
+  goma_mem_tag tag = entry->tag;
+  goma_mem_release(tag, entry->bytes);
+  goma_mem_erase(entry);
+  goma_mem_push_tag(tag);
+  goma_mem_track_alloc(new_ptr, bytes);
+  goma_mem_pop_tag();
+}
+
+void goma_mem_track_bytes(goma_mem_tag tag, long long bytes) {
+  if (!goma_mem_enabled) {
+    return;
+  }
+  if (tag < 0 || tag >= GOMA_MEM_NUM_TAGS) {
+    tag = GOMA_MEM_OTHER;
+  }
+  if (bytes >= 0) {
+    goma_mem_charge(tag, (size_t)bytes);
+  } else {
+    goma_mem_release(tag, (size_t)(-bytes));
+  }
+}
+
+size_t goma_mem_current_bytes(goma_mem_tag tag) {
+  return (tag >= 0 && tag <= GOMA_MEM_NUM_TAGS) ? goma_mem_current[tag] : 0;
+}
+
+size_t goma_mem_peak_bytes(goma_mem_tag tag) {
+  return (tag >= 0 && tag <= GOMA_MEM_NUM_TAGS) ? goma_mem_peak[tag] : 0;
+}
+
+void goma_mem_reset(void) {
+  free(goma_mem_table);
+  goma_mem_table = NULL;
+  goma_mem_table_size = 0;
+  goma_mem_table_count = 0;
+  goma_mem_tag_depth = 0;
+  memset(goma_mem_current, 0, sizeof(goma_mem_current));
+  memset(goma_mem_peak, 0, sizeof(goma_mem_peak));
+}
+
+int goma_mem_parse_args(int *argc, char **argv, int *report) {
+  int n = 1;
+
+  *report = 0;
+  for (int i = 1; i < *argc; i++) {
+    if (strcmp(argv[i], "-mem_report") == 0) {
+      *report = 1;
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argv[n] = NULL;
+  *argc = n;
+  return 0;
+}
+
+static const char *goma_mem_row_name(int i) {
+  return i < GOMA_MEM_NUM_TAGS ? goma_mem_tag_names[i] : "total";
+}
+
+void goma_mem_print_local(FILE *file) {
+  if (!goma_mem_enabled) {
+    return;
+  }
+  fprintf(file, "%-10s %14s %14s\n", "memory", "current [MB]", "peak [MB]");
+  for (int i = 0; i <= GOMA_MEM_NUM_TAGS; i++) {
+    fprintf(file, "%-10s %14.2f %14.2f\n", goma_mem_row_name(i),
+            (double)goma_mem_current[i] / (1024.0 * 1024.0),
+            (double)goma_mem_peak[i] / (1024.0 * 1024.0));
+  }
+  fflush(file);
+}
+
+int goma_mem_report(MPI_Comm comm, const char *label, FILE *file) {
+  enum { N = 2 * (GOMA_MEM_NUM_TAGS + 1) };
+  double local[N], min[N], max[N], sum[N];
+  int rank, size;
+
+  for (int i = 0; i <= GOMA_MEM_NUM_TAGS; i++) {
+    local[2 * i] = (double)goma_mem_current[i] / (1024.0 * 1024.0);
+    local[2 * i + 1] = (double)goma_mem_peak[i] / (1024.0 * 1024.0);
+  }
+  if (MPI_Comm_rank(comm, &rank) != MPI_SUCCESS || MPI_Comm_size(comm, &size) != MPI_SUCCESS ||
+      MPI_Reduce(local, min, N, MPI_DOUBLE, MPI_MIN, 0, comm) != MPI_SUCCESS ||
+      MPI_Reduce(local, max, N, MPI_DOUBLE, MPI_MAX, 0, comm) != MPI_SUCCESS ||
+      MPI_Reduce(local, sum, N, MPI_DOUBLE, MPI_SUM, 0, comm) != MPI_SUCCESS) {
+    return -1;
+  }
+  if (rank != 0) {
+    return 0;
+  }
+
+  fprintf(file, "\nMemory by subsystem, %s (MB per rank over %d ranks)\n", label, size);
+  fprintf(file, "%-10s %10s %10s %10s   %10s %10s %10s\n", "", "current", "", "", "peak", "",
+          "");
+  fprintf(file, "%-10s %10s %10s %10s   %10s %10s %10s\n", "tag", "min", "mean", "max", "min",
+          "mean", "max");
+  for (int i = 0; i <= GOMA_MEM_NUM_TAGS; i++) {
+    int c = 2 * i, p = 2 * i + 1;
+    fprintf(file, "%-10s %10.2f %10.2f %10.2f   %10.2f %10.2f %10.2f\n", goma_mem_row_name(i),
+            min[c], sum[c] / size, max[c], min[p], sum[p] / size, max[p]);
+  }
+  fprintf(file, "\n");
+  fflush(file);
+  return 0;
+}
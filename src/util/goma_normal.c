@@ -3,14 +3,18 @@
 #include <math.h>
 #include <stdlib.h>
 
+#include "gds/gds_vec3.h"
 #include "std.h"
 
 goma_normal *goma_normal_alloc(int size) {
   goma_normal *normal = malloc(sizeof(goma_normal));
-  normal->normal = gds_vector_alloc(3);
+  // the normal and its 3 * MDE derivatives share one allocation
+  gds_vector *vectors[1 + 3 * MDE];
+  normal->block = gds_vector_alloc_block(1 + 3 * MDE, 3, vectors);
+  normal->normal = vectors[0];
   for (int i = 0; i < 3; i++) {
     for (int j = 0; j < MDE; j++) {
-      normal->d_normal_dx[i][j] = gds_vector_alloc(3);
+      normal->d_normal_dx[i][j] = vectors[1 + i * MDE + j];
     }
   }
   return normal;
@@ -133,25 +137,24 @@ void goma_normal_cross(goma_normal *u, goma_normal *v, goma_normal *cross) {
   gds_vector_cross(u->normal, v->normal, cross->normal);
 
   // d/dx (a X b) = d/dx a X b + a X d/dx b
-  gds_vector *tmp = gds_vector_alloc(3);
+  gds_vec3 a, b;
+  gds_vec3_from_vector(&a, u->normal);
+  gds_vec3_from_vector(&b, v->normal);
   for (int i = 0; i < 3; i++) {
     for (int j = 0; j < MDE; j++) {
-      gds_vector_cross(u->d_normal_dx[i][j], v->normal, cross->d_normal_dx[i][j]);
-      gds_vector_cross(u->normal, v->d_normal_dx[i][j], tmp);
-      gds_vector_add(cross->d_normal_dx[i][j], tmp);
+      gds_vec3 da, db, da_b, a_db;
+      gds_vec3_from_vector(&da, u->d_normal_dx[i][j]);
+      gds_vec3_from_vector(&db, v->d_normal_dx[i][j]);
+      gds_vec3_cross(&da, &b, &da_b);
+      gds_vec3_cross(&a, &db, &a_db);
+      gds_vec3_add(&da_b, &a_db);
+      gds_vec3_to_vector(cross->d_normal_dx[i][j], &da_b);
     }
   }
-
-  gds_vector_free(tmp);
 }
 
 void goma_normal_free(goma_normal *normal) {
-  for (int i = 0; i < 3; i++) {
-    for (int j = 0; j < MDE; j++) {
-      gds_vector_free(normal->d_normal_dx[i][j]);
-    }
-  }
-  gds_vector_free(normal->normal);
+  gds_vector_free_block(normal->block);
   free(normal);
 }
 
@@ -169,17 +172,18 @@ goma_normal_val goma_normal_dot(goma_normal *u, goma_normal *v) {
 }
 
 void goma_normal_scale(goma_normal *normal, const goma_normal_val *val) {
-  gds_vector *tmp1 = gds_vector_alloc(3);
+  // d/dx (s n) = s d/dx n + n d/dx s
+  gds_vec3 n;
+  gds_vec3_from_vector(&n, normal->normal);
   for (int i = 0; i < 3; i++) {
     for (int j = 0; j < MDE; j++) {
-      gds_vector_copy(tmp1, normal->normal);
-      gds_vector_scale(normal->d_normal_dx[i][j], val->val);
-      gds_vector_scale(tmp1, val->d_val[i][j]);
-      gds_vector_add(normal->d_normal_dx[i][j], tmp1);
+      gds_vec3 dn;
+      gds_vec3_from_vector(&dn, normal->d_normal_dx[i][j]);
+      gds_vec3_axpy(val->d_val[i][j], &n, val->val, &dn);
+      gds_vec3_to_vector(normal->d_normal_dx[i][j], &dn);
     }
   }
   gds_vector_scale(normal->normal, val->val);
-  gds_vector_free(tmp1);
 }
 
 void goma_normal_rotate_around_vector(goma_normal *rotated,
@@ -0,0 +1,124 @@
+#include "util/goma_perf_log.h"
+
+#include <string.h>
+#include <sys/resource.h>
+
+goma_perf_log Goma_Perf_Log = {0};
+
+char Goma_Perf_Log_File[GOMA_PERF_LOG_FILE_LEN] = "";
+
+void goma_perf_log_init(goma_perf_log *log) { memset(log, 0, sizeof(goma_perf_log)); }
+
+int goma_perf_log_parse_args(int *argc, char **argv, char *file, size_t len) {
+  int n = 1;
+
+  file[0] = '\0';
+  for (int i = 1; i < *argc; i++) {
+    if (strcmp(argv[i], "-perf_log") == 0) {
+      if (i + 1 >= *argc) {
+        return -1;
+      }
+      snprintf(file, len, "%s", argv[++i]);
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argv[n] = NULL;
+  *argc = n;
+  return 0;
+}
+
+void goma_perf_log_newton(goma_perf_log *log, double assembly_s, double solve_s) {
+  log->assembly_s += assembly_s;
+  log->solve_s += solve_s;
+  log->newton_iterations++;
+}
+
+void goma_perf_log_time_step(goma_perf_log *log) { log->time_steps++; }
+
+void goma_perf_log_output(goma_perf_log *log, double output_s) {
+  log->output_s += output_s;
+  log->outputs++;
+}
+
+double goma_perf_log_peak_rss_kb(void) {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0.0;
+  }
+#ifdef __APPLE__
+  return (double)usage.ru_maxrss / 1024.0; /* bytes on macOS */
+#else
+  return (double)usage.ru_maxrss;
+#endif
+}
+
+int goma_perf_log_reduce(const goma_perf_log *log, MPI_Comm comm, goma_perf_log *reduced) {
+  double rss = goma_perf_log_peak_rss_kb();
+  double local_max[5] = {log->assembly_s, log->solve_s, log->output_s, log->wall_s, rss};
+  double global_max[5];
+  double rss_sum;
+  int size;
+  int initialized;
+
+  *reduced = *log;
+  /* serial builds never initialize MPI, the log is then this process's own */
+  if (MPI_Initialized(&initialized) == MPI_SUCCESS && !initialized) {
+    reduced->processors = 1;
+    reduced->peak_rss_max_kb = rss;
+    reduced->peak_rss_sum_kb = rss;
+    return 0;
+  }
+  if (MPI_Comm_size(comm, &size) != MPI_SUCCESS ||
+      MPI_Allreduce(local_max, global_max, 5, MPI_DOUBLE, MPI_MAX, comm) != MPI_SUCCESS ||
+      MPI_Allreduce(&rss, &rss_sum, 1, MPI_DOUBLE, MPI_SUM, comm) != MPI_SUCCESS) {
+    return -1;
+  }
+  /* iteration and step counts are the same on every rank */
+  reduced->assembly_s = global_max[0];
+  reduced->solve_s = global_max[1];
+  reduced->output_s = global_max[2];
+  reduced->wall_s = global_max[3];
+  reduced->processors = size;
+  reduced->peak_rss_max_kb = global_max[4];
+  reduced->peak_rss_sum_kb = rss_sum;
+  return 0;
+}
+
+static void goma_perf_log_json_string(FILE *file, const char *s) {
+  fputc('"', file);
+  for (; *s != '\0'; s++) {
+    unsigned char c = (unsigned char)*s;
+    if (c == '"' || c == '\\') {
+      fprintf(file, "\\%c", c);
+    } else if (c < 0x20) {
+      fprintf(file, "\\u%04x", c);
+    } else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+int goma_perf_log_write_json(const goma_perf_log *log, const char *input_file, FILE *file) {
+  /* a steady run is one step */
+  int steps = log->time_steps > 0 ? log->time_steps : 1;
+
+  fprintf(file, "{\n  \"input_file\": ");
+  goma_perf_log_json_string(file, input_file);
+  fprintf(file, ",\n  \"processors\": %d", log->processors);
+  fprintf(file, ",\n  \"wall_s\": %.6g", log->wall_s);
+  fprintf(file, ",\n  \"assembly_s\": %.6g", log->assembly_s);
+  fprintf(file, ",\n  \"solve_s\": %.6g", log->solve_s);
+  fprintf(file, ",\n  \"newton_iterations\": %d", log->newton_iterations);
+  fprintf(file, ",\n  \"time_steps\": %d", log->time_steps);
+  fprintf(file, ",\n  \"outputs\": %d", log->outputs);
+  fprintf(file, ",\n  \"output_s\": %.6g", log->output_s);
+  fprintf(file, ",\n  \"output_s_per_step\": %.6g", log->output_s / steps);
+  fprintf(file, ",\n  \"newton_iterations_per_step\": %.6g",
+          (double)log->newton_iterations / steps);
+  fprintf(file, ",\n  \"peak_rss_max_mb\": %.6g", log->peak_rss_max_kb / 1024.0);
+  fprintf(file, ",\n  \"peak_rss_sum_mb\": %.6g", log->peak_rss_sum_kb / 1024.0);
+  fprintf(file, "\n}\n");
+  return ferror(file) ? -1 : 0;
+}
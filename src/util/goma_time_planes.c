@@ -0,0 +1,68 @@
+#include "util/goma_time_planes.h"
+
+int goma_time_plane_bracket(
+    const double *times, int num_times, double t, int *lower, int *higher, double *weight) {
+  if (num_times < 1) {
+    return -1;
+  }
+
+  /* first plane at or after t, the last one when t is past them all */
+  int k = 0;
+  while (k < num_times - 1 && t > times[k]) {
+    k++;
+  }
+
+  *higher = k + 1;
+  *lower = k > 0 ? k : 1;
+  *weight = 0.0;
+  if (*lower != *higher && times[k] != times[k - 1]) {
+    *weight = (t - times[k - 1]) / (times[k] - times[k - 1]);
+  }
+  return 0;
+}
+
+void goma_time_plane_slots(int slot_plane[GOMA_TIME_PLANE_SLOTS],
+                           int lower,
+                           int higher,
+                           int slot[2],
+                           int load[GOMA_TIME_PLANE_SLOTS]) {
+  int plane[2] = {lower, higher};
+  int claimed[GOMA_TIME_PLANE_SLOTS];
+
+  for (int s = 0; s < GOMA_TIME_PLANE_SLOTS; s++) {
+    claimed[s] = 0;
+    load[s] = 0;
+  }
+
+  /* keep what is already held */
+  for (int p = 0; p < 2; p++) {
+    slot[p] = -1;
+    for (int s = 0; s < GOMA_TIME_PLANE_SLOTS; s++) {
+      if (slot_plane[s] == plane[p]) {
+        slot[p] = s;
+        claimed[s] = 1;
+      }
+    }
+  }
+
+  /* read the rest into buffers nobody needs */
+  for (int p = 0; p < 2; p++) {
+    if (slot[p] != -1) {
+      continue;
+    }
+    if (p == 1 && plane[1] == plane[0]) {
+      /* the same buffer serves both */
+      slot[1] = slot[0];
+      continue;
+    }
+    for (int s = 0; s < GOMA_TIME_PLANE_SLOTS; s++) {
+      if (!claimed[s]) {
+        slot[p] = s;
+        claimed[s] = 1;
+        slot_plane[s] = plane[p];
+        load[s] = 1;
+        break;
+      }
+    }
+  }
+}
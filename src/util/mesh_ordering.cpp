@@ -0,0 +1,165 @@
+#include "util/mesh_ordering.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+/*
+ * Breadth first search from root over the nodes in [begin, end), fills level
+ * (indexed from begin, -1 when not reached) and returns the nodes in the order
+ * they were reached
+ */
+std::vector<int> bfs_levels(const int *ptr,
+                            const int *adj,
+                            const int begin,
+                            const int end,
+                            const int root,
+                            std::vector<int> &level) {
+  std::vector<int> reached;
+  reached.push_back(root);
+  level[root - begin] = 0;
+  for (size_t head = 0; head < reached.size(); head++) {
+    int node = reached[head];
+    for (int k = ptr[node]; k < ptr[node + 1]; k++) {
+      int nbr = adj[k];
+      if (nbr >= begin && nbr < end && level[nbr - begin] < 0) {
+        level[nbr - begin] = level[node - begin] + 1;
+        reached.push_back(nbr);
+      }
+    }
+  }
+  return reached;
+}
+
+/*
+ * George-Liu pseudo-peripheral node of the component containing seed, level
+ * is work space that must be all -1 and is left that way
+ */
+int pseudo_peripheral_node(const int *ptr,
+                           const int *adj,
+                           const int begin,
+                           const int end,
+                           const std::vector<int> &degree,
+                           const int seed,
+                           std::vector<int> &level) {
+  int root = seed;
+  int eccentricity = -1;
+  for (int iter = 0; iter < 8; iter++) {
+    std::vector<int> reached = bfs_levels(ptr, adj, begin, end, root, level);
+    int last = level[reached.back() - begin];
+    int candidate = reached.back();
+    for (int node : reached) {
+      if (level[node - begin] == last && degree[node - begin] < degree[candidate - begin]) {
+        candidate = node;
+      }
+      level[node - begin] = -1;
+    }
+    if (last <= eccentricity) {
+      break;
+    }
+    eccentricity = last;
+    root = candidate;
+  }
+  return root;
+}
+
+/* reverse Cuthill-McKee order of the nodes in [begin, end) into result */
+void rcm_order(const int *ptr, const int *adj, const int begin, const int end, int *result) {
+  int n = end - begin;
+  std::vector<int> degree(n, 0);
+  for (int node = begin; node < end; node++) {
+    for (int k = ptr[node]; k < ptr[node + 1]; k++) {
+      if (adj[k] >= begin && adj[k] < end && adj[k] != node) {
+        degree[node - begin]++;
+      }
+    }
+  }
+  auto by_degree = [&](int a, int b) {
+    return degree[a - begin] < degree[b - begin] ||
+           (degree[a - begin] == degree[b - begin] && a < b);
+  };
+
+  std::vector<int> seeds(n);
+  std::iota(seeds.begin(), seeds.end(), begin);
+  std::sort(seeds.begin(), seeds.end(), by_degree);
+
+  std::vector<int> order;
+  order.reserve(n);
+  std::vector<char> visited(n, 0);
+  std::vector<int> level(n, -1);
+  std::vector<int> nbrs;
+  for (int seed : seeds) {
+    if (visited[seed - begin]) {
+      continue;
+    }
+    int root = pseudo_peripheral_node(ptr, adj, begin, end, degree, seed, level);
+    size_t head = order.size();
+    order.push_back(root);
+    visited[root - begin] = 1;
+    for (; head < order.size(); head++) {
+      int node = order[head];
+      nbrs.clear();
+      for (int k = ptr[node]; k < ptr[node + 1]; k++) {
+        int nbr = adj[k];
+        if (nbr >= begin && nbr < end && !visited[nbr - begin]) {
+          visited[nbr - begin] = 1;
+          nbrs.push_back(nbr);
+        }
+      }
+      std::sort(nbrs.begin(), nbrs.end(), by_degree);
+      order.insert(order.end(), nbrs.begin(), nbrs.end());
+    }
+  }
+  std::reverse_copy(order.begin(), order.end(), result);
+}
+
+} // namespace
+
+int goma_rcm_order(const int *ptr, const int *adj, int begin, int end, int *order) {
+  try {
+    rcm_order(ptr, adj, begin, end, order);
+  } catch (const std::bad_alloc &) {
+    return -1;
+  }
+  return 0;
+}
+
+uint64_t goma_hilbert_index(uint32_t X[3], int dim, int bits) {
+  uint32_t M = 1u << (bits - 1);
+  for (uint32_t Q = M; Q > 1; Q >>= 1) {
+    uint32_t P = Q - 1;
+    for (int i = 0; i < dim; i++) {
+      if (X[i] & Q) {
+        X[0] ^= P;
+      } else {
+        uint32_t t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+  for (int i = 1; i < dim; i++) {
+    X[i] ^= X[i - 1];
+  }
+  uint32_t t = 0;
+  for (uint32_t Q = M; Q > 1; Q >>= 1) {
+    if (X[dim - 1] & Q) {
+      t ^= Q - 1;
+    }
+  }
+  for (int i = 0; i < dim; i++) {
+    X[i] ^= t;
+  }
+
+  uint64_t key = 0;
+  for (int b = bits - 1; b >= 0; b--) {
+    for (int i = 0; i < dim; i++) {
+      key = (key << 1) | ((X[i] >> b) & 1u);
+    }
+  }
+  return key;
+}
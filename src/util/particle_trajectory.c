@@ -0,0 +1,273 @@
+#include "util/particle_trajectory.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char goma_ptrj_magic[8] = {'G', 'O', 'M', 'A', 'P', 'T', 'R', 'J'};
+static const int goma_ptrj_byte_order = 0x01020304;
+
+static int write_ints(FILE *fp, const int *v, size_t n) {
+  return fwrite(v, sizeof(int), n, fp) == n ? 0 : -1;
+}
+
+static int write_doubles(FILE *fp, const double *v, size_t n) {
+  return fwrite(v, sizeof(double), n, fp) == n ? 0 : -1;
+}
+
+static int read_ints(FILE *fp, int *v, size_t n) {
+  return fread(v, sizeof(int), n, fp) == n ? 0 : -1;
+}
+
+static int read_doubles(FILE *fp, double *v, size_t n) {
+  return fread(v, sizeof(double), n, fp) == n ? 0 : -1;
+}
+
+static void goma_ptrj_free(goma_ptrj_writer *w) {
+  if (w->fp != NULL) {
+    fclose(w->fp);
+  }
+  free(w->x);
+  free(w->time);
+  free(w->vars);
+  free(w->proc_id);
+  free(w);
+}
+
+goma_ptrj_writer *goma_ptrj_open(const char *filename,
+                                 int pdim,
+                                 int num_vars,
+                                 const char *const *var_names,
+                                 int has_proc_id,
+                                 int capacity) {
+  if (pdim < 1 || pdim > 3 || num_vars < 0) {
+    return NULL;
+  }
+  if (capacity <= 0) {
+    capacity = GOMA_PTRJ_DEFAULT_CAPACITY;
+  }
+
+  goma_ptrj_writer *w = calloc(1, sizeof(goma_ptrj_writer));
+  if (w == NULL) {
+    return NULL;
+  }
+  w->pdim = pdim;
+  w->num_vars = num_vars;
+  w->has_proc_id = has_proc_id ? 1 : 0;
+  w->capacity = capacity;
+  w->count = 0;
+  w->x = malloc(sizeof(double) * pdim * capacity);
+  w->time = malloc(sizeof(double) * capacity);
+  w->vars = malloc(sizeof(double) * (num_vars > 0 ? num_vars : 1) * capacity);
+  w->proc_id = w->has_proc_id ? malloc(sizeof(int) * capacity) : NULL;
+  w->fp = fopen(filename, "wb");
+  if (w->x == NULL || w->time == NULL || w->vars == NULL ||
+      (w->has_proc_id && w->proc_id == NULL) || w->fp == NULL) {
+    goma_ptrj_free(w);
+    return NULL;
+  }
+
+  int header[5] = {GOMA_PTRJ_VERSION, goma_ptrj_byte_order, pdim, num_vars, w->has_proc_id};
+  int err = fwrite(goma_ptrj_magic, 1, sizeof(goma_ptrj_magic), w->fp) == sizeof(goma_ptrj_magic)
+                ? 0
+                : -1;
+  if (!err) {
+    err = write_ints(w->fp, header, 5);
+  }
+  for (int i = 0; i < num_vars && !err; i++) {
+    char name[GOMA_PTRJ_NAME_LENGTH];
+    memset(name, 0, sizeof(name));
+    strncpy(name, var_names[i], GOMA_PTRJ_NAME_LENGTH - 1);
+    err = fwrite(name, 1, GOMA_PTRJ_NAME_LENGTH, w->fp) == GOMA_PTRJ_NAME_LENGTH ? 0 : -1;
+  }
+  if (err) {
+    goma_ptrj_free(w);
+    return NULL;
+  }
+  return w;
+}
+
+static int goma_ptrj_write_chunk(goma_ptrj_writer *w) {
+  if (w->count == 0) {
+    return 0;
+  }
+
+  int head[2] = {GOMA_PTRJ_CHUNK, w->count};
+  int err = write_ints(w->fp, head, 2);
+  for (int d = 0; d < w->pdim && !err; d++) {
+    err = write_doubles(w->fp, w->x + (size_t)d * w->capacity, w->count);
+  }
+  if (!err) {
+    err = write_doubles(w->fp, w->time, w->count);
+  }
+  for (int v = 0; v < w->num_vars && !err; v++) {
+    err = write_doubles(w->fp, w->vars + (size_t)v * w->capacity, w->count);
+  }
+  if (!err && w->has_proc_id) {
+    err = write_ints(w->fp, w->proc_id, w->count);
+  }
+  w->count = 0;
+  return err;
+}
+
+int goma_ptrj_append(goma_ptrj_writer *w,
+                     const double *x,
+                     double time,
+                     const double *vars,
+                     int proc_id) {
+  if (w->count == w->capacity) {
+    if (goma_ptrj_write_chunk(w)) {
+      return -1;
+    }
+  }
+
+  int n = w->count;
+  for (int d = 0; d < w->pdim; d++) {
+    w->x[(size_t)d * w->capacity + n] = x[d];
+  }
+  w->time[n] = time;
+  for (int v = 0; v < w->num_vars; v++) {
+    w->vars[(size_t)v * w->capacity + n] = vars[v];
+  }
+  if (w->has_proc_id) {
+    w->proc_id[n] = proc_id;
+  }
+  w->count++;
+  return 0;
+}
+
+int goma_ptrj_zone(goma_ptrj_writer *w, double time) {
+  int kind = GOMA_PTRJ_ZONE;
+  if (goma_ptrj_write_chunk(w)) {
+    return -1;
+  }
+  if (write_ints(w->fp, &kind, 1)) {
+    return -1;
+  }
+  return write_doubles(w->fp, &time, 1);
+}
+
+int goma_ptrj_flush(goma_ptrj_writer *w) {
+  if (goma_ptrj_write_chunk(w)) {
+    return -1;
+  }
+  return fflush(w->fp) == 0 ? 0 : -1;
+}
+
+int goma_ptrj_close(goma_ptrj_writer *w) {
+  if (w == NULL) {
+    return 0;
+  }
+  int err = goma_ptrj_write_chunk(w);
+  if (fclose(w->fp) != 0) {
+    err = -1;
+  }
+  w->fp = NULL;
+  goma_ptrj_free(w);
+  return err;
+}
+
+/*
+ * Write the samples of a binary trajectory file as the rows the text
+ * particle output would have produced.  With tecplot_header the
+ * TITLE/VARIABLES lines and ZONE records are written too; otherwise
+ * zones are dropped, giving FLAT_TEXT output.
+ */
+int goma_ptrj_to_tecplot(const char *filename, FILE *out, int tecplot_header) {
+  FILE *fp = fopen(filename, "rb");
+  if (fp == NULL) {
+    return -1;
+  }
+
+  char magic[sizeof(goma_ptrj_magic)];
+  int header[5];
+  if (fread(magic, 1, sizeof(magic), fp) != sizeof(magic) ||
+      memcmp(magic, goma_ptrj_magic, sizeof(magic)) != 0 || read_ints(fp, header, 5) ||
+      header[0] != GOMA_PTRJ_VERSION || header[1] != goma_ptrj_byte_order || header[2] < 1 ||
+      header[2] > 3 || header[3] < 0) {
+    fclose(fp);
+    return -1;
+  }
+  int pdim = header[2];
+  int num_vars = header[3];
+  int has_proc_id = header[4];
+
+  char *names = calloc((size_t)(num_vars > 0 ? num_vars : 1), GOMA_PTRJ_NAME_LENGTH);
+  if (names == NULL ||
+      fread(names, GOMA_PTRJ_NAME_LENGTH, num_vars, fp) != (size_t)num_vars) {
+    free(names);
+    fclose(fp);
+    return -1;
+  }
+
+  if (tecplot_header) {
+    static const char *coord_names[3] = {"X", "Y", "Z"};
+    fprintf(out, "TITLE = \"Goma Particles\"\n");
+    fprintf(out, "VARIABLES = ");
+    for (int d = 0; d < pdim; d++) {
+      fprintf(out, "\"%s\", ", coord_names[d]);
+    }
+    fprintf(out, "\"TIME\"");
+    for (int v = 0; v < num_vars; v++) {
+      names[(size_t)v * GOMA_PTRJ_NAME_LENGTH + GOMA_PTRJ_NAME_LENGTH - 1] = '\0';
+      fprintf(out, ", \"%s\"", names + (size_t)v * GOMA_PTRJ_NAME_LENGTH);
+    }
+    if (has_proc_id) {
+      fprintf(out, ", \"PROCID\"");
+    }
+    fprintf(out, "\n");
+  }
+  free(names);
+
+  int err = 0;
+  int ncol = pdim + 1 + num_vars;
+  double *cols = NULL;
+  int *proc_id = NULL;
+  int kind;
+  while (!err && read_ints(fp, &kind, 1) == 0) {
+    if (kind == GOMA_PTRJ_ZONE) {
+      double zone_time;
+      err = read_doubles(fp, &zone_time, 1);
+      if (!err && tecplot_header) {
+        fprintf(out, "ZONE T=\"%g\"\n", zone_time);
+      }
+    } else if (kind == GOMA_PTRJ_CHUNK) {
+      int n;
+      if (read_ints(fp, &n, 1) || n < 0) {
+        err = -1;
+        break;
+      }
+      double *new_cols = realloc(cols, sizeof(double) * ncol * (n > 0 ? n : 1));
+      int *new_proc = realloc(proc_id, sizeof(int) * (n > 0 ? n : 1));
+      if (new_cols != NULL) {
+        cols = new_cols;
+      }
+      if (new_proc != NULL) {
+        proc_id = new_proc;
+      }
+      if (new_cols == NULL || new_proc == NULL) {
+        err = -1;
+        break;
+      }
+      err = read_doubles(fp, cols, (size_t)ncol * n);
+      if (!err && has_proc_id) {
+        err = read_ints(fp, proc_id, n);
+      }
+      for (int i = 0; i < n && !err; i++) {
+        for (int c = 0; c < ncol; c++) {
+          fprintf(out, " %12g", cols[(size_t)c * n + i]);
+        }
+        if (has_proc_id) {
+          fprintf(out, " %d", proc_id[i]);
+        }
+        fprintf(out, "\n");
+      }
+    } else {
+      err = -1;
+    }
+  }
+
+  free(cols);
+  free(proc_id);
+  fclose(fp);
+  return err;
+}
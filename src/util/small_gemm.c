@@ -0,0 +1,36 @@
+#include "util/small_gemm.h"
+
+#include <stddef.h>
+
+void goma_small_gemm(int m,
+                     int n,
+                     int k,
+                     const double *restrict A,
+                     int lda,
+                     const double *restrict B,
+                     int ldb,
+                     double *restrict C,
+                     int ldc) {
+  for (int i = 0; i < m; i++) {
+    const double *a = A + (size_t)i * lda;
+    double *c = C + (size_t)i * ldc;
+    int l = 0;
+    for (; l + 4 <= k; l += 4) {
+      const double a0 = a[l], a1 = a[l + 1], a2 = a[l + 2], a3 = a[l + 3];
+      const double *b0 = B + (size_t)l * ldb;
+      const double *b1 = b0 + ldb;
+      const double *b2 = b1 + ldb;
+      const double *b3 = b2 + ldb;
+      for (int j = 0; j < n; j++) {
+        c[j] += a0 * b0[j] + a1 * b1[j] + a2 * b2[j] + a3 * b3[j];
+      }
+    }
+    for (; l < k; l++) {
+      const double a0 = a[l];
+      const double *b0 = B + (size_t)l * ldb;
+      for (int j = 0; j < n; j++) {
+        c[j] += a0 * b0[j];
+      }
+    }
+  }
+}
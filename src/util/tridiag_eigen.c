@@ -0,0 +1,98 @@
+#include "util/tridiag_eigen.h"
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+
+#define TRIDIAG_MAX_ITER 30
+
+int goma_tridiag_eigen(
+    int n, const double *diag, const double *offdiag, double *eigenvalues, double *z0) {
+  if (n < 1 || n > GOMA_TRIDIAG_EIGEN_MAX_N) {
+    return -1;
+  }
+
+  double *d = eigenvalues;
+  double e[GOMA_TRIDIAG_EIGEN_MAX_N];
+  double z[GOMA_TRIDIAG_EIGEN_MAX_N];
+  for (int i = 0; i < n; i++) {
+    d[i] = diag[i];
+    e[i] = (i < n - 1) ? offdiag[i] : 0.0;
+    z[i] = (i == 0) ? 1.0 : 0.0;
+  }
+
+  for (int l = 0; l < n; l++) {
+    int iter = 0;
+    int m;
+    do {
+      for (m = l; m < n - 1; m++) {
+        double dd = fabs(d[m]) + fabs(d[m + 1]);
+        if (fabs(e[m]) <= DBL_EPSILON * dd) {
+          break;
+        }
+      }
+      if (m == l) {
+        break;
+      }
+      if (iter++ == TRIDIAG_MAX_ITER) {
+        return -1;
+      }
+
+      /* Wilkinson shift from the leading 2x2 block */
+      double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+      double r = hypot(g, 1.0);
+      g = d[m] - d[l] + e[l] / (g + copysign(r, g));
+      double s = 1.0, c = 1.0, p = 0.0;
+      int i;
+      for (i = m - 1; i >= l; i--) {
+        double f = s * e[i];
+        double b = c * e[i];
+        r = hypot(f, g);
+        e[i + 1] = r;
+        if (r == 0.0) {
+          /* underflow, deflate and start over */
+          d[i + 1] -= p;
+          e[m] = 0.0;
+          break;
+        }
+        s = f / r;
+        c = g / r;
+        g = d[i + 1] - p;
+        r = (d[i] - g) * s + 2.0 * c * b;
+        p = s * r;
+        d[i + 1] = g + p;
+        g = c * r - b;
+
+        f = z[i + 1];
+        z[i + 1] = s * z[i] + c * f;
+        z[i] = c * z[i] - s * f;
+      }
+      if (r == 0.0 && i >= l) {
+        continue;
+      }
+      d[l] -= p;
+      e[l] = g;
+      e[m] = 0.0;
+    } while (m != l);
+  }
+
+  /* ascending order, n is small */
+  for (int i = 1; i < n; i++) {
+    double dv = d[i];
+    double zv = z[i];
+    int j = i - 1;
+    for (; j >= 0 && d[j] > dv; j--) {
+      d[j + 1] = d[j];
+      z[j + 1] = z[j];
+    }
+    d[j + 1] = dv;
+    z[j + 1] = zv;
+  }
+
+  if (z0 != NULL) {
+    for (int i = 0; i < n; i++) {
+      z0[i] = z[i];
+    }
+  }
+  return 0;
+}
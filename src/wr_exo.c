@@ -740,7 +740,7 @@ void wr_nodal_result_exo(Exo_DB *exo,
   }
   error = ex_put_var(exo->exoid, time_step, EX_NODAL, variable_index, 1, exo->base_mesh->num_nodes,
                      base_vector);
-  free(base_vector);
+  safe_free(base_vector);
   GOMA_EH(error, "ex_put_var nodal");
   error = ex_close(exo->exoid);
   GOMA_EH(error, "ex_close");
@@ -791,7 +791,7 @@ void wr_elem_result_exo(Exo_DB *exo,
 
         error = ex_put_var(exo->exoid, time_step, EX_ELEM_BLOCK, variable_index + 1, exo->eb_id[i],
                            exo->base_mesh->eb_num_elems[i], base_vector);
-        free(base_vector);
+        safe_free(base_vector);
         GOMA_EH(error, "ex_put_var elem");
       }
     } else {
@@ -872,7 +872,7 @@ void create_truth_table(struct Results_Description *rd, Exo_DB *exo, double ***g
 
   tev = 0;
   i = 0;
-  free(exo->elem_var_tab);
+  safe_free(exo->elem_var_tab);
   exo->elem_var_tab = alloc_int_1((exo->num_elem_blocks * rd->nev), 0);
   exo->truth_table_existance_key = (int *)smalloc((V_LAST - V_FIRST) * sizeof(int));
 
@@ -1210,7 +1210,7 @@ void create_truth_table_segregated(struct Results_Description **rd,
   }
   tev = 0;
   i = 0;
-  free(exo->elem_var_tab);
+  safe_free(exo->elem_var_tab);
   exo->elem_var_tab = (int *)smalloc((exo->num_elem_blocks * total_nev) * sizeof(int));
   exo->truth_table_existance_key = (int *)smalloc((V_LAST - V_FIRST) * sizeof(int));
 
@@ -15,6 +15,7 @@
 #define _WR_SOLN_C
 #include "wr_soln.h"
 
+#include <mpi.h>
 #include <stdbool.h>
 #include <stdio.h>
 
@@ -31,6 +32,7 @@
 #include "rf_fem_const.h"
 #include "rf_io_structs.h"
 #include "std.h"
+#include "util/goma_perf_log.h"
 #include "wr_exo.h"
 
 /***********************************************************************/
@@ -72,6 +74,7 @@ void write_solution(char output_file[],             /* name EXODUS II file */
  *************************************************************************/
 {
   int i, i_post, step = 0;
+  double output_start = MPI_Wtime();
 
   /* First nodal quantities */
   for (i = 0; i < rd->TotalNVSolnOutput; i++) {
@@ -150,6 +153,7 @@ void write_solution(char output_file[],             /* name EXODUS II file */
       }
     }
   }
+  goma_perf_log_output(&Goma_Perf_Log, MPI_Wtime() - output_start);
 }
 
 void write_solution_segregated(char output_file[],
@@ -172,6 +176,7 @@ void write_solution_segregated(char output_file[],
                                Dpi *dpi) {
   int i, step = 0;
   int i_post;
+  double output_start = MPI_Wtime();
 
   /* First nodal quantities */
   int offset = 0;
@@ -306,6 +311,7 @@ void write_solution_segregated(char output_file[],
   //        }
   //      }
   //  }
+  goma_perf_log_output(&Goma_Perf_Log, MPI_Wtime() - output_start);
 }
 /*****************************************************************************/
 /*  END of file wr_soln.c  */
@@ -0,0 +1,207 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "gds/gds_vec3.h"
+#include "gds/gds_vector.h"
+
+static const auto zero_comp = Catch::Matchers::WithinAbsMatcher(0.0, 1e-15);
+
+TEST_CASE("gds vec3 layout", "[gds][gds_vec3]") {
+  gds_vec3 v = gds_vec3_make(1.0, 2.0, 3.0);
+  REQUIRE(reinterpret_cast<uintptr_t>(&v) % GDS_VEC3_ALIGNMENT == 0);
+  REQUIRE(v.data[0] == 1.0);
+  REQUIRE(v.data[1] == 2.0);
+  REQUIRE(v.data[2] == 3.0);
+  REQUIRE(v.data[3] == 0.0);
+  REQUIRE(sizeof(gds_vec3) % GDS_VEC3_ALIGNMENT == 0);
+  REQUIRE(sizeof(gds_mat3) % GDS_VEC3_ALIGNMENT == 0);
+}
+
+TEST_CASE("gds vec3 arithmetic", "[gds][gds_vec3]") {
+  gds_vec3 v = gds_vec3_make(1.0, -2.0, 0.5);
+  gds_vec3 u = gds_vec3_make(4.0, 3.0, -1.0);
+
+  REQUIRE(gds_vec3_dot(&v, &u) == Catch::Approx(1.0 * 4.0 - 2.0 * 3.0 - 0.5));
+  REQUIRE(gds_vec3_norm(&u) == Catch::Approx(sqrt(26.0)));
+
+  gds_vec3 w = v;
+  gds_vec3_add(&w, &u);
+  REQUIRE(w.data[0] == 5.0);
+  REQUIRE(w.data[1] == 1.0);
+  REQUIRE(w.data[2] == -0.5);
+  gds_vec3_sub(&w, &u);
+  REQUIRE(w.data[0] == v.data[0]);
+  REQUIRE(w.data[1] == v.data[1]);
+  REQUIRE(w.data[2] == v.data[2]);
+
+  gds_vec3_axpy(2.0, &u, -1.0, &w);
+  REQUIRE(w.data[0] == 7.0);
+  REQUIRE(w.data[1] == 8.0);
+  REQUIRE(w.data[2] == -2.5);
+  REQUIRE(w.data[3] == 0.0);
+
+  gds_vec3 z = gds_vec3_make(1.0, 1.0, 1.0);
+  w = v;
+  double dot = gds_vec3_axpy_dot(2.0, &u, -1.0, &w, &z);
+  REQUIRE(dot == Catch::Approx(7.0 + 8.0 - 2.5));
+  REQUIRE(w.data[0] == 7.0);
+
+  gds_vec3 zero;
+  gds_vec3_zero(&zero);
+  REQUIRE(gds_vec3_normalize(&zero) == 0.0);
+  REQUIRE(zero.data[0] == 0.0);
+  double mag = gds_vec3_normalize(&u);
+  REQUIRE(mag == Catch::Approx(sqrt(26.0)));
+  REQUIRE(gds_vec3_norm(&u) == Catch::Approx(1.0));
+}
+
+TEST_CASE("gds vec3 cross matches gds_vector", "[gds][gds_vec3]") {
+  gds_vector *a = gds_vector_alloc(3);
+  gds_vector *b = gds_vector_alloc(3);
+  gds_vector *c = gds_vector_alloc(3);
+  gds_vector_set(a, 0, 0.3);
+  gds_vector_set(a, 1, -1.2);
+  gds_vector_set(a, 2, 2.0);
+  gds_vector_set(b, 0, 1.5);
+  gds_vector_set(b, 1, 0.25);
+  gds_vector_set(b, 2, -0.7);
+  gds_vector_cross(a, b, c);
+
+  gds_vec3 va, vb, vc;
+  gds_vec3_from_vector(&va, a);
+  gds_vec3_from_vector(&vb, b);
+  gds_vec3_cross(&va, &vb, &vc);
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(vc.data[i] == Catch::Approx(gds_vector_get(c, i)));
+  }
+
+  // output may alias an input
+  gds_vec3_cross(&va, &vb, &va);
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(va.data[i] == Catch::Approx(gds_vector_get(c, i)));
+  }
+
+  gds_vec3_from_vector(&va, a);
+  gds_vec3 n;
+  double mag = gds_vec3_cross_normalize(&va, &vb, &n);
+  REQUIRE(mag == Catch::Approx(sqrt(gds_vector_dot(c, c))));
+  REQUIRE(gds_vec3_norm(&n) == Catch::Approx(1.0));
+  REQUIRE_THAT(gds_vec3_dot(&n, &va), zero_comp);
+  REQUIRE_THAT(gds_vec3_dot(&n, &vb), zero_comp);
+
+  gds_vector_free(a);
+  gds_vector_free(b);
+  gds_vector_free(c);
+}
+
+TEST_CASE("gds mat3 rotation", "[gds][gds_vec3]") {
+  gds_vec3 axis = gds_vec3_make(1.0, 2.0, -0.5);
+  gds_vec3_normalize(&axis);
+  gds_vec3 x = gds_vec3_make(0.2, -0.4, 1.1);
+  double angle = 0.7;
+
+  gds_mat3 R;
+  gds_mat3_rotation(&R, &axis, angle);
+  gds_vec3 y;
+  gds_mat3_mul_vec(&R, &x, &y);
+
+  gds_vec3 y2;
+  gds_vec3_rotate_around_vector(&y2, &x, &axis, angle);
+
+  gds_vector *gx = gds_vector_alloc(3);
+  gds_vector *gaxis = gds_vector_alloc(3);
+  gds_vector *gy = gds_vector_alloc(3);
+  gds_vec3_to_vector(gx, &x);
+  gds_vec3_to_vector(gaxis, &axis);
+  gds_vector_rotate_around_vector(gy, gx, gaxis, angle);
+
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(y.data[i] == Catch::Approx(gds_vector_get(gy, i)));
+    REQUIRE(y2.data[i] == Catch::Approx(gds_vector_get(gy, i)));
+  }
+  REQUIRE(y.data[3] == 0.0);
+
+  // R^T R = I and R^T undoes the rotation
+  gds_vec3 back;
+  gds_mat3_mul_vec_transpose(&R, &y, &back);
+  for (int i = 0; i < 3; i++) {
+    REQUIRE(back.data[i] == Catch::Approx(x.data[i]));
+  }
+  gds_mat3 R2, RRinv;
+  gds_mat3_rotation(&R2, &axis, -angle);
+  gds_mat3_mul(&R, &R2, &RRinv);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      if (i == j) {
+        REQUIRE(RRinv.data[i][j] == Catch::Approx(1.0));
+      } else {
+        REQUIRE_THAT(RRinv.data[i][j], zero_comp);
+      }
+    }
+  }
+
+  gds_vector_free(gx);
+  gds_vector_free(gaxis);
+  gds_vector_free(gy);
+}
+
+TEST_CASE("gds vector block allocation", "[gds][gds_vector]") {
+  gds_vector *vectors[10];
+  void *block = gds_vector_alloc_block(10, 3, vectors);
+  REQUIRE(block != NULL);
+  for (int i = 0; i < 10; i++) {
+    REQUIRE(vectors[i]->size == 3);
+    REQUIRE(reinterpret_cast<uintptr_t>(vectors[i]->data) % sizeof(double) == 0);
+    gds_vector_set_all(vectors[i], i);
+  }
+  // vectors must not overlap
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 3; j++) {
+      REQUIRE(gds_vector_get(vectors[i], j) == i);
+    }
+  }
+  gds_vector_free_block(block);
+}
+
+TEST_CASE("gds vec3 cross and normalize benchmark", "[gds][gds_vec3][!benchmark]") {
+  const size_t n = 1024;
+  static gds_vec3 v[n], u[n];
+  for (size_t i = 0; i < n; i++) {
+    v[i] = gds_vec3_make(1.0 + i, 0.5, -2.0);
+    u[i] = gds_vec3_make(0.3, 2.0 + i, 1.0);
+  }
+
+  BENCHMARK("gds_vector heap temporaries") {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+      gds_vector *a = gds_vector_alloc(3);
+      gds_vector *b = gds_vector_alloc(3);
+      gds_vector *c = gds_vector_alloc(3);
+      gds_vec3_to_vector(a, &v[i]);
+      gds_vec3_to_vector(b, &u[i]);
+      gds_vector_cross(a, b, c);
+      gds_vector_normalize(c);
+      sum += gds_vector_get(c, 0);
+      gds_vector_free(a);
+      gds_vector_free(b);
+      gds_vector_free(c);
+    }
+    return sum;
+  };
+
+  BENCHMARK("gds_vec3 stack") {
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+      gds_vec3 c;
+      gds_vec3_cross_normalize(&v[i], &u[i], &c);
+      sum += c.data[0];
+    }
+    return sum;
+  };
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstring>
+#include <mpi.h>
+
+extern "C" {
+#include "loca_const.h"
+#include "loca_util_const.h"
+}
+
+// turning_point_alg driven through stand-ins for the goma conwrap layer.
+// The problem is
+//
+//   R1 = x1^3 / 3 - x1 + p
+//   R2 = x2 - x1^2 - 1
+//
+// whose solution branch folds at x = (1, 2), p = 2/3.
+
+namespace {
+
+const int N = 2;
+
+double bif_param;
+double jac[N][N];
+double saved_jac[N][N];
+int n_single_solves;
+int n_multi_solves;
+
+void residual(const double *x, double *r) {
+  r[0] = x[0] * x[0] * x[0] / 3.0 - x[0] + bif_param;
+  r[1] = x[1] - x[0] * x[0] - 1.0;
+}
+
+void jacobian(const double *x, double j[N][N]) {
+  j[0][0] = x[0] * x[0] - 1.0;
+  j[0][1] = 0.0;
+  j[1][0] = -2.0;
+  j[1][1] = 1.0;
+}
+
+// solves jac y = x in place, as the goma linear solvers do
+int solve(double *x) {
+  double det = jac[0][0] * jac[1][1] - jac[0][1] * jac[1][0];
+  if (std::fabs(det) < 1e-300) {
+    return -1;
+  }
+  double y0 = (jac[1][1] * x[0] - jac[0][1] * x[1]) / det;
+  double y1 = (jac[0][0] * x[1] - jac[1][0] * x[0]) / det;
+  x[0] = y0;
+  x[1] = y1;
+  return 0;
+}
+
+} // namespace
+
+extern "C" {
+
+void assign_parameter_conwrap(double param) {}
+
+void assign_bif_parameter_conwrap(double param) { bif_param = param; }
+
+void matrix_residual_fill_conwrap(double *x, double *rhs, int matflag) {
+  if (matflag == RECOVER_MATRIX) {
+    std::memcpy(jac, saved_jac, sizeof(jac));
+    return;
+  }
+  if (matflag != MATRIX_ONLY) {
+    residual(x, rhs);
+  }
+  if (matflag != RHS_ONLY) {
+    jacobian(x, jac);
+  }
+  if (matflag == RHS_MATRIX_SAVE) {
+    std::memcpy(saved_jac, jac, sizeof(jac));
+  }
+}
+
+void matvec_mult_conwrap(double *x, double *y) {
+  y[0] = jac[0][0] * x[0] + jac[0][1] * x[1];
+  y[1] = jac[1][0] * x[0] + jac[1][1] * x[1];
+}
+
+int linear_solver_conwrap(double *x, int jac_flag, double *tmp) {
+  n_single_solves++;
+  return solve(x);
+}
+
+int linear_solver_conwrap_multi(double **x, int nrhs, int jac_flag, double *tmp) {
+  n_multi_solves++;
+  int err = 0;
+  for (int k = 0; k < nrhs; k++) {
+    err = solve(x[k]) ? -1 : err;
+  }
+  return err;
+}
+
+void calc_scale_vec_conwrap(double *x, double *scale_vec, int numUnks) {
+  for (int i = 0; i < numUnks; i++) {
+    scale_vec[i] = 1.0;
+  }
+}
+
+double gsum_double_conwrap(double sum) { return sum; }
+
+// not reached by the turning point algorithm
+int komplex_linear_solver_conwrap(double *x, double *y, int jac_flag, double *omega, double *tmp) {
+  return -1;
+}
+void mass_matrix_fill_conwrap(double *x, double *rhs) {}
+void mass_matvec_mult_conwrap(double *x, double *y) {}
+double free_energy_diff_conwrap(double *x, double *x2) { return 0.0; }
+double scaled_dot_prod(double *x, double *y, double *scale_vec, int n) { return 0.0; }
+}
+
+TEST_CASE("turning_point_alg converges to a fold", "[loca][turning_point]") {
+  double x[N] = {1.3, 2.5};
+  double delta_x[N];
+  double x_tang[N] = {0.0, 0.0};
+  double scale_vec[N] = {0.0, 0.0};
+
+  struct con_struct con;
+  std::memset(&con, 0, sizeof(con));
+  con.general_info.method = TURNING_POINT_CONTINUATION;
+  con.general_info.numUnks = N;
+  con.general_info.numOwnedUnks = N;
+  con.general_info.perturb = 1.0e-7;
+  con.general_info.nv_restart = FALSE;
+  con.private_info.x_tang = x_tang;
+  con.private_info.scale_vec = scale_vec;
+  con.turning_point_info.bif_param = 0.5;
+  assign_bif_parameter_conwrap(con.turning_point_info.bif_param);
+  initialize_util_routines(N, N);
+
+  int converged = FALSE;
+  int iter;
+  for (iter = 0; iter < 20 && !converged; iter++) {
+    matrix_residual_fill_conwrap(x, delta_x, RHS_MATRIX);
+    REQUIRE(solve(delta_x) == 0);
+    converged = turning_point_alg(x, delta_x, &con, 1.0e-10, 1.0e-12);
+    for (int i = 0; i < N; i++) {
+      x[i] -= delta_x[i];
+    }
+  }
+
+  REQUIRE(converged);
+  // one single solve (b) and one two rhs solve (c, d) per iteration
+  CHECK(n_single_solves == iter);
+  CHECK(n_multi_solves == iter);
+  CHECK(con.turning_point_info.bif_param == Catch::Approx(2.0 / 3.0).margin(1e-6));
+  CHECK(x[0] == Catch::Approx(1.0).margin(1e-6));
+  CHECK(x[1] == Catch::Approx(2.0).margin(1e-6));
+  // null vector of the Jacobian at the fold, normalized so that its entries sum to N
+  CHECK(x_tang[1] == Catch::Approx(2.0 * x_tang[0]).margin(1e-6));
+  CHECK(x_tang[0] + x_tang[1] == Catch::Approx(N).margin(1e-6));
+}
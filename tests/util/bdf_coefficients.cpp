@@ -0,0 +1,88 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+#include "util/bdf_coefficients.h"
+
+// derivative at time1 of the polynomials 1, s, ..., s^order from the formula
+static void check_exact(int order, double time1, const double *t) {
+  double alpha[6];
+  goma_bdf_derivative_coefficients(order, time1, t, alpha);
+  for (int p = 0; p <= order; p++) {
+    double xdot = alpha[0] * std::pow(time1, p);
+    for (int j = 1; j <= order; j++) {
+      xdot += alpha[j] * std::pow(t[j - 1], p);
+    }
+    double exact = p == 0 ? 0.0 : p * std::pow(time1, p - 1);
+    REQUIRE(xdot == Catch::Approx(exact).margin(1e-8));
+  }
+}
+
+TEST_CASE("constant step BDF coefficients", "[bdf_coefficients]") {
+  const double h = 0.1;
+  double t[5] = {1.0, 1.0 - h, 1.0 - 2 * h, 1.0 - 3 * h, 1.0 - 4 * h};
+  double alpha[6];
+
+  goma_bdf_derivative_coefficients(1, 1.0 + h, t, alpha);
+  REQUIRE(alpha[0] * h == Catch::Approx(1.0));
+  REQUIRE(alpha[1] * h == Catch::Approx(-1.0));
+
+  goma_bdf_derivative_coefficients(2, 1.0 + h, t, alpha);
+  REQUIRE(alpha[0] * h == Catch::Approx(1.5));
+  REQUIRE(alpha[1] * h == Catch::Approx(-2.0));
+  REQUIRE(alpha[2] * h == Catch::Approx(0.5));
+
+  goma_bdf_derivative_coefficients(3, 1.0 + h, t, alpha);
+  REQUIRE(alpha[0] * h == Catch::Approx(11.0 / 6.0));
+  REQUIRE(alpha[1] * h == Catch::Approx(-3.0));
+  REQUIRE(alpha[2] * h == Catch::Approx(1.5));
+  REQUIRE(alpha[3] * h == Catch::Approx(-1.0 / 3.0));
+}
+
+TEST_CASE("variable step BDF coefficients", "[bdf_coefficients]") {
+  double t[5] = {1.0, 0.9, 0.65, 0.6, 0.3};
+
+  // BDF2 with step ratio r = h_n / h_n-1 = 0.5 / 0.1
+  double alpha[6];
+  double h = 0.5, r = h / 0.1;
+  goma_bdf_derivative_coefficients(2, 1.5, t, alpha);
+  REQUIRE(alpha[0] * h == Catch::Approx((1 + 2 * r) / (1 + r)));
+  REQUIRE(alpha[1] * h == Catch::Approx(-(1 + r)));
+  REQUIRE(alpha[2] * h == Catch::Approx(r * r / (1 + r)));
+
+  for (int order = 1; order <= 5; order++) {
+    check_exact(order, 1.5, t);
+    check_exact(order, 1.01, t);
+
+    // consistency: a constant has no derivative
+    goma_bdf_derivative_coefficients(order, 1.2, t, alpha);
+    double sum = 0.0;
+    for (int j = 0; j <= order; j++) {
+      sum += alpha[j];
+    }
+    REQUIRE(sum == Catch::Approx(0.0).margin(1e-9));
+  }
+}
+
+TEST_CASE("BDF extrapolation weights", "[bdf_coefficients]") {
+  double t[5] = {1.0, 0.9, 0.65, 0.6, 0.3};
+  double w[6];
+
+  for (int q = 0; q <= 4; q++) {
+    goma_bdf_extrapolation_weights(q, 1.25, t, w);
+    for (int p = 0; p <= q; p++) {
+      double x = 0.0;
+      for (int j = 0; j <= q; j++) {
+        x += w[j] * std::pow(t[j], p);
+      }
+      REQUIRE(x == Catch::Approx(std::pow(1.25, p)));
+    }
+  }
+
+  // at a stored time the weights pick out that solution
+  goma_bdf_extrapolation_weights(3, t[2], t, w);
+  REQUIRE(w[2] == Catch::Approx(1.0));
+  REQUIRE(w[0] == Catch::Approx(0.0).margin(1e-12));
+  REQUIRE(w[1] == Catch::Approx(0.0).margin(1e-12));
+  REQUIRE(w[3] == Catch::Approx(0.0).margin(1e-12));
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cstring>
+
+#include "util/checkpoint_io.h"
+
+TEST_CASE("checkpoint buffer round trip through a file", "[checkpoint_io]") {
+  const char *filename = "checkpoint_io_test.ckpt";
+  double x[3] = {1.0, -2.5, 1.0e-300};
+
+  goma_ckpt_buffer b;
+  goma_ckpt_buffer_init(&b);
+  REQUIRE(goma_ckpt_put_int(&b, 42) == 0);
+  REQUIRE(goma_ckpt_put_double(&b, 0.125) == 0);
+  REQUIRE(goma_ckpt_put_doubles(&b, x, 3) == 0);
+  REQUIRE(goma_ckpt_write_file(filename, &b) == 0);
+  goma_ckpt_buffer_free(&b);
+
+  // The temporary file is renamed away
+  FILE *tmp = fopen("checkpoint_io_test.ckpt.tmp", "rb");
+  REQUIRE(tmp == nullptr);
+
+  goma_ckpt_buffer r;
+  goma_ckpt_buffer_init(&r);
+  REQUIRE(goma_ckpt_read_file(filename, &r) == 0);
+  int i;
+  double d, y[3];
+  REQUIRE(goma_ckpt_get_int(&r, &i) == 0);
+  REQUIRE(i == 42);
+  REQUIRE(goma_ckpt_get_double(&r, &d) == 0);
+  REQUIRE(d == 0.125);
+  REQUIRE(goma_ckpt_get_doubles(&r, y, 3) == 0);
+  REQUIRE(std::memcmp(x, y, sizeof(x)) == 0);
+
+  // Reading past the end fails
+  REQUIRE(goma_ckpt_get_int(&r, &i) != 0);
+  goma_ckpt_buffer_free(&r);
+  remove(filename);
+}
+
+TEST_CASE("checkpoint arrays must match the expected length", "[checkpoint_io]") {
+  double x[2] = {1.0, 2.0};
+  double y[3];
+
+  goma_ckpt_buffer b;
+  goma_ckpt_buffer_init(&b);
+  REQUIRE(goma_ckpt_put_doubles(&b, x, 2) == 0);
+  REQUIRE(goma_ckpt_get_doubles(&b, y, 3) != 0);
+  goma_ckpt_buffer_free(&b);
+}
+
+TEST_CASE("corrupted checkpoints are rejected", "[checkpoint_io]") {
+  const char *filename = "checkpoint_io_corrupt.ckpt";
+
+  goma_ckpt_buffer b;
+  goma_ckpt_buffer_init(&b);
+  for (int i = 0; i < 100; i++) {
+    REQUIRE(goma_ckpt_put_int(&b, i) == 0);
+  }
+  REQUIRE(goma_ckpt_write_file(filename, &b) == 0);
+  goma_ckpt_buffer_free(&b);
+
+  // Flip a byte in the payload
+  FILE *fp = fopen(filename, "r+b");
+  REQUIRE(fp != nullptr);
+  REQUIRE(fseek(fp, -10, SEEK_END) == 0);
+  int c = fgetc(fp);
+  REQUIRE(fseek(fp, -10, SEEK_END) == 0);
+  fputc(c ^ 0xff, fp);
+  fclose(fp);
+
+  goma_ckpt_buffer r;
+  goma_ckpt_buffer_init(&r);
+  REQUIRE(goma_ckpt_read_file(filename, &r) != 0);
+  goma_ckpt_buffer_free(&r);
+  remove(filename);
+}
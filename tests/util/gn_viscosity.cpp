@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include "util/gn_viscosity.h"
+
+static bool close(double a, double b, double tol) {
+  return std::fabs(a - b) <= tol * (1.0 + std::fabs(b));
+}
+
+TEST_CASE("carreau matches the closed form", "[gn_viscosity]") {
+  const double mu0 = 10., muinf = 0.1, nexp = 0.4, aexp = 1.7, lambda = 0.3;
+  std::vector<double> gd = {0., 1e-3, 0.5, 1., 7., 250.};
+  std::vector<double> at = {1., 0.5, 2., 1., 3., 0.1};
+
+  for (size_t i = 0; i < gd.size(); i++) {
+    double dgd, dat;
+    double mu = goma_carreau(gd[i], at[i], mu0, muinf, nexp, aexp, lambda, &dgd, &dat);
+    double x = at[i] * lambda * gd[i];
+    double visc = std::pow(1. + std::pow(x, aexp), (nexp - 1.) / aexp);
+    double ref = at[i] * (muinf + (mu0 - muinf) * visc);
+    REQUIRE(close(mu, ref, 1e-13));
+    if (gd[i] > 0.) {
+      double h = 1e-6 * gd[i];
+      double mp = goma_carreau(gd[i] + h, at[i], mu0, muinf, nexp, aexp, lambda, nullptr, nullptr);
+      double mm = goma_carreau(gd[i] - h, at[i], mu0, muinf, nexp, aexp, lambda, nullptr, nullptr);
+      REQUIRE(close(dgd, (mp - mm) / (2. * h), 1e-6));
+    } else {
+      REQUIRE(dgd == 0.);
+    }
+    double h = 1e-6 * at[i];
+    double mp = goma_carreau(gd[i], at[i] + h, mu0, muinf, nexp, aexp, lambda, nullptr, nullptr);
+    double mm = goma_carreau(gd[i], at[i] - h, mu0, muinf, nexp, aexp, lambda, nullptr, nullptr);
+    REQUIRE(close(dat, (mp - mm) / (2. * h), 1e-6));
+  }
+}
+
+TEST_CASE("carreau without a shift factor", "[gn_viscosity]") {
+  double d;
+  double mu = goma_carreau(3., 1., 5., 0., 0.5, 2., 1., &d, nullptr);
+  REQUIRE(close(mu, 5. / std::sqrt(std::sqrt(10.)), 1e-14));
+  REQUIRE(close(d, -0.5 * 5. * 9. / 10. / std::sqrt(std::sqrt(10.)) / 3., 1e-14));
+}
+
+TEST_CASE("power law", "[gn_viscosity]") {
+  std::vector<double> gd = {0., 0.1, 2., 40.};
+  const double mu0 = 2., nexp = 0.6, offset = 1e-5;
+
+  for (double g : gd) {
+    double dgd;
+    double mu = goma_power_law(g, mu0, nexp, offset, &dgd);
+    REQUIRE(close(mu, mu0 * std::pow(g + offset, nexp - 1.), 1e-14));
+    REQUIRE(close(dgd, mu0 * (nexp - 1.) * std::pow(g + offset, nexp - 2.), 1e-12));
+  }
+}
+
+TEST_CASE("wlf shift", "[gn_viscosity]") {
+  const double tref = 300., c1 = 8., c2 = 50.;
+  std::vector<double> T = {250., 300., 320., 400.};
+
+  REQUIRE(goma_wlf_shift(tref, tref, c1, c2, nullptr) == 1.);
+  for (double t : T) {
+    double dat;
+    double at = goma_wlf_shift(t, tref, c1, c2, &dat);
+    REQUIRE(close(at, std::exp(c1 * (tref - t) / (c2 + t - tref)), 1e-14));
+    double h = 1e-4;
+    double ap = goma_wlf_shift(t + h, tref, c1, c2, nullptr);
+    double am = goma_wlf_shift(t - h, tref, c1, c2, nullptr);
+    REQUIRE(close(dat, (ap - am) / (2. * h), 1e-6));
+  }
+
+  double da;
+  double a = goma_wlf_shift(tref - c2, tref, c1, c2, &da);
+  REQUIRE(a == 1.);
+  REQUIRE(da == 0.);
+}
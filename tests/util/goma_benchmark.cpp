@@ -0,0 +1,95 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "util/goma_benchmark.h"
+
+static std::string write_json(const goma_benchmark_suite *suite) {
+  FILE *file = tmpfile();
+  REQUIRE(file != nullptr);
+  REQUIRE(goma_benchmark_suite_write_json(suite, file) == 0);
+  std::string json;
+  rewind(file);
+  int c;
+  while ((c = fgetc(file)) != EOF) {
+    json += (char)c;
+  }
+  fclose(file);
+  return json;
+}
+
+TEST_CASE("benchmark statistics", "[goma_benchmark]") {
+  goma_benchmark_result r;
+  memset(&r, 0, sizeof(r));
+
+  double odd[5] = {5.0, 1.0, 4.0, 2.0, 3.0};
+  REQUIRE(goma_benchmark_stats(odd, 5, &r) == 0);
+  REQUIRE(r.repetitions == 5);
+  REQUIRE(r.min_ns == 1.0);
+  REQUIRE(r.median_ns == 3.0);
+  REQUIRE(r.mean_ns == Catch::Approx(3.0));
+  REQUIRE(r.stddev_ns == Catch::Approx(std::sqrt(2.5)));
+
+  double even[4] = {8.0, 2.0, 6.0, 4.0};
+  REQUIRE(goma_benchmark_stats(even, 4, &r) == 0);
+  REQUIRE(r.median_ns == 5.0);
+  REQUIRE(r.min_ns == 2.0);
+
+  double one[1] = {7.0};
+  REQUIRE(goma_benchmark_stats(one, 1, &r) == 0);
+  REQUIRE(r.median_ns == 7.0);
+  REQUIRE(r.stddev_ns == 0.0);
+
+  REQUIRE(goma_benchmark_stats(one, 0, &r) == -1);
+}
+
+TEST_CASE("benchmark clock is monotonic", "[goma_benchmark]") {
+  double t0 = goma_benchmark_now_ns();
+  volatile double sum = 0.0;
+  for (int i = 0; i < 1000; i++) {
+    sum += i;
+  }
+  REQUIRE(goma_benchmark_now_ns() >= t0);
+}
+
+TEST_CASE("benchmark suite JSON output", "[goma_benchmark]") {
+  goma_benchmark_suite suite;
+  goma_benchmark_suite_init(&suite);
+
+  REQUIRE(goma_benchmark_suite_set_context(&suite, "input_file", "dir\\in \"put\"") == 0);
+
+  // grows past the initial capacity
+  for (int i = 0; i < 20; i++) {
+    goma_benchmark_result r;
+    memset(&r, 0, sizeof(r));
+    snprintf(r.name, GOMA_BENCHMARK_NAME_LEN, "kernel_%d", i);
+    double samples[3] = {300.0, 100.0, 200.0};
+    REQUIRE(goma_benchmark_stats(samples, 3, &r) == 0);
+    r.elements = 10;
+    r.quadrature_points = 40;
+    REQUIRE(goma_benchmark_suite_add(&suite, &r) == 0);
+  }
+  REQUIRE(goma_benchmark_suite_skip(&suite, "skipped_kernel", "not used here") == 0);
+  REQUIRE(suite.num_results == 21);
+
+  std::string json = write_json(&suite);
+  REQUIRE(json.find("\"input_file\": \"dir\\\\in \\\"put\\\"\"") != std::string::npos);
+  REQUIRE(json.find("\"name\": \"kernel_19\"") != std::string::npos);
+  REQUIRE(json.find("\"median_ns\": 200") != std::string::npos);
+  REQUIRE(json.find("\"ns_per_element\": 20") != std::string::npos);
+  REQUIRE(json.find("\"ns_per_quadrature_point\": 5") != std::string::npos);
+  // no calls recorded, so no per call figure
+  REQUIRE(json.find("ns_per_call") == std::string::npos);
+  REQUIRE(json.find("\"skipped\": \"not used here\"") != std::string::npos);
+  REQUIRE(json.back() == '\n');
+
+  goma_benchmark_suite_free(&suite);
+  REQUIRE(suite.num_results == 0);
+
+  // an empty suite is still valid JSON
+  std::string empty = write_json(&suite);
+  REQUIRE(empty == "{\n  \"context\": {},\n  \"benchmarks\": []\n}\n");
+}
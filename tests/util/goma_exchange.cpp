@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <mpi.h>
+#include <set>
+#include <vector>
+
+#include "util/goma_exchange.h"
+
+static std::vector<int> message_ints(const goma_exchange_recv &recv, int i) {
+  const int *values = (const int *)(recv.data + recv.offset[i]);
+  return std::vector<int>(values, values + (recv.offset[i + 1] - recv.offset[i]) / sizeof(int));
+}
+
+static std::vector<int> sparse_dest(int rank, int size) {
+  std::set<int> dest{0, (rank + 1) % size};
+  return std::vector<int>(dest.begin(), dest.end());
+}
+
+TEST_CASE("sparse exchange finds who sent to us", "[goma_exchange]") {
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  std::vector<int> dest = sparse_dest(rank, size);
+  std::vector<std::vector<int>> messages;
+  std::vector<const void *> send;
+  std::vector<int> send_bytes;
+  for (int d : dest) {
+    messages.push_back(std::vector<int>{rank, d});
+  }
+  for (auto &m : messages) {
+    send.push_back(m.data());
+    send_bytes.push_back(m.size() * sizeof(int));
+  }
+
+  goma_exchange_recv recv;
+  REQUIRE(goma_exchange_sparse(MPI_COMM_WORLD, 3100, dest.size(), dest.data(), send.data(),
+                               send_bytes.data(), &recv) == 0);
+
+  std::vector<int> expected;
+  for (int source = 0; source < size; source++) {
+    std::vector<int> d = sparse_dest(source, size);
+    if (std::find(d.begin(), d.end(), rank) != d.end()) {
+      expected.push_back(source);
+    }
+  }
+  REQUIRE(recv.num_procs == static_cast<int>(expected.size()));
+  for (int i = 0; i < recv.num_procs; i++) {
+    REQUIRE(recv.proc[i] == expected[i]);
+    REQUIRE(message_ints(recv, i) == std::vector<int>{expected[i], rank});
+  }
+  goma_exchange_recv_free(&recv);
+  REQUIRE(recv.data == nullptr);
+
+  // nobody sends anything
+  REQUIRE(goma_exchange_sparse(MPI_COMM_WORLD, 3101, 0, nullptr, nullptr, nullptr, &recv) == 0);
+  REQUIRE(recv.num_procs == 0);
+  REQUIRE(recv.offset[0] == 0);
+  goma_exchange_recv_free(&recv);
+}
+
+TEST_CASE("neighbor exchange sizes messages on arrival", "[goma_exchange]") {
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  std::set<int> ring{(rank + size - 1) % size, (rank + 1) % size};
+  std::vector<int> neighbor(ring.begin(), ring.end());
+
+  // rank + 1 copies of rank, except nothing to the highest neighbor
+  std::vector<int> payload(rank + 1, rank);
+  std::vector<const void *> send(neighbor.size(), payload.data());
+  std::vector<int> send_bytes(neighbor.size(), payload.size() * sizeof(int));
+  if (neighbor.size() > 1) {
+    send_bytes.back() = 0;
+  }
+
+  goma_exchange_recv recv;
+  REQUIRE(goma_exchange_neighbors(MPI_COMM_WORLD, 3102, neighbor.size(), neighbor.data(),
+                                  send.data(), send_bytes.data(), &recv) == 0);
+  REQUIRE(recv.num_procs == static_cast<int>(neighbor.size()));
+  for (int i = 0; i < recv.num_procs; i++) {
+    int n = neighbor[i];
+    REQUIRE(recv.proc[i] == n);
+    std::set<int> n_ring{(n + size - 1) % size, (n + 1) % size};
+    bool empty = n_ring.size() > 1 && *n_ring.rbegin() == rank;
+    std::vector<int> expected;
+    if (!empty) {
+      expected.assign(n + 1, n);
+    }
+    REQUIRE(message_ints(recv, i) == expected);
+  }
+  goma_exchange_recv_free(&recv);
+}
@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "util/goma_memory.h"
+
+TEST_CASE("memory tags nest", "[goma_memory]") {
+  goma_mem_reset();
+  REQUIRE(goma_mem_current_tag() == GOMA_MEM_OTHER);
+  goma_mem_push_tag(GOMA_MEM_MESH);
+  {
+    goma::mem_tag_scope scope(GOMA_MEM_GHOST);
+    REQUIRE(goma_mem_current_tag() == GOMA_MEM_GHOST);
+  }
+  REQUIRE(goma_mem_current_tag() == GOMA_MEM_MESH);
+  goma_mem_pop_tag();
+  REQUIRE(goma_mem_current_tag() == GOMA_MEM_OTHER);
+  // unbalanced pops are harmless
+  goma_mem_pop_tag();
+  REQUIRE(goma_mem_current_tag() == GOMA_MEM_OTHER);
+  REQUIRE(std::string(goma_mem_tag_name(GOMA_MEM_MATRIX)) == "matrix");
+}
+
+TEST_CASE("memory accounting follows blocks", "[goma_memory]") {
+  goma_mem_reset();
+  goma_mem_enable(1);
+  char a, b, c;
+
+  goma_mem_push_tag(GOMA_MEM_MATRIX);
+  goma_mem_track_alloc(&a, 1000);
+  goma_mem_pop_tag();
+  goma_mem_track_alloc(&b, 500);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_MATRIX) == 1000);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_OTHER) == 500);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_NUM_TAGS) == 1500);
+
+  goma_mem_track_free(&a);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_MATRIX) == 0);
+  REQUIRE(goma_mem_peak_bytes(GOMA_MEM_MATRIX) == 1000);
+  REQUIRE(goma_mem_peak_bytes(GOMA_MEM_NUM_TAGS) == 1500);
+
+  // never tracked, ignored
+  goma_mem_track_free(&c);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_NUM_TAGS) == 500);
+
+  // b was released with a bare free() and its address handed out again
+  goma_mem_push_tag(GOMA_MEM_POST);
+  goma_mem_track_alloc(&b, 200);
+  goma_mem_pop_tag();
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_OTHER) == 0);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_POST) == 200);
+
+  // realloc keeps the tag it had
+  goma_mem_track_realloc(&b, &c, 300);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_POST) == 300);
+  goma_mem_track_free(&b);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_POST) == 300);
+  goma_mem_track_free(&c);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_NUM_TAGS) == 0);
+}
+
+TEST_CASE("memory tracking is off until enabled", "[goma_memory]") {
+  goma_mem_reset();
+  goma_mem_enable(0);
+  char a;
+  goma_mem_track_alloc(&a, 1000);
+  goma_mem_track_bytes(GOMA_MEM_PARTICLES, 1000);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_NUM_TAGS) == 0);
+  REQUIRE(goma_mem_peak_bytes(GOMA_MEM_NUM_TAGS) == 0);
+
+  goma_mem_enable(1);
+  goma_mem_track_alloc(&a, 1000);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_OTHER) == 1000);
+  goma_mem_enable(0);
+  goma_mem_track_free(&a);
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_OTHER) == 1000);
+  goma_mem_reset();
+}
+
+TEST_CASE("memory accounting with many blocks", "[goma_memory]") {
+  goma_mem_reset();
+  goma_mem_enable(1);
+  std::vector<void *> blocks;
+  goma_mem_push_tag(GOMA_MEM_PARTICLES);
+  for (int i = 0; i < 5000; i++) {
+    blocks.push_back(malloc(16));
+    goma_mem_track_alloc(blocks.back(), 16);
+  }
+  goma_mem_pop_tag();
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_PARTICLES) == 5000 * 16);
+
+  // release every other block, then the rest, out of order
+  for (size_t i = 0; i < blocks.size(); i += 2) {
+    goma_mem_track_free(blocks[i]);
+  }
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_PARTICLES) == 2500 * 16);
+  for (size_t i = blocks.size() - 1; i < blocks.size(); i -= 2) {
+    goma_mem_track_free(blocks[i]);
+  }
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_PARTICLES) == 0);
+  REQUIRE(goma_mem_peak_bytes(GOMA_MEM_PARTICLES) == 5000 * 16);
+  for (auto p : blocks) {
+    free(p);
+  }
+}
+
+TEST_CASE("tracked containers charge their tag", "[goma_memory]") {
+  goma_mem_reset();
+  goma_mem_enable(1);
+  {
+    goma::tracked_vector<double, GOMA_MEM_GHOST> v(1000);
+    REQUIRE(goma_mem_current_bytes(GOMA_MEM_GHOST) >= 1000 * sizeof(double));
+    goma::tracked_unordered_map<int, int, GOMA_MEM_GHOST> m;
+    for (int i = 0; i < 100; i++) {
+      m[i] = i;
+    }
+    REQUIRE(goma_mem_current_bytes(GOMA_MEM_GHOST) > 1000 * sizeof(double));
+  }
+  REQUIRE(goma_mem_current_bytes(GOMA_MEM_GHOST) == 0);
+  REQUIRE(goma_mem_peak_bytes(GOMA_MEM_GHOST) > 1000 * sizeof(double));
+}
+
+TEST_CASE("memory report", "[goma_memory]") {
+  goma_mem_reset();
+  goma_mem_enable(1);
+  char a;
+  goma_mem_push_tag(GOMA_MEM_MESH);
+  goma_mem_track_alloc(&a, 2 * 1024 * 1024);
+  goma_mem_pop_tag();
+
+  FILE *file = tmpfile();
+  REQUIRE(file != nullptr);
+  REQUIRE(goma_mem_report(MPI_COMM_SELF, "test", file) == 0);
+  std::string report;
+  rewind(file);
+  int c;
+  while ((c = fgetc(file)) != EOF) {
+    report += (char)c;
+  }
+  fclose(file);
+  REQUIRE(report.find("test (MB per rank over 1 ranks)") != std::string::npos);
+  REQUIRE(report.find("mesh             2.00       2.00       2.00") != std::string::npos);
+  goma_mem_reset();
+
+  char prog[] = "goma", flag[] = "-mem_report", in[] = "input";
+  char *argv[] = {prog, flag, in, nullptr};
+  int argc = 3, enabled = 0;
+  REQUIRE(goma_mem_parse_args(&argc, argv, &enabled) == 0);
+  REQUIRE(enabled == 1);
+  REQUIRE(argc == 2);
+  REQUIRE(std::string(argv[1]) == "input");
+}
@@ -0,0 +1,71 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "util/goma_perf_log.h"
+
+TEST_CASE("perf log strips -perf_log from the command line", "[goma_perf_log]") {
+  char prog[] = "goma", a[] = "-a", perf[] = "-perf_log", out[] = "perf.json", i[] = "-i",
+       in[] = "input";
+  char *argv[] = {prog, a, perf, out, i, in, nullptr};
+  int argc = 6;
+  char file[GOMA_PERF_LOG_FILE_LEN];
+
+  REQUIRE(goma_perf_log_parse_args(&argc, argv, file, GOMA_PERF_LOG_FILE_LEN) == 0);
+  REQUIRE(std::string(file) == "perf.json");
+  REQUIRE(argc == 4);
+  REQUIRE(std::string(argv[1]) == "-a");
+  REQUIRE(std::string(argv[2]) == "-i");
+  REQUIRE(std::string(argv[3]) == "input");
+  REQUIRE(argv[4] == nullptr);
+
+  // not given
+  REQUIRE(goma_perf_log_parse_args(&argc, argv, file, GOMA_PERF_LOG_FILE_LEN) == 0);
+  REQUIRE(file[0] == '\0');
+  REQUIRE(argc == 4);
+
+  // missing file name
+  char *bad[] = {prog, perf, nullptr};
+  int bad_argc = 2;
+  REQUIRE(goma_perf_log_parse_args(&bad_argc, bad, file, GOMA_PERF_LOG_FILE_LEN) == -1);
+}
+
+TEST_CASE("perf log counters and JSON output", "[goma_perf_log]") {
+  goma_perf_log log;
+  goma_perf_log_init(&log);
+  for (int step = 0; step < 4; step++) {
+    goma_perf_log_time_step(&log);
+    goma_perf_log_newton(&log, 1.0, 0.5);
+    goma_perf_log_newton(&log, 1.0, 0.5);
+    goma_perf_log_output(&log, 0.25);
+  }
+  REQUIRE(log.newton_iterations == 8);
+  REQUIRE(log.assembly_s == Catch::Approx(8.0));
+  REQUIRE(log.solve_s == Catch::Approx(4.0));
+  REQUIRE(log.outputs == 4);
+
+  goma_perf_log reduced;
+  REQUIRE(goma_perf_log_reduce(&log, MPI_COMM_SELF, &reduced) == 0);
+  REQUIRE(reduced.processors == 1);
+  REQUIRE(reduced.peak_rss_max_kb > 0.0);
+  REQUIRE(reduced.peak_rss_sum_kb == reduced.peak_rss_max_kb);
+  REQUIRE(reduced.newton_iterations == 8);
+
+  FILE *file = tmpfile();
+  REQUIRE(file != nullptr);
+  REQUIRE(goma_perf_log_write_json(&reduced, "in\"put", file) == 0);
+  std::string json;
+  rewind(file);
+  int c;
+  while ((c = fgetc(file)) != EOF) {
+    json += (char)c;
+  }
+  fclose(file);
+  REQUIRE(json.find("\"input_file\": \"in\\\"put\"") != std::string::npos);
+  REQUIRE(json.find("\"newton_iterations\": 8") != std::string::npos);
+  REQUIRE(json.find("\"output_s_per_step\": 0.25") != std::string::npos);
+  REQUIRE(json.find("\"newton_iterations_per_step\": 2") != std::string::npos);
+  REQUIRE(json.back() == '\n');
+}
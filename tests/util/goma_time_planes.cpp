@@ -0,0 +1,77 @@
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "util/goma_time_planes.h"
+
+TEST_CASE("time plane bracket", "[goma_time_planes]") {
+  double times[4] = {0.0, 1.0, 2.0, 4.0};
+  int lower, higher;
+  double weight;
+
+  REQUIRE(goma_time_plane_bracket(times, 4, 1.5, &lower, &higher, &weight) == 0);
+  REQUIRE(lower == 2);
+  REQUIRE(higher == 3);
+  REQUIRE(weight == Catch::Approx(0.5));
+
+  // on a plane
+  REQUIRE(goma_time_plane_bracket(times, 4, 2.0, &lower, &higher, &weight) == 0);
+  REQUIRE(lower == 2);
+  REQUIRE(higher == 3);
+  REQUIRE(weight == Catch::Approx(1.0));
+
+  // at and before the first plane
+  REQUIRE(goma_time_plane_bracket(times, 4, 0.0, &lower, &higher, &weight) == 0);
+  REQUIRE(lower == 1);
+  REQUIRE(higher == 1);
+  REQUIRE(weight == 0.0);
+  REQUIRE(goma_time_plane_bracket(times, 4, -1.0, &lower, &higher, &weight) == 0);
+  REQUIRE(higher == 1);
+
+  // past the last plane the last two are extrapolated
+  REQUIRE(goma_time_plane_bracket(times, 4, 5.0, &lower, &higher, &weight) == 0);
+  REQUIRE(lower == 3);
+  REQUIRE(higher == 4);
+  REQUIRE(weight == Catch::Approx(1.5));
+
+  REQUIRE(goma_time_plane_bracket(times, 1, 5.0, &lower, &higher, &weight) == 0);
+  REQUIRE(lower == 1);
+  REQUIRE(higher == 1);
+  REQUIRE(goma_time_plane_bracket(times, 0, 5.0, &lower, &higher, &weight) == -1);
+}
+
+TEST_CASE("time plane buffers are reused as time advances", "[goma_time_planes]") {
+  int slot_plane[GOMA_TIME_PLANE_SLOTS] = {0, 0};
+  int slot[2], load[GOMA_TIME_PLANE_SLOTS];
+
+  // first step reads both planes
+  goma_time_plane_slots(slot_plane, 1, 2, slot, load);
+  REQUIRE(slot[0] != slot[1]);
+  REQUIRE(load[0] + load[1] == 2);
+  REQUIRE(slot_plane[slot[0]] == 1);
+  REQUIRE(slot_plane[slot[1]] == 2);
+
+  // same bracket, nothing to read
+  goma_time_plane_slots(slot_plane, 1, 2, slot, load);
+  REQUIRE(load[0] + load[1] == 0);
+
+  // one plane later only the new higher plane is read, over the old lower one
+  int old_higher_slot = slot[1];
+  goma_time_plane_slots(slot_plane, 2, 3, slot, load);
+  REQUIRE(slot[0] == old_higher_slot);
+  REQUIRE(load[slot[0]] == 0);
+  REQUIRE(load[slot[1]] == 1);
+  REQUIRE(slot_plane[slot[1]] == 3);
+
+  // a jump reads both
+  goma_time_plane_slots(slot_plane, 7, 8, slot, load);
+  REQUIRE(load[0] + load[1] == 2);
+
+  // lower == higher shares one buffer and reads it once
+  int empty[GOMA_TIME_PLANE_SLOTS] = {0, 0};
+  goma_time_plane_slots(empty, 1, 1, slot, load);
+  REQUIRE(slot[0] == slot[1]);
+  REQUIRE(load[0] + load[1] == 1);
+  goma_time_plane_slots(empty, 1, 2, slot, load);
+  REQUIRE(load[slot[0]] == 0);
+  REQUIRE(load[slot[1]] == 1);
+}
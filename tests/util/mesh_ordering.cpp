@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include "util/mesh_ordering.h"
+
+struct csr_graph {
+  std::vector<int> ptr;
+  std::vector<int> adj;
+};
+
+static csr_graph make_graph(int n, const std::vector<std::pair<int, int>> &edges) {
+  std::vector<std::vector<int>> nbrs(n);
+  for (auto &e : edges) {
+    nbrs[e.first].push_back(e.second);
+    nbrs[e.second].push_back(e.first);
+  }
+  csr_graph g;
+  g.ptr.push_back(0);
+  for (int v = 0; v < n; v++) {
+    g.adj.insert(g.adj.end(), nbrs[v].begin(), nbrs[v].end());
+    g.ptr.push_back(g.adj.size());
+  }
+  return g;
+}
+
+// 5 point stencil on an nx by ny grid, vertex (i, j) labelled label[i + nx * j]
+static csr_graph grid_graph(int nx, int ny, const std::vector<int> &label) {
+  std::vector<std::pair<int, int>> edges;
+  for (int j = 0; j < ny; j++) {
+    for (int i = 0; i < nx; i++) {
+      if (i + 1 < nx)
+        edges.push_back({label[i + nx * j], label[i + 1 + nx * j]});
+      if (j + 1 < ny)
+        edges.push_back({label[i + nx * j], label[i + nx * (j + 1)]});
+    }
+  }
+  return make_graph(nx * ny, edges);
+}
+
+static int bandwidth(const csr_graph &g, const std::vector<int> &order) {
+  std::vector<int> position(g.ptr.size() - 1);
+  for (size_t p = 0; p < order.size(); p++) {
+    position[order[p]] = p;
+  }
+  int band = 0;
+  for (size_t v = 0; v + 1 < g.ptr.size(); v++) {
+    for (int k = g.ptr[v]; k < g.ptr[v + 1]; k++) {
+      band = std::max(band, std::abs(position[v] - position[g.adj[k]]));
+    }
+  }
+  return band;
+}
+
+TEST_CASE("rcm orders a scrambled path end to end", "[mesh_ordering]") {
+  // path 3 - 0 - 4 - 1 - 2
+  csr_graph g = make_graph(5, {{3, 0}, {0, 4}, {4, 1}, {1, 2}});
+  std::vector<int> order(5);
+  REQUIRE(goma_rcm_order(g.ptr.data(), g.adj.data(), 0, 5, order.data()) == 0);
+  REQUIRE(bandwidth(g, order) == 1);
+  REQUIRE((order.front() == 3 || order.front() == 2));
+}
+
+TEST_CASE("rcm reduces the bandwidth of a scrambled grid", "[mesh_ordering]") {
+  const int nx = 8, ny = 12;
+  std::vector<int> label(nx * ny);
+  std::iota(label.begin(), label.end(), 0);
+  // deterministic scramble
+  for (int k = nx * ny - 1; k > 0; k--) {
+    std::swap(label[k], label[(k * 37 + 11) % (k + 1)]);
+  }
+  csr_graph g = grid_graph(nx, ny, label);
+
+  std::vector<int> identity(nx * ny);
+  std::iota(identity.begin(), identity.end(), 0);
+
+  std::vector<int> order(nx * ny);
+  REQUIRE(goma_rcm_order(g.ptr.data(), g.adj.data(), 0, nx * ny, order.data()) == 0);
+
+  std::vector<int> sorted(order);
+  std::sort(sorted.begin(), sorted.end());
+  REQUIRE(sorted == identity);
+
+  REQUIRE(bandwidth(g, identity) > 2 * nx);
+  REQUIRE(bandwidth(g, order) <= 2 * nx);
+}
+
+TEST_CASE("rcm stays in its range and covers every component", "[mesh_ordering]") {
+  // two triangles 2-3-4 and 5-6-7, vertex 8 isolated, all tied to 0 and 1
+  // outside the range
+  csr_graph g = make_graph(
+      9, {{2, 3}, {3, 4}, {4, 2}, {5, 6}, {6, 7}, {7, 5}, {0, 2}, {0, 5}, {1, 8}, {1, 4}});
+  std::vector<int> order(7);
+  REQUIRE(goma_rcm_order(g.ptr.data(), g.adj.data(), 2, 9, order.data()) == 0);
+
+  REQUIRE(std::set<int>(order.begin(), order.end()) == std::set<int>{2, 3, 4, 5, 6, 7, 8});
+  // components are contiguous
+  std::vector<int> component(9, -1);
+  for (int v : {2, 3, 4})
+    component[v] = 0;
+  for (int v : {5, 6, 7})
+    component[v] = 1;
+  component[8] = 2;
+  int changes = 0;
+  for (size_t p = 1; p < order.size(); p++) {
+    if (component[order[p]] != component[order[p - 1]])
+      changes++;
+  }
+  REQUIRE(changes == 2);
+}
+
+TEST_CASE("hilbert index walks the grid one neighbor at a time", "[mesh_ordering]") {
+  for (int dim = 2; dim <= 3; dim++) {
+    for (int bits = 1; bits <= 4; bits++) {
+      const uint32_t side = 1u << bits;
+      const uint64_t cells = uint64_t(1) << (dim * bits);
+      std::vector<std::vector<uint32_t>> cell_at(cells);
+      for (uint64_t c = 0; c < cells; c++) {
+        uint32_t X[3] = {uint32_t(c % side), uint32_t((c / side) % side),
+                         uint32_t(c / side / side)};
+        std::vector<uint32_t> point(X, X + dim);
+        uint64_t key = goma_hilbert_index(X, dim, bits);
+        REQUIRE(key < cells);
+        REQUIRE(cell_at[key].empty());
+        cell_at[key] = point;
+      }
+      for (uint64_t key = 1; key < cells; key++) {
+        int distance = 0;
+        for (int i = 0; i < dim; i++) {
+          distance += std::abs(int(cell_at[key][i]) - int(cell_at[key - 1][i]));
+        }
+        REQUIRE(distance == 1);
+      }
+      REQUIRE(cell_at[0] == std::vector<uint32_t>(dim, 0));
+    }
+  }
+}
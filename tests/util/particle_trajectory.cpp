@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <string>
+
+#include "util/particle_trajectory.h"
+
+static std::string read_all(FILE *fp) {
+  std::string text;
+  char buf[256];
+  rewind(fp);
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+    text.append(buf, n);
+  }
+  return text;
+}
+
+TEST_CASE("particle trajectory round trip to tecplot", "[particle_trajectory]") {
+  const char *filename = "particle_trajectory_test.ptrj";
+  const char *names[1] = {"VX"};
+
+  // A capacity of 2 forces a chunk boundary in the middle of the samples
+  goma_ptrj_writer *w = goma_ptrj_open(filename, 2, 1, names, 1, 2);
+  REQUIRE(w != nullptr);
+  REQUIRE(goma_ptrj_zone(w, 0.0) == 0);
+  double x0[2] = {1.0, 2.0};
+  double v0[1] = {0.5};
+  double x1[2] = {3.0, 4.0};
+  double v1[1] = {-0.5};
+  double x2[2] = {5.0, 6.0};
+  double v2[1] = {1.5};
+  REQUIRE(goma_ptrj_append(w, x0, 0.0, v0, 0) == 0);
+  REQUIRE(goma_ptrj_append(w, x1, 0.0, v1, 1) == 0);
+  REQUIRE(goma_ptrj_append(w, x2, 0.0, v2, 0) == 0);
+  REQUIRE(goma_ptrj_zone(w, 0.25) == 0);
+  REQUIRE(goma_ptrj_append(w, x0, 0.25, v0, 1) == 0);
+  REQUIRE(goma_ptrj_close(w) == 0);
+
+  FILE *out = tmpfile();
+  REQUIRE(out != nullptr);
+  REQUIRE(goma_ptrj_to_tecplot(filename, out, 1) == 0);
+  std::string text = read_all(out);
+  fclose(out);
+
+  std::string expected;
+  char row[256];
+  expected += "TITLE = \"Goma Particles\"\n";
+  expected += "VARIABLES = \"X\", \"Y\", \"TIME\", \"VX\", \"PROCID\"\n";
+  expected += "ZONE T=\"0\"\n";
+  snprintf(row, sizeof(row), " %12g %12g %12g %12g %d\n", 1.0, 2.0, 0.0, 0.5, 0);
+  expected += row;
+  snprintf(row, sizeof(row), " %12g %12g %12g %12g %d\n", 3.0, 4.0, 0.0, -0.5, 1);
+  expected += row;
+  snprintf(row, sizeof(row), " %12g %12g %12g %12g %d\n", 5.0, 6.0, 0.0, 1.5, 0);
+  expected += row;
+  expected += "ZONE T=\"0.25\"\n";
+  snprintf(row, sizeof(row), " %12g %12g %12g %12g %d\n", 1.0, 2.0, 0.25, 0.5, 1);
+  expected += row;
+  CHECK(text == expected);
+
+  remove(filename);
+}
+
+TEST_CASE("particle trajectory rejects non trajectory files", "[particle_trajectory]") {
+  const char *filename = "particle_trajectory_bad.ptrj";
+  FILE *fp = fopen(filename, "w");
+  REQUIRE(fp != nullptr);
+  fprintf(fp, "TITLE = \"Goma Particles\"\n");
+  fclose(fp);
+
+  FILE *out = tmpfile();
+  REQUIRE(out != nullptr);
+  CHECK(goma_ptrj_to_tecplot(filename, out, 1) != 0);
+  fclose(out);
+  remove(filename);
+}
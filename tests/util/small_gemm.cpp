@@ -0,0 +1,39 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include "util/small_gemm.h"
+
+static double entry(int i, int j, int seed) { return std::sin(1.0 + seed + 0.7 * i + 1.3 * j); }
+
+TEST_CASE("small gemm matches the triple loop", "[small_gemm]") {
+  const int ld = 32;
+  for (int k = 1; k <= 10; k++) {
+    for (int m : {1, 4, 9, 27}) {
+      int n = m + 1;
+      std::vector<double> A(ld * ld), B(ld * ld), C(ld * ld), ref(ld * ld);
+      for (int i = 0; i < ld; i++) {
+        for (int j = 0; j < ld; j++) {
+          A[i * ld + j] = entry(i, j, 0);
+          B[i * ld + j] = entry(i, j, 1);
+          C[i * ld + j] = ref[i * ld + j] = entry(i, j, 2);
+        }
+      }
+      for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+          for (int l = 0; l < k; l++) {
+            ref[i * ld + j] += A[i * ld + l] * B[l * ld + j];
+          }
+        }
+      }
+
+      goma_small_gemm(m, n, k, A.data(), ld, B.data(), ld, C.data(), ld);
+
+      for (int i = 0; i < ld; i++) {
+        for (int j = 0; j < ld; j++) {
+          REQUIRE(std::fabs(C[i * ld + j] - ref[i * ld + j]) < 1e-13);
+        }
+      }
+    }
+  }
+}
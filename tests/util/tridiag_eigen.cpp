@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include "util/tridiag_eigen.h"
+
+TEST_CASE("tridiagonal eigensolver gives Gauss-Legendre points", "[tridiag_eigen]") {
+  // Jacobi matrix of the Legendre polynomials, total weight 2
+  const int n = 3;
+  double diag[n] = {0., 0., 0.};
+  double off[n - 1];
+  for (int k = 1; k < n; k++) {
+    off[k - 1] = k / std::sqrt(4. * k * k - 1.);
+  }
+  double x[n], z0[n];
+  REQUIRE(goma_tridiag_eigen(n, diag, off, x, z0) == 0);
+
+  double ref_x[n] = {-std::sqrt(0.6), 0., std::sqrt(0.6)};
+  double ref_w[n] = {5. / 9., 8. / 9., 5. / 9.};
+  for (int i = 0; i < n; i++) {
+    REQUIRE(std::fabs(x[i] - ref_x[i]) < 1e-14);
+    REQUIRE(std::fabs(2. * z0[i] * z0[i] - ref_w[i]) < 1e-14);
+  }
+}
+
+TEST_CASE("tridiagonal eigensolver matches the 2x2 closed form", "[tridiag_eigen]") {
+  for (int seed = 0; seed < 20; seed++) {
+    double a = std::sin(1. + seed), b = 3. * std::cos(2. + seed), c = 0.1 + seed;
+    double diag[2] = {a, b};
+    double off[1] = {c};
+    double x[2], z0[2];
+    REQUIRE(goma_tridiag_eigen(2, diag, off, x, z0) == 0);
+
+    double mean = 0.5 * (a + b);
+    double rad = std::hypot(0.5 * (a - b), c);
+    REQUIRE(std::fabs(x[0] - (mean - rad)) < 1e-13 * (1. + rad));
+    REQUIRE(std::fabs(x[1] - (mean + rad)) < 1e-13 * (1. + rad));
+    // first components of (c, x - a) normalized
+    for (int i = 0; i < 2; i++) {
+      double v0 = c, v1 = x[i] - a;
+      REQUIRE(std::fabs(z0[i] * z0[i] - v0 * v0 / (v0 * v0 + v1 * v1)) < 1e-12);
+    }
+  }
+}
+
+TEST_CASE("tridiagonal eigensolver reproduces the moments", "[tridiag_eigen]") {
+  // eigenvalues sum to the trace, weights to one and sum w x = diag[0]
+  const int n = 8;
+  std::vector<double> diag(n), off(n - 1), x(n), z0(n);
+  for (int i = 0; i < n; i++) {
+    diag[i] = 1. + 0.5 * i + std::sin(3. * i);
+  }
+  for (int i = 0; i < n - 1; i++) {
+    off[i] = 0.3 + 0.2 * std::cos(i);
+  }
+  REQUIRE(goma_tridiag_eigen(n, diag.data(), off.data(), x.data(), z0.data()) == 0);
+
+  double trace = 0., sum_x = 0., sum_w = 0., mom1 = 0.;
+  for (int i = 0; i < n; i++) {
+    trace += diag[i];
+    sum_x += x[i];
+    sum_w += z0[i] * z0[i];
+    mom1 += z0[i] * z0[i] * x[i];
+    if (i > 0) {
+      REQUIRE(x[i] >= x[i - 1]);
+    }
+  }
+  REQUIRE(std::fabs(sum_x - trace) < 1e-12);
+  REQUIRE(std::fabs(sum_w - 1.) < 1e-13);
+  REQUIRE(std::fabs(mom1 - diag[0]) < 1e-12);
+
+  REQUIRE(goma_tridiag_eigen(0, diag.data(), off.data(), x.data(), z0.data()) == -1);
+  REQUIRE(goma_tridiag_eigen(GOMA_TRIDIAG_EIGEN_MAX_N + 1, diag.data(), off.data(), x.data(),
+                             nullptr) == -1);
+}